@@ -0,0 +1,69 @@
+#!/usr/bin/env python3
+# Checks the maze router's average time per net against a target. The router is exercised by anneal, which routes
+# every connection of its initial placement and reroutes the connections of each evaluated move.
+# Run from the build folder via
+#   python3 ../benchmarks/maze_routing.py -f ./fiction
+# The script exits with status 1 if any run exceeds the target, which defaults to 1 ms per net.
+
+import argparse
+import json
+import os
+import subprocess
+import sys
+import tempfile
+
+BENCHMARKS = ["../benchmarks/ISCAS85/c432.v", "../benchmarks/ISCAS85/c880.v", "../benchmarks/ISCAS85/c1908.v",
+              "../benchmarks/ISCAS85/c3540.v", "../benchmarks/EPFL/ctrl.v", "../benchmarks/EPFL/int2float.v",
+              "../benchmarks/EPFL/cavlc.v", "../benchmarks/EPFL/router.v"]
+
+SCHEMES = ["2ddwave4", "use", "res"]
+
+
+def run(fiction, benchmark, scheme, rounds):
+    with tempfile.TemporaryDirectory() as tmp:
+        log_file = os.path.join(tmp, "routing.json")
+        subprocess.run([fiction, "-c", "read {}; anneal -s {} -r {}".format(benchmark, scheme, rounds),
+                        "-l", log_file], check=True, stdout=subprocess.DEVNULL)
+        with open(log_file) as f:
+            log = json.load(f)
+
+    for entry in log:
+        if entry.get("command", "").startswith("anneal") and "routing" in entry:
+            return entry["routing"]
+
+    return None
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Routing time per net of fiction's maze router")
+    parser.add_argument("-f", "--fiction", default="./fiction", help="path of the fiction executable")
+    parser.add_argument("-r", "--rounds", type=int, default=10, help="number of annealing rounds per run")
+    parser.add_argument("-t", "--target", type=float, default=1.0, help="maximum average time per net in ms")
+    parser.add_argument("benchmarks", nargs="*", default=BENCHMARKS, help="logic networks to place and route")
+    args = parser.parse_args()
+
+    exceeded = 0
+    for benchmark in args.benchmarks:
+        for scheme in SCHEMES:
+            routing = run(args.fiction, benchmark, scheme, args.rounds)
+            if routing is None or routing["searches"] == 0:
+                print("[w] {} ({}): no routing information logged".format(benchmark, scheme))
+                continue
+
+            ms_per_net = routing["ms per net"]
+            status = "ok" if ms_per_net <= args.target else "exceeded"
+            if ms_per_net > args.target:
+                exceeded += 1
+
+            print("[i] {} ({}): {} searches, {} paths found, {:.3f} ms per net ({})".format(
+                benchmark, scheme, routing["searches"], routing["paths found"], ms_per_net, status))
+
+    if exceeded > 0:
+        print("[e] {} runs exceeded the target of {} ms per net".format(exceeded, args.target))
+        sys.exit(1)
+
+    print("[i] all runs met the target of {} ms per net".format(args.target))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,75 @@
+#!/usr/bin/env python3
+# Measures request latencies of fiction's server mode under concurrent load.
+# Start a server from the build folder via
+#   ./fiction -c "read ../benchmarks/TOY; server -s fiction.sock"
+# and run
+#   python3 ../benchmarks/server_load.py -s fiction.sock -c 8 -r 100
+# Each client opens a session of its own and fires the given request repeatedly. Latencies are measured from sending a
+# request line until the end-of-transmission line (0x04) of its response has been received.
+
+import argparse
+import socket
+import statistics
+import threading
+import time
+
+EOT = b"\x04\n"
+
+
+def client(path, request, num_requests, latencies, failures):
+    with socket.socket(socket.AF_UNIX, socket.SOCK_STREAM) as s:
+        s.connect(path)
+        buffer = b""
+        for _ in range(num_requests):
+            start = time.perf_counter()
+            s.sendall(request.encode() + b"\n")
+            while EOT not in buffer:
+                chunk = s.recv(65536)
+                if not chunk:
+                    return
+                buffer += chunk
+            response, buffer = buffer.split(EOT, 1)
+            latencies.append(time.perf_counter() - start)
+            if b"[e]" in response:
+                failures.append(response.decode(errors="replace"))
+        s.sendall(b"quit\n")
+
+
+def percentile(values, p):
+    return values[min(len(values) - 1, int(p / 100.0 * len(values)))]
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Load test for fiction's server mode")
+    parser.add_argument("-s", "--socket", default="fiction.sock", help="path of the server's socket")
+    parser.add_argument("-c", "--clients", type=int, default=8, help="number of concurrent sessions")
+    parser.add_argument("-r", "--requests", type=int, default=100, help="number of requests per session")
+    parser.add_argument("-q", "--request", default="ortho; cell; qca; clear -gc",
+                        help="request line to send; the stores are a copy of the server's ones")
+    args = parser.parse_args()
+
+    latencies, failures = [], []
+    threads = [threading.Thread(target=client, args=(args.socket, args.request, args.requests, latencies, failures))
+               for _ in range(args.clients)]
+
+    start = time.perf_counter()
+    for t in threads:
+        t.start()
+    for t in threads:
+        t.join()
+    total = time.perf_counter() - start
+
+    if not latencies:
+        print("[e] no request has been answered")
+        return
+
+    latencies.sort()
+    print("[i] {} requests in {:.2f} s ({:.1f} requests/s), {} failed".format(len(latencies), total,
+                                                                              len(latencies) / total, len(failures)))
+    print("[i] latency (ms): mean {:.2f}, median {:.2f}, p95 {:.2f}, p99 {:.2f}, max {:.2f}".format(
+        1000 * statistics.mean(latencies), 1000 * statistics.median(latencies), 1000 * percentile(latencies, 95),
+        1000 * percentile(latencies, 99), 1000 * latencies[-1]))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,64 @@
+//
+// Created by marcel on 19.10.26.
+//
+
+#ifndef ANNEALING_PD_CONFIGURATION_H
+#define ANNEALING_PD_CONFIGURATION_H
+
+#include <cstdint>
+#include <memory>
+#include "fcn_clocking_scheme.h"
+
+
+/**
+ * Configuration struct to set up simulated annealing physical design calls.
+ */
+struct annealing_pd_config
+{
+    /**
+     * Clocking scheme to be used.
+     */
+    std::shared_ptr<fcn_clocking_scheme> scheme = nullptr;
+    /**
+     * Flag to indicate that a vertically shifted layout should be created. See fcn_layout::offset.
+     */
+    bool vertical_offset = false;
+    /**
+     * Flag to indicate that designated I/O ports should be placed.
+     */
+    bool io_ports = false;
+    /**
+     * Flag to indicate that wires may cross each other.
+     */
+    bool crossings = true;
+    /**
+     * Number of threads to evaluate candidate moves with. 0 means all available.
+     */
+    std::size_t num_threads = 0ul;
+    /**
+     * Number of annealing rounds. In each round, one move is proposed for every gate. 0 skips the annealing and
+     * returns the constructed initial placement.
+     */
+    std::size_t rounds = 50ul;
+    /**
+     * Temperature of the first round in units of path cost, i.e., tiles.
+     */
+    double initial_temperature = 2.0;
+    /**
+     * Factor by which the temperature is multiplied after each round.
+     */
+    double cooling = 0.9;
+    /**
+     * Maximum distance in tiles a gate is moved in each direction in the first round. The distance shrinks with the
+     * temperature.
+     */
+    std::size_t window = 4ul;
+    /**
+     * Seed of the random number generator that proposes and accepts moves. Results are reproducible for equal seeds
+     * regardless of the number of threads.
+     */
+    std::uint64_t seed = 0ul;
+};
+
+
+#endif //ANNEALING_PD_CONFIGURATION_H
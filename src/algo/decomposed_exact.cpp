@@ -0,0 +1,639 @@
+//
+// Created by marcel on 19.10.26.
+//
+
+#include "decomposed_exact.h"
+
+
+decomposed_exact::decomposed_exact(logic_network_ptr ln, exact_pd_config&& config)
+        :
+        physical_design(std::move(ln)),
+        config{std::move(config)},
+        snapshot{std::make_shared<const logic_network_snapshot>(network)}
+{}
+
+physical_design::pd_result decomposed_exact::operator()()
+{
+    mockturtle::stopwatch<>::duration time{0};
+    nlohmann::json json{};
+
+    // irregular clockings do not continue in the channels between sub-layouts
+    std::vector<partition> partitions{};
+    if (config.scheme->regular)
+        partitions = mockturtle::call_with_stopwatch(time, [this]{ return partition_network(); });
+
+    // nothing to decompose
+    if (partitions.size() < 2ul)
+    {
+        const auto pd = create_exact(network, exact_pd_config{config});
+        auto result = (*pd)();
+        layout = pd->get_layout();
+
+        return result;
+    }
+
+    auto success = true;
+    {
+        mockturtle::stopwatch stop{time};
+
+        const auto subs = extract_sub_networks(partitions);
+
+        // all sub-calls share one thread budget
+        const std::size_t budget = config.num_threads > 1ul ? config.num_threads :
+                                   std::max(std::thread::hardware_concurrency(), 1u);
+        const auto num_workers = std::min(budget, subs.size());
+        const auto sub_threads = std::max(budget / num_workers / std::max(config.solver_threads, 1u), std::size_t{1});
+
+        std::vector<std::shared_ptr<exact>> pds{};
+        for (const auto& sub : subs)
+        {
+            auto sub_config = config;
+            sub_config.decompose = false;
+            sub_config.border_io = true;  // cut I/Os have to be reachable from the channels
+            sub_config.num_threads = sub_threads;
+            sub_config.trace_file.clear();  // profiles of all partitions are logged instead
+            pds.push_back(create_exact(sub.network, std::move(sub_config)));
+        }
+
+        std::vector<pd_result> results(pds.size());
+        std::atomic<std::size_t> next{0ul};
+        const auto worker = [&pds, &results, &next]
+        {
+            for (auto i = next++; i < pds.size(); i = next++)
+                results[i] = (*pds[i])();
+        };
+
+        // the calling thread works as well
+        std::vector<std::thread> threads{};
+        for (auto t = 1ul; t < num_workers; ++t)
+            threads.emplace_back(worker);
+
+        worker();
+
+        for (auto& t : threads)
+            t.join();
+
+        std::vector<fcn_gate_layout_ptr> sub_layouts{};
+        for (auto i = 0ul; i < pds.size(); ++i)
+        {
+            auto sub_json = results[i].json;
+            sub_json["POs"] = partitions[i].num_pos;
+            sub_json["vertices"] = pds[i]->get_logic_network()->vertex_count(config.io_ports);
+            sub_json["cut inputs"] = subs[i].cut_pis.size();
+            sub_json["cut outputs"] = subs[i].cut_pos.size();
+
+            if (results[i].success)
+            {
+                const auto sl = pds[i]->get_layout();
+                sub_json["x"] = sl->x();
+                sub_json["y"] = sl->y();
+                sub_layouts.push_back(sl);
+            }
+            else
+                success = false;
+
+            json["partitions"].push_back(sub_json);
+        }
+
+        if (success)
+        {
+            const auto jn = join(sub_layouts, subs);
+            json["cut edges"] = jn.cut_edges.size();
+
+            // widen the channels until all cut edges can be routed
+            auto unrouted = 0ul;
+            for (coord_t channel = 1ul; channel <= 4ul; channel *= 2ul)
+            {
+                json["channel width"] = channel;
+                if ((unrouted = stitch(jn, sub_layouts, place(sub_layouts, channel))) == 0ul)
+                    break;
+            }
+            json["unrouted edges"] = unrouted;
+
+            if (unrouted > 0ul)
+            {
+                json["equivalence"] = "NONE";
+                success = false;
+            }
+            else
+            {
+                switch (equivalence_checker{layout, true}().eq)
+                {
+                    case equivalence_checker::equiv_result::eq_type::STRONG:
+                    {
+                        json["equivalence"] = "STRONG";
+                        break;
+                    }
+                    case equivalence_checker::equiv_result::eq_type::WEAK:
+                    {
+                        json["equivalence"] = "WEAK";
+                        break;
+                    }
+                    default:
+                    {
+                        json["equivalence"] = "NONE";
+                        success = false;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    json["runtime (s)"] = mockturtle::to_seconds(time);
+
+    return pd_result{success, json};
+}
+
+void decomposed_exact::interrupt() noexcept
+{
+    interrupted = true;
+
+    std::lock_guard<std::mutex> guard(pd_mutex);
+    for (const auto& pd : sub_pds)
+        pd->interrupt();
+}
+
+std::shared_ptr<exact> decomposed_exact::create_exact(logic_network_ptr ln, exact_pd_config&& cfg)
+{
+    auto pd = std::make_shared<exact>(std::move(ln), std::move(cfg));
+
+    std::lock_guard<std::mutex> guard(pd_mutex);
+    sub_pds.push_back(pd);
+
+    // interrupt might have been called before the sub-call was registered
+    if (interrupted)
+        pd->interrupt();
+
+    return pd;
+}
+
+std::vector<decomposed_exact::partition> decomposed_exact::partition_network() const noexcept
+{
+    const auto n = snapshot->vertex_count(true);
+
+    // only logic gates are taken into account for overlaps because PIs and fan-outs hardly occupy any area
+    boost::dynamic_bitset<> gates(n);
+    for (auto&& v : snapshot->vertices(true))
+    {
+        switch (snapshot->get_op(v))
+        {
+            case operation::PI:
+            case operation::PO:
+            case operation::W:
+            case operation::F1O2:
+            case operation::F1O3:
+                break;
+            default:
+                gates.set(v);
+        }
+    }
+
+    std::vector<partition> partitions{};
+    for (auto&& po : snapshot->get_pos())
+    {
+        partition p{boost::dynamic_bitset<>(n), 1ul};
+        p.vertices.set(po);
+
+        std::vector<logic_vertex> stack{po};
+        while (!stack.empty())
+        {
+            const auto v = stack.back();
+            stack.pop_back();
+
+            for (auto&& iav : snapshot->inv_adjacent_vertices(v, true))
+            {
+                if (!p.vertices.test(iav))
+                {
+                    p.vertices.set(iav);
+                    stack.push_back(iav);
+                }
+            }
+        }
+
+        partitions.push_back(std::move(p));
+    }
+
+    const std::size_t max_partitions = config.max_partitions ? config.max_partitions :
+                                       std::max(std::thread::hardware_concurrency(), 1u);
+
+    const auto num_gates = [&gates](const partition& p){ return (p.vertices & gates).count(); };
+    // fraction of the smaller partition's gates that are shared; cones without gates are merged with priority
+    const auto overlap = [&gates, &num_gates](const partition& p1, const partition& p2) -> double
+    {
+        const auto smaller = std::min(num_gates(p1), num_gates(p2));
+        if (smaller == 0ul)
+            return 1.0;
+
+        return static_cast<double>((p1.vertices & p2.vertices & gates).count()) / static_cast<double>(smaller);
+    };
+
+    std::vector<std::vector<double>> overlaps(partitions.size(), std::vector<double>(partitions.size(), 0.0));
+    for (auto i = 0ul; i < partitions.size(); ++i)
+    {
+        for (auto j = i + 1; j < partitions.size(); ++j)
+            overlaps[i][j] = overlaps[j][i] = overlap(partitions[i], partitions[j]);
+    }
+
+    std::vector<bool> merged(partitions.size(), false);
+    for (auto num_partitions = partitions.size(); num_partitions > 1ul; --num_partitions)
+    {
+        // find the pair of partitions with the largest overlap; prefer small ones in case of ties
+        std::optional<std::pair<std::size_t, std::size_t>> best{};
+        for (auto i = 0ul; i < partitions.size(); ++i)
+        {
+            for (auto j = i + 1; j < partitions.size() && !merged[i]; ++j)
+            {
+                if (merged[j])
+                    continue;
+
+                if (!best || overlaps[i][j] > overlaps[best->first][best->second] ||
+                    (overlaps[i][j] == overlaps[best->first][best->second] &&
+                     partitions[i].vertices.count() + partitions[j].vertices.count() <
+                     partitions[best->first].vertices.count() + partitions[best->second].vertices.count()))
+                    best = {i, j};
+            }
+        }
+
+        const auto [i, j] = *best;
+        if (overlaps[i][j] < config.merge_threshold && num_partitions <= max_partitions)
+            break;
+
+        partitions[i].vertices |= partitions[j].vertices;
+        partitions[i].num_pos += partitions[j].num_pos;
+        merged[j] = true;
+
+        for (auto k = 0ul; k < partitions.size(); ++k)
+        {
+            if (k != i && !merged[k])
+                overlaps[i][k] = overlaps[k][i] = overlap(partitions[i], partitions[k]);
+        }
+    }
+
+    std::vector<partition> result{};
+    for (auto i = 0ul; i < partitions.size(); ++i)
+    {
+        if (!merged[i])
+            result.push_back(std::move(partitions[i]));
+    }
+
+    return result;
+}
+
+std::vector<decomposed_exact::sub_network>
+decomposed_exact::extract_sub_networks(const std::vector<partition>& partitions) const noexcept
+{
+    // each vertex is owned by the first partition containing it; since partitions are closed under fan-in, cut edges
+    // only lead to partitions with higher indices
+    std::vector<std::size_t> owner(snapshot->vertex_count(true), partitions.size());
+    for (auto i = partitions.size(); i-- > 0ul;)
+    {
+        const auto& vs = partitions[i].vertices;
+        for (auto v = vs.find_first(); v != boost::dynamic_bitset<>::npos; v = vs.find_next(v))
+            owner[v] = i;
+    }
+    // PIs without any path to a PO still have to be part of the joint network
+    for (auto&& pi : snapshot->get_pis())
+    {
+        if (owner[pi] == partitions.size())
+            owner[pi] = 0ul;
+    }
+
+    const auto is_fan_out = [this](const logic_vertex v)
+    {
+        const auto op = snapshot->get_op(v);
+        return op == operation::F1O2 || op == operation::F1O3;
+    };
+    // fan-outs are bypassed and have exactly one predecessor
+    const auto driver = [this, &is_fan_out](logic_vertex v)
+    {
+        while (is_fan_out(v))
+            v = *snapshot->inv_adjacent_vertices(v, true).begin();
+
+        return v;
+    };
+
+    // driving vertices of cut edges and the partitions they are cut to
+    std::set<std::pair<logic_vertex, std::size_t>> cuts{};
+    for (auto&& v : snapshot->vertices(true))
+    {
+        if (is_fan_out(v) || owner[v] == partitions.size())
+            continue;
+
+        for (auto&& iav : snapshot->inv_adjacent_vertices(v, true))
+        {
+            if (const auto d = driver(iav); owner[d] != owner[v])
+                cuts.emplace(d, owner[v]);
+        }
+    }
+
+    std::vector<sub_network> subs{};
+    for (auto i = 0ul; i < partitions.size(); ++i)
+    {
+        // copying keeps name and logic description
+        sub_network sub{std::make_shared<logic_network>(*network)};
+        auto& sn = sub.network;
+        sn->clear_network();
+
+        const auto is_owned = [i, &owner, &is_fan_out](const logic_vertex v){ return owner[v] == i && !is_fan_out(v); };
+
+        std::unordered_map<logic_vertex, logic_vertex> vertex_map{};
+        for (auto&& v : snapshot->vertices(true))
+        {
+            if (!is_owned(v))
+                continue;
+
+            if (snapshot->is_pi(v))
+                vertex_map.emplace(v, sn->create_pi(snapshot->get_port_name(v)));
+            else if (snapshot->is_po(v))
+                vertex_map.emplace(v, sn->create_po(snapshot->get_port_name(v)));
+            else
+                vertex_map.emplace(v, sn->create_logic_vertex(snapshot->get_op(v)));
+        }
+
+        for (auto&& v : snapshot->vertices(true))
+        {
+            if (!is_owned(v))
+                continue;
+
+            for (auto&& iav : snapshot->inv_adjacent_vertices(v, true))
+            {
+                const auto d = driver(iav);
+                if (owner[d] == i)
+                {
+                    sn->create_edge(vertex_map.at(d), vertex_map.at(v));
+                    continue;
+                }
+
+                auto it = sub.cut_pis.find(d);
+                if (it == sub.cut_pis.end())
+                    it = sub.cut_pis.emplace(d, sn->create_pi(fmt::format("cut_{}", d))).first;
+
+                // a pin cannot be connected to another pin directly
+                if (snapshot->is_po(v) && !config.io_ports)
+                {
+                    const auto w = sn->create_logic_vertex(operation::W);
+                    sn->create_edge(it->second, w);
+                    sn->create_edge(w, vertex_map.at(v));
+                }
+                else
+                    sn->create_edge(it->second, vertex_map.at(v));
+            }
+        }
+
+        for (auto&& [d, j] : cuts)
+        {
+            if (owner[d] != i)
+                continue;
+
+            const auto po = sn->create_po(fmt::format("cut_{}_{}", d, j));
+            sn->create_edge(vertex_map.at(d), po);
+            sub.cut_pos.emplace(std::make_pair(d, j), po);
+        }
+
+        subs.push_back(std::move(sub));
+    }
+
+    return subs;
+}
+
+decomposed_exact::joint_network decomposed_exact::join(const std::vector<fcn_gate_layout_ptr>& sub_layouts,
+                                                       const std::vector<sub_network>& subs) const noexcept
+{
+    // copying keeps name and logic description which serves as specification for equivalence checking
+    joint_network jn{std::make_shared<logic_network>(*network)};
+    jn.network->clear_network();
+    jn.vertex_maps.resize(sub_layouts.size());
+    jn.edge_maps.resize(sub_layouts.size());
+
+    for (auto i = 0ul; i < sub_layouts.size(); ++i)
+    {
+        // exact might have substituted fan-outs in the sub-network, which keeps the vertices that were there before
+        const auto sn = sub_layouts[i]->get_network();
+        auto& vertex_map = jn.vertex_maps[i];
+
+        std::unordered_set<logic_vertex> cut_ports{};
+        for (auto&& [d, v] : subs[i].cut_pis)
+            cut_ports.insert(v);
+        for (auto&& [c, v] : subs[i].cut_pos)
+            cut_ports.insert(v);
+
+        for (auto&& v : sn->vertices(true))
+        {
+            // cut I/O ports become wires of the connections between sub-layouts; cut pins are bypassed
+            if (cut_ports.count(v))
+            {
+                if (config.io_ports)
+                    vertex_map.emplace(v, jn.network->create_logic_vertex(operation::W));
+            }
+            else if (sn->is_pi(v))
+                vertex_map.emplace(v, jn.network->create_pi(sn->get_port_name(v)));
+            else if (sn->is_po(v))
+                vertex_map.emplace(v, jn.network->create_po(sn->get_port_name(v)));
+            else
+                vertex_map.emplace(v, jn.network->create_logic_vertex(sn->get_op(v)));
+        }
+
+        for (auto&& e : sn->edges(true))
+        {
+            const auto s = vertex_map.find(sn->source(e)), t = vertex_map.find(sn->target(e));
+            if (s != vertex_map.end() && t != vertex_map.end())
+                jn.edge_maps[i].emplace(e, jn.network->create_edge(s->second, t->second));
+        }
+    }
+
+    for (auto i = 0ul; i < sub_layouts.size(); ++i)
+    {
+        for (auto&& [c, p] : subs[i].cut_pos)
+        {
+            const auto& [d, j] = c;
+            const auto q = subs[j].cut_pis.at(d);
+
+            if (config.io_ports)
+            {
+                jn.cut_edges.push_back({i, p, j, q, jn.network->create_edge(jn.vertex_maps[i].at(p),
+                                                                            jn.vertex_maps[j].at(q))});
+            }
+            else
+            {
+                // connect the cut output's predecessor to all successors of the cut input
+                const auto x = *sub_layouts[i]->get_network()->inv_adjacent_vertices(p, true).begin();
+                for (auto&& y : sub_layouts[j]->get_network()->adjacent_vertices(q, true))
+                {
+                    jn.cut_edges.push_back({i, x, j, y, jn.network->create_edge(jn.vertex_maps[i].at(x),
+                                                                                jn.vertex_maps[j].at(y))});
+                }
+            }
+        }
+    }
+
+    return jn;
+}
+
+decomposed_exact::placement decomposed_exact::place(const std::vector<fcn_gate_layout_ptr>& sub_layouts,
+                                                    const coord_t channel) const noexcept
+{
+    // positions must be multiples of the cutout to preserve clock zones; shifted layouts need even rows additionally
+    const coord_t align_x = config.scheme->cutout_x;
+    coord_t align_y = config.scheme->cutout_y;
+    if (config.vertical_offset && align_y % 2 == 1)
+        align_y *= 2;
+
+    const auto align = [](const coord_t v, const coord_t a){ return (v + a - 1) / a * a; };
+    const auto gap_x = channel * align_x, gap_y = channel * align_y;
+
+    // incorporating BGL bug
+    placement p{std::vector<fcn_dimension_xy>(sub_layouts.size()), fcn_dimension_xy{2ul, 2ul}};
+
+    // information flows south-east in 2DDWave and east in ToPoliNano; cut edges lead to later partitions only
+    if (config.twoddwave || config.topolinano)
+    {
+        coord_t x = 0ul, y = 0ul;
+        for (auto i = 0ul; i < sub_layouts.size(); ++i)
+        {
+            p.positions[i] = fcn_dimension_xy{x, y};
+            x += align(sub_layouts[i]->x(), align_x) + gap_x;
+            if (config.twoddwave)
+                y += align(sub_layouts[i]->y(), align_y) + gap_y;
+        }
+    }
+    // other clockings allow for information flow in all directions
+    else
+    {
+        coord_t total_area = 0ul, max_width = 0ul;
+        for (const auto& sl : sub_layouts)
+        {
+            total_area += (align(sl->x(), align_x) + gap_x) * (align(sl->y(), align_y) + gap_y);
+            max_width   = std::max(max_width, align(sl->x(), align_x) + gap_x);
+        }
+
+        const auto shelf_width = std::max(max_width, static_cast<coord_t>(std::ceil(std::sqrt(total_area))));
+
+        // shelves are filled from the highest to the lowest sub-layout
+        std::vector<std::size_t> order(sub_layouts.size());
+        std::iota(order.begin(), order.end(), 0ul);
+        std::stable_sort(order.begin(), order.end(), [&sub_layouts](const auto i, const auto j)
+                         { return sub_layouts[i]->y() > sub_layouts[j]->y(); });
+
+        coord_t x = 0ul, y = 0ul, shelf_height = 0ul;
+        for (const auto i : order)
+        {
+            const auto width  = align(sub_layouts[i]->x(), align_x) + gap_x,
+                       height = align(sub_layouts[i]->y(), align_y) + gap_y;
+
+            if (x > 0ul && x + width > shelf_width)
+            {
+                x = 0ul;
+                y += shelf_height;
+                shelf_height = 0ul;
+            }
+
+            p.positions[i] = fcn_dimension_xy{x, y};
+            x += width;
+            shelf_height = std::max(shelf_height, height);
+        }
+    }
+
+    // channels surround the sub-layouts to the south and east as well
+    for (auto i = 0ul; i < sub_layouts.size(); ++i)
+    {
+        p.size[X] = std::max(p.size[X], p.positions[i][X] + sub_layouts[i]->x() + gap_x);
+        p.size[Y] = std::max(p.size[Y], p.positions[i][Y] + sub_layouts[i]->y() + gap_y);
+    }
+
+    return p;
+}
+
+std::size_t decomposed_exact::stitch(const joint_network& jn, const std::vector<fcn_gate_layout_ptr>& sub_layouts,
+                                     const placement& p) noexcept
+{
+    const auto& jnet = jn.network;
+
+    layout = std::make_shared<fcn_gate_layout>(fcn_dimension_xyz{p.size[X], p.size[Y], 2ul}, *config.scheme, jnet,
+                                               config.vertical_offset ? fcn_layout::offset::VERTICAL :
+                                                                        fcn_layout::offset::NONE);
+
+    // only primary I/Os of the joint network count as such
+    const auto is_pi = [this, &jnet](const logic_vertex v)
+    {
+        if (config.io_ports)
+            return jnet->is_pi(v);
+
+        for (auto&& iav : jnet->inv_adjacent_vertices(v, true))
+        {
+            if (jnet->is_pi(iav))
+                return true;
+        }
+
+        return false;
+    };
+    const auto is_po = [this, &jnet](const logic_vertex v)
+    {
+        if (config.io_ports)
+            return jnet->is_po(v);
+
+        for (auto&& av : jnet->adjacent_vertices(v, true))
+        {
+            if (jnet->is_po(av))
+                return true;
+        }
+
+        return false;
+    };
+
+    const auto shift = [&p](const std::size_t i, const layout_tile& t)
+    {
+        return layout_tile{t[X] + p.positions[i][X], t[Y] + p.positions[i][Y], t[Z]};
+    };
+
+    for (auto i = 0ul; i < sub_layouts.size(); ++i)
+    {
+        const auto& sl = sub_layouts[i];
+
+        for (auto&& t : sl->tiles())
+        {
+            if (sl->is_free_tile(t))
+                continue;
+
+            const auto jt = shift(i, t);
+
+            if (auto v = sl->get_logic_vertex(t))
+            {
+                const auto jv = jn.vertex_maps[i].at(*v);
+                layout->assign_logic_vertex(jt, jv, is_pi(jv), is_po(jv));
+            }
+            else
+            {
+                for (auto&& e : sl->get_logic_edges(t))
+                {
+                    const auto& je = jn.edge_maps[i].at(e);
+                    layout->assign_logic_edge(jt, je);
+                    layout->assign_wire_inp_dir(jt, je, sl->get_wire_inp_dirs(t, e));
+                    layout->assign_wire_out_dir(jt, je, sl->get_wire_out_dirs(t, e));
+                }
+            }
+
+            layout->assign_tile_inp_dir(jt, sl->get_tile_inp_dirs(t));
+            layout->assign_tile_out_dir(jt, sl->get_tile_out_dirs(t));
+            layout->assign_latch(jt, sl->get_latch(t));
+        }
+    }
+
+    maze_router::router_config rc{};
+    rc.crossings = config.crossings;
+    rc.latches   = config.clock_latches;
+    maze_router router{layout, rc};
+
+    auto unrouted = 0ul;
+    for (const auto& ce : jn.cut_edges)
+    {
+        const auto source = sub_layouts[ce.source_partition]->get_logic_tile(ce.source),
+                   target = sub_layouts[ce.target_partition]->get_logic_tile(ce.target);
+
+        if (!source || !target ||
+            !router.route(shift(ce.source_partition, *source), shift(ce.target_partition, *target), ce.edge))
+            ++unrouted;
+    }
+
+    return unrouted;
+}
@@ -0,0 +1,255 @@
+//
+// Created by marcel on 19.10.26.
+//
+
+#ifndef FICTION_DECOMPOSED_EXACT_H
+#define FICTION_DECOMPOSED_EXACT_H
+
+#include "exact.h"
+#include "equivalence_checker.h"
+#include "maze_router.h"
+#include <boost/dynamic_bitset.hpp>
+#include <boost/functional/hash/hash.hpp>
+#include <atomic>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <set>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+/**
+ * A hierarchical variant of the exact physical design approach that trades the optimality guarantee for scalability.
+ * Since the runtime of exact grows exponentially with the number of vertices, it quickly becomes unusable for networks
+ * beyond a few dozen gates. Many networks, however, consist of output cones that overlap only weakly.
+ *
+ * This approach computes the transitive fan-in cone of each PO and greedily merges cones that share a large fraction of
+ * their vertices until a given overlap threshold and a maximum number of partitions is respected. Each vertex is then
+ * assigned to the first partition containing it. Since cones are closed under fan-in, signals only cross from a
+ * partition to ones with higher indices. Every partition is extracted as a sub-network in which such cut edges are
+ * replaced by designated cut I/Os. All sub-networks are placed and routed by exact in parallel using an own Z3 context
+ * each and sharing one thread budget. Cut I/Os are placed at the sub-layouts' borders.
+ *
+ * The resulting sub-layouts are placed into a joint layout with routing channels in between. Their positions are
+ * aligned to the clocking scheme's cutout so that each sub-layout keeps its clock zones. For feed-forward clockings,
+ * i.e., 2DDWave and ToPoliNano, later partitions are placed south-east or east of earlier ones respectively. Cut edges
+ * are then routed through the channels by a maze_router; if that fails, the channels are widened. Cut I/O ports become
+ * wires of the routed connections and cut pins are bypassed. Finally, the stitched layout is verified against the
+ * original specification via equivalence_checker, which identifies ports by name.
+ *
+ * Since irregular clockings do not continue in the channels, they are not decomposed. Note that primary I/Os located
+ * at sub-layouts' borders are not necessarily located at the joint layout's border.
+ */
+class decomposed_exact : public physical_design
+{
+public:
+    /**
+     * Standard constructor.
+     *
+     * @param ln Logic network to be placed and routed.
+     * @param config Configuration object storing all the bounds, flags, and so on. It is passed to each sub-call of
+     *               exact. Its number of threads is the budget shared by all sub-calls and defaults to the number of
+     *               available threads.
+     */
+    decomposed_exact(logic_network_ptr ln, exact_pd_config&& config);
+    /**
+     * Starts the physical design process. Partitions the network, solves each partition exactly in parallel, stitches
+     * the resulting layouts, routes the cut edges, and checks the result for equivalence. If only one partition is
+     * found or the clocking is irregular, this approach degrades to a single exact call.
+     *
+     * @return Result type containing statistical information about the process.
+     */
+    pd_result operator()() override;
+    /**
+     * Interrupts all sub-calls of exact.
+     */
+    void interrupt() noexcept override;
+
+private:
+    /**
+     * Shortcuts for types.
+     */
+    using logic_vertex = logic_network::vertex;
+    using layout_tile  = fcn_gate_layout::tile;
+    /**
+     * Arguments, flags, and options for the physical design process stored in one configuration object.
+     */
+    const exact_pd_config config;
+    /**
+     * Frozen snapshot of the logic network. Used for all traversals.
+     */
+    logic_network_snapshot_ptr snapshot;
+    /**
+     * All sub-calls of exact. Access is restricted by pd_mutex such that they can be interrupted from other threads.
+     */
+    std::vector<std::shared_ptr<exact>> sub_pds{};
+    /**
+     * Restricts access to sub_pds.
+     */
+    std::mutex pd_mutex{};
+    /**
+     * Flag to indicate that interrupt has been called.
+     */
+    std::atomic<bool> interrupted{false};
+    /**
+     * Creates a sub-call of exact and registers it for interruption. If interrupt has been called already, the sub-call
+     * is interrupted right away.
+     *
+     * @param ln Logic network to be placed and routed.
+     * @param cfg Configuration of the sub-call.
+     * @return New instance of exact.
+     */
+    std::shared_ptr<exact> create_exact(logic_network_ptr ln, exact_pd_config&& cfg);
+    /**
+     * A partition of the network given by the set of vertices (indexed by logic_vertex) belonging to a union of PO
+     * cones and the number of POs whose cones have been united.
+     */
+    struct partition
+    {
+        boost::dynamic_bitset<> vertices;
+        std::size_t num_pos;
+    };
+    /**
+     * Computes the transitive fan-in cones of all POs and merges them greedily such that the resulting partitions share
+     * less than config.merge_threshold of their gates and there are no more than the allowed number of them. PIs,
+     * fan-outs, and balance vertices are not considered for the overlap as they hardly occupy any area.
+     *
+     * @return Partitions of the stored network.
+     */
+    std::vector<partition> partition_network() const noexcept;
+    /**
+     * A partition extracted as a logic network. Cut I/Os are identified by the vertex of the stored network that drives
+     * the cut edge and, for cut outputs, additionally by the index of the partition the signal is cut to.
+     */
+    struct sub_network
+    {
+        /**
+         * Logic network induced by the partition's vertices.
+         */
+        logic_network_ptr network;
+        /**
+         * Cut inputs of network by their driving vertex.
+         */
+        std::map<logic_vertex, logic_vertex> cut_pis{};
+        /**
+         * Cut outputs of network by their driving vertex and target partition.
+         */
+        std::map<std::pair<logic_vertex, std::size_t>, logic_vertex> cut_pos{};
+    };
+    /**
+     * Assigns each vertex to the first partition containing it and creates a sub-network per partition. Fan-outs are
+     * bypassed, i.e., exact substitutes them anew in each sub-network. Edges whose source belongs to another partition
+     * are replaced by cut I/Os. The created networks keep the logic description of the stored one.
+     *
+     * @param partitions Partitions to extract.
+     * @return Sub-network of each partition.
+     */
+    std::vector<sub_network> extract_sub_networks(const std::vector<partition>& partitions) const noexcept;
+    /**
+     * A cut edge of the joint network that has to be routed between two sub-layouts.
+     */
+    struct cut_edge
+    {
+        /**
+         * Index of the sub-layout the edge starts in.
+         */
+        std::size_t source_partition;
+        /**
+         * Vertex of the source sub-layout's network whose tile the edge starts at.
+         */
+        logic_vertex source;
+        /**
+         * Index of the sub-layout the edge ends in.
+         */
+        std::size_t target_partition;
+        /**
+         * Vertex of the target sub-layout's network whose tile the edge ends at.
+         */
+        logic_vertex target;
+        /**
+         * Edge in the joint network.
+         */
+        logic_network::edge edge;
+    };
+    /**
+     * The network associated with the stitched layout together with the mappings of all sub-networks' elements to it.
+     */
+    struct joint_network
+    {
+        /**
+         * Union of all sub-networks in which cut I/Os are connected.
+         */
+        logic_network_ptr network;
+        /**
+         * Maps vertices of each sub-network to the joint network. Cut pins are not mapped.
+         */
+        std::vector<std::unordered_map<logic_vertex, logic_vertex>> vertex_maps{};
+        /**
+         * Maps edges of each sub-network to the joint network. Edges incident to cut pins are not mapped.
+         */
+        std::vector<std::unordered_map<logic_network::edge, logic_network::edge,
+                                       boost::hash<logic_network::edge>>> edge_maps{};
+        /**
+         * Edges connecting the sub-layouts.
+         */
+        std::vector<cut_edge> cut_edges{};
+    };
+    /**
+     * Creates the joint network from the sub-layouts' networks. Cut I/O ports become balance vertices that are
+     * connected to each other. Cut pins are bypassed instead, i.e., the predecessor of a cut output is connected to the
+     * successors of the corresponding cut input directly. The joint network is complete before any layout is
+     * associated with it.
+     *
+     * @param sub_layouts Layouts whose networks are to be joined.
+     * @param subs Sub-networks providing the cut I/Os of each sub-layout.
+     * @return Joint network.
+     */
+    joint_network join(const std::vector<fcn_gate_layout_ptr>& sub_layouts,
+                       const std::vector<sub_network>& subs) const noexcept;
+    /**
+     * Positions of all sub-layouts in the joint layout together with its size.
+     */
+    struct placement
+    {
+        /**
+         * Position of each sub-layout's north-western tile.
+         */
+        std::vector<fcn_dimension_xy> positions;
+        /**
+         * Size of the joint layout.
+         */
+        fcn_dimension_xy size;
+    };
+    /**
+     * Places the given sub-layouts such that cut edges can be routed in between. For 2DDWave, sub-layouts are placed
+     * diagonally, for ToPoliNano, side by side in partition order. Other clockings allow for information flow in any
+     * direction; hence, sub-layouts are packed into shelves such that the joint layout is roughly square. Sub-layouts
+     * are separated and surrounded to the south and east by channels. All positions are multiples of the clocking
+     * scheme's cutout to preserve its clock zones.
+     *
+     * @param sub_layouts Layouts to place.
+     * @param channel Width of the channels in multiples of the cutout.
+     * @return Placement of the sub-layouts.
+     */
+    placement place(const std::vector<fcn_gate_layout_ptr>& sub_layouts, const coord_t channel) const noexcept;
+    /**
+     * Creates the joint layout from the given sub-layouts at the given positions and routes all cut edges. The result
+     * is stored in layout.
+     *
+     * @param jn Joint network to associate with the layout.
+     * @param sub_layouts Layouts to stitch.
+     * @param p Placement of the sub-layouts.
+     * @return Number of cut edges that could not be routed.
+     */
+    std::size_t stitch(const joint_network& jn, const std::vector<fcn_gate_layout_ptr>& sub_layouts,
+                       const placement& p) noexcept;
+};
+
+
+#endif //FICTION_DECOMPOSED_EXACT_H
@@ -52,6 +52,92 @@ std::size_t design_checker::get_warnings() const noexcept
     return warnings;
 }
 
+bool design_checker::violates(const design_rule r, const fcn_gate_layout::tile& t) const noexcept
+{
+    switch (r)
+    {
+        case design_rule::OVERFULL_TILE:
+        {
+            auto it = layout->e_map->find(t);
+            return it != layout->e_map->cend() && it->second.size() > wire_limit;
+        }
+        case design_rule::MISSING_CONNECTION:
+        {
+            if (layout->is_free_tile(t))
+                return false;
+
+            auto odf = layout->outgoing_data_flow(t);
+            bool dangling_out_connection = odf.empty() && !layout->is_po(t);
+
+            auto idf = layout->incoming_data_flow(t);
+            bool dangling_inp_connection = idf.empty() && !layout->is_pi(t);
+
+            return dangling_out_connection || dangling_inp_connection;
+        }
+        case design_rule::WIRE_CROSSING_GATE:
+        {
+            return t[Z] != GROUND && !layout->is_free_tile(t) && !layout->is_wire_tile(layout->below(t));
+        }
+        case design_rule::UNCLOCKED_TILE:
+        {
+            return !layout->is_regularly_clocked() && !layout->is_free_tile(t) && !layout->tile_clocking(t);
+        }
+        case design_rule::DIRECTION_AGAINST_DATA_FLOW:
+        {
+            if (layout->is_free_tile(t))
+                return false;
+
+            layout::directions out_dirs{}, inp_dirs{};
+
+            for (auto&& odf : layout->outgoing_data_flow(t))
+                out_dirs |= layout->get_bearing(t, odf);
+
+            for (auto&& idf : layout->incoming_data_flow(t))
+                inp_dirs |= layout->get_bearing(t, idf);
+
+            return (out_dirs != layout->get_tile_out_dirs(t)) || (inp_dirs != layout->get_tile_inp_dirs(t));
+        }
+        case design_rule::WIRE_IO:
+        {
+            return (layout->is_pi(t) || layout->is_po(t)) && !layout->is_gate_tile(t);
+        }
+        case design_rule::GATE_IO:
+        {
+            return (layout->is_pi(t) || layout->is_po(t)) &&
+                   layout->get_op(t) != operation::PI && layout->get_op(t) != operation::PO;
+        }
+        case design_rule::NON_BORDER_IO:
+        {
+            return (layout->is_pi(t) || layout->is_po(t)) && !layout->is_border(t);
+        }
+        default:
+        {
+            return false;
+        }
+    }
+}
+
+bool design_checker::is_design_breaking(const design_rule r) noexcept
+{
+    return r != design_rule::UNCLOCKED_TILE && r != design_rule::GATE_IO && r != design_rule::NON_BORDER_IO;
+}
+
+const char* design_checker::report_key(const design_rule r) noexcept
+{
+    switch (r)
+    {
+        case design_rule::OVERFULL_TILE: return "Overfull tiles";
+        case design_rule::MISSING_CONNECTION: return "Missing connections";
+        case design_rule::WIRE_CROSSING_GATE: return "Wires crossing gates";
+        case design_rule::UNCLOCKED_TILE: return "Unclocked non-empty tiles";
+        case design_rule::DIRECTION_AGAINST_DATA_FLOW: return "Directions against data flow";
+        case design_rule::WIRE_IO: return "Wire I/O ports";
+        case design_rule::GATE_IO: return "Gate I/O ports";
+        case design_rule::NON_BORDER_IO: return "Border I/O ports";
+        default: return "";
+    }
+}
+
 void design_checker::log_tile(const fcn_gate_layout::tile& t, nlohmann::json& report) const noexcept
 {
     std::stringstream s{};
@@ -88,9 +174,9 @@ std::string design_checker::wire_count_check(nlohmann::json& report) noexcept
     nlohmann::json wire_report{};
 
     auto all_matched = true;
-    for (auto& [t, e] : layout->e_map)
+    for (auto& [t, e] : *layout->e_map)
     {
-        if (e.size() > wire_limit)
+        if (violates(design_rule::OVERFULL_TILE, t))
         {
             all_matched = false;
             log_tile(t, wire_report);
@@ -98,7 +184,7 @@ std::string design_checker::wire_count_check(nlohmann::json& report) noexcept
         }
     }
 
-    report["Overfull tiles"] = wire_report;
+    report[report_key(design_rule::OVERFULL_TILE)] = wire_report;
 
     return summary(fmt::format("all tiles have at most {} wire{} assigned", wire_limit, wire_limit != 1 ? "s" : ""), all_matched, true);
 }
@@ -110,13 +196,7 @@ std::string design_checker::missing_connections_check(nlohmann::json& report) no
     auto all_connected = true;
     for (auto&& t : layout->tiles() | iter::filterfalse([this](const auto& _t){return layout->is_free_tile(_t);}))
     {
-        auto odf = layout->outgoing_data_flow(t);
-        bool dangling_out_connection = (std::distance(odf.begin(), odf.end()) == 0) && !layout->is_po(t);
-
-        auto idf = layout->incoming_data_flow(t);
-        bool dangling_inp_connection = (std::distance(idf.begin(), idf.end()) == 0) && !layout->is_pi(t);
-
-        if (dangling_out_connection || dangling_inp_connection)
+        if (violates(design_rule::MISSING_CONNECTION, t))
         {
             all_connected = false;
             log_tile(t, connections_report);
@@ -124,7 +204,7 @@ std::string design_checker::missing_connections_check(nlohmann::json& report) no
         }
     }
 
-    report["Missing connections"] = connections_report;
+    report[report_key(design_rule::MISSING_CONNECTION)] = connections_report;
 
     return summary("all occupied tiles are properly connected", all_connected, true);
 }
@@ -136,7 +216,7 @@ std::string design_checker::crossing_gates_check(nlohmann::json& report) noexcep
     auto all_wire_crossings = true;
     for (auto&& cross : layout->crossing_layers() | iter::filterfalse([this](const auto& _t){return layout->is_free_tile(_t);}))
     {
-        if (!layout->is_wire_tile(layout->below(cross)))
+        if (violates(design_rule::WIRE_CROSSING_GATE, cross))
         {
             all_wire_crossings = false;
             log_tile(cross, crossing_report);
@@ -144,7 +224,7 @@ std::string design_checker::crossing_gates_check(nlohmann::json& report) noexcep
         }
     }
 
-    report["Wires crossing gates"] = crossing_report;
+    report[report_key(design_rule::WIRE_CROSSING_GATE)] = crossing_report;
 
     return summary("all wire crossings cross over other wires only", all_wire_crossings, true);
 }
@@ -158,7 +238,7 @@ std::string design_checker::tile_clocking_check(nlohmann::json& report) noexcept
     {
         for (auto&& t : layout->tiles() | iter::filterfalse([this](const auto& _t){return layout->is_free_tile(_t);}))
         {
-            if (!layout->tile_clocking(t))
+            if (violates(design_rule::UNCLOCKED_TILE, t))
             {
                 all_clocked = false;
                 log_tile(t, clock_report);
@@ -167,7 +247,7 @@ std::string design_checker::tile_clocking_check(nlohmann::json& report) noexcept
         }
     }
 
-    report["Unclocked non-empty tiles"] = clock_report;
+    report[report_key(design_rule::UNCLOCKED_TILE)] = clock_report;
 
     return summary("all occupied tiles are clocked", all_clocked, false);
 }
@@ -179,15 +259,7 @@ std::string design_checker::direction_check(nlohmann::json& report) noexcept
     auto correct_directions = true;
     for (auto&& t : layout->tiles() | iter::filterfalse([this](const auto& _t){return layout->is_free_tile(_t);}))
     {
-        layout::directions out_dirs{}, inp_dirs{};
-
-        for (auto&& odf : layout->outgoing_data_flow(t))
-            out_dirs |= layout->get_bearing(t, odf);
-
-        for (auto&& idf : layout->incoming_data_flow(t))
-            inp_dirs |= layout->get_bearing(t, idf);
-
-        if ((out_dirs != layout->get_tile_out_dirs(t)) || (inp_dirs != layout->get_tile_inp_dirs(t)))
+        if (violates(design_rule::DIRECTION_AGAINST_DATA_FLOW, t))
         {
             correct_directions = false;
             log_tile(t, direction_report);
@@ -195,7 +267,7 @@ std::string design_checker::direction_check(nlohmann::json& report) noexcept
         }
     }
 
-    report["Directions against data flow"] = direction_report;
+    report[report_key(design_rule::DIRECTION_AGAINST_DATA_FLOW)] = direction_report;
 
     return summary("all tiles' directions respect data flow", correct_directions, true);
 }
@@ -207,7 +279,7 @@ std::string design_checker::operation_io_check(nlohmann::json& report) noexcept
     auto all_operation = true;
     for (auto&& io : iter::chain(layout->get_pis(), layout->get_pos()))
     {
-        if (!layout->is_gate_tile(io))
+        if (violates(design_rule::WIRE_IO, io))
         {
             all_operation = false;
             log_tile(io, wire_io_report);
@@ -215,7 +287,7 @@ std::string design_checker::operation_io_check(nlohmann::json& report) noexcept
         }
     }
 
-    report["Wire I/O ports"] = wire_io_report;
+    report[report_key(design_rule::WIRE_IO)] = wire_io_report;
 
     return summary("all I/O ports are assigned to some operation", all_operation, true);
 }
@@ -227,7 +299,7 @@ std::string design_checker::io_port_check(nlohmann::json& report) noexcept
     auto all_pin = true;
     for (auto&& io : iter::chain(layout->get_pis(), layout->get_pos()))
     {
-        if (layout->get_op(io) != operation::PI && layout->get_op(io) != operation::PO)
+        if (violates(design_rule::GATE_IO, io))
         {
             all_pin = false;
             log_tile(io, port_report);
@@ -235,7 +307,7 @@ std::string design_checker::io_port_check(nlohmann::json& report) noexcept
         }
     }
 
-    report["Gate I/O ports"] = port_report;
+    report[report_key(design_rule::GATE_IO)] = port_report;
 
     return summary("all I/O ports are realized by designated pins", all_pin, false);
 }
@@ -247,7 +319,7 @@ std::string design_checker::border_io_check(nlohmann::json& report) noexcept
     auto all_border = true;
     for (auto&& io : iter::chain(layout->get_pis(), layout->get_pos()))
     {
-        if (!layout->is_border(io))
+        if (violates(design_rule::NON_BORDER_IO, io))
         {
             all_border = false;
             log_tile(io, border_report);
@@ -255,7 +327,7 @@ std::string design_checker::border_io_check(nlohmann::json& report) noexcept
         }
     }
 
-    report["Border I/O ports"] = border_report;
+    report[report_key(design_rule::NON_BORDER_IO)] = border_report;
 
     return summary("all I/O ports are located at layout's borders", all_border, false);
 }
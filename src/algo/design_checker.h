@@ -55,6 +55,38 @@ public:
      * @return warnings.
      */
     std::size_t get_warnings() const noexcept;
+    /**
+     * Design rules that are checked tile by tile. See check for a description.
+     */
+    enum class design_rule { OVERFULL_TILE, MISSING_CONNECTION, WIRE_CROSSING_GATE, UNCLOCKED_TILE,
+                             DIRECTION_AGAINST_DATA_FLOW, WIRE_IO, GATE_IO, NON_BORDER_IO };
+    /**
+     * Number of design rules.
+     */
+    static constexpr std::size_t num_design_rules = 8ul;
+    /**
+     * Checks whether tile t violates design rule r. Used by check as well as by incremental_design_checker so that
+     * both agree on the rules.
+     *
+     * @param r Design rule to check.
+     * @param t Tile to check.
+     * @return True iff t violates r.
+     */
+    bool violates(const design_rule r, const fcn_gate_layout::tile& t) const noexcept;
+    /**
+     * Returns whether violations of design rule r are design breaking or mere warnings.
+     *
+     * @param r Design rule.
+     * @return True iff violations of r are design breaking.
+     */
+    static bool is_design_breaking(const design_rule r) noexcept;
+    /**
+     * Returns the key under which check lists violations of design rule r in its report.
+     *
+     * @param r Design rule.
+     * @return Report key of r.
+     */
+    static const char* report_key(const design_rule r) noexcept;
 
 private:
     /**
@@ -5,9 +5,10 @@
 #include "equivalence_checker.h"
 
 
-equivalence_checker::equivalence_checker(fcn_gate_layout_ptr fgl)
+equivalence_checker::equivalence_checker(fcn_gate_layout_ptr fgl, const bool match_port_names)
         :
-        miter{mockturtle::miter<logic_network::mig_nt>(fgl->extract(), fgl->network->mig)},
+        miter{mockturtle::miter<logic_network::mig_nt>(
+                match_port_names ? match_ports(fgl->extract(), fgl->network->mig) : fgl->extract(), fgl->network->mig)},
         layout{std::move(fgl)}
 {}
 
@@ -66,3 +67,66 @@ equivalence_checker::equiv_result equivalence_checker::operator()()
 
     return result;
 }
+
+logic_network::mig_nt equivalence_checker::match_ports(const logic_network::mig_nt& ntk,
+                                                       const logic_network::mig_nt& spec) noexcept
+{
+    if (ntk.num_pos() != spec.num_pos())
+        return ntk;
+
+    logic_network::mig_nt matched{};
+
+    // port names as assigned by logic_network
+    std::unordered_map<std::string, logic_network::mig_nt::signal> pi_signals{};
+    auto pi_c = 0ul;
+    spec.foreach_pi([&](const auto& pi)
+    {
+        const auto s = spec.make_signal(pi);
+        const auto name = spec.has_name(s) ? spec.get_name(s) : fmt::format("pi{}", pi_c++);
+
+        pi_signals.emplace(name, matched.create_pi(name));
+    });
+
+    std::unordered_map<std::string, uint32_t> po_indices{};
+    auto po_c = 0ul;
+    spec.foreach_po([&](const auto&, auto i)
+    {
+        po_indices.emplace(spec.has_output_name(i) ? spec.get_output_name(i) : fmt::format("po{}", po_c++), i);
+    });
+
+    if (pi_signals.size() != spec.num_pis() || po_indices.size() != spec.num_pos())
+        return ntk;
+
+    std::vector<logic_network::mig_nt::signal> leaves{};
+    ntk.foreach_pi([&](const auto& pi)
+    {
+        const auto s = ntk.make_signal(pi);
+        if (auto it = pi_signals.find(ntk.has_name(s) ? ntk.get_name(s) : ""); it != pi_signals.end())
+            leaves.push_back(it->second);
+    });
+
+    if (leaves.size() != ntk.num_pis())
+        return ntk;
+
+    const auto outputs = mockturtle::cleanup_dangling(ntk, matched, leaves.begin(), leaves.end());
+
+    // POs in the order of the specification
+    std::vector<std::optional<uint32_t>> po_order(spec.num_pos());
+    ntk.foreach_po([&](const auto&, auto i)
+    {
+        if (ntk.has_output_name(i))
+        {
+            if (auto it = po_indices.find(ntk.get_output_name(i)); it != po_indices.end())
+                po_order[it->second] = i;
+        }
+    });
+
+    if (std::any_of(po_order.cbegin(), po_order.cend(), [](const auto& o){ return !o.has_value(); }))
+        return ntk;
+
+    for (auto i = 0ul; i < po_order.size(); ++i)
+        matched.create_po(outputs[*po_order[i]], spec.has_output_name(static_cast<uint32_t>(i)) ?
+                                                 spec.get_output_name(static_cast<uint32_t>(i)) : "");
+
+    return matched;
+}
@@ -7,9 +7,14 @@
 
 #include "logic_network.h"
 #include "fcn_gate_layout.h"
+#include <mockturtle/algorithms/cleanup.hpp>
 #include <mockturtle/algorithms/equivalence_checking.hpp>
 #include <mockturtle/algorithms/miter.hpp>
 #include <nlohmann/json.hpp>
+#include <algorithm>
+#include <optional>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 
@@ -27,6 +32,10 @@
  * Logical equivalence is checked with a SAT solver by extracting a logic description from the topological structure of
  * the gate layout and transforming it to CNF via Tseitin transformation.
  *
+ * Optionally, I/Os are matched by name instead of by position if port names are unique in the specification. Thereby,
+ * layouts whose I/Os are not ordered like the specification's ones, e.g. such stitched by decomposed_exact, can be
+ * checked as well.
+ *
  * The technique is presented in "Verification for Field-coupled Nanocomputing Circuits" by Marcel Walter, Robert Wille,
  * Frank Sill Torres, Daniel Große, and Rolf Drechsler in DAC 2020.
  */
@@ -37,8 +46,9 @@ public:
      * Standard constructor. Creates a miter structure from a gate layout and its associated logic network.
      *
      * @param fgl Gate layout to check.
+     * @param match_port_names Flag to indicate that I/Os should be matched by name instead of by position.
      */
-    explicit equivalence_checker(fcn_gate_layout_ptr fgl);
+    explicit equivalence_checker(fcn_gate_layout_ptr fgl, const bool match_port_names = false);
     /**
      * Standard constructor. Creates a miter structure from two gate layouts.
      *
@@ -58,7 +68,7 @@ public:
         /**
          * Stores the equivalence type.
          */
-        eq_type eq;
+        eq_type eq = eq_type::NONE;
         /**
          * Delay value at which weak equivalence manifests.
          */
@@ -88,6 +98,16 @@ private:
      * The gate layout to check.
      */
     fcn_gate_layout_ptr layout;
+    /**
+     * Rebuilds the given logic description such that its I/Os are ordered like the specification's ones. Ports are
+     * identified by name; several PIs of the same name are merged into one. If names in the specification are not
+     * unique or not all ports can be matched, the logic description is returned unaltered.
+     *
+     * @param ntk Logic description whose ports are to be matched.
+     * @param spec Specification providing port names and order.
+     * @return Logic description with ports matched to spec.
+     */
+    static logic_network::mig_nt match_ports(const logic_network::mig_nt& ntk, const logic_network::mig_nt& spec) noexcept;
 };
 
 
@@ -8,41 +8,313 @@
 exact::exact(logic_network_ptr ln, exact_pd_config&& config)
         :
         physical_design(std::move(ln)),
-        config{config}
+        config{resolve_solver_strategy(config)}
 {
+    if (this->config.profile || !this->config.trace_file.empty())
+        profiler = std::make_shared<profile_sink>();
+
+    if (this->config.unsat_cores)
+        rules = std::make_shared<rule_store>();
+
     // OPEN clocking and RES support fan-out of outdegree 3
     auto fan_out_degree = config.scheme->name == "OPEN3" ||
                           config.scheme->name == "OPEN4" ||
                           config.scheme->name == "RES" ? 3u : 2u;
 
-    network->substitute_fan_outs(fan_out_degree);
+    // copy the network only if fan-outs have to be substituted
+    if (network->requires_fan_out_substitution())
+        make_unique_network(network)->substitute_fan_outs(fan_out_degree);
 
     lower_bound = std::max(static_cast<unsigned long>(network->vertex_count(config.io_ports)), 4ul);  // incorporating BGL bug
-    dit = dimension_iterator{config.fixed_size ? config.fixed_size : lower_bound};
+
+    // depth and width of the network determine the aspect ratio its layouts are expected to have
+    const network_hierarchy hierarchy{network, false};
+    std::vector<uint64_t> level_sizes(hierarchy.height() + 1ul, 0ul);
+    for (auto&& v : network->vertices(true))
+        ++level_sizes[hierarchy.get_level(v)];
+
+    const auto depth = level_sizes.size();
+    const auto width = *std::max_element(level_sizes.cbegin(), level_sizes.cend());
+
+    auto policy = this->config.policy;
+    if (policy.derive_aspect_ratio)
+        policy.max_aspect_ratio = derived_aspect_ratio(depth, width);
+
+    // information flows from west to east in ToPoliNano, i.e., the network's depth spans the x-axis
+    const auto preferred_ratio = this->config.topolinano ?
+                                 static_cast<double>(depth) / static_cast<double>(width) : 1.0;
+
+    dit = dimension_explorer{this->config.fixed_size ? this->config.fixed_size : lower_bound, this->config.upper_bound,
+                             policy, preferred_ratio};
+}
+
+void exact::interrupt() noexcept
+{
+    interrupted = true;
+
+    std::lock_guard<std::mutex> guard(ctx_mutex);
+    for (const auto& ctx : contexts)
+        ctx->interrupt();
+}
+
+exact::ctx_ptr exact::create_context() noexcept
+{
+    auto ctx = std::make_shared<z3::context>();
+
+    std::lock_guard<std::mutex> guard(ctx_mutex);
+    contexts.push_back(ctx);
+
+    // interrupt might have been called before the context was registered
+    if (interrupted)
+        ctx->interrupt();
+
+    return ctx;
 }
 
 physical_design::pd_result exact::operator()()
 {
-    if (config.num_threads > 1)
+    auto result = config.num_threads > 1 ? run_asynchronously() : run_synchronously();
+
+    if (!instance_info.is_null())
+        result.json["instance"] = instance_info;
+
+    if (profiler)
     {
-       return run_asynchronously();
+        result.json["profile"] = summarize_profile();
+
+        if (!config.trace_file.empty())
+            write_trace();
     }
-    else
+
+    if (rules)
+    {
+        std::lock_guard<std::mutex> guard(rules->mutex);
+        result.json["learned rules"] = {{"pruned dimensions", rules->num_pruned}, {"cores", rules->log}};
+    }
+
+    switch (config.strategy)
+    {
+        case exact_solver_strategy::TACTIC:
+            result.json["solver strategy"] = "tactic";
+            break;
+        case exact_solver_strategy::SAT:
+            result.json["solver strategy"] = "sat";
+            break;
+        default:
+            result.json["solver strategy"] = "smt";
+            break;
+    }
+
+    return result;
+}
+
+bool exact::is_integer_free(const exact_pd_config& c) noexcept
+{
+    // irregular clockings need tile clock variables
+    if (!c.scheme->regular)
+        return false;
+
+    // global synchronization needs PI clock variables except for 2DDWave with border I/Os, where it reduces to
+    // restricting the entry tiles, and clock latches need latch variables
+    return c.desynchronize || (!c.clock_latches && (c.topolinano || (c.twoddwave && c.border_io)));
+}
+
+exact_pd_config exact::resolve_solver_strategy(exact_pd_config c) noexcept
+{
+    if (c.strategy == exact_solver_strategy::AUTO)
+    {
+        c.strategy = is_integer_free(c) ? exact_solver_strategy::SAT : exact_solver_strategy::SMT;
+    }
+    else if (c.strategy == exact_solver_strategy::SAT && !is_integer_free(c))
+    {
+        std::cout << "[w] SAT strategy requires a regular clocking without clock latches and without global "
+                     "synchronization (unless 2DDWave with border I/Os is used); falling back to SMT" << std::endl;
+        c.strategy = exact_solver_strategy::SMT;
+    }
+
+    return c;
+}
+
+void exact::profile_sink::add(nlohmann::json&& record) noexcept
+{
+    std::lock_guard<std::mutex> guard(mutex);
+    records.push_back(std::move(record));
+}
+
+int64_t exact::profile_sink::timestamp(const std::chrono::steady_clock::time_point& t) const noexcept
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(t - start).count();
+}
+
+bool exact::rule_store::prunes(const fcn_dimension_xy& dim) noexcept
+{
+    std::lock_guard<std::mutex> guard(mutex);
+
+    if (unsat.count(dim) || std::any_of(bounds.cbegin(), bounds.cend(), [&dim](const auto& b)
+                                        { return dim[X] <= b[X] && dim[Y] <= b[Y]; }))
+    {
+        ++num_pruned;
+        return true;
+    }
+
+    return false;
+}
+
+void exact::rule_store::learn(const std::vector<fcn_dimension_xy>& new_bounds,
+                              const std::vector<fcn_dimension_xy>& new_unsat, nlohmann::json&& entry) noexcept
+{
+    std::lock_guard<std::mutex> guard(mutex);
+
+    for (const auto& nb : new_bounds)
+    {
+        bounds.erase(std::remove_if(bounds.begin(), bounds.end(), [&nb](const auto& b)
+                                    { return b[X] <= nb[X] && b[Y] <= nb[Y]; }), bounds.end());
+        bounds.push_back(nb);
+    }
+
+    unsat.insert(new_unsat.cbegin(), new_unsat.cend());
+    log.push_back(std::move(entry));
+}
+
+nlohmann::json exact::summarize_profile() const noexcept
+{
+    std::lock_guard<std::mutex> guard(profiler->mutex);
+
+    nlohmann::json phase_totals = nlohmann::json::object(), outcomes = nlohmann::json::object();
+    auto reuse_hits = 0ul;
+
+    for (const auto& r : profiler->records)
+    {
+        if (r["solver reuse"] != "none")
+            ++reuse_hits;
+
+        const auto outcome = r["outcome"].get<std::string>();
+        outcomes[outcome] = outcomes.value(outcome, 0ul) + 1ul;
+
+        for (const auto& p : r["phases"])
+        {
+            auto& total = phase_totals[p["phase"].get<std::string>()];
+            total["time (s)"]   = total.value("time (s)", 0.0) + p["time (s)"].get<double>();
+            total["assertions"] = total.value("assertions", 0ul) + p["assertions"].get<std::size_t>();
+        }
+    }
+
+    return nlohmann::json
+    {
+        {"dimensions", profiler->records.size()},
+        {"solver reuse hits", reuse_hits},
+        {"outcomes", outcomes},
+        {"phase totals", phase_totals},
+        {"records", profiler->records}
+    };
+}
+
+void exact::write_trace() const noexcept
+{
+    std::ofstream trace{config.trace_file};
+    if (!trace.good())
+    {
+        std::cout << "[e] could not open trace file " << config.trace_file << std::endl;
+        return;
+    }
+
+    std::lock_guard<std::mutex> guard(profiler->mutex);
+
+    // complete events (ph = X) with timestamps and durations in µs
+    nlohmann::json events = nlohmann::json::array();
+    for (const auto& r : profiler->records)
     {
-        return run_synchronously();
+        events.push_back(
+        {
+            {"name", fmt::format("{} × {}", r["dimension"][X].get<coord_t>(), r["dimension"][Y].get<coord_t>())},
+            {"cat", "dimension"},
+            {"ph", "X"},
+            {"ts", r["start (µs)"]},
+            {"dur", r["time (s)"].get<double>() * 1e6},
+            {"pid", 0},
+            {"tid", r["thread"]},
+            {"args",
+             {
+                {"outcome", r["outcome"]},
+                {"solver reuse", r["solver reuse"]},
+                {"assertions", r["assertions"]}
+             }
+            }
+        });
+
+        for (const auto& p : r["phases"])
+        {
+            events.push_back(
+            {
+                {"name", p["phase"]},
+                {"cat", "phase"},
+                {"ph", "X"},
+                {"ts", p["start (µs)"]},
+                {"dur", p["time (s)"].get<double>() * 1e6},
+                {"pid", 0},
+                {"tid", r["thread"]},
+                {"args", {{"assertions", p["assertions"]}}}
+            });
+        }
     }
+
+    trace << nlohmann::json{{"traceEvents", events}, {"displayTimeUnit", "ms"}}.dump() << std::endl;
 }
 
-exact::smt_handler::smt_handler(ctx_ptr ctx, fcn_gate_layout_ptr fgl, const exact_pd_config& c) noexcept
+exact::smt_handler::smt_handler(ctx_ptr ctx, fcn_gate_layout_ptr fgl, const exact_pd_config& c,
+                                std::shared_ptr<profile_sink> sink, const unsigned tid,
+                                std::shared_ptr<rule_store> rules) noexcept
         :
         ctx{std::move(ctx)},
         layout{std::move(fgl)},
-        network{layout->get_network()},
-        hierarchy{std::make_shared<network_hierarchy>(network,false)},
-        config{c}
+        network{std::make_shared<const logic_network_snapshot>(layout->get_network())},
+        hierarchy{std::make_shared<network_hierarchy>(layout->get_network(), false)},
+        config{c},
+        sink{std::move(sink)},
+        tid{tid},
+        rules{std::move(rules)}
 {
     hierarchy->unify_output_ranks();
     hierarchy->unify_inv_input_ranks();
+
+    compute_levels();
+
+    if (config.domain_pruning)
+        classify_data_flow();
+}
+
+template <typename Fn>
+decltype(auto) exact::smt_handler::profile(const char* phase, Fn&& fn)
+{
+    if (!sink)
+        return fn();
+
+    const auto assertions = solver->assertions().size();
+    const auto start = std::chrono::steady_clock::now();
+
+    const auto add_phase = [this, phase, assertions, &start]
+    {
+        record["phases"].push_back(
+        {
+            {"phase", phase},
+            {"start (µs)", sink->timestamp(start)},
+            {"time (s)", std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count()},
+            {"assertions", solver->assertions().size() - assertions}
+        });
+    };
+
+    if constexpr (std::is_void_v<std::invoke_result_t<Fn>>)
+    {
+        fn();
+        add_phase();
+    }
+    else
+    {
+        auto result = fn();
+        add_phase();
+
+        return result;
+    }
 }
 
 bool exact::smt_handler::skippable(const fcn_dimension_xy& dim) const noexcept
@@ -61,16 +333,31 @@ bool exact::smt_handler::skippable(const fcn_dimension_xy& dim) const noexcept
             dim[Y] < std::max(network->num_pis(), network->num_pos()))
             return true;
     }
+    // 2DDWave optimization: information flows eastwards and southwards only, i.e., the height - 1 vertices of a longest
+    // path without its I/Os need a monotone path of distinct tiles which is at most X + Y - 1 tiles long
+    else if (config.twoddwave && !config.vertical_offset)
+    {
+        if (dim[X] + dim[Y] < hierarchy->height())
+            return true;
+    }
 
-    return false;
+    // rules learned from UNSAT cores of other dimensions
+    return rules && rules->prunes(dim);
 }
 
 void exact::smt_handler::update(const fcn_dimension_xy& dim) noexcept
 {
+    dimension_start = std::chrono::steady_clock::now();
+
     layout->resize(dim);
+    analyze_reachability();
     check_point = std::make_shared<solver_check_point>(fetch_solver(dim));
     ++lc;
     solver = check_point->state->solver;
+    assumption_families.clear();
+
+    if (sink)
+        record = {{"dimension", {dim[X], dim[Y]}}, {"solver reuse", solver_reuse}, {"phases", nlohmann::json::array()}};
 }
 
 void exact::smt_handler::set_timeout(const unsigned t)
@@ -84,27 +371,51 @@ bool exact::smt_handler::is_satisfiable()
 {
     generate_smt_instance();
 
-    switch (solver->check(check_point->assumptions))
+    z3::check_result result;
+    try
+    {
+        result = profile("check", [this]{ return solver->check(check_point->assumptions); });
+    }
+    catch (const z3::exception&)
+    {
+        finish_record("interrupted");
+        throw;
+    }
+
+    switch (result)
     {
         case z3::sat:
         {
             // TODO out-of-solver constraints and maybe going back into solver
 
             // optimize the generated result
-            if (auto opt = optimize(); opt != nullptr)
+            if (auto opt = profile("optimize", [this]{ return optimize(); }); opt != nullptr)
             {
-                opt->check();
-                assign_layout(opt->get_model());
+                profile("optimize check", [&opt]{ return opt->check(); });
+                profile("assign_layout", [this, &opt]{ assign_layout(opt->get_model()); });
             }
             else
             {
-                assign_layout(solver->get_model());
+                profile("assign_layout", [this]{ assign_layout(solver->get_model()); });
             }
 
+            finish_record("sat");
+
             return true;
         }
+        case z3::unsat:
+        {
+            if (rules)
+                profile("learn_from_core", [this]{ learn_from_core(); });
+
+            finish_record("unsat");
+
+            return false;
+        }
         default:
         {
+            finish_record(solver->reason_unknown());
+
             return false;
         }
     }
@@ -115,6 +426,227 @@ void exact::smt_handler::store_solver_state(const fcn_dimension_xy& dim) noexcep
     solver_tree[dim] = check_point->state;
 }
 
+void exact::smt_handler::finish_record(const std::string& outcome)
+{
+    if (!sink)
+        return;
+
+    nlohmann::json z3_statistics = nlohmann::json::object();
+    const auto stats = solver->statistics();
+    for (auto i = 0u; i < stats.size(); ++i)
+        z3_statistics[stats.key(i)] = stats.is_uint(i) ? nlohmann::json(stats.uint_value(i)) :
+                                                         nlohmann::json(stats.double_value(i));
+
+    record["outcome"]    = outcome;
+    record["thread"]     = tid;
+    record["start (µs)"] = sink->timestamp(dimension_start);
+    record["time (s)"]   = std::chrono::duration<double>(std::chrono::steady_clock::now() - dimension_start).count();
+    record["assertions"] = solver->assertions().size();
+    record["instance"]   = instance_statistics();
+    record["z3"]         = z3_statistics;
+
+    sink->add(std::move(record));
+    record = nlohmann::json{};
+}
+
+nlohmann::json exact::smt_handler::instance_statistics() const noexcept
+{
+    return nlohmann::json
+    {
+        {"tile-element pairs", num_pairs},
+        {"pairs without variables", num_pruned_pairs},
+        {"pairs excluded by assumptions", num_assumed_pairs}
+    };
+}
+
+void exact::smt_handler::compute_levels() noexcept
+{
+    const auto n = network->vertex_count(true);
+    level.assign(n, 0ul);
+    inv_level.assign(n, 0ul);
+
+    // topological order via Kahn's algorithm
+    std::vector<logic_vertex> order{};
+    std::vector<std::size_t> in_deg(n, 0ul);
+    for (auto&& v : network->vertices(config.io_ports))
+    {
+        if (in_deg[v] = network->in_degree(v, config.io_ports); in_deg[v] == 0ul)
+            order.push_back(v);
+    }
+
+    for (auto i = 0ul; i < order.size(); ++i)
+    {
+        for (auto&& av : network->adjacent_vertices(order[i], config.io_ports))
+        {
+            level[av] = std::max(level[av], level[order[i]] + 1);
+            if (--in_deg[av] == 0ul)
+                order.push_back(av);
+        }
+    }
+
+    for (auto it = order.crbegin(); it != order.crend(); ++it)
+    {
+        for (auto&& av : network->adjacent_vertices(*it, config.io_ports))
+            inv_level[*it] = std::max(inv_level[*it], inv_level[av] + 1);
+    }
+}
+
+void exact::smt_handler::classify_data_flow() noexcept
+{
+    if (!layout->is_regularly_clocked())
+        return;
+
+    // every relation between tiles of the scheme occurs in a layout that covers the cutout twice in each direction
+    layout->resize(fcn_dimension_xy{config.scheme->cutout_x * 2ul, config.scheme->cutout_y * 2ul});
+
+    auto quadrant = true, column = true;
+    for (auto&& t : layout->ground_layer())
+    {
+        for (auto&& at : layout->outgoing_clocked_tiles(t))
+        {
+            quadrant = quadrant && at[X] >= t[X] && at[Y] >= t[Y];
+            column   = column && at[X] > t[X];
+        }
+    }
+
+    flow = quadrant ? data_flow::QUADRANT : column ? data_flow::COLUMN : data_flow::ARBITRARY;
+}
+
+void exact::smt_handler::analyze_reachability() noexcept
+{
+    in_reach.clear();
+    out_reach.clear();
+
+    if (!config.domain_pruning || !layout->is_regularly_clocked())
+        return;
+
+    std::vector<layout_tile> tiles{};
+    std::unordered_map<layout_tile, std::vector<layout_tile>, boost::hash<layout_tile>> succ{}, pred{};
+    reach_map in_deg{};
+
+    for (auto&& t : layout->ground_layer())
+    {
+        tiles.push_back(t);
+        in_deg.emplace(t, 0ul);
+    }
+
+    for (const auto& t : tiles)
+    {
+        for (auto&& at : layout->outgoing_clocked_tiles(t))
+        {
+            succ[t].push_back(at);
+            pred[at].push_back(t);
+            ++in_deg[at];
+        }
+    }
+
+    // topological order via Kahn's algorithm
+    std::vector<layout_tile> order{};
+    for (const auto& t : tiles)
+    {
+        if (in_deg[t] == 0ul)
+            order.push_back(t);
+    }
+    for (auto i = 0ul; i < order.size(); ++i)
+    {
+        for (const auto& at : succ[order[i]])
+        {
+            if (--in_deg[at] == 0ul)
+                order.push_back(at);
+        }
+    }
+
+    if (order.size() == tiles.size())  // acyclic data flow; longest paths can be computed exactly
+    {
+        for (const auto& t : order)
+        {
+            auto& r = in_reach[t];
+            for (const auto& pt : pred[t])
+                r = std::max(r, in_reach[pt] + 1);
+        }
+        for (auto it = order.crbegin(); it != order.crend(); ++it)
+        {
+            auto& r = out_reach[*it];
+            for (const auto& st : succ[*it])
+                r = std::max(r, out_reach[st] + 1);
+        }
+    }
+    else  // cyclic data flow; a simple path into/out of t cannot be longer than the number of tiles reaching/reached
+    {
+        const auto count_reachable = [](const layout_tile& t, auto& adjacency)
+        {
+            std::set<layout_tile> visited{t};
+            std::vector<layout_tile> stack{t};
+            while (!stack.empty())
+            {
+                auto current = stack.back();
+                stack.pop_back();
+                for (const auto& at : adjacency[current])
+                {
+                    if (visited.insert(at).second)
+                        stack.push_back(at);
+                }
+            }
+
+            return visited.size() - 1;
+        };
+
+        for (const auto& t : tiles)
+        {
+            in_reach[t]  = count_reachable(t, pred);
+            out_reach[t] = count_reachable(t, succ);
+        }
+    }
+}
+
+bool exact::smt_handler::is_permanently_infeasible(const layout_tile& t, const std::size_t l) const noexcept
+{
+    if (!config.domain_pruning)
+        return false;
+
+    switch (flow)
+    {
+        case data_flow::QUADRANT:
+        {
+            // all tiles able to reach t are located north-west of it; therefore, growing layouts do not add any paths
+            if (auto it = in_reach.find(t); it != in_reach.end())
+                return it->second < l;
+
+            return false;
+        }
+        case data_flow::COLUMN:
+        {
+            // each step leads one column further east
+            return t[X] < l;
+        }
+        default:
+        {
+            return false;
+        }
+    }
+}
+
+template <typename Cutout>
+std::vector<exact::layout_tile> exact::smt_handler::clocked_tiles(const layout_tile& t, const Cutout& cutout,
+                                                                  const bool outgoing) const noexcept
+{
+    std::vector<layout_tile> tiles{};
+    tiles.reserve(4ul);
+
+    if (outgoing)
+    {
+        for (auto&& at : layout->outgoing_clocked_tiles(t, cutout))
+            tiles.push_back(at);
+    }
+    else
+    {
+        for (auto&& iat : layout->incoming_clocked_tiles(t, cutout))
+            tiles.push_back(iat);
+    }
+
+    return tiles;
+}
+
 z3::expr exact::smt_handler::get_lit_e() noexcept
 {
     return ctx->bool_const(fmt::format("lit_e_{}", lc).c_str());
@@ -133,6 +665,10 @@ exact::smt_handler::solver_check_point exact::smt_handler::fetch_solver(const fc
         assumptions.push_back(state.lit.s);
         assumptions.push_back(state.lit.e);
 
+        // constraint families of previous dimensions stay guarded by their tracking literals
+        for (const auto& [track, family] : state.trackers)
+            assumptions.push_back(track);
+
         return assumptions;
     };
 
@@ -149,7 +685,7 @@ exact::smt_handler::solver_check_point exact::smt_handler::fetch_solver(const fc
 
         // deep-copy solver state
         const auto state = it_x->second;
-        solver_state new_state = {state->solver, {get_lit_e(), state->lit.s}};
+        solver_state new_state = {state->solver, {get_lit_e(), state->lit.s}, state->trackers};
 
         // reset eastern constraints
         new_state.solver->add(not state->lit.e);
@@ -157,6 +693,8 @@ exact::smt_handler::solver_check_point exact::smt_handler::fetch_solver(const fc
         // remove solver
         solver_tree.erase(it_x);
 
+        solver_reuse = fmt::format("{} × {}", dim[X] - 1, dim[Y]);
+
         return {std::make_shared<solver_state>(new_state), added_tiles, updated_tiles, create_assumptions(new_state)};
     }
     else
@@ -174,7 +712,7 @@ exact::smt_handler::solver_check_point exact::smt_handler::fetch_solver(const fc
 
             // deep-copy solver state
             const auto state = it_y->second;
-            solver_state new_state = {state->solver, {state->lit.e, get_lit_s()}};
+            solver_state new_state = {state->solver, {state->lit.e, get_lit_s()}, state->trackers};
 
             // reset southern constraints
             new_state.solver->add(not state->lit.s);
@@ -182,6 +720,8 @@ exact::smt_handler::solver_check_point exact::smt_handler::fetch_solver(const fc
             // remove solver
             solver_tree.erase(it_y);
 
+            solver_reuse = fmt::format("{} × {}", dim[X], dim[Y] - 1);
+
             return {std::make_shared<solver_state>(new_state), added_tiles, updated_tiles,
                     create_assumptions(new_state)};
         }
@@ -196,13 +736,76 @@ exact::smt_handler::solver_check_point exact::smt_handler::fetch_solver(const fc
             }
 
             // create new state
-            solver_state new_state{std::make_shared<z3::solver>(*ctx), {get_lit_e(), get_lit_s()}};
+            solver_state new_state{create_solver(), {get_lit_e(), get_lit_s()}};
+
+            solver_reuse = "none";
 
             return {std::make_shared<solver_state>(new_state), added_tiles, {}, create_assumptions(new_state)};
         }
     }
 }
 
+exact::solver_ptr exact::smt_handler::create_solver() const noexcept
+{
+    solver_ptr s;
+
+    // Z3's cube-and-conquer mode is a global parameter (parallel.enable) that would affect all concurrent exact runs;
+    // its tactics are used per solver instead
+    const auto sat_tactic = config.parallel_solving ? "psat" : "sat";
+    const auto smt_tactic = config.parallel_solving ? "psmt" : "smt";
+
+    switch (config.strategy)
+    {
+        case exact_solver_strategy::TACTIC:
+        {
+            auto pipeline = z3::tactic{*ctx, "simplify"} & z3::tactic{*ctx, "propagate-values"} &
+                            z3::tactic{*ctx, "solve-eqs"};
+
+            // integer-free instances can be bit-blasted entirely and handed to the SAT solver
+            if (is_integer_free(config))
+                pipeline = pipeline & z3::tactic{*ctx, "card2bv"} & z3::tactic{*ctx, "bit-blast"} &
+                           z3::tactic{*ctx, sat_tactic};
+            else
+                pipeline = pipeline & z3::tactic{*ctx, smt_tactic};
+
+            s = std::make_shared<z3::solver>(pipeline.mk_solver());
+            break;
+        }
+        case exact_solver_strategy::SAT:
+        {
+            if (config.parallel_solving)
+            {
+                s = std::make_shared<z3::solver>((z3::tactic{*ctx, "card2bv"} & z3::tactic{*ctx, "bit-blast"} &
+                                                  z3::tactic{*ctx, sat_tactic}).mk_solver());
+            }
+            else
+            {
+                // QF_FD is Z3's incremental finite domain solver, i.e. a SAT solver with native cardinality
+                // constraints
+                s = std::make_shared<z3::solver>(*ctx, "QF_FD");
+            }
+            break;
+        }
+        default:
+        {
+            if (config.parallel_solving)
+                s = std::make_shared<z3::solver>(z3::tactic{*ctx, smt_tactic}.mk_solver());
+            else
+                s = std::make_shared<z3::solver>(*ctx);
+            break;
+        }
+    }
+
+    if (config.solver_threads > 1u)
+    {
+        z3::params p{*ctx};
+        p.set("threads", config.solver_threads);
+        s->set(p);
+    }
+
+    return s;
+}
+
 bool exact::smt_handler::is_added_tile(const layout_tile& t) const noexcept
 {
     return check_point->added_tiles.count(t);
@@ -220,11 +823,17 @@ exact::smt_handler::assumption_literals& exact::smt_handler::lit() const noexcep
 
 z3::expr exact::smt_handler::get_tv(const layout_tile& t, const logic_vertex v) noexcept
 {
+    if (is_permanently_infeasible(t, level[v]))
+        return ctx->bool_val(false);
+
     return ctx->bool_const(fmt::format("tv_({},{})_{}", t[X], t[Y], v).c_str());
 }
 
 z3::expr exact::smt_handler::get_te(const layout_tile& t, const logic_edge& e) noexcept
 {
+    if (is_permanently_infeasible(t, level[network->source(e)] + 1))
+        return ctx->bool_val(false);
+
     return ctx->bool_const(fmt::format("te_({},{})_({},{})",
             t[X], t[Y],network->source(e), network->target(e)).c_str());
 }
@@ -369,142 +978,170 @@ void exact::smt_handler::restrict_clocks() noexcept
 
 void exact::smt_handler::define_adjacent_vertex_tiles() noexcept
 {
-    for (auto&& t : iter::chain(check_point->added_tiles, check_point->updated_tiles))
+    fcn_clock::dispatch(layout->get_clocking(), [this](const auto& cutout)
     {
-        for (auto&& v : network->vertices(config.io_ports))
+        for (auto&& t : iter::chain(check_point->added_tiles, check_point->updated_tiles))
         {
-            auto tv = get_tv(t, v);
-            z3::expr_vector conj{*ctx};
-            for (auto&& ae : network->out_edges(v, config.io_ports))
-            {
-                z3::expr_vector disj{*ctx};
+            // clocked neighbors do not depend on vertices and edges and are therefore determined only once
+            const auto ats = layout->is_regularly_clocked() ? clocked_tiles(t, cutout, true) :
+                                                              std::vector<layout_tile>{};
 
-                if (auto tgt = network->target(ae); layout->is_regularly_clocked())
-                {
-                    for (auto&& at : layout->outgoing_clocked_tiles(t))
-                        disj.push_back((get_tv(at, tgt) or get_te(at, ae)) and get_tc(t, at));
-                }
-                else  // irregular clocking
+            for (auto&& v : network->vertices(config.io_ports))
+            {
+                auto tv = get_tv(t, v);
+                z3::expr_vector conj{*ctx};
+                for (auto&& ae : network->out_edges(v, config.io_ports))
                 {
-                    for (auto&& at : layout->surrounding_2d(t))
+                    z3::expr_vector disj{*ctx};
+
+                    if (auto tgt = network->target(ae); layout->is_regularly_clocked())
                     {
-                        // clocks must differ by 1
-                        auto mod = z3::mod(get_tcl(at) - get_tcl(t), layout->num_clocks()) == ctx->int_val(1);
-                        disj.push_back(((get_tv(at, tgt) or get_te(at, ae)) and mod) and get_tc(t, at));
+                        for (auto&& at : ats)
+                            disj.push_back((get_tv(at, tgt) or get_te(at, ae)) and get_tc(t, at));
+                    }
+                    else  // irregular clocking
+                    {
+                        for (auto&& at : layout->surrounding_2d(t))
+                        {
+                            // clocks must differ by 1
+                            auto mod = z3::mod(get_tcl(at) - get_tcl(t), layout->num_clocks()) == ctx->int_val(1);
+                            disj.push_back(((get_tv(at, tgt) or get_te(at, ae)) and mod) and get_tc(t, at));
+                        }
                     }
-                }
 
-                if (!disj.empty())
-                    conj.push_back(z3::mk_or(disj));
-            }
-            if (!conj.empty())
-            {
-                solver->add(mk_as_if_se(z3::implies(tv, z3::mk_and(conj)), t));
+                    if (!disj.empty())
+                        conj.push_back(z3::mk_or(disj));
+                }
+                if (!conj.empty())
+                {
+                    solver->add(mk_as_if_se(z3::implies(tv, z3::mk_and(conj)), t));
+                }
             }
         }
-    }
+    });
 }
 
 void exact::smt_handler::define_inv_adjacent_vertex_tiles() noexcept
 {
-    for (auto&& t : iter::chain(check_point->added_tiles, check_point->updated_tiles))
+    fcn_clock::dispatch(layout->get_clocking(), [this](const auto& cutout)
     {
-        for (auto&& v : network->vertices(config.io_ports))
+        for (auto&& t : iter::chain(check_point->added_tiles, check_point->updated_tiles))
         {
-            auto tv = get_tv(t, v);
-            z3::expr_vector conj{*ctx};
-            for (auto&& iae : network->in_edges(v, config.io_ports))
-            {
-                z3::expr_vector disj{*ctx};
+            // clocked neighbors do not depend on vertices and edges and are therefore determined only once
+            const auto iats = layout->is_regularly_clocked() ? clocked_tiles(t, cutout, false) :
+                                                               std::vector<layout_tile>{};
 
-                if (auto src = network->source(iae); layout->is_regularly_clocked())
-                {
-                    for (auto&& iat : layout->incoming_clocked_tiles(t))
-                        disj.push_back((get_tv(iat, src) or get_te(iat, iae)) and get_tc(iat, t));
-                }
-                else  // irregular clocking
+            for (auto&& v : network->vertices(config.io_ports))
+            {
+                auto tv = get_tv(t, v);
+                z3::expr_vector conj{*ctx};
+                for (auto&& iae : network->in_edges(v, config.io_ports))
                 {
-                    for (auto&& iat : layout->surrounding_2d(t))
+                    z3::expr_vector disj{*ctx};
+
+                    if (auto src = network->source(iae); layout->is_regularly_clocked())
                     {
-                        // clocks must differ by 1
-                        auto mod = z3::mod(get_tcl(t) - get_tcl(iat), layout->num_clocks()) == ctx->int_val(1);
-                        disj.push_back(((get_tv(iat, src) or get_te(iat, iae)) and mod) and get_tc(iat, t));
+                        for (auto&& iat : iats)
+                            disj.push_back((get_tv(iat, src) or get_te(iat, iae)) and get_tc(iat, t));
+                    }
+                    else  // irregular clocking
+                    {
+                        for (auto&& iat : layout->surrounding_2d(t))
+                        {
+                            // clocks must differ by 1
+                            auto mod = z3::mod(get_tcl(t) - get_tcl(iat), layout->num_clocks()) == ctx->int_val(1);
+                            disj.push_back(((get_tv(iat, src) or get_te(iat, iae)) and mod) and get_tc(iat, t));
+                        }
                     }
-                }
 
-                if (!disj.empty())
-                    conj.push_back(z3::mk_or(disj));
-            }
-            if (!conj.empty())
-            {
-                solver->add(mk_as_if_se(z3::implies(tv, z3::mk_and(conj)), t));
+                    if (!disj.empty())
+                        conj.push_back(z3::mk_or(disj));
+                }
+                if (!conj.empty())
+                {
+                    solver->add(mk_as_if_se(z3::implies(tv, z3::mk_and(conj)), t));
+                }
             }
         }
-    }
+    });
 }
 
 void exact::smt_handler::define_adjacent_edge_tiles() noexcept
 {
-    for (auto&& t : iter::chain(check_point->added_tiles, check_point->updated_tiles))
+    fcn_clock::dispatch(layout->get_clocking(), [this](const auto& cutout)
     {
-        for (auto&& e : network->edges(config.io_ports))
+        for (auto&& t : iter::chain(check_point->added_tiles, check_point->updated_tiles))
         {
-            auto te = network->target(e);
-            z3::expr_vector disj{*ctx};
+            // clocked neighbors do not depend on edges and are therefore determined only once
+            const auto ats = layout->is_regularly_clocked() ? clocked_tiles(t, cutout, true) :
+                                                              std::vector<layout_tile>{};
 
-            if (layout->is_regularly_clocked())
-            {
-                for (auto&& at : layout->outgoing_clocked_tiles(t))
-                    disj.push_back((get_tv(at, te) or get_te(at, e)) and get_tc(t, at));
-            }
-            else  // irregular clocking
+            for (auto&& e : network->edges(config.io_ports))
             {
-                for (auto&& at : layout->surrounding_2d(t))
+                auto te = network->target(e);
+                z3::expr_vector disj{*ctx};
+
+                if (layout->is_regularly_clocked())
                 {
-                    // clocks must differ by 1
-                    auto mod = z3::mod(get_tcl(at) - get_tcl(t), layout->num_clocks()) == ctx->int_val(1);
-                    disj.push_back(((get_tv(at, te) or get_te(at, e)) and mod) and get_tc(t, at));
+                    for (auto&& at : ats)
+                        disj.push_back((get_tv(at, te) or get_te(at, e)) and get_tc(t, at));
+                }
+                else  // irregular clocking
+                {
+                    for (auto&& at : layout->surrounding_2d(t))
+                    {
+                        // clocks must differ by 1
+                        auto mod = z3::mod(get_tcl(at) - get_tcl(t), layout->num_clocks()) == ctx->int_val(1);
+                        disj.push_back(((get_tv(at, te) or get_te(at, e)) and mod) and get_tc(t, at));
+                    }
                 }
-            }
 
-            if (!disj.empty())
-            {
-                solver->add(mk_as_if_se(z3::implies(get_te(t, e), z3::mk_or(disj)), t));
+                if (!disj.empty())
+                {
+                    solver->add(mk_as_if_se(z3::implies(get_te(t, e), z3::mk_or(disj)), t));
+                }
             }
         }
-    }
+    });
 }
 
 void exact::smt_handler::define_inv_adjacent_edge_tiles() noexcept
 {
-    for (auto&& t : iter::chain(check_point->added_tiles, check_point->updated_tiles))
+    fcn_clock::dispatch(layout->get_clocking(), [this](const auto& cutout)
     {
-        for (auto&& e : network->edges(config.io_ports))
+        for (auto&& t : iter::chain(check_point->added_tiles, check_point->updated_tiles))
         {
-            auto se = network->source(e);
-            z3::expr_vector disj{*ctx};
+            // clocked neighbors do not depend on edges and are therefore determined only once
+            const auto iats = layout->is_regularly_clocked() ? clocked_tiles(t, cutout, false) :
+                                                               std::vector<layout_tile>{};
 
-            if (layout->is_regularly_clocked())
-            {
-                for (auto&& iat : layout->incoming_clocked_tiles(t))
-                    disj.push_back((get_tv(iat, se) or get_te(iat, e)) and get_tc(iat, t));
-            }
-            else  // irregular clocking
+            for (auto&& e : network->edges(config.io_ports))
             {
-                for (auto&& iat : layout->surrounding_2d(t))
+                auto se = network->source(e);
+                z3::expr_vector disj{*ctx};
+
+                if (layout->is_regularly_clocked())
                 {
-                    // clocks must differ by 1
-                    auto mod = z3::mod(get_tcl(t) - get_tcl(iat), layout->num_clocks()) == ctx->int_val(1);
-                    disj.push_back(((get_tv(iat, se) or get_te(iat, e)) and mod) and get_tc(iat, t));
+                    for (auto&& iat : iats)
+                        disj.push_back((get_tv(iat, se) or get_te(iat, e)) and get_tc(iat, t));
+                }
+                else  // irregular clocking
+                {
+                    for (auto&& iat : layout->surrounding_2d(t))
+                    {
+                        // clocks must differ by 1
+                        auto mod = z3::mod(get_tcl(t) - get_tcl(iat), layout->num_clocks()) == ctx->int_val(1);
+                        disj.push_back(((get_tv(iat, se) or get_te(iat, e)) and mod) and get_tc(iat, t));
+                    }
                 }
-            }
 
-            if (!disj.empty())
-            {
-                solver->add(mk_as_if_se(z3::implies(get_te(t, e), z3::mk_or(disj)), t));
+                if (!disj.empty())
+                {
+                    solver->add(mk_as_if_se(z3::implies(get_te(t, e), z3::mk_or(disj)), t));
+                }
             }
         }
-    }
+    });
 }
 
 void exact::smt_handler::establish_sub_paths() noexcept
@@ -979,6 +1616,55 @@ void exact::smt_handler::utilize_hierarchical_information() noexcept
     }
 }
 
+void exact::smt_handler::restrict_domains() noexcept
+{
+    num_pairs = 0ul, num_pruned_pairs = 0ul, num_assumed_pairs = 0ul;
+
+    // without pruning, neither pairs without variables nor assumptions exist; only count the pairs
+    if (!config.domain_pruning)
+    {
+        num_pairs = layout->x() * layout->y() *
+                    (network->vertex_count(config.io_ports) + network->edge_count(config.io_ports));
+        return;
+    }
+
+    // bounds of the current dimension might be relaxed in larger ones; hence, use assumptions here
+    const auto exclude = [this](const layout_tile& t, const std::size_t l, const std::size_t il, const z3::expr& var)
+    {
+        if (auto it = in_reach.find(t), ot = out_reach.find(t); it != in_reach.end() && ot != out_reach.end())
+        {
+            if (it->second < l || ot->second < il)
+            {
+                check_point->assumptions.push_back(not var);
+                ++num_assumed_pairs;
+            }
+        }
+    };
+
+    for (auto&& t : layout->ground_layer())
+    {
+        for (auto&& v : network->vertices(config.io_ports))
+        {
+            ++num_pairs;
+
+            if (is_permanently_infeasible(t, level[v]))
+                ++num_pruned_pairs;
+            else
+                exclude(t, level[v], inv_level[v], get_tv(t, v));
+        }
+        for (auto&& e : network->edges(config.io_ports))
+        {
+            ++num_pairs;
+
+            const auto src = network->source(e), tgt = network->target(e);
+            if (is_permanently_infeasible(t, level[src] + 1))
+                ++num_pruned_pairs;
+            else
+                exclude(t, level[src] + 1, inv_level[tgt] + 1, get_te(t, e));
+        }
+    }
+}
+
 void exact::smt_handler::enforce_border_io() noexcept
 {
     auto assign_border = [this](const logic_vertex _v)
@@ -1334,56 +2020,160 @@ void exact::smt_handler::minimize_clock_latches(optimize_ptr optimize) noexcept
     optimize->minimize(z3::sum(latch_counter));
 }
 
+void exact::smt_handler::generate(const char* family, void (smt_handler::*constraints)() noexcept) noexcept
+{
+    // each constraint family is a phase of its own in the profile
+    if (!rules)
+    {
+        profile(family, [this, constraints]{ (this->*constraints)(); });
+        return;
+    }
+
+    const auto num_assumptions = check_point->assumptions.size();
+
+    // collect the family's constraints in a scratch solver
+    auto actual_solver = solver;
+    solver = std::make_shared<z3::solver>(*ctx);
+    profile(family, [this, constraints]{ (this->*constraints)(); });
+    const auto assertions = solver->assertions();
+    solver = actual_solver;
+
+    // remember which family created which assumptions
+    for (auto i = num_assumptions; i < check_point->assumptions.size(); ++i)
+        assumption_families.emplace_back(check_point->assumptions[static_cast<int>(i)], family);
+
+    if (assertions.empty())
+        return;
+
+    // guard the family by a fresh tracking literal
+    auto track = ctx->bool_const(fmt::format("track_{}_{}", family, lc).c_str());
+    for (const auto& e : assertions)
+        solver->add(z3::implies(track, e));
+
+    check_point->assumptions.push_back(track);
+    check_point->state->trackers.emplace_back(track, family);
+}
+
+bool exact::smt_handler::is_embedding_closed(const std::string& family) noexcept
+{
+    // border I/Os are not located at the border anymore after embedding, hierarchical information is derived from
+    // them, and topology-specific constraints involve the layout's bounds
+    return family != "enforce_border_io" && family != "utilize_hierarchical_information" &&
+           family != "topology_specific_constraints";
+}
+
+void exact::smt_handler::learn_from_core() noexcept
+{
+    z3::expr_vector core{*ctx};
+    try
+    {
+        core = solver->unsat_core();
+    }
+    catch (const z3::exception&)
+    {
+        return;
+    }
+
+    const fcn_dimension_xy dim{layout->x(), layout->y()};
+    std::set<std::string> families{};
+    std::vector<std::string> literals{};
+
+    for (const auto& c : core)
+    {
+        const auto is_c = [&c](const auto& p){ return z3::eq(p.first, c); };
+
+        if (auto t = std::find_if(check_point->state->trackers.cbegin(), check_point->state->trackers.cend(), is_c);
+                t != check_point->state->trackers.cend())
+            families.insert(t->second);
+        else if (auto a = std::find_if(assumption_families.cbegin(), assumption_families.cend(), is_c);
+                a != assumption_families.cend())
+            families.insert(a->second);
+        else  // eastern or southern border literal
+            literals.push_back(c.to_string());
+    }
+
+    std::vector<fcn_dimension_xy> bounds{}, unsat{};
+
+    // an empty core gives no information about which constraints are responsible
+    if (!core.empty() && std::all_of(families.cbegin(), families.cend(), is_embedding_closed))
+        bounds.push_back(dim);
+
+    // 2DDWave is symmetric under transposition, i.e., mirroring a layout at its main diagonal swaps its dimension
+    if (config.twoddwave && !config.vertical_offset && dim[X] != dim[Y])
+    {
+        const fcn_dimension_xy transposed{dim[Y], dim[X]};
+
+        if (bounds.empty())
+            unsat.push_back(transposed);
+        else
+            bounds.push_back(transposed);
+    }
+
+    if (bounds.empty() && unsat.empty())
+        return;
+
+    rules->learn(bounds, unsat,
+    {
+        {"dimension", {dim[X], dim[Y]}},
+        {"core size", core.size()},
+        {"families", families},
+        {"border literals", literals},
+        {"bounds", bounds},
+        {"unsat", unsat}
+    });
+}
+
 void exact::smt_handler::generate_smt_instance() noexcept
 {
     // placement constraints
-    restrict_tile_elements();
-    restrict_vertices();
+    generate("restrict_tile_elements", &smt_handler::restrict_tile_elements);
+    generate("restrict_vertices", &smt_handler::restrict_vertices);
 
     // local synchronization constraints
-    define_adjacent_vertex_tiles();
-    define_inv_adjacent_vertex_tiles();
-    define_adjacent_edge_tiles();
-    define_inv_adjacent_edge_tiles();
+    generate("define_adjacent_vertex_tiles", &smt_handler::define_adjacent_vertex_tiles);
+    generate("define_inv_adjacent_vertex_tiles", &smt_handler::define_inv_adjacent_vertex_tiles);
+    generate("define_adjacent_edge_tiles", &smt_handler::define_adjacent_edge_tiles);
+    generate("define_inv_adjacent_edge_tiles", &smt_handler::define_inv_adjacent_edge_tiles);
 
     // global synchronization constraints
     if (!config.desynchronize && !config.topolinano)
     {
-        assign_pi_clockings();
-        global_synchronization();
+        generate("assign_pi_clockings", &smt_handler::assign_pi_clockings);
+        generate("global_synchronization", &smt_handler::global_synchronization);
     }
 
     // open clocking scheme constraints
     if (!layout->is_regularly_clocked())
-        restrict_clocks();
+        generate("restrict_clocks", &smt_handler::restrict_clocks);
 
     // path/cycle constraints
     if (!config.topolinano && !config.twoddwave)  // linear schemes; no cycles by definition
     {
-        establish_sub_paths();
-        establish_transitive_paths();
-        eliminate_cycles();
+        generate("establish_sub_paths", &smt_handler::establish_sub_paths);
+        generate("establish_transitive_paths", &smt_handler::establish_transitive_paths);
+        generate("eliminate_cycles", &smt_handler::eliminate_cycles);
     }
 
     // I/O pin constraints
     if (config.border_io)
-        enforce_border_io();
+        generate("enforce_border_io", &smt_handler::enforce_border_io);
 
     // straight inverter constraints
     if (config.straight_inverters)
-        enforce_straight_inverters();
+        generate("enforce_straight_inverters", &smt_handler::enforce_straight_inverters);
 
     // clock latch constraints
     if (config.clock_latches && !config.desynchronize)
-        restrict_clock_latches();
+        generate("restrict_clock_latches", &smt_handler::restrict_clock_latches);
 
     // topology-specific constraints
-    topology_specific_constraints();
+    generate("topology_specific_constraints", &smt_handler::topology_specific_constraints);
 
     // symmetry breaking constraints
-    prevent_insufficiencies();
-    define_number_of_connections();
-    utilize_hierarchical_information();
+    generate("prevent_insufficiencies", &smt_handler::prevent_insufficiencies);
+    generate("define_number_of_connections", &smt_handler::define_number_of_connections);
+    generate("utilize_hierarchical_information", &smt_handler::utilize_hierarchical_information);
+    generate("restrict_domains", &smt_handler::restrict_domains);
 }
 
 exact::optimize_ptr exact::smt_handler::optimize() noexcept
@@ -1567,11 +2357,11 @@ fcn_gate_layout_ptr exact::explore_asynchronously(const unsigned t_num, std::sha
     // timeout measurement
     mockturtle::stopwatch<>::duration time{0};
 
-    auto ctx = std::make_shared<z3::context>();
+    auto ctx = create_context();
     auto layout_sketch = std::make_shared<fcn_gate_layout>(*config.scheme, network, config.vertical_offset ?
                                                                                     fcn_layout::offset::VERTICAL :
                                                                                     fcn_layout::offset::NONE);
-    smt_handler handler{ctx,layout_sketch, config};
+    smt_handler handler{ctx, layout_sketch, config, profiler, t_num, rules};
     (*ti_list)[t_num].ctx = ctx;
 
     while (true)
@@ -1583,12 +2373,14 @@ fcn_gate_layout_ptr exact::explore_asynchronously(const unsigned t_num, std::sha
             std::lock_guard<std::mutex> guard(dit_mutex);
 
             ++dit;
+
+            // all dimensions within the upper bound have been handed out or the process has been interrupted
+            if (!(dit <= config.upper_bound) || interrupted)
+                return nullptr;
+
             dimension = *dit;  // operations ++ and * are split to prevent a vector copy construction
         }
 
-        if (area(dimension) > config.upper_bound)
-            return nullptr;
-
         if (handler.skippable(dimension))
             continue;
 
@@ -1631,6 +2423,8 @@ fcn_gate_layout_ptr exact::explore_asynchronously(const unsigned t_num, std::sha
                         else
                             return nullptr;
                     }
+
+                    instance_info = handler.instance_statistics();
                 }
 
                 // interrupt other threads that are working on higher dimensions
@@ -1736,9 +2530,9 @@ exact::pd_result exact::run_synchronously() noexcept
     auto layout_sketch = std::make_shared<fcn_gate_layout>(*config.scheme, network, config.vertical_offset ?
                                                                                     fcn_layout::offset::VERTICAL :
                                                                                     fcn_layout::offset::NONE);
-    smt_handler handler{std::make_shared<z3::context>(), layout_sketch, config};
+    smt_handler handler{create_context(), layout_sketch, config, profiler, 0u, rules};
 
-    for (; dit <= config.upper_bound; ++dit)  // <= to prevent overflow
+    for (; dit <= config.upper_bound && !interrupted; ++dit)  // <= to prevent overflow
     {
 
 #if (PROGRESS_BARS)
@@ -1763,6 +2557,8 @@ exact::pd_result exact::run_synchronously() noexcept
                 return handler.is_satisfiable();
             });
 
+            instance_info = handler.instance_statistics();
+
             if (sat)
             {
                 layout = layout_sketch;
@@ -7,12 +7,16 @@
 
 #include "physical_design.h"
 #include "exact_pd_config.h"
-#include "iter/dimension_iterator.h"
+#include "iter/dimension_explorer.h"
 #include "fmt/format.h"
+#include <atomic>
 #include <chrono>
+#include <fstream>
 #include <mutex>
 #include <future>
 #include <thread>
+#include <set>
+#include <unordered_map>
 #include <z3++.h>
 
 /**
@@ -58,6 +62,10 @@ public:
      * @return Result type containing statistical information about the process.
      */
     pd_result operator()() override;
+    /**
+     * Interrupts all Z3 contexts that are currently in use and prevents further dimensions from being examined.
+     */
+    void interrupt() noexcept override;
 
 private:
     /**
@@ -82,15 +90,153 @@ private:
     /**
      * Iterates over the possible dimensions for the fcn_gate_layout to find.
      */
-    dimension_iterator dit{0};
+    dimension_explorer dit{0};
     /**
      * Dimension of found result. Only interesting for asynchronous case.
      */
     std::optional<fcn_dimension_xy> result_dimension;
     /**
-     * Restricts access to the dimension_iterator and the result_dimension.
+     * Restricts access to the dimension_explorer and the result_dimension.
      */
     std::mutex dit_mutex{}, rd_mutex{};
+    /**
+     * Instance size information of the handler that found the result. Access is restricted by rd_mutex.
+     */
+    nlohmann::json instance_info{};
+    /**
+     * Flag to indicate that interrupt has been called.
+     */
+    std::atomic<bool> interrupted{false};
+    /**
+     * All Z3 contexts in use such that they can be interrupted from other threads. Access is restricted by ctx_mutex.
+     */
+    std::vector<ctx_ptr> contexts{};
+    /**
+     * Restricts access to contexts.
+     */
+    std::mutex ctx_mutex{};
+    /**
+     * Creates a new Z3 context and registers it for interruption. If interrupt has been called already, the context is
+     * interrupted right away.
+     *
+     * @return New Z3 context.
+     */
+    ctx_ptr create_context() noexcept;
+    /**
+     * Collects per-dimension profiling records of all smt_handlers. Each record is a JSON object containing the
+     * examined dimension, the solver state it reused, timings and added assertions per instance generation phase, the
+     * solver outcome, and Z3's statistics. Timestamps are given in µs since the sink's creation.
+     */
+    struct profile_sink
+    {
+        /**
+         * Point in time all timestamps refer to.
+         */
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        /**
+         * Records of all examined dimensions in order of completion.
+         */
+        nlohmann::json records = nlohmann::json::array();
+        /**
+         * Restricts access to records.
+         */
+        std::mutex mutex{};
+        /**
+         * Adds the given record. Thread-safe.
+         *
+         * @param record Record to add.
+         */
+        void add(nlohmann::json&& record) noexcept;
+        /**
+         * Returns the time passed between start and t in µs.
+         *
+         * @param t Point in time.
+         * @return Timestamp of t.
+         */
+        int64_t timestamp(const std::chrono::steady_clock::time_point& t) const noexcept;
+    };
+    /**
+     * Profiling sink shared by all handlers. nullptr if profiling is disabled.
+     */
+    std::shared_ptr<profile_sink> profiler = nullptr;
+    /**
+     * Aggregates the collected profile, i.e. total time and assertions per phase, solver outcomes, and the number of
+     * dimensions that reused a solver state. Contains all records as well.
+     *
+     * @return JSON object summarizing the profile.
+     */
+    nlohmann::json summarize_profile() const noexcept;
+    /**
+     * Writes the collected profile in Chrome's trace event format to config.trace_file. Each dimension and each phase
+     * within it become complete events on the timeline of the thread that examined them.
+     */
+    void write_trace() const noexcept;
+    /**
+     * Dimension-level rules learned from UNSAT cores. They are shared by all handlers since they hold for the network
+     * and configuration at hand regardless of which thread discovered them.
+     */
+    struct rule_store
+    {
+        /**
+         * Every dimension that is not larger than one of these in both X and Y is UNSAT.
+         */
+        std::vector<fcn_dimension_xy> bounds{};
+        /**
+         * Single dimensions known to be UNSAT.
+         */
+        std::set<fcn_dimension_xy> unsat{};
+        /**
+         * Learned rules together with the cores they have been derived from.
+         */
+        nlohmann::json log = nlohmann::json::array();
+        /**
+         * Number of dimensions skipped due to learned rules.
+         */
+        std::size_t num_pruned = 0ul;
+        /**
+         * Restricts access to all of the above.
+         */
+        std::mutex mutex{};
+        /**
+         * Checks whether the given dimension is UNSAT according to the learned rules and counts it if so. Thread-safe.
+         *
+         * @param dim Dimension to check.
+         * @return true iff dim can be skipped.
+         */
+        bool prunes(const fcn_dimension_xy& dim) noexcept;
+        /**
+         * Adds the given bounds and UNSAT dimensions. Existing bounds that are dominated by new ones are removed.
+         * Thread-safe.
+         *
+         * @param new_bounds Dimensions which, together with all dimensions that are not larger in X and Y, are UNSAT.
+         * @param new_unsat Single dimensions that are UNSAT.
+         * @param entry Log entry describing the core the rules have been derived from.
+         */
+        void learn(const std::vector<fcn_dimension_xy>& new_bounds, const std::vector<fcn_dimension_xy>& new_unsat,
+                   nlohmann::json&& entry) noexcept;
+    };
+    /**
+     * Rules shared by all handlers. nullptr if core-based learning is disabled.
+     */
+    std::shared_ptr<rule_store> rules = nullptr;
+    /**
+     * Checks whether the instances generated under the given configuration can do without integer variables, i.e.
+     * the clocking is regular, no clock latches are involved, and global synchronization is either disabled or
+     * reduces to restricting entry tiles as for 2DDWave with border I/Os. Such instances are purely Boolean (with
+     * cardinality constraints) and can be handed to a SAT solver.
+     *
+     * @param c Configuration to check.
+     * @return True iff instances generated under c do not contain integer variables.
+     */
+    static bool is_integer_free(const exact_pd_config& c) noexcept;
+    /**
+     * Resolves exact_solver_strategy::AUTO to a concrete strategy and falls back to exact_solver_strategy::SMT if
+     * exact_solver_strategy::SAT was requested for instances that need integer variables.
+     *
+     * @param c Configuration whose strategy is to be resolved.
+     * @return c with a resolved solver strategy.
+     */
+    static exact_pd_config resolve_solver_strategy(exact_pd_config c) noexcept;
 
     /**
      * Sub-class to exact to handle construction of SMT instances as well as house-keeping like storing solver
@@ -106,8 +252,13 @@ private:
          * @param ctx The context that is used in all solvers.
          * @param fgl The gate layout pointer that is going to contain the created layout.
          * @param c The configurations to respect in the SMT instance generation process.
+         * @param sink Profiling sink to add records to. No profiling takes place if nullptr.
+         * @param tid Identifier of the thread using this handler for profiling records.
+         * @param rules Store for rules learned from UNSAT cores. No cores are extracted if nullptr.
          */
-        smt_handler(ctx_ptr ctx, fcn_gate_layout_ptr fgl, const exact_pd_config& c) noexcept;
+        smt_handler(ctx_ptr ctx, fcn_gate_layout_ptr fgl, const exact_pd_config& c,
+                    std::shared_ptr<profile_sink> sink = nullptr, const unsigned tid = 0u,
+                    std::shared_ptr<rule_store> rules = nullptr) noexcept;
         /**
          * Evaluates a given dimension regarding the stored configurations whether it can be skipped, i.e. does not
          * need to be explored by the SMT solver. The better this function is, the more UNSAT instances can be skipped
@@ -147,6 +298,13 @@ private:
          * @param dim Key to storing the current solver state.
          */
         void store_solver_state(const fcn_dimension_xy& dim) noexcept;
+        /**
+         * Returns information about the size of the most recently generated instance, i.e. the number of tile-element
+         * pairs and how many of them have been excluded by reachability-based domain pruning.
+         *
+         * @return JSON object containing instance size information.
+         */
+        nlohmann::json instance_statistics() const noexcept;
 
     private:
         /**
@@ -179,6 +337,11 @@ private:
              * Watched literals for eastern and southern constraints which are used to reformulate them.
              */
             assumption_literals lit;
+            /**
+             * Tracking literals guarding all constraint families added to solver together with the families' names.
+             * They have to be assumed in each check. Only used if UNSAT cores are extracted.
+             */
+            std::vector<std::pair<z3::expr, std::string>> trackers{};
         };
         /**
          * Alias for a pointer to a solver state.
@@ -222,9 +385,9 @@ private:
          */
         fcn_gate_layout_ptr layout;
         /**
-         * Logical specification for the layout.
+         * Logical specification for the layout as a frozen snapshot for fast traversal during instance generation.
          */
-        logic_network_ptr network;
+        logic_network_snapshot_ptr network;
         /**
          * Network hierarchy used for symmetry breaking.
          */
@@ -233,6 +396,36 @@ private:
          * Configurations specifying layout restrictions. Used in instance generation among other places.
          */
         const exact_pd_config config;
+        /**
+         * Length of the longest path from any source to a vertex (level) and from a vertex to any sink (inverse level)
+         * in the network with respect to config.io_ports. Unlike the hierarchy's levels, these are never unified and
+         * can therefore be used to safely bound vertex placements.
+         */
+        std::vector<std::size_t> level{}, inv_level{};
+        /**
+         * Alias for a map assigning path lengths to tiles.
+         */
+        using reach_map = std::unordered_map<layout_tile, std::size_t, boost::hash<layout_tile>>;
+        /**
+         * Upper bounds on the length of simple data flow paths into (in_reach) and out of (out_reach) each ground
+         * tile of the current layout dimension as given by the clocking scheme.
+         */
+        reach_map in_reach{}, out_reach{};
+        /**
+         * Data flow directions of the clocking scheme that allow for bounds on in_reach which hold for all larger
+         * layout dimensions as well. QUADRANT means that information never flows north or west, i.e. all tiles able
+         * to reach a tile t are located north-west of it. COLUMN means that information always flows east, i.e. no
+         * path into t can be longer than t's x-coordinate.
+         */
+        enum class data_flow { ARBITRARY, QUADRANT, COLUMN };
+        /**
+         * Data flow directions of the used clocking scheme.
+         */
+        data_flow flow = data_flow::ARBITRARY;
+        /**
+         * Size information about the most recently generated instance.
+         */
+        std::size_t num_pairs = 0ul, num_pruned_pairs = 0ul, num_assumed_pairs = 0ul;
         /**
          * Assumption literal counter.
          */
@@ -255,6 +448,74 @@ private:
          * Shortcut to the solver stored in check_point.
          */
         solver_ptr solver;
+        /**
+         * Profiling sink and the identifier of the thread using this handler.
+         */
+        const std::shared_ptr<profile_sink> sink;
+        const unsigned tid;
+        /**
+         * Profiling record of the dimension currently worked on.
+         */
+        nlohmann::json record{};
+        /**
+         * Point in time the current dimension was started to be worked on.
+         */
+        std::chrono::steady_clock::time_point dimension_start{};
+        /**
+         * Dimension whose solver state has been reused for the current one or "none".
+         */
+        std::string solver_reuse{"none"};
+        /**
+         * Executes fn and, if profiling is enabled, adds its runtime and the number of assertions it added to the
+         * solver as a phase to the current record.
+         *
+         * @tparam Fn Function type.
+         * @param phase Name of the phase.
+         * @param fn Function to execute.
+         * @return Result of fn.
+         */
+        template <typename Fn>
+        decltype(auto) profile(const char* phase, Fn&& fn);
+        /**
+         * Rules learned from UNSAT cores shared with other handlers.
+         */
+        const std::shared_ptr<rule_store> rules;
+        /**
+         * Assumptions of the current dimension together with the names of the constraint families that created them.
+         * Only filled if UNSAT cores are extracted.
+         */
+        std::vector<std::pair<z3::expr, std::string>> assumption_families{};
+        /**
+         * Generates the given constraint family. If UNSAT cores are extracted, the family's constraints are collected
+         * in a scratch solver first and then added to the actual one guarded by a fresh tracking literal which is
+         * assumed in each check. This way, cores reveal which families are responsible for UNSAT results.
+         *
+         * @param family Name of the constraint family.
+         * @param constraints Member function generating the family's constraints.
+         */
+        void generate(const char* family, void (smt_handler::*constraints)() noexcept) noexcept;
+        /**
+         * Checks whether all constraints of the given family that hold for a dimension are satisfied by every layout of
+         * a smaller dimension when placed in its north-western corner. This is the case for all families except for
+         * those that pin elements to the layout's borders or are derived from such pinning.
+         *
+         * @param family Name of the constraint family.
+         * @return true iff family is closed under embedding into larger dimensions.
+         */
+        static bool is_embedding_closed(const std::string& family) noexcept;
+        /**
+         * Extracts the UNSAT core of the last check and translates it into dimension-level rules. If all families in
+         * the core are closed under embedding, no layout can exist for any dimension that is not larger in both X and
+         * Y. For transposition-symmetric clocking schemes, the transposed dimension is UNSAT as well.
+         */
+        void learn_from_core() noexcept;
+        /**
+         * Completes the current profiling record with the given outcome, the instance size, and Z3's statistics and
+         * hands it over to the sink. Does nothing if profiling is disabled.
+         *
+         * @param outcome Outcome of the solver check.
+         */
+        void finish_record(const std::string& outcome);
         /**
          * Returns the lc-th eastern assumption literal from the stored context.
          *
@@ -278,6 +539,12 @@ private:
          *                new to the solver. If no such solver is available, a new one is created.
          */
         solver_check_point fetch_solver(const fcn_dimension_xy& dim) noexcept;
+        /**
+         * Creates a new solver from the stored context according to the configured solver strategy and thread count.
+         *
+         * @return Pointer to a fresh solver.
+         */
+        solver_ptr create_solver() const noexcept;
         /**
          * Checks whether a given tile belongs to the added tiles of the current solver check point.
          *
@@ -298,6 +565,44 @@ private:
          * @return Reference to check_point->state->lit.
          */
         assumption_literals& lit() const noexcept;
+        /**
+         * Determines the levels and inverse levels of all vertices in the stored network.
+         */
+        void compute_levels() noexcept;
+        /**
+         * Probes the clocking scheme's data flow on a layout that covers its cutout twice in each direction in order
+         * to find out which bounds on in_reach hold independently of the layout dimension.
+         */
+        void classify_data_flow() noexcept;
+        /**
+         * Computes in_reach and out_reach for all ground tiles of the current layout dimension. If the tiles' data
+         * flow graph is acyclic, longest path lengths are determined. Otherwise, the number of tiles that can reach a
+         * tile (or can be reached from it) is used as an upper bound on simple path lengths.
+         */
+        void analyze_reachability() noexcept;
+        /**
+         * Checks whether the placement of an element with the given level onto tile t is infeasible in the current
+         * and all larger layout dimensions. Such pairs do not need any variables.
+         *
+         * @param t Tile to consider.
+         * @param l Number of tiles on the longest path from any source to the element's tile excluding the latter.
+         * @return True iff no path of length l can lead into t for any layout dimension.
+         */
+        bool is_permanently_infeasible(const layout_tile& t, const std::size_t l) const noexcept;
+        /**
+         * Collects the tiles that are clocked outgoing or incoming to t in a regularly clocked layout. Clock zones are
+         * looked up in the given cutout which is obtained once per constraint generator via fcn_clock::dispatch such
+         * that each pre-defined clocking scheme gets its own instantiation of the generator's hot loops.
+         *
+         * @tparam Cutout fcn_clock::static_cutout or fcn_clock::dynamic_cutout of the layout's clocking scheme.
+         * @param t Tile to consider.
+         * @param cutout Cutout of the layout's clocking scheme.
+         * @param outgoing Flag to indicate that outgoing instead of incoming clocked tiles are desired.
+         * @return All tiles that are clocked outgoing or incoming to t, respectively.
+         */
+        template <typename Cutout>
+        std::vector<layout_tile> clocked_tiles(const layout_tile& t, const Cutout& cutout,
+                                               const bool outgoing) const noexcept;
         /**
          * Returns a tv variable from the stored context representing that tile t has vertex v assigned.
          *
@@ -460,6 +765,13 @@ private:
          * clocking scheme is feed-back-free. Symmetry breaking constraints.
          */
         void utilize_hierarchical_information() noexcept;
+        /**
+         * Adds assumptions to the current solver check point that exclude vertices and edges from tiles that cannot
+         * be reached by a sufficiently long path from any source or cannot reach any sink by a sufficiently long path
+         * in the current layout dimension. Pairs that are infeasible in all dimensions are not considered because no
+         * variables exist for them. Symmetry breaking constraints.
+         */
+        void restrict_domains() noexcept;
         /**
          * Adds constraints to the solver to position the primary inputs and primary outputs at the layout's borders.
          */
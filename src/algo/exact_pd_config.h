@@ -8,13 +8,69 @@
 #include <string>
 #include <memory>
 #include <limits>
+#include <optional>
+#include <unordered_map>
+#include <boost/algorithm/string.hpp>
 #include "fcn_clocking_scheme.h"
+#include "iter/dimension_explorer.h"
 
 /**
  * Default timeout defined by Z3.
  */
 constexpr const unsigned DEFAULT_TIMEOUT = 4294967u;
 
+/**
+ * Strategies to solve the SMT instances generated by exact physical design.
+ */
+enum class exact_solver_strategy
+{
+    /**
+     * Z3's default incremental SMT solver.
+     */
+    SMT,
+    /**
+     * Tactic pipeline simplify -> propagate-values -> solve-eqs -> card2bv -> bit-blast -> sat for integer-free
+     * instances and simplify -> propagate-values -> solve-eqs -> smt otherwise. Tactic-based solvers are not
+     * incremental, i.e. each check starts from scratch.
+     */
+    TACTIC,
+    /**
+     * Z3's incremental finite domain solver that is a pure SAT solver with native cardinality support. Applicable to
+     * integer-free instances only, i.e. regular clocking without global synchronization and clock latches.
+     */
+    SAT,
+    /**
+     * SAT if the instance is integer-free, SMT otherwise.
+     */
+    AUTO
+};
+
+/**
+ * Looks up a solver strategy by name. Names are case-insensitive.
+ *
+ * @param name Name of the desired solver strategy.
+ * @return Solver strategy called name or std::nullopt if none such exists.
+ */
+inline std::optional<exact_solver_strategy> get_solver_strategy(const std::string& name) noexcept
+{
+    static const std::unordered_map<std::string, exact_solver_strategy> strategy_lookup
+    {{
+        { "SMT", exact_solver_strategy::SMT },
+        { "TACTIC", exact_solver_strategy::TACTIC },
+        { "SAT", exact_solver_strategy::SAT },
+        { "AUTO", exact_solver_strategy::AUTO }
+    }};
+
+    if (auto it = strategy_lookup.find(boost::to_upper_copy(name)); it != strategy_lookup.end())
+    {
+        return it->second;
+    }
+    else
+    {
+        return std::nullopt;
+    }
+}
+
 /**
  * Configuration struct to set up exact physical design calls.
  */
@@ -28,6 +84,10 @@ struct exact_pd_config
      * Use just one fixed tile size.
      */
     std::size_t fixed_size = 0ul;
+    /**
+     * Order and restrictions of the dimensions to explore.
+     */
+    exploration_policy policy{};
     /**
      * Number of threads to use for exploring the possible dimensions.
      */
@@ -84,6 +144,50 @@ struct exact_pd_config
      * Sets a timeout in ms for the solving process. Standard is 4294967 seconds as defined by Z3.
      */
     unsigned timeout = DEFAULT_TIMEOUT;
+    /**
+     * Flag to indicate that tile-element pairs that are infeasible due to the clocking scheme's data flow should be
+     * excluded from the instance.
+     */
+    bool domain_pruning = true;
+    /**
+     * Strategy to solve the generated instances with.
+     */
+    exact_solver_strategy strategy = exact_solver_strategy::SMT;
+    /**
+     * Number of threads each Z3 solver is allowed to use internally (sat.threads/smt.threads).
+     */
+    unsigned solver_threads = 1u;
+    /**
+     * Flag to indicate that Z3's parallel cube-and-conquer tactics (psmt/psat) should be used. They are set per solver
+     * rather than via the global parallel.enable such that concurrent exact runs do not affect each other.
+     */
+    bool parallel_solving = false;
+    /**
+     * Flag to indicate that timings and sizes of each instance generation phase, solver outcomes, and Z3 statistics
+     * should be recorded for each examined dimension.
+     */
+    bool profile = false;
+    /**
+     * Flag to indicate that UNSAT cores should be extracted and translated into rules that prune further dimensions.
+     */
+    bool unsat_cores = false;
+    /**
+     * Name of a file to write the recorded profile to in Chrome's trace event format. Implies profile if not empty.
+     */
+    std::string trace_file{};
+    /**
+     * Flag to indicate that the network should be decomposed into its PO cones which are placed and routed
+     * independently before their layouts are stitched together. Trades optimality for scalability.
+     */
+    bool decompose = false;
+    /**
+     * Maximum number of sub-networks to create when decomposing. 0 refers to the number of available threads.
+     */
+    std::size_t max_partitions = 0ul;
+    /**
+     * Cones sharing at least this fraction of the smaller one's vertices are merged when decomposing.
+     */
+    double merge_threshold = 0.5;
 };
 
 
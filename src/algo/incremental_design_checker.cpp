@@ -0,0 +1,165 @@
+//
+// Created by marcel on 19.10.26.
+//
+
+#include "incremental_design_checker.h"
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+
+incremental_design_checker::incremental_design_checker(fcn_gate_layout_ptr fgl, std::size_t wl)
+        :
+        layout{std::move(fgl)},
+        rules{layout, wl},
+        subscription{layout->subscribe([this](const auto& t){ on_modification(t); })}
+{
+    check_all();
+}
+
+incremental_design_checker::~incremental_design_checker()
+{
+    layout->unsubscribe(subscription);
+}
+
+std::size_t incremental_design_checker::get_drvs() noexcept
+{
+    update();
+    return drvs;
+}
+
+std::size_t incremental_design_checker::get_warnings() noexcept
+{
+    update();
+    return warnings;
+}
+
+bool incremental_design_checker::is_violating(const fcn_gate_layout::tile& t) noexcept
+{
+    update();
+    return std::any_of(violations.cbegin(), violations.cend(), [&t](const auto& v){ return v.count(t) > 0u; });
+}
+
+bool incremental_design_checker::is_violating(const design_rule r, const fcn_gate_layout::tile& t) noexcept
+{
+    update();
+    return violations[static_cast<std::size_t>(r)].count(t) > 0u;
+}
+
+const incremental_design_checker::tile_set& incremental_design_checker::get_violations(const design_rule r) noexcept
+{
+    update();
+    return violations[static_cast<std::size_t>(r)];
+}
+
+void incremental_design_checker::update() noexcept
+{
+    if (modified_all)
+    {
+        check_all();
+    }
+    else if (!modified.empty())
+    {
+        // the data flow of a tile depends on the tiles on adjacent positions in all layers
+        tile_set affected{};
+        for (const auto& t : modified)
+        {
+            const fcn_gate_layout::tile g{{t[X], t[Y], GROUND}};
+            std::vector<fcn_gate_layout::tile> positions{g};
+            for (auto&& at : layout->surrounding_2d(g))
+                positions.push_back(at);
+
+            for (const auto& p : positions)
+            {
+                for (coord_t z = 0; z < layout->z(); ++z)
+                    affected.insert(fcn_gate_layout::tile{{p[X], p[Y], z}});
+            }
+        }
+
+        for (const auto& t : affected)
+            check_tile(t);
+
+        modified.clear();
+    }
+    else
+    {
+        return;
+    }
+
+    assert(is_consistent() && "incremental design rule check deviates from full check");
+}
+
+void incremental_design_checker::on_modification(const std::optional<fcn_gate_layout::tile>& t) noexcept
+{
+    if (!t)
+    {
+        modified_all = true;
+        modified.clear();
+    }
+    else if (!modified_all)
+    {
+        modified.insert(*t);
+    }
+}
+
+void incremental_design_checker::check_all() noexcept
+{
+    for (auto& v : violations)
+        v.clear();
+
+    drvs = 0, warnings = 0;
+
+    for (auto&& t : layout->tiles())
+        check_tile(t);
+
+    modified.clear();
+    modified_all = false;
+}
+
+void incremental_design_checker::check_tile(const fcn_gate_layout::tile& t) noexcept
+{
+    for (std::size_t i = 0; i < design_checker::num_design_rules; ++i)
+    {
+        const auto r = static_cast<design_rule>(i);
+        auto& counter = design_checker::is_design_breaking(r) ? drvs : warnings;
+
+        if (rules.violates(r, t))
+        {
+            if (violations[i].insert(t).second)
+                ++counter;
+        }
+        else if (violations[i].erase(t) > 0u)
+        {
+            --counter;
+        }
+    }
+}
+
+bool incremental_design_checker::is_consistent() noexcept
+{
+    // returns right away if called by the assertion in update
+    update();
+
+    // a stream without buffer discards the full check's output
+    std::ostream discard{nullptr};
+    const auto report = rules.check(discard);
+
+    std::size_t tracked_drvs = 0, tracked_warnings = 0;
+    for (std::size_t i = 0; i < design_checker::num_design_rules; ++i)
+    {
+        const auto r = static_cast<design_rule>(i);
+        (design_checker::is_design_breaking(r) ? tracked_drvs : tracked_warnings) += violations[i].size();
+
+        const auto& entries = report[design_checker::report_key(r)];
+        if (entries.size() != violations[i].size())
+            return false;
+
+        for (const auto& t : violations[i])
+        {
+            if (entries.find(to_string(t)) == entries.cend())
+                return false;
+        }
+    }
+
+    return tracked_drvs == drvs && tracked_warnings == warnings;
+}
@@ -0,0 +1,154 @@
+//
+// Created by marcel on 19.10.26.
+//
+
+#ifndef FICTION_INCREMENTAL_DESIGN_CHECKER_H
+#define FICTION_INCREMENTAL_DESIGN_CHECKER_H
+
+#include "design_checker.h"
+#include "fcn_gate_layout.h"
+#include <array>
+#include <optional>
+#include <unordered_set>
+
+
+/**
+ * Keeps track of design rule violations of a gate layout while it is being modified, e.g., during manual editing or
+ * post-layout optimizations like latch insertion, compaction, or rerouting. Instead of re-validating the entire layout
+ * like design_checker::check does, it subscribes to the layout's modifications (see fcn_gate_layout::subscribe) and
+ * only re-checks the modified tiles together with all tiles on adjacent positions in all layers, i.e., all tiles
+ * whose data flow can be affected by the modification. Rules are evaluated via design_checker::violates such that
+ * both checkers agree.
+ *
+ * Modified tiles are collected and re-checked on the next query such that a sequence of modifications, which might
+ * pass through intermediate states that violate rules, is handled at once. Afterwards, the numbers of violations and
+ * the violation state of a tile can be queried in O(1). If the layout is resized or cleared, all tiles are re-checked.
+ *
+ * In debug builds, every update is cross-checked against a full design_checker::check.
+ *
+ * Violations of the I/O rules are counted once per tile even if it is both PI and PO, whereas design_checker::check
+ * counts them once per port.
+ */
+class incremental_design_checker
+{
+public:
+    /**
+     * Alias for a design rule.
+     */
+    using design_rule = design_checker::design_rule;
+    /**
+     * Alias for a set of tiles.
+     */
+    using tile_set = std::unordered_set<fcn_gate_layout::tile, boost::hash<fcn_gate_layout::tile>>;
+    /**
+     * Standard constructor. Checks the whole layout once and subscribes to its modifications.
+     *
+     * @param fgl Gate layout to keep track of.
+     * @param wl Maximum number of wires per tile.
+     */
+    explicit incremental_design_checker(fcn_gate_layout_ptr fgl, std::size_t wl = 1);
+    /**
+     * Destructor. Unsubscribes from the layout's modifications.
+     */
+    ~incremental_design_checker();
+    /**
+     * The layout's callback refers to this object. Therefore, it must not be copied or moved.
+     */
+    incremental_design_checker(const incremental_design_checker&) = delete;
+    incremental_design_checker& operator=(const incremental_design_checker&) = delete;
+    /**
+     * Returns the current number of design rule violations.
+     *
+     * @return Number of tiles violating a design breaking rule counted once per violated rule.
+     */
+    std::size_t get_drvs() noexcept;
+    /**
+     * Returns the current number of warnings.
+     *
+     * @return Number of tiles violating a non-breaking rule counted once per violated rule.
+     */
+    std::size_t get_warnings() noexcept;
+    /**
+     * Checks whether tile t currently violates any design rule.
+     *
+     * @param t Tile to check.
+     * @return True iff t violates at least one design rule.
+     */
+    bool is_violating(const fcn_gate_layout::tile& t) noexcept;
+    /**
+     * Checks whether tile t currently violates design rule r.
+     *
+     * @param r Design rule.
+     * @param t Tile to check.
+     * @return True iff t violates r.
+     */
+    bool is_violating(const design_rule r, const fcn_gate_layout::tile& t) noexcept;
+    /**
+     * Returns all tiles that currently violate design rule r.
+     *
+     * @param r Design rule.
+     * @return Set of tiles violating r.
+     */
+    const tile_set& get_violations(const design_rule r) noexcept;
+    /**
+     * Re-checks all modified tiles since the last call. Called by all queries; calling it explicitly is not necessary.
+     */
+    void update() noexcept;
+    /**
+     * Compares the tracked violations to the report of a full design_checker::check after updating them. The tiles
+     * violating each rule have to match the report and the counters have to match the numbers of tracked violations.
+     * Used in debug builds after every update and by check -i.
+     *
+     * @return True iff both agree.
+     */
+    bool is_consistent() noexcept;
+
+private:
+    /**
+     * Layout whose violations are tracked.
+     */
+    fcn_gate_layout_ptr layout;
+    /**
+     * Evaluates the design rules on single tiles.
+     */
+    design_checker rules;
+    /**
+     * Identifier of the subscription to layout's modifications.
+     */
+    fcn_gate_layout::subscription subscription;
+    /**
+     * Tiles modified since the last update.
+     */
+    tile_set modified{};
+    /**
+     * Flag to indicate that the whole layout has been modified since the last update.
+     */
+    bool modified_all = false;
+    /**
+     * Tiles violating each design rule indexed by the rule's value.
+     */
+    std::array<tile_set, design_checker::num_design_rules> violations{};
+    /**
+     * Current numbers of violations of design breaking and non-breaking rules respectively.
+     */
+    std::size_t drvs = 0, warnings = 0;
+    /**
+     * Callback registered at the layout.
+     *
+     * @param t Modified tile or std::nullopt if the whole layout has been modified.
+     */
+    void on_modification(const std::optional<fcn_gate_layout::tile>& t) noexcept;
+    /**
+     * Drops all violations and checks every tile of the layout.
+     */
+    void check_all() noexcept;
+    /**
+     * Re-evaluates all design rules on tile t and updates the violation sets and counters accordingly.
+     *
+     * @param t Tile to re-check.
+     */
+    void check_tile(const fcn_gate_layout::tile& t) noexcept;
+};
+
+
+#endif //FICTION_INCREMENTAL_DESIGN_CHECKER_H
@@ -0,0 +1,261 @@
+//
+// Created by marcel on 19.10.26.
+//
+
+#ifndef FICTION_DIMENSION_EXPLORER_H
+#define FICTION_DIMENSION_EXPLORER_H
+
+#include "fcn_layout.h"
+#include <boost/algorithm/string.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+/**
+ * Orders in which layout dimensions can be explored.
+ *
+ * AREA: Ascending area; dimensions of equal area are enumerated in factorization order.
+ * BEST_FIRST: Ascending area windows; dimensions within each window are sorted by their predicted likelihood of being
+ *             SAT, i.e., by how close their aspect ratio is to the one predicted for the network.
+ */
+enum class exploration_order { AREA, BEST_FIRST };
+
+/**
+ * Looks up an exploration order by name. Names are case-insensitive.
+ *
+ * @param name Name of the desired exploration order.
+ * @return Exploration order called name or std::nullopt if none such exists.
+ */
+inline std::optional<exploration_order> get_exploration_order(const std::string& name) noexcept
+{
+    static const std::unordered_map<std::string, exploration_order> order_lookup
+    {{
+        { "AREA", exploration_order::AREA },
+        { "BEST", exploration_order::BEST_FIRST },
+        { "BEST_FIRST", exploration_order::BEST_FIRST }
+    }};
+
+    if (auto it = order_lookup.find(boost::to_upper_copy(name)); it != order_lookup.end())
+    {
+        return it->second;
+    }
+    else
+    {
+        return std::nullopt;
+    }
+}
+
+/**
+ * Policy that determines which dimensions are explored in which order by physical design approaches that iterate
+ * over layout sizes.
+ */
+struct exploration_policy
+{
+    /**
+     * Order in which dimensions are explored.
+     */
+    exploration_order order = exploration_order::AREA;
+    /**
+     * Maximum ratio of a dimension's longer side to its shorter one. Dimensions exceeding it are not explored at all.
+     * 0 means unbounded. Any bound forfeits the optimality guarantee.
+     */
+    double max_aspect_ratio = 0.0;
+    /**
+     * Let the physical design approach derive max_aspect_ratio from the network's depth and width.
+     */
+    bool derive_aspect_ratio = false;
+    /**
+     * Number of additional areas that are united into one window for BEST_FIRST exploration. The first solution found
+     * exceeds the minimum area by at most area_slack tiles. 0 keeps the optimality guarantee in area.
+     */
+    uint64_t area_slack = 0ul;
+};
+
+/**
+ * Derives an aspect ratio bound from a network's depth and width. Layouts rarely need to be stretched further than
+ * twice the ratio between the longer and the shorter of the two.
+ *
+ * @param depth Number of levels of the network.
+ * @param width Maximum number of vertices on one level.
+ * @return Aspect ratio bound of at least 2.
+ */
+inline double derived_aspect_ratio(const uint64_t depth, const uint64_t width) noexcept
+{
+    const auto longer  = static_cast<double>(std::max({depth, width, 1ul}));
+    const auto shorter = static_cast<double>(std::max(std::min(depth, width), 1ul));
+
+    return std::max(2.0 * longer / shorter, 2.0);
+}
+
+/**
+ * Iterates over layout dimensions according to an exploration_policy. It provides the same interface as
+ * dimension_iterator such that it can be used as a drop-in replacement. Like dimension_iterator, only dimensions with
+ * x, y >= 2 are generated to work around a bug in the BGL.
+ *
+ * Dimensions are generated in windows of area_slack + 1 consecutive areas. All dimensions of a window violating the
+ * aspect ratio bound or exceeding the upper bound are dropped and the remaining ones are sorted as requested. Since
+ * windows are processed in ascending order of area, exploring them exhaustively finds a solution of minimum area if
+ * area_slack is 0 and no aspect ratio bound is set.
+ */
+class dimension_explorer
+{
+public:
+    /**
+     * Standard constructor.
+     *
+     * @param n Starting area of the exploration.
+     * @param upper_bound Maximum area to explore.
+     * @param p Exploration policy. A derived aspect ratio bound has to be resolved by the caller.
+     * @param preferred_ratio Predicted ratio x / y of a dimension to be SAT. Used for BEST_FIRST ordering.
+     */
+    explicit dimension_explorer(uint64_t n, const uint64_t upper_bound = std::numeric_limits<uint64_t>::max(),
+                                const exploration_policy& p = {}, const double preferred_ratio = 1.0) noexcept
+            :
+            num{n},
+            upper{upper_bound},
+            policy{p},
+            log_ratio{std::log(std::max(preferred_ratio, std::numeric_limits<double>::min()))}
+    {
+        next_window();
+    }
+    /**
+     * Lets the explorer point to the next dimension of the current window. If there are no further ones, the next
+     * window is computed.
+     *
+     * @return Reference to this.
+     */
+    dimension_explorer& operator++() noexcept
+    {
+        if (++pos >= window.size())
+            next_window();
+
+        return *this;
+    }
+    /**
+     * Current dimension. Must only be called if the explorer is not exhausted.
+     *
+     * @return Dimension the explorer points to.
+     */
+    fcn_dimension_xy operator*() const
+    {
+        return window[pos];
+    }
+    /**
+     * Checks whether the explorer still points to a dimension whose area is not larger than m.
+     *
+     * @param m Area to compare with.
+     * @return true iff the current dimension has an area of at most m.
+     */
+    bool operator<=(const uint64_t m) const noexcept
+    {
+        return pos < window.size() && area(window[pos]) <= m;
+    }
+
+private:
+    /**
+     * Next area to factorize.
+     */
+    uint64_t num;
+    /**
+     * Maximum area to explore.
+     */
+    uint64_t upper;
+    /**
+     * Exploration policy.
+     */
+    exploration_policy policy;
+    /**
+     * Natural logarithm of the predicted aspect ratio.
+     */
+    double log_ratio;
+    /**
+     * Dimensions of the current window in exploration order.
+     */
+    std::vector<fcn_dimension_xy> window{};
+    /**
+     * Index of the current dimension in window.
+     */
+    std::size_t pos = 0ul;
+    /**
+     * Checks whether the given dimension respects the aspect ratio bound.
+     *
+     * @param dim Dimension to check.
+     * @return true iff dim is admissible.
+     */
+    bool admissible(const fcn_dimension_xy& dim) const noexcept
+    {
+        if (policy.max_aspect_ratio <= 0.0)
+            return true;
+
+        return static_cast<double>(std::max(dim[X], dim[Y])) <=
+               policy.max_aspect_ratio * static_cast<double>(std::min(dim[X], dim[Y]));
+    }
+    /**
+     * Deviation of the given dimension's aspect ratio from the predicted one on a logarithmic scale. Smaller values
+     * indicate a higher chance of being SAT.
+     *
+     * @param dim Dimension to score.
+     * @return Score of dim.
+     */
+    double score(const fcn_dimension_xy& dim) const noexcept
+    {
+        // the difference of logarithms is exactly antisymmetric which keeps scores of rotated dimensions equal
+        return std::abs(std::log(static_cast<double>(dim[X])) - std::log(static_cast<double>(dim[Y])) - log_ratio);
+    }
+    /**
+     * Fills window with the admissible dimensions of the next area_slack + 1 areas that contain any and sorts them
+     * according to the policy. The window stays empty if the upper bound has been exceeded.
+     */
+    void next_window() noexcept
+    {
+        window.clear();
+        pos = 0ul;
+
+        const auto window_size = policy.order == exploration_order::BEST_FIRST ? policy.area_slack + 1ul : 1ul;
+
+        // areas without admissible dimensions do not count towards the window size
+        for (auto areas = 0ul; areas < window_size && num <= upper; ++num)
+        {
+            const auto size = window.size();
+
+            // same order as in dimension_iterator
+            for (auto i = 2ul; i * i <= num; ++i)
+            {
+                if (num % i != 0)
+                    continue;
+
+                for (const auto& dim : {fcn_dimension_xy{i, num / i}, fcn_dimension_xy{num / i, i}})
+                {
+                    if (admissible(dim))
+                        window.push_back(dim);
+
+                    // square
+                    if (i * i == num)
+                        break;
+                }
+            }
+
+            if (window.size() > size)
+                ++areas;
+        }
+
+        // a stable sort keeps rotated dimensions of equal score next to each other
+        if (policy.order == exploration_order::BEST_FIRST)
+        {
+            std::stable_sort(window.begin(), window.end(), [this](const auto& d1, const auto& d2)
+            {
+                const auto s1 = score(d1), s2 = score(d2);
+                return s1 < s2 || (s1 == s2 && area(d1) < area(d2));
+            });
+        }
+    }
+};
+
+
+#endif //FICTION_DIMENSION_EXPLORER_H
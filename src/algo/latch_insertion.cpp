@@ -0,0 +1,167 @@
+//
+// Created by marcel on 19.10.26.
+//
+
+#include "latch_insertion.h"
+#include <fmt/format.h>
+#include <itertools.hpp>
+#include <algorithm>
+#include <tuple>
+
+
+latch_insertion::latch_insertion(fcn_gate_layout_ptr fgl) noexcept
+        :
+        layout{std::move(fgl)}
+{}
+
+nlohmann::json latch_insertion::latch_result::json() const
+{
+    return
+    {
+        {"critical path", {{"before", cp_before}, {"after", cp_after}}},
+        {"throughput", {{"before", fmt::format("1/{}", tp_before)}, {"after", fmt::format("1/{}", tp_after)}}},
+        {"latches", latches},
+        {"latch cycles", cycles},
+        {"unbalanced tiles", unbalanced},
+        {"runtime (s)", mockturtle::to_seconds(runtime)}
+    };
+}
+
+latch_insertion::latch_result latch_insertion::operator()()
+{
+    latch_result result{};
+    std::tie(result.cp_before, result.tp_before) = layout->critical_path_length_and_throughput();
+
+    {
+        mockturtle::stopwatch stop{result.runtime};
+
+        predecessor_map preds{};
+        const auto order = topological_order(preds);
+
+        const auto num_clocks = static_cast<std::size_t>(layout->num_clocks());
+        arrival_map arrival{};
+
+        // arrival times are computed just like signal delays in fcn_gate_layout::signal_delay
+        for (const auto& t : order)
+        {
+            const auto& in = preds[t];
+            const auto clk = static_cast<std::size_t>(layout->tile_clocking(t).value_or(0));
+
+            if (in.empty())
+            {
+                arrival[t] = clk + layout->get_latch(t);
+                continue;
+            }
+
+            std::size_t latest = 0ul;
+            for (const auto& i : in)
+                latest = std::max(arrival[i], latest);
+
+            // delay earlier inputs such that all arrive together
+            auto balanced = true;
+            for (const auto& i : in)
+            {
+                if (const auto skew = latest - arrival[i]; skew > 0ul)
+                {
+                    // latches have to be multiples of full clock cycles to leave the clocking intact
+                    if (auto w = latchable_wire(i, preds); w && skew % num_clocks == 0ul)
+                    {
+                        if (layout->get_latch(*w) == 0u)
+                            ++result.latches;
+
+                        layout->assign_latch(*w, layout->get_latch(*w) +
+                                                 static_cast<fcn_gate_layout::latch_delay>(skew));
+                        result.cycles += skew / num_clocks;
+                    }
+                    else
+                        balanced = false;
+                }
+            }
+
+            if (!balanced)
+                ++result.unbalanced;
+
+            // primary inputs with incoming data flow receive their signal one phase before their own clock
+            if (layout->is_pi(t))
+                latest = std::max((clk + (num_clocks - 1)) % num_clocks, latest);
+
+            arrival[t] = latest + 1ul + layout->get_latch(t);
+        }
+    }
+
+    std::tie(result.cp_after, result.tp_after) = layout->critical_path_length_and_throughput();
+
+    return result;
+}
+
+std::vector<fcn_gate_layout::tile> latch_insertion::topological_order(predecessor_map& preds) const noexcept
+{
+    std::unordered_map<fcn_gate_layout::tile, std::size_t, boost::hash<fcn_gate_layout::tile>> in_degree{};
+    std::unordered_map<fcn_gate_layout::tile, std::vector<fcn_gate_layout::tile>,
+                       boost::hash<fcn_gate_layout::tile>> succs{};
+
+    // determine data flow once such that predecessors and successors are consistent
+    std::vector<fcn_gate_layout::tile> tiles{};
+    for (auto&& t : layout->tiles() | iter::filterfalse([this](const fcn_gate_layout::tile& _t)
+                                                         { return layout->is_free_tile(_t); }))
+    {
+        tiles.push_back(t);
+        in_degree.emplace(t, 0ul);
+    }
+
+    for (const auto& t : tiles)
+    {
+        for (auto&& s : layout->outgoing_data_flow(t))
+        {
+            succs[t].push_back(s);
+            preds[s].push_back(t);
+            ++in_degree[s];
+        }
+    }
+
+    // Kahn's algorithm
+    std::vector<fcn_gate_layout::tile> order{};
+    order.reserve(tiles.size());
+    for (const auto& t : tiles)
+    {
+        if (in_degree[t] == 0ul)
+            order.push_back(t);
+    }
+
+    for (auto i = 0ul; i < order.size(); ++i)
+    {
+        for (const auto& s : succs[order[i]])
+        {
+            if (--in_degree[s] == 0ul)
+                order.push_back(s);
+        }
+    }
+
+    return order;
+}
+
+std::optional<fcn_gate_layout::tile> latch_insertion::latchable_wire(fcn_gate_layout::tile t,
+                                                                     const predecessor_map& preds) const noexcept
+{
+    // follow the wire segment backwards until the next gate
+    while (layout->is_wire_tile(t))
+    {
+        // latches apply to all tiles stacked on the same ground tile; hence, crossings cannot hold them
+        auto crossing = false;
+        for (auto z : iter::range(layout->z()))
+        {
+            if (z != t[Z] && !layout->is_free_tile(fcn_gate_layout::tile{t[X], t[Y], z}))
+                crossing = true;
+        }
+
+        if (!crossing && layout->get_logic_edges(t).size() == 1ul)
+            return t;
+
+        if (auto it = preds.find(t); it != preds.end() && it->second.size() == 1ul)
+            t = it->second.front();
+        else
+            break;
+    }
+
+    return std::nullopt;
+}
@@ -0,0 +1,110 @@
+//
+// Created by marcel on 19.10.26.
+//
+
+#ifndef FICTION_LATCH_INSERTION_H
+#define FICTION_LATCH_INSERTION_H
+
+
+#include "fcn_gate_layout.h"
+#include <mockturtle/utils/stopwatch.hpp>
+#include <nlohmann/json.hpp>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+#include <boost/functional/hash/hash.hpp>
+
+
+/**
+ * Post-placement synchronization of placed and routed gate layouts via artificial clock latches as introduced in
+ * "Synchronization of Clocked Field-Coupled Circuits" by Frank Sill Torres, Marcel Walter, Robert Wille, Daniel Große,
+ * and Rolf Drechsler in IEEE-NANO 2018.
+ *
+ * Gates whose input paths differ in length, e.g., in layouts generated by orthogonal, reduce the layout's throughput.
+ * This pass visits all tiles once in topological order of their data flow and computes the signal arrival time at each
+ * tile in clock phases. Whenever the inputs of a tile arrive at different times, the earlier ones are delayed by
+ * assigning latches to the wire tiles closest to the tile on their respective paths such that all inputs arrive
+ * together. Since delays of paths to the same tile differ by multiples of num_clocks() in regularly clocked layouts,
+ * latches stall signals for whole clock cycles and leave the clocking intact. Only wire tiles that are not part of a
+ * crossing are used. Tiles whose earlier inputs are not routed via such wires remain unbalanced.
+ *
+ * The algorithm works in linear time in the number of tiles.
+ */
+class latch_insertion
+{
+public:
+    /**
+     * Standard constructor.
+     *
+     * @param fgl Gate layout to insert latches into. It is modified in place.
+     */
+    explicit latch_insertion(fcn_gate_layout_ptr fgl) noexcept;
+    /**
+     * Result type containing statistical information about the latch insertion.
+     */
+    struct latch_result
+    {
+        /**
+         * Critical path length and throughput (1/x where only x is given) before and after latch insertion.
+         */
+        std::size_t cp_before = 0ul, tp_before = 0ul, cp_after = 0ul, tp_after = 0ul;
+        /**
+         * Number of wire tiles that were assigned a latch and the sum of all inserted latch delays in clock cycles.
+         */
+        std::size_t latches = 0ul, cycles = 0ul;
+        /**
+         * Number of tiles whose inputs could not be balanced.
+         */
+        std::size_t unbalanced = 0ul;
+        /**
+         * Runtime of the latch insertion.
+         */
+        mockturtle::stopwatch<>::duration runtime{0};
+        /**
+         * Returns the result's information as JSON.
+         *
+         * @return JSON object containing all information.
+         */
+        nlohmann::json json() const;
+    };
+    /**
+     * Starts the latch insertion process.
+     *
+     * @return Result type containing statistical information about the process.
+     */
+    latch_result operator()();
+
+private:
+    /**
+     * Gate layout to insert latches into.
+     */
+    fcn_gate_layout_ptr layout;
+    /**
+     * Alias for a map assigning signal arrival times in clock phases to tiles.
+     */
+    using arrival_map = std::unordered_map<fcn_gate_layout::tile, std::size_t, boost::hash<fcn_gate_layout::tile>>;
+    /**
+     * Alias for a map assigning the tiles with data flow to a tile to that tile.
+     */
+    using predecessor_map = std::unordered_map<fcn_gate_layout::tile, std::vector<fcn_gate_layout::tile>,
+                                               boost::hash<fcn_gate_layout::tile>>;
+    /**
+     * Returns all non-free tiles of the layout in topological order of their data flow.
+     *
+     * @param preds Map to store the tiles with data flow to each tile in.
+     * @return Vector of tiles where each tile is placed after all tiles with data flow to it.
+     */
+    std::vector<fcn_gate_layout::tile> topological_order(predecessor_map& preds) const noexcept;
+    /**
+     * Searches the path that ends in the given tile backwards for the first wire tile that can hold a latch, i.e., one
+     * that carries a single logic edge and is not part of a crossing. The search stops at the first gate tile.
+     *
+     * @param t Last tile of the path.
+     * @param preds Tiles with data flow to each tile.
+     * @return Wire tile that can hold a latch or std::nullopt if there is none on the path.
+     */
+    std::optional<fcn_gate_layout::tile> latchable_wire(fcn_gate_layout::tile t, const predecessor_map& preds) const noexcept;
+};
+
+
+#endif //FICTION_LATCH_INSERTION_H
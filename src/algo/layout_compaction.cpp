@@ -0,0 +1,809 @@
+//
+// Created by marcel on 19.10.26.
+//
+
+#include "layout_compaction.h"
+#include <itertools.hpp>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <limits>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
+
+
+layout_compaction::layout_compaction(fcn_gate_layout_ptr fgl, compaction_config cfg) noexcept
+        :
+        layout{std::move(fgl)},
+        config{cfg}
+{}
+
+nlohmann::json layout_compaction::compaction_result::json() const
+{
+    return
+    {
+        {"x", {{"before", x_before}, {"after", x_after}}},
+        {"y", {{"before", y_before}, {"after", y_after}}},
+        {"area", {{"before", x_before * y_before}, {"after", x_after * y_after}}},
+        {"wires", {{"before", wires_before}, {"after", wires_after}}},
+        {"crossings", {{"before", crossings_before}, {"after", crossings_after}}},
+        {"deleted rows", deleted_rows},
+        {"deleted columns", deleted_columns},
+        {"relocations", relocations},
+        {"rounds", rounds},
+        {"rolled back rounds", rollbacks},
+        {"runtime (s)", mockturtle::to_seconds(runtime)}
+    };
+}
+
+layout_compaction::compaction_result layout_compaction::operator()()
+{
+    compaction_result result{};
+    result.x_before = layout->x();
+    result.y_before = layout->y();
+    result.wires_before = layout->wire_count();
+    result.crossings_before = static_cast<std::size_t>(layout->crossing_count());
+
+    {
+        mockturtle::stopwatch stop{result.runtime};
+
+        // only tiles modified in a round are re-checked
+        incremental_design_checker checker{layout};
+        const auto drvs = checker.get_drvs();
+
+        while (config.max_rounds == 0ul || result.rounds < config.max_rounds)
+        {
+            ++result.rounds;
+
+            const auto deleted_rows = result.deleted_rows, deleted_columns = result.deleted_columns,
+                       relocations = result.relocations;
+
+            layout->begin_transaction();
+
+            const auto relocated = config.relocate && relocate_gates(result);
+            const auto deleted = delete_rows_and_columns(result);
+
+            // a round must not introduce design rule violations; otherwise, it is undone and the compaction stops
+            if (checker.get_drvs() > drvs)
+            {
+                layout->rollback_transaction();
+
+                result.deleted_rows = deleted_rows;
+                result.deleted_columns = deleted_columns;
+                result.relocations = relocations;
+                ++result.rollbacks;
+
+                break;
+            }
+
+            layout->commit_transaction();
+
+            if (!relocated && !deleted)
+                break;
+        }
+    }
+
+    result.x_after = layout->x();
+    result.y_after = layout->y();
+    result.wires_after = layout->wire_count();
+    result.crossings_after = static_cast<std::size_t>(layout->crossing_count());
+
+    return result;
+}
+
+bool layout_compaction::delete_rows_and_columns(compaction_result& result) noexcept
+{
+    std::vector<bool> keep_x(layout->x(), false), keep_y(layout->y(), false);
+
+    // gates can never be deleted
+    for (const auto& tv : layout->v_map->left)
+    {
+        keep_x[tv.first[X]] = true;
+        keep_y[tv.first[Y]] = true;
+    }
+    // wires can only be deleted along their direction
+    for (const auto& [t, edges] : *layout->e_map)
+    {
+        if (layout->get_latch(t) != 0u)
+        {
+            keep_x[t[X]] = true;
+            keep_y[t[Y]] = true;
+            continue;
+        }
+
+        for (const auto& e : edges)
+        {
+            const auto inp = layout->get_wire_inp_dirs(t, e), out = layout->get_wire_out_dirs(t, e);
+
+            if (inp != layout::DIR_W || out != layout::DIR_E)
+                keep_x[t[X]] = true;
+            if (inp != layout::DIR_N || out != layout::DIR_S)
+                keep_y[t[Y]] = true;
+        }
+    }
+
+    // determine new coordinates
+    std::vector<coord_t> new_x(layout->x()), new_y(layout->y());
+    coord_t x_size = 0ul, y_size = 0ul;
+    for (auto x : iter::range(layout->x()))
+    {
+        new_x[x] = x_size;
+        if (keep_x[x])
+            ++x_size;
+    }
+    for (auto y : iter::range(layout->y()))
+    {
+        new_y[y] = y_size;
+        if (keep_y[y])
+            ++y_size;
+    }
+
+    if (x_size == layout->x() && y_size == layout->y())
+        return false;
+
+    result.deleted_columns += layout->x() - x_size;
+    result.deleted_rows += layout->y() - y_size;
+
+    const auto is_kept = [&keep_x, &keep_y](const auto& t){ return keep_x[t[X]] && keep_y[t[Y]]; };
+    const auto shift = [&new_x, &new_y](const tile& t){ return tile{new_x[t[X]], new_y[t[Y]], t[Z]}; };
+
+    // store all assignments of tiles that are kept
+    struct gate_assignment
+    {
+        tile t;
+        logic_network::vertex v;
+        bool pi, po;
+        layout::directions inp, out;
+    };
+    struct wire_assignment
+    {
+        tile t;
+        logic_network::edge e;
+        layout::directions inp, out;
+    };
+
+    std::vector<gate_assignment> gates{};
+    gates.reserve(layout->v_map->size());
+    for (const auto& tv : layout->v_map->left)
+    {
+        const auto& t = tv.first;
+        gates.push_back({shift(t), tv.second, layout->is_pi(t), layout->is_po(t),
+                         layout->get_tile_inp_dirs(t), layout->get_tile_out_dirs(t)});
+    }
+
+    std::vector<wire_assignment> wires{};
+    wires.reserve(layout->e_map->size());
+    for (const auto& [t, edges] : *layout->e_map)
+    {
+        if (!is_kept(t))
+            continue;
+
+        for (const auto& e : edges)
+            wires.push_back({shift(t), e, layout->get_wire_inp_dirs(t, e), layout->get_wire_out_dirs(t, e)});
+    }
+
+    std::vector<std::pair<tile, fcn_layout::latch_delay>> latches{};
+    for (const auto& [g, l] : *layout->l_map)
+    {
+        if (is_kept(g))
+            latches.emplace_back(shift(tile{g[X], g[Y], GROUND}), l);
+    }
+
+    // rebuild the layout
+    layout->clear_layout();
+    // incorporate BGL bug
+    layout->resize(fcn_dimension_xyz{std::max(x_size, coord_t{2}), std::max(y_size, coord_t{2}), layout->z()});
+
+    for (const auto& g : gates)
+    {
+        layout->assign_logic_vertex(g.t, g.v, g.pi, g.po);
+        layout->assign_tile_inp_dir(g.t, g.inp);
+        layout->assign_tile_out_dir(g.t, g.out);
+    }
+    for (const auto& w : wires)
+    {
+        layout->assign_logic_edge(w.t, w.e);
+        layout->assign_wire_inp_dir(w.t, w.e, w.inp);
+        layout->assign_wire_out_dir(w.t, w.e, w.out);
+    }
+    for (const auto& [t, l] : latches)
+        layout->assign_latch(t, l);
+
+    return true;
+}
+
+bool layout_compaction::relocate_gates(compaction_result& result)
+{
+    const auto neighborhoods = gather_neighborhoods();
+    std::vector<std::optional<relocation>> relocations(neighborhoods.size());
+
+    // evaluations only read the layout and can therefore run in parallel
+    std::atomic<std::size_t> next_gate{0ul};
+    const auto worker = [this, &neighborhoods, &relocations, &next_gate]
+    {
+        for (auto i = next_gate++; i < neighborhoods.size(); i = next_gate++)
+            relocations[i] = evaluate(neighborhoods[i], i);
+    };
+
+    // the calling thread works as well
+    const std::size_t threads_available = config.threads == 0ul ?
+                                          std::max(std::thread::hardware_concurrency(), 1u) : config.threads;
+    std::vector<std::thread> threads{};
+    for (auto t = 1ul; t < threads_available; ++t)
+        threads.emplace_back(worker);
+
+    worker();
+
+    for (auto& t : threads)
+        t.join();
+
+    // apply relocations in order of their gates' distance to the north-western corner and skip those that read tiles
+    // which have been altered in the meantime
+    ground_set altered{};
+    auto relocated = false;
+    for (const auto& r : relocations)
+    {
+        if (!r || std::any_of(r->footprint.cbegin(), r->footprint.cend(),
+                              [&altered](const auto& g){ return altered.count(g) > 0ul; }))
+            continue;
+
+        apply(*r, neighborhoods[r->gate]);
+        altered.insert(r->footprint.cbegin(), r->footprint.cend());
+
+        ++result.relocations;
+        relocated = true;
+    }
+
+    return relocated;
+}
+
+std::vector<layout_compaction::gate_neighborhood> layout_compaction::gather_neighborhoods() const noexcept
+{
+    std::vector<gate_neighborhood> neighborhoods{};
+    neighborhoods.reserve(layout->v_map->size());
+    for (const auto& tv : layout->v_map->left)
+        neighborhoods.push_back({tv.first, tv.second, {}, {}});
+
+    // gates closer to the north-western corner are relocated first
+    std::sort(neighborhoods.begin(), neighborhoods.end(), [](const auto& gn1, const auto& gn2)
+              { return std::make_tuple(gn1.t[X] + gn1.t[Y], gn1.t[Y]) < std::make_tuple(gn2.t[X] + gn2.t[Y], gn2.t[Y]); });
+
+    std::unordered_map<tile, std::size_t, boost::hash<tile>> index{};
+    for (auto i : iter::range(neighborhoods.size()))
+    {
+        auto& gn = neighborhoods[i];
+        index.emplace(gn.t, i);
+
+        // I/Os at the layout's borders have to stay there; this includes gates that are marked as PI or PO when no
+        // designated I/O pins are used
+        if (layout->is_pi(gn.t))
+        {
+            gn.fixed_x = gn.t[X] == 0ul;
+            gn.fixed_y = gn.t[Y] == 0ul;
+        }
+        if (layout->is_po(gn.t))
+        {
+            gn.fixed_x = gn.fixed_x || gn.t[X] == layout->x() - 1;
+            gn.fixed_y = gn.fixed_y || gn.t[Y] == layout->y() - 1;
+        }
+    }
+
+    // trace all outgoing connections and register them as incoming connections of their targets as well
+    for (auto i : iter::range(neighborhoods.size()))
+    {
+        const auto t = neighborhoods[i].t;
+        const auto v = neighborhoods[i].v;
+
+        for (const auto& [at, gw] : layout->outgoing_data_flow(t, {v}))
+        {
+            connection c{{}, {t}};
+
+            auto current = at;
+            auto current_gw = gw;
+            // follow the wire until the next gate
+            while (const auto e = std::get_if<logic_network::edge>(&current_gw))
+            {
+                c.e = *e;
+                c.path.push_back(current);
+
+                const auto odf = layout->outgoing_data_flow(current, current_gw);
+                if (odf.size() != 1ul)
+                    break;
+
+                std::tie(current, current_gw) = odf.front();
+            }
+
+            if (const auto w = std::get_if<logic_network::vertex>(&current_gw); w)
+            {
+                // gates can be adjacent without any wire in between
+                if (c.path.size() == 1ul)
+                    c.e = *layout->get_network()->get_edge(v, *w);
+
+                c.path.push_back(current);
+
+                if (auto it = index.find(current); it != index.end())
+                    neighborhoods[it->second].inputs.push_back(c);
+
+                neighborhoods[i].outputs.push_back(std::move(c));
+            }
+            // a connection that cannot be traced must not be torn apart
+            else
+                neighborhoods[i].fixed_x = neighborhoods[i].fixed_y = true;
+        }
+    }
+
+    return neighborhoods;
+}
+
+std::optional<layout_compaction::relocation>
+layout_compaction::evaluate(const gate_neighborhood& gn, const std::size_t index) const noexcept
+{
+    if (gn.t[Z] != GROUND || (gn.fixed_x && gn.fixed_y))
+        return std::nullopt;
+
+    // latches must not be moved since that would alter the layout's timing, and tiles holding multiple wires cannot be
+    // ripped up partially
+    for (const auto& c : iter::chain(gn.inputs, gn.outputs))
+    {
+        for (const auto& t : c.path)
+        {
+            if (layout->get_latch(t) != 0u || layout->get_logic_edges(t).size() > 1ul)
+                return std::nullopt;
+        }
+    }
+
+    std::optional<relocation> best{};
+
+    // evaluate far relocations first; once one is possible, closer ones cannot be better
+    for (auto distance = 2 * config.window; distance > 0ul && !best; --distance)
+    {
+        for (auto dx : iter::range(distance > config.window ? distance - config.window : 0ul,
+                                   std::min(distance, config.window) + 1))
+        {
+            const auto dy = distance - dx;
+
+            if (dx > gn.t[X] || dy > gn.t[Y] || (gn.fixed_x && dx > 0ul) || (gn.fixed_y && dy > 0ul))
+                continue;
+
+            if (auto r = evaluate(gn, tile{gn.t[X] - dx, gn.t[Y] - dy, GROUND}); r &&
+                    (!best || std::tie(r->wires, r->crossings) < std::tie(best->wires, best->crossings)))
+                best = std::move(r);
+        }
+    }
+
+    if (best)
+        best->gate = index;
+
+    return best;
+}
+
+std::optional<layout_compaction::relocation>
+layout_compaction::evaluate(const gate_neighborhood& gn, const tile& target) const noexcept
+{
+    relocation r{0ul, target, {}, {}, 0ul, 0ul, {}};
+
+    const auto is_north_west = [](const tile& t1, const tile& t2)
+    {
+        return t1[X] <= t2[X] && t1[Y] <= t2[Y] && (t1[X] != t2[X] || t1[Y] != t2[Y]);
+    };
+
+    tile_set ripped{gn.t}, blocked{target, tile{target[X], target[Y], CROSSING}};
+
+    // determine the closest tiles at which the connections can be rerouted and rip up everything in between
+    std::vector<std::size_t> inp_junctions{}, out_junctions{};
+    for (const auto& c : gn.inputs)
+    {
+        auto j = c.path.size() - 1;
+        while (j-- > 0ul)
+        {
+            if (is_north_west(c.path[j], target) && is_junction(c.path[j]))
+                break;
+        }
+        // no junction found
+        if (j == std::numeric_limits<std::size_t>::max())
+            return std::nullopt;
+
+        inp_junctions.push_back(j);
+        ripped.insert(c.path.cbegin() + static_cast<long>(j) + 1, c.path.cend() - 1);
+    }
+    for (const auto& c : gn.outputs)
+    {
+        auto j = 1ul;
+        for (; j < c.path.size(); ++j)
+        {
+            if (is_north_west(target, c.path[j]) && is_junction(c.path[j]))
+                break;
+        }
+        // no junction found
+        if (j == c.path.size())
+            return std::nullopt;
+
+        out_junctions.push_back(j);
+        ripped.insert(c.path.cbegin() + 1, c.path.cbegin() + static_cast<long>(j));
+    }
+
+    // the new gate tile has to be free after ripping up
+    if (is_occupied(target, ripped, {}) ||
+        (layout->z() > 1 && is_occupied(tile{target[X], target[Y], CROSSING}, ripped, {})))
+        return std::nullopt;
+
+    const auto count_crossings = [](auto begin, auto end)
+    {
+        return static_cast<std::size_t>(std::count_if(begin, end, [](const tile& t){ return t[Z] != GROUND; }));
+    };
+
+    // routes connections in the given order and returns false if any of them fails
+    const auto route_all = [&](const std::vector<std::size_t>& inp_order, const std::vector<std::size_t>& out_order)
+    {
+        auto free_inp = layout::DIR_NONE | layout::DIR_W | layout::DIR_N;
+        auto free_out = layout::DIR_NONE | layout::DIR_E | layout::DIR_S;
+        auto occupied = blocked;
+
+        r.inputs.assign(gn.inputs.size(), {});
+        r.outputs.assign(gn.outputs.size(), {});
+        r.wires = r.crossings = 0ul;
+
+        for (auto i : inp_order)
+        {
+            const auto& c = gn.inputs[i];
+            const auto j = inp_junctions[i];
+            const auto& p = c.path[j];
+
+            if ((target[X] - p[X] + 1) * (target[Y] - p[Y] + 1) > max_route_area)
+                return false;
+
+            // a gate junction cannot use the directions of its other outputs
+            auto first = layout::DIR_NONE | layout::DIR_E | layout::DIR_S;
+            if (j == 0ul)
+                first &= ~(layout->get_tile_out_dirs(p) & ~layout->get_bearing(p, c.path[1]));
+
+            auto rt = find_route(p, target, first, free_inp, ripped, occupied);
+            if (!rt)
+                return false;
+
+            auto& [tiles, crossings] = *rt;
+            free_inp &= ~layout->get_bearing(target, tiles[tiles.size() - 2]);
+            occupied.insert(tiles.cbegin() + 1, tiles.cend() - 1);
+
+            r.wires += j + tiles.size() - 2;
+            r.crossings += count_crossings(c.path.cbegin() + 1, c.path.cbegin() + static_cast<long>(j) + 1) + crossings;
+            r.inputs[i] = {j, std::move(tiles)};
+        }
+        for (auto i : out_order)
+        {
+            const auto& c = gn.outputs[i];
+            const auto j = out_junctions[i];
+            const auto& q = c.path[j];
+
+            if ((q[X] - target[X] + 1) * (q[Y] - target[Y] + 1) > max_route_area)
+                return false;
+
+            // a gate junction cannot use the directions of its other inputs
+            auto last = layout::DIR_NONE | layout::DIR_W | layout::DIR_N;
+            if (j == c.path.size() - 1)
+                last &= ~(layout->get_tile_inp_dirs(q) & ~layout->get_bearing(q, c.path[j - 1]));
+
+            auto rt = find_route(target, q, free_out, last, ripped, occupied);
+            if (!rt)
+                return false;
+
+            auto& [tiles, crossings] = *rt;
+            free_out &= ~layout->get_bearing(target, tiles[1]);
+            occupied.insert(tiles.cbegin() + 1, tiles.cend() - 1);
+
+            r.wires += c.path.size() - 1 - j + tiles.size() - 2;
+            r.crossings += count_crossings(c.path.cbegin() + static_cast<long>(j), c.path.cend() - 1) + crossings;
+            r.outputs[i] = {j, std::move(tiles)};
+        }
+
+        return true;
+    };
+
+    // connections compete for the directions of the gate; hence, both orders are tried if there are two of them
+    std::vector<std::size_t> inp_identity{}, out_identity{};
+    for (auto i : iter::range(gn.inputs.size()))
+        inp_identity.push_back(i);
+    for (auto i : iter::range(gn.outputs.size()))
+        out_identity.push_back(i);
+
+    auto success = false;
+    for (auto inp_permutation = inp_identity; !success; )
+    {
+        for (auto out_permutation = out_identity; !success; )
+        {
+            success = route_all(inp_permutation, out_permutation);
+            if (!std::next_permutation(out_permutation.begin(), out_permutation.end()))
+                break;
+        }
+        if (!std::next_permutation(inp_permutation.begin(), inp_permutation.end()))
+            break;
+    }
+
+    if (!success)
+        return std::nullopt;
+
+    // all ground positions whose state has been read, i.e., the connections' endpoints, junctions, ripped up tiles,
+    // and new tiles; kept wire segments are not altered by the relocation
+    const auto add_to_footprint = [&r](const tile& t){ r.footprint.push_back({t[X], t[Y]}); };
+    for (auto i : iter::range(gn.inputs.size()))
+    {
+        const auto& path = gn.inputs[i].path;
+        add_to_footprint(path.front());
+        std::for_each(path.cbegin() + static_cast<long>(inp_junctions[i]), path.cend(), add_to_footprint);
+    }
+    for (auto i : iter::range(gn.outputs.size()))
+    {
+        const auto& path = gn.outputs[i].path;
+        std::for_each(path.cbegin(), path.cbegin() + static_cast<long>(out_junctions[i]) + 1, add_to_footprint);
+        add_to_footprint(path.back());
+    }
+    for (const auto& rc : iter::chain(r.inputs, r.outputs))
+        std::for_each(rc.tiles.cbegin(), rc.tiles.cend(), add_to_footprint);
+    add_to_footprint(target);
+
+    return r;
+}
+
+bool layout_compaction::is_junction(const tile& t) const noexcept
+{
+    if (layout->is_gate_tile(t))
+        return true;
+
+    return t[Z] == GROUND && layout->get_logic_edges(t).size() == 1ul &&
+           (layout->z() < 2 || layout->is_free_tile(tile{t[X], t[Y], CROSSING}));
+}
+
+bool layout_compaction::is_occupied(const tile& t, const tile_set& ripped, const tile_set& blocked) const noexcept
+{
+    return blocked.count(t) > 0ul || (!layout->is_free_tile(t) && ripped.count(t) == 0ul);
+}
+
+std::optional<layout_compaction::route>
+layout_compaction::find_route(const tile& a, const tile& b, const layout::directions first,
+                              const layout::directions last, const tile_set& ripped,
+                              const tile_set& blocked) const noexcept
+{
+    // box spanned by a and b in local coordinates
+    const auto width = b[X] - a[X] + 1, height = b[Y] - a[Y] + 1;
+
+    // moves in 2DDWave are eastwards (0) and southwards (1)
+    const std::array<layout::directions, 2> moves{{layout::DIR_E, layout::DIR_S}};
+
+    // a state is a local position, the move by which it was entered, and the layer (0: ground, 1: crossing)
+    const auto state = [width](const coord_t x, const coord_t y, const std::size_t m, const std::size_t l)
+    {
+        return ((y * width + x) * 2 + m) * 2 + l;
+    };
+
+    constexpr const auto none = std::numeric_limits<std::size_t>::max();
+    const auto start = width * height * 4;
+
+    std::vector<std::size_t> cost(width * height * 4, none), parent(width * height * 4, none);
+    auto best_cost = none, best_parent = none;
+
+    // crossings are only possible above straight wires perpendicular to the path
+    const auto is_crossable = [this, &ripped, &blocked](const tile& t, const layout::directions m)
+    {
+        if (layout->z() < 2 || ripped.count(t) > 0ul || blocked.count(t) > 0ul || layout->get_latch(t) != 0u ||
+            is_occupied(tile{t[X], t[Y], CROSSING}, ripped, blocked))
+            return false;
+
+        const auto edges = layout->get_logic_edges(t);
+        if (edges.size() != 1ul)
+            return false;
+
+        const auto inp = layout->get_wire_inp_dirs(t, *edges.cbegin()), out = layout->get_wire_out_dirs(t, *edges.cbegin());
+
+        return m == layout::DIR_S ? (inp == layout::DIR_W && out == layout::DIR_E) :
+                                    (inp == layout::DIR_N && out == layout::DIR_S);
+    };
+
+    // relaxes all states at local position (x, y) entered by move m from state from with cost c
+    const auto enter = [&](const coord_t x, const coord_t y, const std::size_t m, const std::size_t c,
+                           const std::size_t from)
+    {
+        if (x >= width || y >= height)
+            return;
+
+        // target reached
+        if (x == width - 1 && y == height - 1)
+        {
+            if ((last & layout::opposite(moves[m])).any() && c < best_cost)
+            {
+                best_cost = c;
+                best_parent = from;
+            }
+            return;
+        }
+
+        const auto relax = [&cost, &parent](const std::size_t s, const std::size_t _c, const std::size_t _from)
+        {
+            if (_c < cost[s])
+            {
+                cost[s] = _c;
+                parent[s] = _from;
+            }
+        };
+
+        const tile t{a[X] + x, a[Y] + y, GROUND};
+        if (!is_occupied(t, ripped, blocked) &&
+            (layout->z() < 2 || !is_occupied(tile{t[X], t[Y], CROSSING}, ripped, blocked)))
+            relax(state(x, y, m, 0), c, from);
+        if (is_crossable(t, moves[m]))
+            relax(state(x, y, m, 1), c + 1, from);
+    };
+
+    for (auto m : iter::range(moves.size()))
+    {
+        if ((first & moves[m]).any())
+            enter(m == 0 ? 1ul : 0ul, m == 1 ? 1ul : 0ul, m, 0ul, start);
+    }
+
+    // all moves lead eastwards or southwards; hence, row-major order is topological
+    for (auto y : iter::range(height))
+    {
+        for (auto x : iter::range(width))
+        {
+            for (auto m : iter::range(moves.size()))
+            {
+                for (auto l : iter::range(2ul))
+                {
+                    const auto s = state(x, y, m, l);
+                    if (cost[s] == none)
+                        continue;
+
+                    for (auto n : iter::range(moves.size()))
+                    {
+                        // crossings have to be straight
+                        if (l == 1ul && n != m)
+                            continue;
+
+                        enter(x + (n == 0 ? 1 : 0), y + (n == 1 ? 1 : 0), n, cost[s], s);
+                    }
+                }
+            }
+        }
+    }
+
+    if (best_cost == none)
+        return std::nullopt;
+
+    // reconstruct the path backwards
+    std::vector<tile> path{b};
+    for (auto s = best_parent; s != start; s = parent[s])
+    {
+        const auto position = s / 4;
+        path.push_back(tile{a[X] + position % width, a[Y] + position / width, s % 2 == 0 ? GROUND : CROSSING});
+    }
+    path.push_back(a);
+
+    std::reverse(path.begin(), path.end());
+
+    return route{std::move(path), best_cost};
+}
+
+void layout_compaction::apply(const relocation& r, const gate_neighborhood& gn) noexcept
+{
+    const auto pi = layout->is_pi(gn.t), po = layout->is_po(gn.t);
+
+    // rip up the gate and all rerouted wire segments
+    std::vector<tile> ripped{gn.t};
+    for (auto i : iter::range(gn.inputs.size()))
+    {
+        const auto& path = gn.inputs[i].path;
+        ripped.insert(ripped.end(), path.cbegin() + static_cast<long>(r.inputs[i].junction) + 1, path.cend() - 1);
+    }
+    for (auto i : iter::range(gn.outputs.size()))
+    {
+        const auto& path = gn.outputs[i].path;
+        ripped.insert(ripped.end(), path.cbegin() + 1, path.cbegin() + static_cast<long>(r.outputs[i].junction));
+    }
+
+    for (const auto& t : ripped)
+        layout->clear_tile(t);
+
+    // wires crossing over ripped up ones are lowered to the ground layer
+    for (const auto& t : ripped)
+    {
+        if (t[Z] != GROUND || layout->z() < 2)
+            continue;
+
+        const tile c{t[X], t[Y], CROSSING};
+        if (layout->is_free_tile(c) || !layout->is_free_tile(t))
+            continue;
+
+        for (const auto& e : layout->get_logic_edges(c))
+        {
+            const auto inp = layout->get_wire_inp_dirs(c, e), out = layout->get_wire_out_dirs(c, e);
+            layout->assign_logic_edge(t, e);
+            layout->assign_wire_inp_dir(t, e, inp);
+            layout->assign_wire_out_dir(t, e, out);
+        }
+        layout->clear_tile(c);
+    }
+
+    // redirect the junctions; old directions are removed first in case a gate serves as multiple junctions
+    for (auto i : iter::range(gn.inputs.size()))
+    {
+        const auto& [e, path] = gn.inputs[i];
+        const auto& p = path[r.inputs[i].junction];
+
+        if (r.inputs[i].junction == 0ul)
+            redirect_gate(p, layout->get_bearing(p, path[1]), layout::DIR_NONE, false);
+        else
+            layout->assign_wire_out_dir(p, e, layout::DIR_NONE);
+    }
+    for (auto i : iter::range(gn.outputs.size()))
+    {
+        const auto& [e, path] = gn.outputs[i];
+        const auto& q = path[r.outputs[i].junction];
+
+        if (r.outputs[i].junction == path.size() - 1)
+            redirect_gate(q, layout->get_bearing(q, path[path.size() - 2]), layout::DIR_NONE, true);
+        else
+            layout->assign_wire_inp_dir(q, e, layout::DIR_NONE);
+    }
+
+    // place the gate at its new tile
+    layout->assign_logic_vertex(r.target, gn.v, pi, po);
+
+    // assigns the given connection's edge to all new tiles between its endpoints
+    const auto assign_wires = [this](const logic_network::edge& e, const std::vector<tile>& tiles)
+    {
+        for (auto k : iter::range(1ul, tiles.size() - 1))
+        {
+            layout->assign_logic_edge(tiles[k], e);
+            layout->assign_wire_inp_dir(tiles[k], e, layout->get_bearing(tiles[k], tiles[k - 1]));
+            layout->assign_wire_out_dir(tiles[k], e, layout->get_bearing(tiles[k], tiles[k + 1]));
+        }
+    };
+
+    for (auto i : iter::range(gn.inputs.size()))
+    {
+        const auto& e = gn.inputs[i].e;
+        const auto& [j, tiles] = r.inputs[i];
+        const auto& p = tiles.front();
+
+        if (j == 0ul)
+            redirect_gate(p, layout::DIR_NONE, layout->get_bearing(p, tiles[1]), false);
+        else
+            layout->assign_wire_out_dir(p, e, layout->get_bearing(p, tiles[1]));
+
+        assign_wires(e, tiles);
+        layout->assign_tile_inp_dir(r.target, layout->get_bearing(r.target, tiles[tiles.size() - 2]));
+    }
+    for (auto i : iter::range(gn.outputs.size()))
+    {
+        const auto& c = gn.outputs[i];
+        const auto& [j, tiles] = r.outputs[i];
+        const auto& q = tiles.back();
+
+        if (j == c.path.size() - 1)
+            redirect_gate(q, layout::DIR_NONE, layout->get_bearing(q, tiles[tiles.size() - 2]), true);
+        else
+            layout->assign_wire_inp_dir(q, c.e, layout->get_bearing(q, tiles[tiles.size() - 2]));
+
+        assign_wires(c.e, tiles);
+        layout->assign_tile_out_dir(r.target, layout->get_bearing(r.target, tiles[1]));
+    }
+}
+
+void layout_compaction::redirect_gate(const tile& t, const layout::directions d_old, const layout::directions d_new,
+                                      const bool inp) noexcept
+{
+    const auto dirs = ((inp ? layout->get_tile_inp_dirs(t) : layout->get_tile_out_dirs(t)) & ~d_old) | d_new;
+
+    if (inp)
+    {
+        layout->assign_tile_inp_dir(t, layout::DIR_NONE);
+        if (dirs.any())
+            layout->assign_tile_inp_dir(t, dirs);
+    }
+    else
+    {
+        layout->assign_tile_out_dir(t, layout::DIR_NONE);
+        if (dirs.any())
+            layout->assign_tile_out_dir(t, dirs);
+    }
+}
@@ -0,0 +1,298 @@
+//
+// Created by marcel on 19.10.26.
+//
+
+#ifndef FICTION_LAYOUT_COMPACTION_H
+#define FICTION_LAYOUT_COMPACTION_H
+
+
+#include "fcn_gate_layout.h"
+#include "directions.h"
+#include "incremental_design_checker.h"
+#include <mockturtle/utils/stopwatch.hpp>
+#include <nlohmann/json.hpp>
+#include <optional>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include <boost/functional/hash/hash.hpp>
+
+
+/**
+ * Post-placement compaction of 2DDWave-clocked gate layouts as generated, e.g., by orthogonal. Since information flows
+ * exclusively eastwards and southwards in 2DDWave, every path that only consists of such steps is legal with respect to
+ * the clocking. This allows for two kinds of area reduction that never need to consider clock numbers.
+ *
+ * Rows (columns) that only contain straight vertical (horizontal) wires or no elements at all can be deleted by moving
+ * all tiles south (east) of them one step north (west). All deletable rows and columns are identified in one scan over
+ * the assigned tiles and removed in a single rebuild of the layout.
+ *
+ * Gates are relocated towards the north-west. For each gate, all positions within a window of the given size to its
+ * north-west are evaluated. The wires connecting the gate are ripped up up to the closest tiles at which they can be
+ * rerouted and new monotone paths that may cross straight wires are determined via dynamic programming over the
+ * bounding boxes of the connections. Candidates are ranked by their distance to the north-western corner, their wire
+ * length, and their number of crossings. Since evaluations only read the layout, the best relocation of all gates is
+ * determined in parallel. Relocations are then applied one by one. Before a relocation is applied, an incremental
+ * legality check ensures that none of the tiles it read during its evaluation has been altered by a previously applied
+ * one. Otherwise, it is discarded and reevaluated in the next round.
+ *
+ * Both steps are repeated until neither of them yields an improvement. Since gates are only moved north-west, this
+ * process is guaranteed to converge. Each round runs in a transaction of the layout. Afterwards, an
+ * incremental_design_checker re-checks the modified tiles and the round is rolled back if it introduced design rule
+ * violations, in which case the compaction stops. Designated I/O pins located at the layout's borders stay there and tiles holding
+ * latches are left untouched to preserve the layout's timing.
+ */
+class layout_compaction
+{
+public:
+    /**
+     * Configures the compaction.
+     */
+    struct compaction_config
+    {
+        /**
+         * Flag to enable gate relocation. If disabled, only rows and columns are deleted.
+         */
+        bool relocate = true;
+        /**
+         * Maximum distance in tiles that a gate is moved westwards and northwards in a single relocation.
+         */
+        coord_t window = 6ul;
+        /**
+         * Maximum number of rounds of relocation and deletion. 0 means until convergence.
+         */
+        std::size_t max_rounds = 0ul;
+        /**
+         * Number of threads to evaluate relocations with. 0 means number of available threads.
+         */
+        std::size_t threads = 0ul;
+    };
+    /**
+     * Standard constructor.
+     *
+     * @param fgl 2DDWave-clocked gate layout to compact. It is modified in place.
+     * @param cfg Configuration of the compaction.
+     */
+    layout_compaction(fcn_gate_layout_ptr fgl, compaction_config cfg) noexcept;
+    /**
+     * Result type containing statistical information about the compaction.
+     */
+    struct compaction_result
+    {
+        /**
+         * Layout dimensions before and after the compaction.
+         */
+        coord_t x_before = 0ul, y_before = 0ul, x_after = 0ul, y_after = 0ul;
+        /**
+         * Number of wire tiles and crossings before and after the compaction.
+         */
+        std::size_t wires_before = 0ul, wires_after = 0ul, crossings_before = 0ul, crossings_after = 0ul;
+        /**
+         * Number of deleted rows and columns as well as applied relocations.
+         */
+        std::size_t deleted_rows = 0ul, deleted_columns = 0ul, relocations = 0ul;
+        /**
+         * Number of rounds performed.
+         */
+        std::size_t rounds = 0ul;
+        /**
+         * Number of rounds that were rolled back because they introduced design rule violations.
+         */
+        std::size_t rollbacks = 0ul;
+        /**
+         * Runtime of the compaction.
+         */
+        mockturtle::stopwatch<>::duration runtime{0};
+        /**
+         * Returns the result's information as JSON.
+         *
+         * @return JSON object containing all information.
+         */
+        nlohmann::json json() const;
+    };
+    /**
+     * Starts the compaction process.
+     *
+     * @return Result type containing statistical information about the process.
+     */
+    compaction_result operator()();
+
+private:
+    /**
+     * Gate layout to compact.
+     */
+    fcn_gate_layout_ptr layout;
+    /**
+     * Configuration of the compaction.
+     */
+    const compaction_config config;
+    /**
+     * Maximum number of tiles in the bounding box of a single connection that is rerouted. Keeps evaluations cheap if
+     * a wire can only be ripped up back to a gate that is located far away.
+     */
+    static constexpr coord_t max_route_area = 1ul << 14u;
+    /**
+     * Alias for a tile.
+     */
+    using tile = fcn_gate_layout::tile;
+    /**
+     * Alias for a hash set of tiles.
+     */
+    using tile_set = std::unordered_set<tile, boost::hash<tile>>;
+    /**
+     * Alias for a hash set of ground positions.
+     */
+    using ground_set = std::unordered_set<fcn_layout::ground, boost::hash<fcn_layout::ground>>;
+    /**
+     * A placed logic edge from its source gate tile to its target gate tile (both inclusive) with all wire tiles in
+     * between in order of information flow.
+     */
+    struct connection
+    {
+        logic_network::edge e;
+        std::vector<tile> path;
+    };
+    /**
+     * A gate tile together with all connections to and from it.
+     */
+    struct gate_neighborhood
+    {
+        tile t;
+        logic_network::vertex v;
+        std::vector<connection> inputs, outputs;
+        /**
+         * Flags to indicate that the gate must not leave its column or row respectively, e.g., because it is an I/O pin
+         * located at the layout's border.
+         */
+        bool fixed_x = false, fixed_y = false;
+    };
+    /**
+     * A connection rerouted by a relocation. The original path is kept up to (inputs) or from (outputs) the junction
+     * index and replaced by the given tiles otherwise. The new tiles include both endpoints, i.e., the junction tile
+     * and the new gate tile.
+     */
+    struct rerouted_connection
+    {
+        std::size_t junction;
+        std::vector<tile> tiles;
+    };
+    /**
+     * A possible relocation of a gate.
+     */
+    struct relocation
+    {
+        /**
+         * Index of the gate's neighborhood.
+         */
+        std::size_t gate;
+        /**
+         * New tile of the gate.
+         */
+        tile target;
+        /**
+         * Rerouted connections in the same order as the neighborhood's inputs and outputs.
+         */
+        std::vector<rerouted_connection> inputs, outputs;
+        /**
+         * Number of wire tiles and crossings of all connections of the gate after the relocation.
+         */
+        std::size_t wires, crossings;
+        /**
+         * Ground positions whose state has been read during the evaluation.
+         */
+        std::vector<fcn_layout::ground> footprint;
+    };
+    /**
+     * A new monotone path together with the number of crossings it uses.
+     */
+    using route = std::pair<std::vector<tile>, std::size_t>;
+    /**
+     * Deletes all rows and columns that only contain straight wires or no elements at all in a single rebuild.
+     *
+     * @param result Result to count the deleted rows and columns in.
+     * @return True, iff any row or column has been deleted.
+     */
+    bool delete_rows_and_columns(compaction_result& result) noexcept;
+    /**
+     * Performs one round of gate relocation, i.e., evaluates all gates in parallel and applies the legal relocations.
+     *
+     * @param result Result to count the applied relocations in.
+     * @return True, iff any gate has been relocated.
+     */
+    bool relocate_gates(compaction_result& result);
+    /**
+     * Determines all connections to and from each gate in the ground layer.
+     *
+     * @return Neighborhoods of all gates.
+     */
+    std::vector<gate_neighborhood> gather_neighborhoods() const noexcept;
+    /**
+     * Evaluates all positions in the window north-west of the given gate and returns the best relocation if any.
+     *
+     * @param gn Neighborhood of the gate.
+     * @param index Index of gn.
+     * @return Best relocation of the gate or std::nullopt if it cannot be moved.
+     */
+    std::optional<relocation> evaluate(const gate_neighborhood& gn, const std::size_t index) const noexcept;
+    /**
+     * Evaluates the relocation of the given gate to the given tile.
+     *
+     * @param gn Neighborhood of the gate.
+     * @param target New tile of the gate.
+     * @return Relocation if all connections can be rerouted, std::nullopt otherwise.
+     */
+    std::optional<relocation> evaluate(const gate_neighborhood& gn, const tile& target) const noexcept;
+    /**
+     * Checks whether the direction of information flow of the given tile of a path can be altered, i.e., whether a
+     * connection can be rerouted at it. That is the case for gate tiles and for ground tiles holding a single wire with
+     * nothing above.
+     *
+     * @param t Tile to check.
+     * @return True, iff t can serve as a junction.
+     */
+    bool is_junction(const tile& t) const noexcept;
+    /**
+     * Determines a monotone path from tile a to tile b that uses as few crossings as possible. Intermediate tiles can
+     * either be free ground tiles or crossing tiles above straight wires that run perpendicular to the path.
+     *
+     * @param a Start tile.
+     * @param b End tile.
+     * @param first Directions in which the path may leave a.
+     * @param last Directions from which the path may enter b.
+     * @param ripped Tiles that are considered free.
+     * @param blocked Tiles that are considered occupied.
+     * @return Path from a to b (both inclusive) and its number of crossings or std::nullopt if there is none.
+     */
+    std::optional<route> find_route(const tile& a, const tile& b, const layout::directions first,
+                                    const layout::directions last, const tile_set& ripped,
+                                    const tile_set& blocked) const noexcept;
+    /**
+     * Checks whether the given tile is occupied with respect to the tiles of a relocation.
+     *
+     * @param t Tile to check.
+     * @param ripped Tiles that are considered free.
+     * @param blocked Tiles that are considered occupied.
+     * @return True, iff t is occupied.
+     */
+    bool is_occupied(const tile& t, const tile_set& ripped, const tile_set& blocked) const noexcept;
+    /**
+     * Applies the given relocation to the layout.
+     *
+     * @param r Relocation to apply.
+     * @param gn Neighborhood of the relocated gate.
+     */
+    void apply(const relocation& r, const gate_neighborhood& gn) noexcept;
+    /**
+     * Replaces the directions d_old in the tile directions of gate tile t by d_new.
+     *
+     * @param t Gate tile.
+     * @param d_old Directions to remove.
+     * @param d_new Directions to add.
+     * @param inp Flag to indicate that input directions should be altered. Output directions are altered otherwise.
+     */
+    void redirect_gate(const tile& t, const layout::directions d_old, const layout::directions d_new,
+                       const bool inp) noexcept;
+};
+
+
+#endif //FICTION_LAYOUT_COMPACTION_H
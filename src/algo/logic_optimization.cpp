@@ -0,0 +1,233 @@
+//
+// Created by marcel on 19.10.26.
+//
+
+#include "logic_optimization.h"
+#include <mockturtle/algorithms/cleanup.hpp>
+#include <mockturtle/algorithms/cut_rewriting.hpp>
+#include <mockturtle/algorithms/mig_algebraic_rewriting.hpp>
+#include <mockturtle/algorithms/mig_resub.hpp>
+#include <mockturtle/algorithms/node_resynthesis/akers.hpp>
+#include <mockturtle/algorithms/node_resynthesis/mig_npn.hpp>
+#include <mockturtle/algorithms/refactoring.hpp>
+#include <mockturtle/views/depth_view.hpp>
+#include <mockturtle/views/fanout_view.hpp>
+#include <functional>
+#include <utility>
+
+
+namespace
+{
+    /**
+     * Node cost function for cut rewriting and refactoring. Each gate is charged with its complemented fan-ins as they
+     * become inverter vertices. If desired, MAJ gates are charged so high that no replacement containing one is ever
+     * considered beneficial.
+     */
+    struct fcn_node_cost
+    {
+        bool penalize_maj = false;
+
+        template <class Ntk>
+        uint32_t operator()(const Ntk& ntk, const typename Ntk::node& n) const
+        {
+            auto cost = 1u;
+            auto constant = false;
+
+            ntk.foreach_fanin(n, [&](const auto& f)
+            {
+                if (ntk.is_constant(ntk.get_node(f)))
+                    constant = true;
+                else if (ntk.is_complemented(f))
+                    ++cost;
+            });
+
+            if (penalize_maj && !constant)
+                cost += 1000u;
+
+            return cost;
+        }
+    };
+}
+
+
+logic_optimizer::logic_optimizer(logic_network_ptr ln, optimizer_config config) noexcept
+        :
+        network{std::move(ln)},
+        config{config}
+{}
+
+logic_optimizer::optimization_result logic_optimizer::operator()()
+{
+    optimization_result result{};
+
+    {
+        mockturtle::stopwatch stop{result.runtime};
+
+        // deep copy without names; they are re-attached in the end
+        auto best = mockturtle::cleanup_dangling<logic_network::mig_nt, mockturtle::mig_network>(network->get_mig());
+        auto best_cost = result.before = cost(best);
+
+        // do not introduce MAJ gates into AOIGs unless explicitly allowed
+        const fcn_node_cost cost_fn{!config.allow_maj && result.before.maj == 0ul};
+
+        mockturtle::mig_npn_resynthesis npn_resyn{};
+        mockturtle::akers_resynthesis<mockturtle::mig_network> akers_resyn{};
+
+        using pass = std::pair<std::string, std::function<mockturtle::mig_network(const mockturtle::mig_network&)>>;
+        std::vector<pass> passes{};
+
+        if (config.balance)
+        {
+            passes.emplace_back("balance", [](const mockturtle::mig_network& mig)
+            {
+                auto copy = mockturtle::cleanup_dangling(mig);
+                mockturtle::depth_view<mockturtle::mig_network> depth_mig{copy};
+
+                mockturtle::mig_algebraic_depth_rewriting_params ps{};
+                ps.allow_area_increase = false;
+                mockturtle::mig_algebraic_depth_rewriting(depth_mig, ps);
+
+                return mockturtle::cleanup_dangling(copy);
+            });
+        }
+        if (config.resubstitute)
+        {
+            passes.emplace_back("resubstitute", [](const mockturtle::mig_network& mig)
+            {
+                auto copy = mockturtle::cleanup_dangling(mig);
+                mockturtle::fanout_view<mockturtle::mig_network> fanout_mig{copy};
+                mockturtle::depth_view<mockturtle::fanout_view<mockturtle::mig_network>> resub_mig{fanout_mig};
+
+                mockturtle::mig_resubstitution(resub_mig);
+
+                return mockturtle::cleanup_dangling(copy);
+            });
+        }
+        if (config.rewrite)
+        {
+            passes.emplace_back("rewrite", [&npn_resyn, &cost_fn](const mockturtle::mig_network& mig)
+            {
+                mockturtle::cut_rewriting_params ps{};
+                ps.cut_enumeration_ps.cut_size = 4u;
+
+                return mockturtle::cleanup_dangling(mockturtle::cut_rewriting(mig, npn_resyn, ps, nullptr, cost_fn));
+            });
+        }
+        if (config.refactor)
+        {
+            passes.emplace_back("refactor", [&akers_resyn, &cost_fn](const mockturtle::mig_network& mig)
+            {
+                auto copy = mockturtle::cleanup_dangling(mig);
+                mockturtle::refactoring(copy, akers_resyn, {}, nullptr, cost_fn);
+
+                return mockturtle::cleanup_dangling(copy);
+            });
+        }
+
+        for (const auto& p : passes)
+            result.accepted[p.first] = 0ul;
+
+        for (auto improved = !passes.empty();
+             improved && (config.max_rounds == 0ul || result.rounds < config.max_rounds); ++result.rounds)
+        {
+            improved = false;
+
+            for (const auto& [name, apply] : passes)
+            {
+                auto candidate = apply(best);
+                const auto candidate_cost = cost(candidate);
+
+                if (cost_fn.penalize_maj && candidate_cost.maj > 0ul)
+                    continue;
+
+                const auto total = candidate_cost.total(config.fan_out_weight),
+                           best_total = best_cost.total(config.fan_out_weight);
+
+                // ties are broken by depth which keeps the sequence of accepted results strictly decreasing
+                if (total < best_total || (total == best_total && candidate_cost.depth < best_cost.depth))
+                {
+                    best = std::move(candidate);
+                    best_cost = candidate_cost;
+                    result.accepted[name] = result.accepted[name].get<std::size_t>() + 1ul;
+                    improved = true;
+                }
+            }
+        }
+
+        result.after = best_cost;
+        result.network = std::make_shared<logic_network>(restore_names(best), network->get_name());
+    }
+
+    return result;
+}
+
+logic_optimizer::fcn_cost logic_optimizer::cost(const mockturtle::mig_network& mig) noexcept
+{
+    fcn_cost c{};
+
+    // number of outgoing edges per node in the rebuilt logic network
+    std::vector<std::size_t> out_degree(mig.size(), 0ul);
+    const auto count_edge = [&mig, &c, &out_degree](const auto& f)
+    {
+        ++out_degree[mig.node_to_index(mig.get_node(f))];
+        // each complemented edge becomes an inverter vertex of its own
+        if (mig.is_complemented(f))
+            ++c.inverters;
+    };
+
+    mig.foreach_gate([&](const auto& n)
+    {
+        ++c.gates;
+
+        auto constant = false;
+        mig.foreach_fanin(n, [&](const auto& f)
+        {
+            if (mig.is_constant(mig.get_node(f)))
+                constant = true;
+            else
+                count_edge(f);
+        });
+
+        if (!constant)
+            ++c.maj;
+    });
+    mig.foreach_po([&](const auto& f)
+    {
+        // constant outputs are omitted by logic_network
+        if (!mig.is_constant(mig.get_node(f)))
+            count_edge(f);
+    });
+
+    for (const auto d : out_degree)
+    {
+        if (d > 1ul)
+            c.fan_outs += d - 1ul;
+    }
+
+    c.depth = mockturtle::depth_view<mockturtle::mig_network>{mig}.depth();
+
+    return c;
+}
+
+logic_network::mig_nt logic_optimizer::restore_names(const mockturtle::mig_network& mig) const noexcept
+{
+    const auto& spec = network->get_mig();
+    logic_network::mig_nt named{};
+
+    // port names as assigned by logic_network
+    std::vector<logic_network::mig_nt::signal> pis{};
+    auto pi_c = 0ul;
+    spec.foreach_pi([&](const auto& pi)
+    {
+        const auto s = spec.make_signal(pi);
+        pis.push_back(named.create_pi(spec.has_name(s) ? spec.get_name(s) : fmt::format("pi{}", pi_c++)));
+    });
+
+    const auto outputs = mockturtle::cleanup_dangling(mig, named, pis.begin(), pis.end());
+
+    auto po_c = 0ul;
+    for (auto i = 0u; i < outputs.size(); ++i)
+        named.create_po(outputs[i], spec.has_output_name(i) ? spec.get_output_name(i) : fmt::format("po{}", po_c++));
+
+    return named;
+}
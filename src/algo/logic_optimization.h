@@ -0,0 +1,146 @@
+//
+// Created by marcel on 19.10.26.
+//
+
+#ifndef FICTION_LOGIC_OPTIMIZATION_H
+#define FICTION_LOGIC_OPTIMIZATION_H
+
+#include "logic_network.h"
+#include <mockturtle/networks/mig.hpp>
+#include <mockturtle/utils/stopwatch.hpp>
+#include <nlohmann/json.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+/**
+ * Optimizes logic networks before physical design. Layout area as well as the runtime of exact physical design are
+ * driven by the number of vertices a logic network consists of. Other than in conventional technologies, inverters and
+ * fan-outs are not for free in FCN but occupy tiles of their own. Furthermore, each fan-out opens up a path that is
+ * likely to cross others. Node count alone is therefore a poor objective.
+ *
+ * This optimizer runs mockturtle's depth-oriented algebraic rewriting, resubstitution, cut rewriting, and cut-based
+ * refactoring on the MIG a logic network was created from. Each pass works on a copy and its result is only accepted if
+ * it lowers the FCN cost, i.e., the weighted number of gate, inverter, and fan-out vertices the rebuilt logic network
+ * would consist of. Passes are repeated until a round does not yield any improvement. If the original network is an
+ * AOIG, results containing MAJ gates are rejected by default such that physical design approaches that cannot handle
+ * them, e.g., orthogonal, remain applicable.
+ */
+class logic_optimizer
+{
+public:
+    /**
+     * Configures the optimization passes.
+     */
+    struct optimizer_config
+    {
+        /**
+         * Flags to enable the single passes.
+         */
+        bool balance = true, resubstitute = true, rewrite = true, refactor = true;
+        /**
+         * Allow MAJ gates in the result even if the original network is an AOIG.
+         */
+        bool allow_maj = false;
+        /**
+         * Maximum number of rounds in which all enabled passes are applied. 0 means until convergence.
+         */
+        std::size_t max_rounds = 0ul;
+        /**
+         * Weight of fan-out vertices in the FCN cost. Since each fan-out potentially causes wire crossings, it is
+         * weighted higher than gates and inverters by default.
+         */
+        std::size_t fan_out_weight = 2ul;
+    };
+    /**
+     * Number of vertices of a logic network rebuilt from an MIG divided by their kind. Fan-outs are counted as if
+     * substituted by fan-out vertices of degree 2.
+     */
+    struct fcn_cost
+    {
+        std::size_t gates = 0ul, maj = 0ul, inverters = 0ul, fan_outs = 0ul;
+        /**
+         * Number of levels of the MIG.
+         */
+        uint32_t depth = 0u;
+        /**
+         * Weighted sum of all vertices.
+         *
+         * @param fan_out_weight Weight of fan-out vertices.
+         * @return FCN cost.
+         */
+        std::size_t total(const std::size_t fan_out_weight) const noexcept
+        {
+            return gates + inverters + fan_out_weight * fan_outs;
+        }
+    };
+    /**
+     * Standard constructor.
+     *
+     * @param ln Logic network to optimize. It is not altered.
+     * @param config Configuration of the passes.
+     */
+    explicit logic_optimizer(logic_network_ptr ln, optimizer_config config = {}) noexcept;
+    /**
+     * Encapsulates the resulting information.
+     */
+    struct optimization_result
+    {
+        /**
+         * Optimized logic network. Contains a copy of the original one if no pass was successful.
+         */
+        logic_network_ptr network;
+        /**
+         * FCN costs before and after the optimization.
+         */
+        fcn_cost before, after;
+        /**
+         * Number of rounds performed.
+         */
+        std::size_t rounds = 0ul;
+        /**
+         * Number of accepted results per pass.
+         */
+        nlohmann::json accepted{};
+        /**
+         * Stores the runtime.
+         */
+        mockturtle::stopwatch<>::duration runtime{0};
+    };
+    /**
+     * Performs the optimization.
+     *
+     * @return Result container.
+     */
+    optimization_result operator()();
+    /**
+     * Computes the FCN cost of the given MIG.
+     *
+     * @param mig MIG whose cost is desired.
+     * @return FCN cost of mig.
+     */
+    static fcn_cost cost(const mockturtle::mig_network& mig) noexcept;
+
+private:
+    /**
+     * Logic network to optimize.
+     */
+    logic_network_ptr network;
+    /**
+     * Configuration of the passes.
+     */
+    const optimizer_config config;
+    /**
+     * Rebuilds a named MIG from an optimized one by re-attaching the I/O names of the original network. Passes do not
+     * alter the order of I/Os.
+     *
+     * @param mig Optimized MIG.
+     * @return mig with port names of the original network.
+     */
+    logic_network::mig_nt restore_names(const mockturtle::mig_network& mig) const noexcept;
+};
+
+
+#endif //FICTION_LOGIC_OPTIMIZATION_H
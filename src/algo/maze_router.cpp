@@ -0,0 +1,411 @@
+//
+// Created by marcel on 19.10.26.
+//
+
+#include "maze_router.h"
+#include <algorithm>
+
+
+maze_router::maze_router(fcn_gate_layout_ptr fgl, router_config cfg) noexcept
+        :
+        layout{std::move(fgl)},
+        config{cfg}
+{}
+
+maze_router::maze_router(fcn_gate_layout_ptr fgl) noexcept
+        :
+        maze_router(std::move(fgl), router_config{})
+{}
+
+std::optional<maze_router::routing_path>
+maze_router::find_path(const fcn_gate_layout::tile& source, const fcn_gate_layout::tile& target) noexcept
+{
+    mockturtle::stopwatch stop{statistics.runtime};
+
+    auto path = search(source, target);
+
+    ++statistics.searches;
+    if (path)
+        ++statistics.paths;
+
+    return path;
+}
+
+const maze_router::router_statistics& maze_router::get_statistics() const noexcept
+{
+    return statistics;
+}
+
+std::optional<maze_router::routing_path>
+maze_router::search(const fcn_gate_layout::tile& source, const fcn_gate_layout::tile& target) noexcept
+{
+    if (source == target)
+        return std::nullopt;
+
+    prepare();
+
+    const auto src = to_index(source), dst = to_index(target);
+    const fcn_gate_layout::tile target_ground{target[X], target[Y], GROUND};
+
+    // manhattan distance in the ground layer never overestimates since every step changes x or y by exactly one
+    const auto heuristic = [this, &target_ground](const fcn_gate_layout::tile& t)
+    {
+        return static_cast<std::uint32_t>(layout->manhattan_distance(fcn_gate_layout::tile{t[X], t[Y], GROUND},
+                                                                     target_ground));
+    };
+
+    const auto visit = [this, &heuristic](const fcn_gate_layout::tile& t, const search_index i, const std::uint32_t c,
+                                          const search_index p, const fcn_layout::latch_delay l)
+    {
+        if (closed[i] == generation || (stamp[i] == generation && cost[i] <= c))
+            return;
+
+        stamp[i]        = generation;
+        cost[i]         = c;
+        parent[i]       = p;
+        parent_latch[i] = l;
+
+        open.push(c + heuristic(t), i);
+    };
+
+    const auto top_layer = config.crossings && layout->z() > 1 ? CROSSING : GROUND;
+
+    // paths must not leave the bounding box of source and target by more than the margin
+    const auto within_margin = [this, &source, &target](const fcn_gate_layout::tile& t)
+    {
+        if (!config.margin)
+            return true;
+
+        const auto m = *config.margin;
+        const auto in_range = [m](const coord_t c, const coord_t a, const coord_t b)
+        {
+            return c + m >= std::min(a, b) && c <= std::max(a, b) + m;
+        };
+
+        return in_range(t[X], source[X], target[X]) && in_range(t[Y], source[Y], target[Y]);
+    };
+
+    visit(source, src, 0u, no_parent, 0u);
+
+    while (!open.empty())
+    {
+        const auto i = open.pop().second;
+        if (closed[i] == generation)
+            continue;
+
+        closed[i] = generation;
+
+        // target reached; reconstruct the path backwards
+        if (i == dst)
+        {
+            routing_path p{};
+            for (auto j = dst; j != no_parent; j = parent[j])
+            {
+                const auto t = to_tile(j);
+                p.tiles.push_back(t);
+
+                if (j != src && j != dst && t[Z] != GROUND)
+                    ++p.crossings;
+                if (parent_latch[j] != 0u)
+                    p.latches.emplace_back(to_tile(parent[j]), parent_latch[j]);
+            }
+
+            std::reverse(p.tiles.begin(), p.tiles.end());
+
+            return p;
+        }
+
+        const auto t = to_tile(i);
+        // new ground wire tiles can hold latches; crossing tiles would delay the wires below as well
+        const auto latchable = config.latches && i != src && t[Z] == GROUND;
+        // crossing tiles have to be left in the direction they were entered from
+        const auto straight = t[Z] != GROUND ? layout->get_bearing(to_tile(parent[i]), t) : layout::DIR_NONE;
+
+        for (const auto& g : layout->surrounding_2d(fcn_gate_layout::tile{t[X], t[Y], GROUND}))
+        {
+            for (auto z = GROUND; z <= top_layer; ++z)
+            {
+                const fcn_gate_layout::tile n{g[X], g[Y], z};
+                const auto d = layout->get_bearing(t, n);
+
+                if (t[Z] != GROUND && d != straight)
+                    continue;
+                // directions can only be used once per gate
+                if (i == src && (used_dirs(source) & d).any())
+                    continue;
+
+                const auto j = to_index(n);
+                if (j == dst)
+                {
+                    if ((used_dirs(target) & layout::opposite(d)).any())
+                        continue;
+                }
+                else if (!within_margin(n) || !is_passable(t, n))
+                    continue;
+
+                if (const auto l = required_latch(t, n, latchable); l)
+                {
+                    const auto c = cost[i] + 1u + (j != dst && z != GROUND ? config.crossing_cost : 0u) +
+                                   (*l != 0u ? config.latch_cost : 0u);
+
+                    visit(n, j, c, i, *l);
+                }
+            }
+        }
+    }
+
+    return std::nullopt;
+}
+
+void maze_router::assign_path(const routing_path& p, const logic_network::edge& e) noexcept
+{
+    const auto& tiles = p.tiles;
+
+    for (auto k = 1ul; k < tiles.size() - 1; ++k)
+    {
+        layout->assign_logic_edge(tiles[k], e);
+        layout->assign_wire_inp_dir(tiles[k], e, layout->get_bearing(tiles[k], tiles[k - 1]));
+        layout->assign_wire_out_dir(tiles[k], e, layout->get_bearing(tiles[k], tiles[k + 1]));
+    }
+
+    layout->assign_tile_out_dir(tiles.front(), layout->get_bearing(tiles.front(), tiles[1]));
+    layout->assign_tile_inp_dir(tiles.back(), layout->get_bearing(tiles.back(), tiles[tiles.size() - 2]));
+
+    for (const auto& [t, l] : p.latches)
+        layout->assign_latch(t, l);
+}
+
+std::vector<std::pair<logic_network::edge, fcn_gate_layout::tile>> maze_router::rip_up(const routing_path& p) noexcept
+{
+    const auto& tiles = p.tiles;
+    std::vector<std::pair<logic_network::edge, fcn_gate_layout::tile>> lowered{};
+
+    for (auto k = 1ul; k < tiles.size() - 1; ++k)
+    {
+        // latches belong to the whole stack and have to survive the removal of crossing wires
+        const auto l = layout->get_latch(tiles[k]);
+        layout->clear_tile(tiles[k]);
+        if (tiles[k][Z] != GROUND && l != 0u)
+            layout->assign_latch(tiles[k], l);
+    }
+
+    // wires crossing over ripped up ones are lowered to the ground layer
+    for (auto k = 1ul; k < tiles.size() - 1; ++k)
+    {
+        const auto& t = tiles[k];
+        if (t[Z] != GROUND || layout->z() < 2)
+            continue;
+
+        const fcn_gate_layout::tile c{t[X], t[Y], CROSSING};
+        if (layout->is_free_tile(c))
+            continue;
+
+        for (const auto& e : layout->get_logic_edges(c))
+        {
+            const auto inp = layout->get_wire_inp_dirs(c, e), out = layout->get_wire_out_dirs(c, e);
+            layout->assign_logic_edge(t, e);
+            layout->assign_wire_inp_dir(t, e, inp);
+            layout->assign_wire_out_dir(t, e, out);
+            lowered.emplace_back(e, t);
+        }
+        layout->clear_tile(c);
+    }
+
+    // remove the path's directions from its endpoints
+    const auto remove_dir = [this](const fcn_gate_layout::tile& t, const layout::directions d, const bool inp)
+    {
+        const auto dirs = (inp ? layout->get_tile_inp_dirs(t) : layout->get_tile_out_dirs(t)) & ~d;
+
+        if (inp)
+        {
+            layout->assign_tile_inp_dir(t, layout::DIR_NONE);
+            if (dirs.any())
+                layout->assign_tile_inp_dir(t, dirs);
+        }
+        else
+        {
+            layout->assign_tile_out_dir(t, layout::DIR_NONE);
+            if (dirs.any())
+                layout->assign_tile_out_dir(t, dirs);
+        }
+    };
+
+    remove_dir(tiles.front(), layout->get_bearing(tiles.front(), tiles[1]), false);
+    remove_dir(tiles.back(), layout->get_bearing(tiles.back(), tiles[tiles.size() - 2]), true);
+
+    return lowered;
+}
+
+void maze_router::block(const fcn_gate_layout::tile& t) noexcept
+{
+    overlay[t] = overlay_state::BLOCKED;
+}
+
+void maze_router::block(const routing_path& p) noexcept
+{
+    const auto& tiles = p.tiles;
+
+    for (auto k = 1ul; k < tiles.size() - 1; ++k)
+        block(tiles[k]);
+
+    dir_overlays[tiles.front()].used |= layout->get_bearing(tiles.front(), tiles[1]);
+    dir_overlays[tiles.back()].used  |= layout->get_bearing(tiles.back(), tiles[tiles.size() - 2]);
+}
+
+void maze_router::release(const fcn_gate_layout::tile& t) noexcept
+{
+    overlay[t] = overlay_state::RELEASED;
+}
+
+void maze_router::release(const routing_path& p) noexcept
+{
+    const auto& tiles = p.tiles;
+
+    for (auto k = 1ul; k < tiles.size() - 1; ++k)
+    {
+        const auto& t = tiles[k];
+
+        // rip_up lowers wires of other paths onto ground tiles below them
+        if (t[Z] == GROUND && layout->z() > 1)
+        {
+            const fcn_gate_layout::tile c{t[X], t[Y], CROSSING};
+            if (!layout->is_free_tile(c) && std::find(tiles.cbegin(), tiles.cend(), c) == tiles.cend())
+                continue;
+        }
+
+        release(t);
+    }
+
+    dir_overlays[tiles.front()].released |= layout->get_bearing(tiles.front(), tiles[1]);
+    dir_overlays[tiles.back()].released  |= layout->get_bearing(tiles.back(), tiles[tiles.size() - 2]);
+}
+
+void maze_router::clear_overlay() noexcept
+{
+    overlay.clear();
+    dir_overlays.clear();
+}
+
+bool maze_router::is_free(const fcn_gate_layout::tile& t) const noexcept
+{
+    if (const auto o = get_overlay(t); o)
+        return *o == overlay_state::RELEASED;
+
+    return layout->is_free_tile(t);
+}
+
+std::optional<maze_router::routing_path>
+maze_router::route(const fcn_gate_layout::tile& source, const fcn_gate_layout::tile& target,
+                   const logic_network::edge& e) noexcept
+{
+    auto p = find_path(source, target);
+    if (p)
+        assign_path(*p, e);
+
+    return p;
+}
+
+void maze_router::prepare() noexcept
+{
+    if (layout->x() != x_size || layout->y() != y_size || layout->z() != z_size)
+    {
+        x_size = layout->x();
+        y_size = layout->y();
+        z_size = layout->z();
+
+        const auto size = static_cast<std::size_t>(x_size * y_size * z_size);
+        stamp.assign(size, 0u);
+        closed.assign(size, 0u);
+        cost.resize(size);
+        parent.resize(size);
+        parent_latch.resize(size);
+        generation = 0u;
+    }
+
+    open.clear();
+
+    // stamps would become ambiguous after an overflow
+    if (++generation == 0u)
+    {
+        std::fill(stamp.begin(), stamp.end(), 0u);
+        std::fill(closed.begin(), closed.end(), 0u);
+        generation = 1u;
+    }
+}
+
+maze_router::search_index maze_router::to_index(const fcn_gate_layout::tile& t) const noexcept
+{
+    return static_cast<search_index>((t[Z] * y_size + t[Y]) * x_size + t[X]);
+}
+
+fcn_gate_layout::tile maze_router::to_tile(const search_index i) const noexcept
+{
+    return fcn_gate_layout::tile{i % x_size, (i / x_size) % y_size, i / (x_size * y_size)};
+}
+
+layout::directions maze_router::used_dirs(const fcn_gate_layout::tile& t) const noexcept
+{
+    auto dirs = layout->get_tile_inp_dirs(t) | layout->get_tile_out_dirs(t);
+
+    if (const auto it = dir_overlays.find(t); it != dir_overlays.cend())
+        dirs = (dirs & ~it->second.released) | it->second.used;
+
+    return dirs;
+}
+
+std::optional<maze_router::overlay_state> maze_router::get_overlay(const fcn_gate_layout::tile& t) const noexcept
+{
+    if (const auto it = overlay.find(t); it != overlay.cend())
+        return it->second;
+
+    return std::nullopt;
+}
+
+bool maze_router::is_passable(const fcn_gate_layout::tile& from, const fcn_gate_layout::tile& t) const noexcept
+{
+    if (!is_free(t))
+        return false;
+
+    if (t[Z] == GROUND)
+        return true;
+
+    // crossings are only possible above wires that are neither ripped up nor pending
+    const fcn_gate_layout::tile below{t[X], t[Y], GROUND};
+    if (!layout->is_wire_tile(below) || layout->is_gate_tile(below) || get_overlay(below))
+        return false;
+
+    // the wires below must not run along the path
+    const auto d = layout->get_bearing(from, t);
+    const auto axis = d | layout::opposite(d);
+    for (const auto& e : layout->get_logic_edges(below))
+    {
+        if (((layout->get_wire_inp_dirs(below, e) | layout->get_wire_out_dirs(below, e)) & axis).any())
+            return false;
+    }
+
+    return true;
+}
+
+std::optional<fcn_layout::latch_delay>
+maze_router::required_latch(const fcn_gate_layout::tile& t, const fcn_gate_layout::tile& n,
+                            const bool latchable) const noexcept
+{
+    if (layout->is_outgoing_clocked(t, n))
+        return 0u;
+
+    if (!latchable || layout->get_latch(t) != 0u)
+        return std::nullopt;
+
+    const auto ct = layout->tile_clocking(t), cn = layout->tile_clocking(n);
+    if (!ct || !cn)
+        return std::nullopt;
+
+    // latch l satisfies (ct + l + 1) mod num_clocks == cn
+    const auto num_clocks = static_cast<unsigned>(layout->num_clocks());
+    const auto l = (static_cast<unsigned>(*cn) + 2u * num_clocks - static_cast<unsigned>(*ct) - 1u) % num_clocks;
+
+    if (l == 0u)
+        return std::nullopt;
+
+    return static_cast<fcn_layout::latch_delay>(l);
+}
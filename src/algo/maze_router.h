@@ -0,0 +1,339 @@
+//
+// Created by marcel on 19.10.26.
+//
+
+#ifndef FICTION_MAZE_ROUTER_H
+#define FICTION_MAZE_ROUTER_H
+
+
+#include "fcn_gate_layout.h"
+#include "radix_heap.h"
+#include "directions.h"
+#include <mockturtle/utils/stopwatch.hpp>
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <boost/functional/hash/hash.hpp>
+
+
+/**
+ * Clocking-aware A* maze router that connects placed tiles of a gate layout via wire tiles. It can be used to route
+ * single logic edges between fixed gate positions, e.g., as the routing backend of heuristic placers.
+ *
+ * Paths only step from a tile to one of its outgoing_clocked_tiles, which makes them valid under any clocking scheme
+ * including irregular ones and respects previously assigned latches. Free ground tiles are used as regular wires. If
+ * the layout has a crossing layer, a path may additionally pass straight over a ground tile holding wires that do not
+ * run in the path's direction, as long as the tile above it in the CROSSING layer is free. Optionally, the router may
+ * assign latches to its own new wire tiles to reach neighbors whose clock number would otherwise not allow data flow.
+ *
+ * The search's cost of a path is its number of tiles plus configurable penalties for crossings and latches. The
+ * manhattan_metric of grid_graph projected onto the ground layer serves as a consistent heuristic. Since keys are
+ * therefore monotone, the open list is kept in a radix_heap. Costs, parents, and visited flags are stored in arrays
+ * that are allocated once per layout size and invalidated in constant time via generation stamps, so that routing many
+ * nets does not cause any allocations.
+ *
+ * Several nets can be evaluated without modifying the layout by blocking the tiles of found paths and releasing the
+ * tiles of paths that are about to be ripped up in an overlay that is only visible to this router.
+ *
+ * A maze_router object keeps search state and must not be shared between threads. Use one object per thread instead.
+ */
+class maze_router
+{
+public:
+    /**
+     * Configures the router.
+     */
+    struct router_config
+    {
+        /**
+         * Flag to allow paths to use the crossing layer.
+         */
+        bool crossings = true;
+        /**
+         * Flag to allow paths to assign latches to their wire tiles.
+         */
+        bool latches = false;
+        /**
+         * Additional cost of a crossing tile.
+         */
+        std::uint32_t crossing_cost = 2u;
+        /**
+         * Additional cost of a latch.
+         */
+        std::uint32_t latch_cost = 4u;
+        /**
+         * Maximum distance in tiles by which paths may leave the bounding box of their source and target. Unbounded if
+         * not set.
+         */
+        std::optional<coord_t> margin = std::nullopt;
+    };
+    /**
+     * A routed path between two tiles.
+     */
+    struct routing_path
+    {
+        /**
+         * Tiles from source to target (both inclusive) in order of information flow.
+         */
+        std::vector<fcn_gate_layout::tile> tiles{};
+        /**
+         * Latches to assign to wire tiles of the path.
+         */
+        std::vector<std::pair<fcn_gate_layout::tile, fcn_layout::latch_delay>> latches{};
+        /**
+         * Number of crossing tiles in the path.
+         */
+        std::size_t crossings = 0ul;
+    };
+    /**
+     * Statistics about all searches of a router.
+     */
+    struct router_statistics
+    {
+        /**
+         * Number of calls to find_path (including the ones by route) and number of them that found a path.
+         */
+        std::size_t searches = 0ul, paths = 0ul;
+        /**
+         * Accumulated runtime of all searches.
+         */
+        mockturtle::stopwatch<>::duration runtime{0};
+    };
+    /**
+     * Standard constructor.
+     *
+     * @param fgl Gate layout to route in.
+     * @param cfg Configuration of the router.
+     */
+    maze_router(fcn_gate_layout_ptr fgl, router_config cfg) noexcept;
+    /**
+     * Standard constructor using the default configuration.
+     *
+     * @param fgl Gate layout to route in.
+     */
+    explicit maze_router(fcn_gate_layout_ptr fgl) noexcept;
+    /**
+     * Determines a cheapest path from source to target. Both tiles can be occupied, e.g., by gates, while all tiles in
+     * between have to be free or crossable. Directions already in use at source or target are avoided. The overlay is
+     * taken into account and the layout is not modified.
+     *
+     * @param source Tile at which the path starts.
+     * @param target Tile at which the path ends.
+     * @return Cheapest path from source to target or std::nullopt if there is none.
+     */
+    std::optional<routing_path> find_path(const fcn_gate_layout::tile& source,
+                                          const fcn_gate_layout::tile& target) noexcept;
+    /**
+     * Assigns the given logic edge to all wire tiles of the given path, sets wire and tile directions accordingly, and
+     * assigns the path's latches.
+     *
+     * @param p Path to assign.
+     * @param e Logic edge realized by p.
+     */
+    void assign_path(const routing_path& p, const logic_network::edge& e) noexcept;
+    /**
+     * Determines a cheapest path from source to target and assigns it to the layout as logic edge e.
+     *
+     * @param source Tile at which the path starts.
+     * @param target Tile at which the path ends.
+     * @param e Logic edge to route.
+     * @return Assigned path or std::nullopt if there is none.
+     */
+    std::optional<routing_path> route(const fcn_gate_layout::tile& source, const fcn_gate_layout::tile& target,
+                                      const logic_network::edge& e) noexcept;
+    /**
+     * Removes the given path from the layout, i.e., clears its wire tiles and removes the directions it uses from its
+     * endpoints. Wires crossing over a ground tile of the path are lowered to the ground layer. Paths of lowered wires
+     * that are kept by the caller need to be updated accordingly.
+     *
+     * @param p Path to remove.
+     * @return Logic edges whose wires have been lowered together with the ground tiles they have been lowered to.
+     */
+    std::vector<std::pair<logic_network::edge, fcn_gate_layout::tile>> rip_up(const routing_path& p) noexcept;
+    /**
+     * Marks tile t as occupied for all subsequent searches until clear_overlay is called.
+     *
+     * @param t Tile to block.
+     */
+    void block(const fcn_gate_layout::tile& t) noexcept;
+    /**
+     * Marks all wire tiles of the given path as occupied and the directions it uses at its endpoints as used for all
+     * subsequent searches until clear_overlay is called. This way, multiple paths can be determined that do not
+     * interfere with each other before any of them is assigned.
+     *
+     * @param p Path to block.
+     */
+    void block(const routing_path& p) noexcept;
+    /**
+     * Marks tile t as free for all subsequent searches until clear_overlay is called.
+     *
+     * @param t Tile to release.
+     */
+    void release(const fcn_gate_layout::tile& t) noexcept;
+    /**
+     * Marks the given path as ripped up for all subsequent searches until clear_overlay is called. Its wire tiles are
+     * considered free and the directions it uses at its endpoints are considered unused. Ground tiles below wires of
+     * other paths stay occupied since rip_up would lower those wires onto them.
+     *
+     * @param p Path to release.
+     */
+    void release(const routing_path& p) noexcept;
+    /**
+     * Discards all blocked and released tiles and directions.
+     */
+    void clear_overlay() noexcept;
+    /**
+     * Checks whether tile t is free with respect to the layout and the overlay.
+     *
+     * @param t Tile to check.
+     * @return True, iff t is free.
+     */
+    bool is_free(const fcn_gate_layout::tile& t) const noexcept;
+    /**
+     * Returns statistics about all searches performed by this router so far. Dividing the runtime by the number of
+     * searches yields the average time per net.
+     *
+     * @return Statistics of this router.
+     */
+    const router_statistics& get_statistics() const noexcept;
+
+private:
+    /**
+     * Gate layout to route in.
+     */
+    fcn_gate_layout_ptr layout;
+    /**
+     * Configuration of the router.
+     */
+    const router_config config;
+    /**
+     * Alias for a tile's position in the search arrays.
+     */
+    using search_index = std::uint32_t;
+    /**
+     * Index that marks the absence of a parent.
+     */
+    static constexpr search_index no_parent = UINT32_MAX;
+    /**
+     * Open list.
+     */
+    radix_heap<std::uint32_t, search_index> open{};
+    /**
+     * Generation stamps; entries of the search arrays are only valid if their stamp equals the current generation.
+     */
+    std::vector<std::uint32_t> stamp{};
+    /**
+     * Stamps of tiles that have been expanded in the current generation.
+     */
+    std::vector<std::uint32_t> closed{};
+    /**
+     * Cost of the cheapest known path to each tile.
+     */
+    std::vector<std::uint32_t> cost{};
+    /**
+     * Predecessor of each tile on its cheapest known path.
+     */
+    std::vector<search_index> parent{};
+    /**
+     * Latch that has to be assigned to the predecessor of each tile to reach it.
+     */
+    std::vector<fcn_layout::latch_delay> parent_latch{};
+    /**
+     * Current generation.
+     */
+    std::uint32_t generation = 0u;
+    /**
+     * States a tile can have in the overlay.
+     */
+    enum class overlay_state : std::uint8_t { BLOCKED, RELEASED };
+    /**
+     * Overlay state of blocked and released tiles. Overlays are small; hence, a hash map suffices.
+     */
+    std::unordered_map<fcn_gate_layout::tile, overlay_state, boost::hash<fcn_gate_layout::tile>> overlay{};
+    /**
+     * Directions of tiles that are used or released in the overlay.
+     */
+    struct dir_overlay
+    {
+        layout::directions used = layout::DIR_NONE, released = layout::DIR_NONE;
+    };
+    /**
+     * Overlay of tile directions.
+     */
+    std::unordered_map<fcn_gate_layout::tile, dir_overlay, boost::hash<fcn_gate_layout::tile>> dir_overlays{};
+    /**
+     * Layout dimensions the search arrays have been allocated for.
+     */
+    coord_t x_size = 0ul, y_size = 0ul, z_size = 0ul;
+    /**
+     * Statistics about all searches so far.
+     */
+    router_statistics statistics{};
+    /**
+     * Performs the A* search of find_path.
+     *
+     * @param source Tile at which the path starts.
+     * @param target Tile at which the path ends.
+     * @return Cheapest path from source to target or std::nullopt if there is none.
+     */
+    std::optional<routing_path> search(const fcn_gate_layout::tile& source,
+                                       const fcn_gate_layout::tile& target) noexcept;
+    /**
+     * Allocates the search arrays if the layout's dimensions have changed and starts a new generation.
+     */
+    void prepare() noexcept;
+    /**
+     * Returns the directions of tile t that are in use with respect to the layout and the overlay.
+     *
+     * @param t Tile whose used directions are desired.
+     * @return Used input and output directions of t.
+     */
+    layout::directions used_dirs(const fcn_gate_layout::tile& t) const noexcept;
+    /**
+     * Returns the overlay state of tile t if it has one.
+     *
+     * @param t Tile whose overlay state is desired.
+     * @return Overlay state of t or std::nullopt if it has none.
+     */
+    std::optional<overlay_state> get_overlay(const fcn_gate_layout::tile& t) const noexcept;
+    /**
+     * Returns the position of the given tile in the search arrays.
+     *
+     * @param t Tile whose index is desired.
+     * @return Index of t.
+     */
+    search_index to_index(const fcn_gate_layout::tile& t) const noexcept;
+    /**
+     * Returns the tile at the given position of the search arrays.
+     *
+     * @param i Index whose tile is desired.
+     * @return Tile at index i.
+     */
+    fcn_gate_layout::tile to_tile(const search_index i) const noexcept;
+    /**
+     * Checks whether the path can enter tile t coming from tile from, i.e., whether t is a free ground tile or a free
+     * crossing tile above wires that run perpendicular to the movement from from to t and that are not part of the
+     * overlay.
+     *
+     * @param from Previous tile.
+     * @param t Tile to enter.
+     * @return True, iff t can be used as a wire tile of the path.
+     */
+    bool is_passable(const fcn_gate_layout::tile& from, const fcn_gate_layout::tile& t) const noexcept;
+    /**
+     * Determines the latch that has to be assigned to tile t such that it can pass information to tile n.
+     *
+     * @param t Source tile.
+     * @param n Target tile.
+     * @param latchable Flag to indicate that t may receive a latch.
+     * @return 0 if t is outgoing clocked to n, the necessary latch if t is latchable, or std::nullopt otherwise.
+     */
+    std::optional<fcn_layout::latch_delay> required_latch(const fcn_gate_layout::tile& t,
+                                                          const fcn_gate_layout::tile& n,
+                                                          const bool latchable) const noexcept;
+};
+
+
+#endif //FICTION_MAZE_ROUTER_H
@@ -5,21 +5,31 @@
 #include "one_pass_synthesis.h"
 
 
-const pybind11::scoped_interpreter one_pass_synthesis::instance{};
+void one_pass_synthesis::initialize_interpreter() noexcept
+{
+    static const auto instance = []
+    {
+        auto interpreter = std::make_unique<const pybind11::scoped_interpreter>();
+
+        // add Mugen's path to Python's sys.path module scope once per interpreter
+        pybind11::module::import("sys").attr("path").attr("append")(MUGEN_PATH);
+
+        return interpreter;
+    }();
+}
 
 one_pass_synthesis::one_pass_synthesis(std::vector<kitty::dynamic_truth_table>&& tts, onepass_pd_config&& config)
         :
         physical_design(),
         spec(std::move(tts)),
         config{std::move(config)},
-        dit{std::max(this->config.fixed_size, 1ul)}
+        dit{std::max(this->config.fixed_size, 1ul), this->config.upper_bound, this->config.policy}
 {
     assert(!spec.empty());
     assert(std::adjacent_find(spec.begin(), spec.end(),
             [](const auto& a, const auto& b){return a.num_vars() != b.num_vars();}) == spec.end());
 
-    // add Mugen's path to Python's sys.path module scope
-    pybind11::module::import("sys").attr("path").attr("append")(MUGEN_PATH);
+    initialize_interpreter();
 }
 
 physical_design::pd_result one_pass_synthesis::operator()()
@@ -27,6 +37,21 @@ physical_design::pd_result one_pass_synthesis::operator()()
     if (!test_dependencies())
         return pd_result{false, nlohmann::json{{"runtime (s)", 0.0}}};
 
+    if (config.num_processes > 1ul)
+    {
+        // forked workers could block forever on locks held by threads of background jobs
+        if (!background_jobs::get().running())
+            return run_asynchronously();
+
+        std::cout << "[w] dimensions are explored sequentially because forking is unsafe while background jobs are "
+                     "running" << std::endl;
+    }
+
+    return run_synchronously();
+}
+
+physical_design::pd_result one_pass_synthesis::run_synchronously()
+{
     mockturtle::stopwatch<>::duration time{0};
 
     auto layout_sketch = std::make_shared<fcn_gate_layout>(*config.scheme,
@@ -78,6 +103,171 @@ physical_design::pd_result one_pass_synthesis::operator()()
     return pd_result{false, nlohmann::json{{"runtime (s)", mockturtle::to_seconds(time)}}};
 }
 
+physical_design::pd_result one_pass_synthesis::run_asynchronously()
+{
+    namespace py = pybind11;
+
+    const auto start = std::chrono::steady_clock::now();
+    const auto elapsed = [&start]{ return std::chrono::steady_clock::now() - start; };
+
+    auto layout_sketch = std::make_shared<fcn_gate_layout>(*config.scheme,
+                                                           std::make_shared<logic_network>(std::move(config.name)));
+
+    mugen_handler handler{spec, layout_sketch, config};
+
+    std::vector<worker> workers{};
+    std::optional<fcn_dimension_xy> result_dimension{};
+    std::string result_message{};
+
+    const auto failure = [this, &elapsed]
+    {
+        return pd_result{false, nlohmann::json{{"runtime (s)", mockturtle::to_seconds(elapsed())},
+                                               {"processes", config.num_processes}}};
+    };
+
+    while (!config.timeout || elapsed() < std::chrono::seconds{config.timeout})
+    {
+        // hand out dimensions in ascending order of area to idle workers
+        while (workers.size() < config.num_processes && dit <= config.upper_bound)  // <= to prevent overflow
+        {
+            const auto dimension = *dit;
+
+            // all remaining dimensions are at least as large as the one of the found solution
+            if (result_dimension && area(*result_dimension) <= area(dimension))
+                break;
+
+            ++dit;
+
+            if (handler.skippable(dimension))
+                continue;
+
+            handler.update(dimension);
+
+            if (config.timeout)
+                update_timeout(handler, elapsed());
+
+            if (auto w = spawn_worker(handler, dimension); w)
+            {
+                workers.push_back(std::move(*w));
+            }
+            else
+            {
+                std::cout << "[e] could not create a worker process" << std::endl;
+
+                for (const auto& running : workers)
+                    terminate_worker(running);
+
+                return failure();
+            }
+        }
+
+        if (workers.empty())
+            break;
+
+        std::vector<pollfd> fds{};
+        for (const auto& w : workers)
+            fds.push_back({w.fd, POLLIN, 0});
+
+        // a negative value would block indefinitely
+        auto poll_timeout = -1;
+        if (config.timeout)
+        {
+            const auto time_left = std::chrono::ceil<std::chrono::milliseconds>(std::chrono::seconds{config.timeout} -
+                                                                               elapsed());
+            poll_timeout = std::max(static_cast<int>(time_left.count()), 0);
+        }
+
+        if (poll(fds.data(), fds.size(), poll_timeout) < 0 && errno != EINTR)
+            break;
+
+        std::vector<worker> running{};
+        for (auto i = 0ul; i < workers.size(); ++i)
+        {
+            auto& w = workers[i];
+
+            if (!(fds[i].revents & (POLLIN | POLLHUP | POLLERR)))
+            {
+                running.push_back(std::move(w));
+                continue;
+            }
+
+            char buffer[65536];
+            if (const auto n = read(w.fd, buffer, sizeof(buffer)); n > 0 || (n < 0 && errno == EINTR))
+            {
+                if (n > 0)
+                    w.message.append(buffer, static_cast<std::size_t>(n));
+
+                running.push_back(std::move(w));
+                continue;
+            }
+
+            // end of file: the worker has finished
+            close(w.fd);
+            waitpid(w.pid, nullptr, 0);
+
+            // a worker that crashed did not send anything
+            if (w.message.empty())
+                continue;
+
+            if (const auto status = static_cast<worker_status>(w.message.front());
+                    (status == worker_status::SAT || status == worker_status::SAT_NO_PAYLOAD) &&
+                    (!result_dimension || area(w.dimension) < area(*result_dimension)))
+            {
+                result_dimension = w.dimension;
+                result_message   = std::move(w.message);
+            }
+        }
+        workers = std::move(running);
+
+        // terminate workers that cannot improve the found solution anymore
+        if (result_dimension)
+        {
+            workers.erase(std::remove_if(workers.begin(), workers.end(), [&result_dimension](const worker& w)
+            {
+                if (area(*result_dimension) <= area(w.dimension))
+                {
+                    terminate_worker(w);
+                    return true;
+                }
+
+                return false;
+            }), workers.end());
+        }
+    }
+
+    // timeout reached
+    for (const auto& w : workers)
+        terminate_worker(w);
+
+    if (!result_dimension)
+        return failure();
+
+    handler.update(*result_dimension);
+
+    try
+    {
+        if (static_cast<worker_status>(result_message.front()) == worker_status::SAT)
+        {
+            handler.to_gate_layout(py::module::import("pickle").attr("loads")(
+                    py::bytes(result_message.data() + 1, result_message.size() - 1)));
+        }
+        // the network could not be transferred, so it has to be synthesized once more
+        else if (!handler.is_satisfiable())
+        {
+            return failure();
+        }
+    }
+    catch (...)
+    {
+        return failure();
+    }
+
+    layout = layout_sketch;
+
+    return pd_result{true, nlohmann::json{{"runtime (s)", mockturtle::to_seconds(elapsed())},
+                                          {"processes", config.num_processes}}};
+}
+
 bool one_pass_synthesis::test_dependencies() const
 {
     namespace py = pybind11;
@@ -151,6 +341,18 @@ void one_pass_synthesis::mugen_handler::update(const uint32_t timeout) noexcept
 }
 
 bool one_pass_synthesis::mugen_handler::is_satisfiable()
+{
+    if (auto net = synthesize(); !net.is_none())
+    {
+        to_gate_layout(net);
+
+        return true;
+    }
+
+    return false;
+}
+
+pybind11::object one_pass_synthesis::mugen_handler::synthesize()
 {
     namespace py = pybind11;
     using namespace py::literals;
@@ -163,15 +365,10 @@ bool one_pass_synthesis::mugen_handler::is_satisfiable()
     auto nets = scheme_graph.attr("synthesize")(scheme_graph, py_spec);
     for (auto net_it = nets.begin(); net_it != nets.end(); ++net_it)
     {
-        if (net_it->is_none())
-            return false;
-
-        to_gate_layout(*net_it);
-
-        return true;
+        return py::reinterpret_borrow<py::object>(*net_it);
     }
 
-    return false;
+    return py::none();
 }
 
 pybind11::list one_pass_synthesis::mugen_handler::as_py_lists(const std::vector<kitty::dynamic_truth_table>& tts) const
@@ -444,3 +641,95 @@ void one_pass_synthesis::update_timeout(mugen_handler& handler, mockturtle::stop
 
     handler.update(time_left);
 }
+
+std::optional<one_pass_synthesis::worker>
+one_pass_synthesis::spawn_worker(mugen_handler& handler, const fcn_dimension_xy& dimension) const
+{
+    namespace py = pybind11;
+
+    int fds[2];
+    if (pipe(fds) != 0)
+        return std::nullopt;
+
+    // buffered output would be written by both processes otherwise
+    std::cout.flush();
+
+    pid_t pid;
+    try
+    {
+        // os.fork takes care of the interpreter's state in both processes
+        pid = py::module::import("os").attr("fork")().cast<pid_t>();
+    }
+    catch (const py::error_already_set&)
+    {
+        close(fds[0]);
+        close(fds[1]);
+
+        return std::nullopt;
+    }
+
+    if (pid == 0)  // worker
+    {
+        close(fds[0]);
+        // own process group such that solver processes started by Mugen can be terminated as well
+        setpgid(0, 0);
+
+        std::string message{};
+        try
+        {
+            if (auto net = handler.synthesize(); net.is_none())
+            {
+                message.push_back(static_cast<char>(worker_status::UNSAT));
+            }
+            else
+            {
+                try
+                {
+                    message.push_back(static_cast<char>(worker_status::SAT));
+                    const py::bytes payload = py::module::import("pickle").attr("dumps")(net);
+                    message.append(static_cast<std::string>(payload));
+                }
+                catch (const py::error_already_set&)
+                {
+                    message = static_cast<char>(worker_status::SAT_NO_PAYLOAD);
+                }
+            }
+        }
+        // timeout reached
+        catch (...)
+        {
+            message = static_cast<char>(worker_status::ABORTED);
+        }
+
+        for (std::size_t written = 0ul; written < message.size();)
+        {
+            const auto n = write(fds[1], message.data() + written, message.size() - written);
+            if (n < 0 && errno == EINTR)
+                continue;
+            if (n < 0)
+                break;
+
+            written += static_cast<std::size_t>(n);
+        }
+
+        close(fds[1]);
+
+        // skip the clean-up of everything that belongs to the parent process, e.g., the Python interpreter
+        _exit(0);
+    }
+
+    close(fds[1]);
+    setpgid(pid, pid);
+
+    return worker{pid, fds[0], dimension};
+}
+
+void one_pass_synthesis::terminate_worker(const worker& w) noexcept
+{
+    // the whole process group including Mugen's solver processes
+    if (kill(-w.pid, SIGKILL) != 0)
+        kill(w.pid, SIGKILL);
+
+    close(w.fd);
+    waitpid(w.pid, nullptr, 0);
+}
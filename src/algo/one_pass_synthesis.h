@@ -8,10 +8,20 @@
 
 #include "physical_design.h"
 #include "onepass_pd_config.h"
-#include "iter/dimension_iterator.h"
+#include "iter/dimension_explorer.h"
+#include "background_jobs.h"
 #include <pybind11/embed.h>
 #include <kitty/dynamic_truth_table.hpp>
 #include <kitty/print.hpp>
+#include <poll.h>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <cerrno>
+#include <chrono>
+#include <optional>
+#include <string>
+#include <vector>
 
 
 /**
@@ -30,6 +40,11 @@
  * Since Mugen is written in Python3, fiction uses pybind11 for interoperability. This can lead to performance and
  * integration issues. Make sure to follow all steps given in the README carefully if you decide to run this code.
  *
+ * Since the embedded interpreter cannot run multiple instances of Mugen concurrently, dimensions can be explored in
+ * parallel by forked worker processes instead. Each worker solves one dimension and sends the synthesized network back
+ * to the parent process through a pipe. Once a worker finds a solution, all workers exploring dimensions that are not
+ * smaller are terminated.
+ *
  * This approach is still experimental and can be excluded from compilation.
  */
 class one_pass_synthesis : public physical_design
@@ -51,6 +66,15 @@ public:
      * @return Result type containing statistical information about the process.
      */
     pd_result operator()() override;
+    /**
+     * Starts the Python interpreter that is necessary to call Mugen, a library written in Python, if it is not running
+     * yet. The interpreter is scoped and only needs to exist. It handles creation and proper destruction of all Python
+     * objects used during this session and deals with the CPython API. Mugen's path is added to Python's sys.path
+     * once on startup such that it does not grow with every instance. Since it is created on first use only, no
+     * startup costs are paid by sessions that do not call onepass. Processes that fork sessions, e.g., the server
+     * command, can start it beforehand such that all sessions share the startup costs.
+     */
+    static void initialize_interpreter() noexcept;
 
 private:
     /**
@@ -64,23 +88,31 @@ private:
     /**
      * Iterates over the possible dimensions for the fcn_gate_layout to find.
      */
-    dimension_iterator dit{0};
-    /**
-     * A Python interpreter instance that is necessary to call Mugen, a library written in Python. This instance is
-     * scoped and only need to exist. No operations are to be performed on this object. It handles creation and proper
-     * destruction of all Python objects used during this session and deals with the CPython API.
-     */
-    static const pybind11::scoped_interpreter instance;
+    dimension_explorer dit{0};
     /**
      * Path to the Mugen library.
      */
-    const char* MUGEN_PATH = "../libs/mugen/";
+    static constexpr const char* MUGEN_PATH = "../libs/mugen/";
     /**
      * Tests whether all needed dependencies have been installed and can be accessed via Python.
      *
      * @return true iff all dependencies are met.
      */
     bool test_dependencies() const;
+    /**
+     * Explores all dimensions one after another in the calling process.
+     *
+     * @return Result type containing statistical information about the process.
+     */
+    pd_result run_synchronously();
+    /**
+     * Explores multiple dimensions at once using config.num_processes forked worker processes. Dimensions are handed
+     * out in ascending order of area. The parent process collects the results via pipes and terminates all workers
+     * whose dimensions are not smaller than the one of the first found solution.
+     *
+     * @return Result type containing statistical information about the process.
+     */
+    pd_result run_asynchronously();
 
     /**
      * Sub-class to handle interaction with the Python code Mugen as well as some house-keeping.
@@ -124,6 +156,18 @@ private:
          * @return true iff the instance generated for the current configuration is SAT.
          */
         bool is_satisfiable();
+        /**
+         * Passes the current scheme_graph to Mugen and synthesizes it.
+         *
+         * @return The synthesized network or None if the instance generated for the current configuration is UNSAT.
+         */
+        pybind11::object synthesize();
+        /**
+         * Extracts an fcn_gate_layout from the network synthesized by Mugen.
+         *
+         * @param net Synthesis result returned by Mugen.
+         */
+        void to_gate_layout(pybind11::handle net) const;
 
     private:
         /**
@@ -160,12 +204,6 @@ private:
          * @return A scheme_graph object representing the clocking scheme in its dimension and data flow.
          */
         pybind11::object generate_scheme_graph();
-        /**
-         * Extracts an fcn_gate_layout from the network synthesized by Mugen.
-         *
-         * @param net Synthesis result returned by Mugen.
-         */
-        void to_gate_layout(pybind11::handle net) const;
     };
 
     /**
@@ -176,6 +214,47 @@ private:
      * @param time Time passed since beginning of the solving process.
      */
     void update_timeout(mugen_handler& handler, mockturtle::stopwatch<>::duration time) const noexcept;
+    /**
+     * A forked process that explores a single dimension.
+     */
+    struct worker
+    {
+        /**
+         * Process ID.
+         */
+        pid_t pid;
+        /**
+         * Read end of the pipe the worker sends its result through.
+         */
+        int fd;
+        /**
+         * Dimension the worker explores.
+         */
+        fcn_dimension_xy dimension;
+        /**
+         * Bytes received so far.
+         */
+        std::string message{};
+    };
+    /**
+     * Status bytes prepended to a worker's message.
+     */
+    enum class worker_status : char { SAT = 'S', SAT_NO_PAYLOAD = 'L', UNSAT = 'U', ABORTED = 'A' };
+    /**
+     * Forks a worker process that explores the handler's current dimension. The worker writes a status byte followed
+     * by the pickled network in case of SAT to its pipe and exits.
+     *
+     * @param handler Handler that has already been updated to the dimension to explore.
+     * @param dimension Dimension to explore.
+     * @return Worker information or std::nullopt if no process could be created.
+     */
+    std::optional<worker> spawn_worker(mugen_handler& handler, const fcn_dimension_xy& dimension) const;
+    /**
+     * Kills the given worker and releases its resources.
+     *
+     * @param w Worker to terminate.
+     */
+    static void terminate_worker(const worker& w) noexcept;
 };
 
 
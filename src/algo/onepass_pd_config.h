@@ -9,6 +9,7 @@
 #include <memory>
 #include <limits>
 #include "fcn_clocking_scheme.h"
+#include "iter/dimension_explorer.h"
 
 
 /**
@@ -24,10 +25,18 @@ struct onepass_pd_config
      * Use just one fixed tile size.
      */
     std::size_t fixed_size = 0ul;
+    /**
+     * Order and restrictions of the dimensions to explore.
+     */
+    exploration_policy policy{};
     /**
      * Number of threads to use for exploring the possible dimensions.
      */
     std::size_t num_threads = 1ul;
+    /**
+     * Number of worker processes that explore different dimensions in parallel.
+     */
+    std::size_t num_processes = 1ul;
     /**
      * Enable the use of wire elements.
      */
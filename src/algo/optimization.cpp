@@ -3,14 +3,19 @@
 //
 
 #include "fcn_cell_layout.h"
+#include <algorithm>
+#include <map>
+#include <optional>
+#include <type_traits>
+#include <vector>
 
 
 void fcn_cell_layout::clean_up_topolinano() noexcept
 {
     enum class status { SEARCH, COLLECT, SKIP };
-    bool improvement_found;
+    bool merged_up;
 
-    auto handle = [this, &improvement_found](const auto& _hump)
+    auto handle = [this, &merged_up](const auto& _hump)
     {
         // single cell collections are no humps, do not merge them.
         if (_hump.size() > 1)
@@ -41,8 +46,6 @@ void fcn_cell_layout::clean_up_topolinano() noexcept
                         assign_cell_mode(hc, fcn::cell_mode::NORMAL);
                         assign_cell_name(hc, "");
                     }
-
-                    improvement_found = true;
                 }
             }
             // if there are normal cells north of first and last hump cell, this is a lower hump
@@ -67,233 +70,207 @@ void fcn_cell_layout::clean_up_topolinano() noexcept
                         assign_cell_name(hc, "");
                     }
 
-                    improvement_found = true;
+                    merged_up = true;
                 }
             }
         }
     };
 
-    do
+    // rows are swept top to bottom; merging a hump down only alters the next row, which is swept anyway, but merging a
+    // hump up alters the previous one, which is therefore swept again
+    for (coord_t row = 0; row < y(); )
     {
         status st = status::SEARCH;
-        improvement_found = false;
+        std::vector<cell> hump{};
+        merged_up = false;
 
-        for (auto&& row : iter::range(y()))
+        for (auto&& column : iter::range(x()))
         {
-            std::vector<cell> hump{};
-
-            for (auto&& column : iter::range(x()))
+            // simple state machine for identifying humps and removing them
+            switch (auto c = cell{column, row, GROUND}; st)
             {
-                // simple state machine for identifying humps and removing them
-                switch (auto c = cell{column, row, GROUND}; st)
+                case status::SEARCH:
                 {
-                    case status::SEARCH:
+                    switch (auto t = get_cell_type(c); t)
                     {
-                        switch (auto t = get_cell_type(c); t)
+                        // encountering a normal, input, or inverter magnet triggers collecting hump cells
+                        case fcn::NORMAL_CELL:
+                        case fcn::INPUT_CELL:
+                        case fcn::inml::INVERTER_MAGNET:
                         {
-                            // encountering a normal, input, or inverter magnet triggers collecting hump cells
-                            case fcn::NORMAL_CELL:
-                            case fcn::INPUT_CELL:
-                            case fcn::inml::INVERTER_MAGNET:
-                            {
-                                st = status::COLLECT;
-                                hump.push_back(c);
-                                break;
-                            }
-                            // remain searching
-                            case fcn::EMPTY_CELL:
-                            {
-                                break;
-                            }
-                            // everything else leads to skipping
-                            default:
-                            {
-                                st = status::SKIP;
-                                break;
-                            }
+                            st = status::COLLECT;
+                            hump.push_back(c);
+                            break;
                         }
-                        break;
-                    }
-                    case status::COLLECT:
-                    {
-                        switch (auto t = get_cell_type(c); t)
+                        // remain searching
+                        case fcn::EMPTY_CELL:
                         {
-                            // collect cells
-                            case fcn::NORMAL_CELL:
-                            case fcn::inml::INVERTER_MAGNET:
-                            {
-                                hump.push_back(c);
-                                break;
-                            }
-                            // interesting branch: could be a hump
-                            case fcn::EMPTY_CELL:
-                            case fcn::OUTPUT_CELL:
-                            {
-                                handle(hump);
-                                // discard hump cells and start searching again
-                                hump.clear();
-                                st = status::SEARCH;
-                                break;
-                            }
-                            // encountered anything else: cannot be a hump
-                            default:
-                            {
-                                hump.clear();
-                                st = status::SKIP;
-                                break;
-                            }
+                            break;
+                        }
+                        // everything else leads to skipping
+                        default:
+                        {
+                            st = status::SKIP;
+                            break;
                         }
-                        break;
                     }
-                    case status::SKIP:
+                    break;
+                }
+                case status::COLLECT:
+                {
+                    switch (auto t = get_cell_type(c); t)
                     {
-                        if (auto t = get_cell_type(c); t == fcn::EMPTY_CELL)
+                        // collect cells
+                        case fcn::NORMAL_CELL:
+                        case fcn::inml::INVERTER_MAGNET:
                         {
-                            // skipping over, return to searching
+                            hump.push_back(c);
+                            break;
+                        }
+                        // interesting branch: could be a hump
+                        case fcn::EMPTY_CELL:
+                        case fcn::OUTPUT_CELL:
+                        {
+                            handle(hump);
+                            // discard hump cells and start searching again
+                            hump.clear();
                             st = status::SEARCH;
+                            break;
                         }
-                        break;
+                        // encountered anything else: cannot be a hump
+                        default:
+                        {
+                            hump.clear();
+                            st = status::SKIP;
+                            break;
+                        }
+                    }
+                    break;
+                }
+                case status::SKIP:
+                {
+                    if (auto t = get_cell_type(c); t == fcn::EMPTY_CELL)
+                    {
+                        // skipping over, return to searching
+                        st = status::SEARCH;
                     }
                     break;
                 }
+                break;
             }
         }
-    } while (improvement_found);
+
+        if (merged_up && row > 0)
+            --row;
+        else
+            ++row;
+    }
 }
 
 void fcn_cell_layout::cut_optimization() noexcept
 {
-    auto find_cut_wire = [this](auto c, bool exit_on_occupied) -> std::optional<cell>
+    const auto width = library->gate_x_size();
+    if (x() <= width)
+        return;
+
+    // gather the occupied rows of each column in one pass over all assigned cells
+    std::vector<std::vector<coord_t>> occupied_rows(x());
+    std::vector<bool> cuttable(x(), true);
+    for (const auto& [c, t] : type_map)
     {
-        auto counter = 0u;
-        // iterate from start position left to right over layout cells
-        for (; c[X] != this->x() - 1; c = east(c))
-        {
-            auto t = get_cell_type(c);
+        if (t == fcn::NORMAL_CELL && c[Z] == GROUND)
+            occupied_rows[c[X]].push_back(c[Y]);
+        else
+            cuttable[c[X]] = false;
+    }
 
-            if (t == fcn::NORMAL_CELL)
-                ++counter;
-            else if (is_free_cell(c))
-            {
-                if (exit_on_occupied)
-                    break;
-            }
-            // cell occupied but not a normal cell
-            if (t != fcn::NORMAL_CELL && !is_free_cell(c))
-            {
-                if (exit_on_occupied)
-                    break;
-            }
+    // a column can be part of a cut if it consists of horizontal wire cells only, i.e., normal cells none of which is
+    // connected to its northern neighbor; columns with the same occupied rows form cuts seamlessly
+    std::map<std::vector<coord_t>, std::size_t> patterns{};
+    std::vector<std::optional<std::size_t>> column_pattern(x());
+    for (coord_t column = 0; column < x(); ++column)
+    {
+        auto& rows = occupied_rows[column];
+        std::sort(rows.begin(), rows.end());
 
-            // cut wire found, return end position
-            if (counter == library->gate_x_size())
-                return c;
-        }
+        if (!cuttable[column] || rows.empty() ||
+            std::adjacent_find(rows.cbegin(), rows.cend(), [](const auto r1, const auto r2){ return r1 + 1 == r2; })
+            != rows.cend())
+            continue;
 
-        // no cut wire in this row
-        return std::nullopt;
-    };
+        column_pattern[column] = patterns.emplace(rows, patterns.size()).first->second;
+    }
 
-    auto is_first_cut = [this](auto c) -> bool
+    // identify all cuts in one scan; a cut consists of gate_x_size consecutive remaining columns of the same pattern and
+    // since removed columns merge their neighbors, cuts can also span over previously found ones
+    std::vector<bool> removed(x(), false);
+    std::vector<coord_t> remaining{};
+    for (coord_t column = 0; column < x(); ++column)
     {
-        for (auto n = north(c); is_free_cell(n); n = north(n))
+        remaining.push_back(column);
+
+        // the eastern border column never ends a cut
+        if (column == x() - 1 || remaining.size() < width || !column_pattern[column])
+            continue;
+
+        const auto first = remaining.end() - static_cast<std::ptrdiff_t>(width);
+        if (std::all_of(first, remaining.end(),
+                        [&column_pattern, column](const auto c){ return column_pattern[c] == column_pattern[column]; }))
         {
-            if (n[Y] == 0)
-                return true;
+            std::for_each(first, remaining.end(), [&removed](const auto c){ removed[c] = true; });
+            remaining.erase(first, remaining.end());
         }
+    }
 
-        return false;
-    };
+    if (std::none_of(removed.cbegin(), removed.cend(), [](const auto r){ return r; }))
+        return;
 
-    auto cut_if_valid = [this](auto c) -> bool
+    // compute the column remapping once and rewrite all cell planes in a single pass each
+    std::vector<coord_t> new_x(x());
+    for (coord_t column = 0, next = 0; column < x(); ++column)
     {
-        std::vector<cell> cut{};
-        for (auto x : iter::range(c[X] - (library->gate_x_size() - 1), c[X] + 1))
-        {
-            for (auto y : iter::range(c[Y], y()))
-            {
-                switch (auto trace_cell = cell{x, y, GROUND}; get_cell_type(trace_cell))
-                {
-                    case fcn::NORMAL_CELL:
-                    {
-                        if (auto pre_cell = cell{x, y - 1, GROUND}; get_cell_type(pre_cell) == fcn::EMPTY_CELL)
-                        {
-                            cut.push_back(trace_cell);
-                            continue;
-                        }
-                        else
-                            return false;
-                    }
-                    case fcn::EMPTY_CELL:
-                    {
-                        continue;
-                    }
-                    default:
-                    {
-                        return false;
-                    }
-                }
-            }
-        }
+        new_x[column] = next;
+        if (!removed[column])
+            ++next;
+    }
+
+    const auto remap = [&new_x](const auto& c){ return cell{new_x[c[X]], c[Y], c[Z]}; };
 
-        for (const auto& _c : cut)
+    const auto rewrite = [&removed, &remap](auto& map)
+    {
+        std::remove_reference_t<decltype(map)> remapped{};
+        remapped.reserve(map.size());
+
+        for (auto& [c, v] : map)
         {
-            assign_cell_type(_c, fcn::EMPTY_CELL);
-            assign_cell_mode(_c, fcn::cell_mode::NORMAL);
-            assign_cell_name(_c, "");
+            if (!removed[c[X]])
+                remapped.emplace(remap(c), std::move(v));
         }
 
-        return true;
+        map = std::move(remapped);
     };
 
-    auto merge_cut_pieces = [this](auto c) -> void
+    rewrite(type_map);
+    rewrite(mode_map);
+    rewrite(name_map);
+
+    for (auto* primaries : {&pi_set, &po_set})
     {
-        for (auto y : iter::range(y()))
+        primary_set remapped{};
+        for (const auto& c : **primaries)
         {
-            for (auto x : iter::range(c[X] + 1, x()))
-            {
-                if (auto source = cell{x, y, GROUND}; !is_free_cell(source))
-                {
-                    auto target = cell{x - library->gate_x_size(), y, GROUND};
-                    // copy cell to new position
-                    assign_cell_type(target, get_cell_type(source));
-                    assign_cell_mode(target, get_cell_mode(source));
-                    assign_cell_name(target, get_cell_name(source));
-                    // remove cell from old position
-                    assign_cell_type(source, fcn::EMPTY_CELL);
-                    assign_cell_mode(source, fcn::cell_mode::NORMAL);
-                    assign_cell_name(source, "");
-                }
-            }
+            if (!removed[c[X]])
+                remapped.insert(remap(c));
         }
-    };
 
-    bool cut_found;
-    do
-    {
-        cut_found = false;
-        for (auto&& y : iter::range(y()))
-        {
-            for (coord_t x = 0u; x < this->x(); ++x)
-            {
-                if (auto c = find_cut_wire(cell{x, y, GROUND}, false); c)
-                {
-                    // update x iterator
-                    x = (*c)[X];
+        primaries->write() = std::move(remapped);
+    }
 
-                    if (is_first_cut(*c) && cut_if_valid(*c))
-                    {
-                        cut_found = true;
-                        merge_cut_pieces(*c);
-                        break;
-                    }
-                }
-                else
-                {
-                    // no need to look more than once if there is no cut wire found
-                    break;
-                }
-            }
-        }
-    } while (cut_found);
+    latch_map latches{};
+    for (const auto& [g, l] : *l_map)
+    {
+        if (!removed[g[X]])
+            latches.emplace(ground{{new_x[g[X]], g[Y]}}, l);
+    }
+    l_map.write() = std::move(latches);
 }
@@ -11,7 +11,12 @@ orthogonal::orthogonal(logic_network_ptr ln, const unsigned n, const bool io, co
         io_ports{io},
         border_ios{border}
 {
-    network->substitute_fan_outs();
+    // copy the network only if fan-outs have to be substituted
+    if (network->requires_fan_out_substitution())
+        make_unique_network(network)->substitute_fan_outs();
+
+    // the network is not altered anymore from here on
+    snapshot = std::make_shared<const logic_network_snapshot>(network);
 }
 
 physical_design::pd_result orthogonal::operator()()
@@ -53,7 +58,7 @@ orthogonal::jdfs_ordering orthogonal::jdfs_order() const
     // stores the ordering
     jdfs_ordering ordering{};
     // store discovery of vertices
-    std::vector<bool> discovered(network->vertex_count(io_ports), false);
+    std::vector<bool> discovered(snapshot->vertex_count(io_ports), false);
     // helper function to check is a given vertex has already been discovered
     const auto is_discovered = [&discovered](const logic_network::vertex _v){ return discovered[_v]; };
 
@@ -62,19 +67,19 @@ orthogonal::jdfs_ordering orthogonal::jdfs_order() const
             jdfs = [&](const logic_network::vertex _v)
     {
         // if all predecessors are yet discovered
-        if (auto iav = network->inv_adjacent_vertices(_v, io_ports); std::all_of(iav.begin(), iav.end(), is_discovered))
+        if (auto iav = snapshot->inv_adjacent_vertices(_v, io_ports); std::all_of(iav.begin(), iav.end(), is_discovered))
         {
             discovered[_v] = true;
             ordering.push_back(_v);
 
-            for (auto&& av : network->adjacent_vertices(_v, io_ports) | iter::filterfalse(is_discovered))
+            for (auto&& av : snapshot->adjacent_vertices(_v, io_ports) | iter::filterfalse(is_discovered))
                 jdfs(av);
         }
     };
 
     // call joint dfs for each vertex without predecessors
-    for (auto&& root : network->vertices(io_ports) | iter::filter([this](const logic_network::vertex _v)
-                                                                  {return network->in_degree(_v, io_ports) == 0u;}))
+    for (auto&& root : snapshot->vertices(io_ports) | iter::filter([this](const logic_network::vertex _v)
+                                                                  {return snapshot->in_degree(_v, io_ports) == 0u;}))
         jdfs(root);
 
     return ordering;
@@ -88,13 +93,13 @@ orthogonal::red_blue_coloring orthogonal::find_rb_coloring(const jdfs_ordering&
 
 #if (PROGRESS_BARS)
     // initialize a progress bar
-    mockturtle::progress_bar coloring_bar{static_cast<uint32_t>(network->edge_count(io_ports)),
+    mockturtle::progress_bar coloring_bar{static_cast<uint32_t>(snapshot->edge_count(io_ports)),
                                           "[i] pre-processing: |{0}|"};
     uint32_t bar_counter = 0u;
 #endif
 
     // range of logic edges
-    auto edges = network->edges(io_ports);
+    auto edges = snapshot->edges(io_ports);
     // color all edges white initially
     std::for_each(edges.begin(), edges.end(),
                   [&rb_coloring](const logic_network::edge& _e){rb_coloring.emplace(_e, rb_color::WHITE);});
@@ -107,13 +112,13 @@ orthogonal::red_blue_coloring orthogonal::find_rb_coloring(const jdfs_ordering&
 
         rb_coloring[_e] = _c;
 
-        for (auto&& oe : network->out_edges(network->source(_e), io_ports))
+        for (auto&& oe : snapshot->out_edges(snapshot->source(_e), io_ports))
         {
             if (oe != _e)
                 apply(oe, contrary(_c));
         }
 
-        for (auto&& ie : network->in_edges(network->target(_e), io_ports))
+        for (auto&& ie : snapshot->in_edges(snapshot->target(_e), io_ports))
         {
             if (ie != _e)
                 apply(ie, _c);
@@ -127,7 +132,7 @@ orthogonal::red_blue_coloring orthogonal::find_rb_coloring(const jdfs_ordering&
 
     for (auto&& v : jdfs | iter::reversed)
     {
-        auto ie = network->in_edges(v, io_ports);
+        auto ie = snapshot->in_edges(v, io_ports);
         // if any ingoing edge is BLUE, color them all in BLUE, and RED otherwise
         auto color = std::any_of(ie.begin(), ie.end(),
                                  [&rb_coloring](const logic_network::edge& _e)
@@ -146,16 +151,16 @@ fcn_dimension_xy orthogonal::determine_layout_size(const red_blue_coloring& rb_c
 {
     coord_t horizontal = 0ul, vertical = 0ul;
 
-    for (auto&& v : network->vertices(io_ports))
+    for (auto&& v : snapshot->vertices(io_ports))
     {
-        if (auto degree = network->in_degree(v, io_ports); degree == 0)
+        if (auto degree = snapshot->in_degree(v, io_ports); degree == 0)
         {
             ++horizontal; ++vertical;
         }
         else if (degree == 1)
         {
             // incoming edge
-            auto in_e = *network->in_edges(v, io_ports).begin();
+            auto in_e = *snapshot->in_edges(v, io_ports).begin();
             if (rb_coloring.at(in_e) == rb_color::RED)
                 ++horizontal;
             else
@@ -163,7 +168,7 @@ fcn_dimension_xy orthogonal::determine_layout_size(const red_blue_coloring& rb_c
         }
         else if (degree == 2)
         {
-            auto ep = network->in_edges(v, io_ports).begin();
+            auto ep = snapshot->in_edges(v, io_ports).begin();
             // incoming edge 1
             const auto e1 = *ep;
             ++ep;
@@ -202,7 +207,7 @@ void orthogonal::elongate_ios() const noexcept
             continue;
 
         auto v = layout->get_logic_vertex(pi);
-        auto e = *network->out_edges(*v).begin();
+        auto e = *snapshot->out_edges(*v).begin();
 
         auto new_pi = fcn_gate_layout::tile{0, pi[Y], GROUND};
         auto pi_x = pi[X];
@@ -238,7 +243,7 @@ void orthogonal::elongate_ios() const noexcept
             continue;
 
         auto v = layout->get_logic_vertex(po);
-        auto e = *network->in_edges(*v).begin();
+        auto e = *snapshot->in_edges(*v).begin();
 
         auto new_po = fcn_gate_layout::tile{layout->x() - 1, po[Y], GROUND};
         auto po_x = po[X];
@@ -344,22 +349,22 @@ void orthogonal::orthogonal_embedding(red_blue_coloring& rb_coloring, const jdfs
     for (auto& v : jdfs)
     {
         // if operation has no predecessors, add 1 row and 1 column to the grid
-        if (network->in_degree(v, io_ports) == 0u)
+        if (snapshot->in_degree(v, io_ports) == 0u)
         {
             fcn_gate_layout::tile t{x_helper, y_helper, GROUND};
-            layout->assign_logic_vertex(t, v, io_ports ? network->is_pi(v) : network->pre_pi(v),
-                                              io_ports ? network->is_po(v) : network->post_po(v));
+            layout->assign_logic_vertex(t, v, io_ports ? snapshot->is_pi(v) : snapshot->pre_pi(v),
+                                              io_ports ? snapshot->is_po(v) : snapshot->post_po(v));
             pos.emplace(v, t);
 
             ++x_helper; ++y_helper;
         }
         // if operation has one predecessor, add either 1 row or 1 column
-        else if (network->in_degree(v, io_ports) == 1u)
+        else if (snapshot->in_degree(v, io_ports) == 1u)
         {
             // incoming edge
-            auto in_e = *network->in_edges(v, io_ports).begin();
+            auto in_e = *snapshot->in_edges(v, io_ports).begin();
             // predecessor tile
-            const auto pre_t = pos[network->source(in_e)];
+            const auto pre_t = pos[snapshot->source(in_e)];
 
             // edge is RED (horizontal)
             if (rb_coloring[in_e] == rb_color::RED)
@@ -368,8 +373,8 @@ void orthogonal::orthogonal_embedding(red_blue_coloring& rb_coloring, const jdfs
                 const auto y_pos = pre_t[Y];
 
                 fcn_gate_layout::tile t{x_helper, y_pos, GROUND};
-                layout->assign_logic_vertex(t, v, io_ports ? network->is_pi(v) : network->pre_pi(v),
-                                                  io_ports ? network->is_po(v) : network->post_po(v));
+                layout->assign_logic_vertex(t, v, io_ports ? snapshot->is_pi(v) : snapshot->pre_pi(v),
+                                                  io_ports ? snapshot->is_po(v) : snapshot->post_po(v));
                 pos.emplace(v, t);
 
                 wire_east(pre_t, t, in_e);
@@ -387,8 +392,8 @@ void orthogonal::orthogonal_embedding(red_blue_coloring& rb_coloring, const jdfs
                 const auto x_pos = pre_t[X];
 
                 fcn_gate_layout::tile t{x_pos, y_helper, GROUND};
-                layout->assign_logic_vertex(t, v, io_ports ? network->is_pi(v) : network->pre_pi(v),
-                                                  io_ports ? network->is_po(v) : network->post_po(v));
+                layout->assign_logic_vertex(t, v, io_ports ? snapshot->is_pi(v) : snapshot->pre_pi(v),
+                                                  io_ports ? snapshot->is_po(v) : snapshot->post_po(v));
                 pos.emplace(v, t);
 
                 wire_south(pre_t, t, in_e);
@@ -403,7 +408,7 @@ void orthogonal::orthogonal_embedding(red_blue_coloring& rb_coloring, const jdfs
         // operation has two predecessors
         else
         {
-            auto ep = network->in_edges(v, io_ports).begin();
+            auto ep = snapshot->in_edges(v, io_ports).begin();
             // incoming edge 1
             const auto e1 = *ep;
             ++ep;
@@ -412,8 +417,8 @@ void orthogonal::orthogonal_embedding(red_blue_coloring& rb_coloring, const jdfs
 
             // there cannot be more than two incoming wires
             const std::vector<std::pair<logic_network::edge, logic_network::vertex>>
-                    evp{std::make_pair(e1, network->source(e1)),
-                        std::make_pair(e2, network->source(e2))};
+                    evp{std::make_pair(e1, snapshot->source(e1)),
+                        std::make_pair(e2, snapshot->source(e2))};
 
             fcn_gate_layout::tile t;
 
@@ -453,8 +458,8 @@ void orthogonal::orthogonal_embedding(red_blue_coloring& rb_coloring, const jdfs
             }
 
             // place operation
-            layout->assign_logic_vertex(t, v, io_ports ? network->is_pi(v) : network->pre_pi(v),
-                                              io_ports ? network->is_po(v) : network->post_po(v));
+            layout->assign_logic_vertex(t, v, io_ports ? snapshot->is_pi(v) : snapshot->pre_pi(v),
+                                              io_ports ? snapshot->is_po(v) : snapshot->post_po(v));
             pos.emplace(v, t);
 
             // do routing dependent on colors
@@ -60,6 +60,10 @@ private:
      * Flag to indicate that designated I/O ports should be routed to the layout's borders.
      */
     const bool border_ios;
+    /**
+     * Frozen snapshot of the logic network taken after fan-out substitution. Used for all traversals.
+     */
+    logic_network_snapshot_ptr snapshot;
     /**
      * Colors used for a red-blue-coloring of 3-graphs.
      */
@@ -7,6 +7,7 @@
 
 #include "fcn_gate_layout.h"
 #include "network_hierarchy.h"
+#include "logic_network_snapshot.h"
 #include "mockturtle/utils/stopwatch.hpp"
 #include "mockturtle/utils/progress_bar.hpp"
 #include "nlohmann/json.hpp"
@@ -44,13 +45,14 @@ public:
      */
     physical_design() = default;
     /**
-     * Standard constructor.
+     * Standard constructor. The given logic network is shared and only copied if the physical design approach needs to
+     * modify it, e.g., by substituting fan-outs. See make_unique_network.
      *
      * @param ln Logic network.
      */
     explicit physical_design(std::shared_ptr<logic_network>&& ln)
             :
-            network{std::make_shared<logic_network>(*ln)}
+            network{std::move(ln)}
     {}
     /**
      * Starts a physical design process. This function need to be overridden by each sub-class.
@@ -59,6 +61,12 @@ public:
      * @return Result type containing statistical information.
      */
     virtual pd_result operator()() = 0;
+    /**
+     * Requests a running physical design process to stop as soon as possible, e.g., because its result is not needed
+     * anymore. Can be called from any thread. The interrupted process returns an unsuccessful or a less optimized
+     * result. Approaches that cannot be preempted ignore the request, which is the default.
+     */
+    virtual void interrupt() noexcept {}
     /**
      * Returns the stored layout.
      *
@@ -80,7 +88,7 @@ public:
 
 protected:
     /**
-     * Logic network to be mapped to a layout.
+     * Logic network to be mapped to a layout. Shared with the caller; call make_unique_network before modifying it.
      */
     logic_network_ptr network = nullptr;
     /**
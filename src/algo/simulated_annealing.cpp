@@ -0,0 +1,597 @@
+//
+// Created by marcel on 19.10.26.
+//
+
+#include "simulated_annealing.h"
+#include <itertools.hpp>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <thread>
+#include <tuple>
+
+
+simulated_annealing::simulated_annealing(logic_network_ptr ln, annealing_pd_config&& config)
+        :
+        physical_design(std::move(ln)),
+        config{std::move(config)},
+        routing{this->config.crossings, false, 2u, 4u, coord_t{4}},
+        generator{this->config.seed}
+{
+    // OPEN clocking is assigned the RES pattern for 4 phases, which supports fan-outs of outdegree 3 as well
+    const auto fan_out_degree = this->config.scheme->name == "OPEN4" || this->config.scheme->name == "RES" ? 3u : 2u;
+
+    // copy the network only if fan-outs have to be substituted
+    if (network->requires_fan_out_substitution())
+        make_unique_network(network)->substitute_fan_outs(fan_out_degree);
+
+    // the network is not altered anymore from here on
+    snapshot = std::make_shared<const logic_network_snapshot>(network);
+    positions.resize(snapshot->vertex_count(true));
+}
+
+physical_design::pd_result simulated_annealing::operator()()
+{
+    nlohmann::json log{};
+    mockturtle::stopwatch<>::duration time{0};
+    auto success = false;
+
+    {
+        mockturtle::stopwatch stop{time};
+
+        const auto order = topological_order();
+        initialize_layout(order);
+
+        if (!supports_degrees())
+            std::cout << "[e] the clocking scheme does not offer tiles with enough incoming or outgoing neighbors "
+                         "for all gates" << std::endl;
+        else if (construct(order))
+        {
+            const auto bb = layout->determine_bounding_box();
+            log["initial"] = {{"x", bb.max_x + 1ul}, {"y", bb.max_y + 1ul}, {"wires", layout->wire_count()},
+                              {"crossings", layout->crossing_count()}};
+
+            anneal(log);
+            layout->shrink_to_fit();
+            success = true;
+        }
+    }  // stopwatch stops here
+
+    if (success)
+    {
+        log["x"] = layout->x();
+        log["y"] = layout->y();
+        log["wires"] = layout->wire_count();
+        log["crossings"] = layout->crossing_count();
+    }
+    log["growths"] = growths;
+
+    // searches of all routers, i.e., of the construction and of all evaluated moves
+    maze_router::router_statistics routing_stats{};
+    for (const auto& r : routers)
+    {
+        const auto& rs = r.get_statistics();
+        routing_stats.searches += rs.searches;
+        routing_stats.paths += rs.paths;
+        routing_stats.runtime += rs.runtime;
+    }
+    const auto routing_time = mockturtle::to_seconds(routing_stats.runtime);
+    log["routing"] = {{"searches", routing_stats.searches}, {"paths found", routing_stats.paths},
+                      {"runtime (s)", routing_time},
+                      {"ms per net", routing_stats.searches > 0ul ?
+                                     1000.0 * routing_time / static_cast<double>(routing_stats.searches) : 0.0}};
+
+    log["runtime (s)"] = mockturtle::to_seconds(time);
+
+    return pd_result{success, log};
+}
+
+void simulated_annealing::interrupt() noexcept
+{
+    interrupted = true;
+}
+
+void simulated_annealing::initialize_layout(const std::vector<logic_network::vertex>& order) noexcept
+{
+    // the depth of the network is a lower bound for the layout's size under most clocking schemes
+    std::vector<std::size_t> level(snapshot->vertex_count(true), 0ul);
+    std::size_t depth = 0ul;
+    for (const auto v : order)
+    {
+        for (const auto& e : snapshot->in_edges(v, config.io_ports))
+            level[v] = std::max(level[v], level[snapshot->source(e)] + 1ul);
+
+        depth = std::max(depth, level[v]);
+    }
+
+    const auto n = static_cast<double>(snapshot->vertex_count(config.io_ports));
+    const auto side = std::max({coord_t{8}, static_cast<coord_t>(std::ceil(2.0 * std::sqrt(n))),
+                                static_cast<coord_t>(depth * 3ul / 4ul + 2ul)});
+
+    // a crossing layer is created in any case due to a bug in the BGL; the router decides whether to use it
+    layout = std::make_shared<fcn_gate_layout>(fcn_dimension_xyz{side, side, 2ul}, *config.scheme, network,
+                                               config.vertical_offset ? fcn_layout::offset::VERTICAL :
+                                                                        fcn_layout::offset::NONE);
+    assign_open_clocking();
+
+    routers.clear();
+    routers.emplace_back(layout, routing);
+}
+
+void simulated_annealing::grow() noexcept
+{
+    layout->resize(fcn_dimension_xyz{layout->x() + layout->x() / 2ul, layout->y() + layout->y() / 2ul, layout->z()});
+    assign_open_clocking();
+
+    // new tiles might have become available at the north-western corner
+    root_diagonal = 0ul;
+    root_y = 0ul;
+
+    ++growths;
+}
+
+void simulated_annealing::assign_open_clocking() noexcept
+{
+    if (layout->is_regularly_clocked())
+        return;
+
+    const auto& pattern = layout->num_clocks() == 3u ? fcn_clock::bancs_3 : fcn_clock::res_4;
+    for (auto y : iter::range(layout->y()))
+    {
+        for (auto x : iter::range(layout->x()))
+            layout->assign_clocking(tile{x, y, GROUND}, pattern[y % pattern.size()][x % pattern[0].size()]);
+    }
+}
+
+bool simulated_annealing::supports_degrees() const noexcept
+{
+    // two periods of every pre-defined cutout fit into this window, which is kept off the borders
+    const auto x_max = std::min(layout->x() - 1ul, coord_t{13}), y_max = std::min(layout->y() - 1ul, coord_t{13});
+
+    std::size_t max_in = 0ul, max_out = 0ul;
+    for (auto y : iter::range(coord_t{1}, y_max))
+    {
+        for (auto x : iter::range(coord_t{1}, x_max))
+        {
+            const tile t{x, y, GROUND};
+            max_in  = std::max(max_in, static_cast<std::size_t>(layout->in_degree(t)));
+            max_out = std::max(max_out, static_cast<std::size_t>(layout->out_degree(t)));
+        }
+    }
+
+    for (const auto v : snapshot->vertices(config.io_ports))
+    {
+        if (snapshot->in_degree(v, config.io_ports) > max_in || snapshot->out_degree(v, config.io_ports) > max_out)
+            return false;
+    }
+
+    return true;
+}
+
+std::vector<logic_network::vertex> simulated_annealing::topological_order() const noexcept
+{
+    std::vector<std::size_t> pending(snapshot->vertex_count(true), 0ul);
+    std::vector<logic_network::vertex> order{};
+    order.reserve(snapshot->vertex_count(config.io_ports));
+
+    for (const auto v : snapshot->vertices(config.io_ports))
+    {
+        pending[v] = snapshot->in_degree(v, config.io_ports);
+        if (pending[v] == 0ul)
+            order.push_back(v);
+    }
+
+    // order doubles as the queue of Kahn's algorithm
+    for (auto i = 0ul; i < order.size(); ++i)
+    {
+        for (const auto& e : snapshot->out_edges(order[i], config.io_ports))
+        {
+            if (const auto t = snapshot->target(e); --pending[t] == 0ul)
+                order.push_back(t);
+        }
+    }
+
+    return order;
+}
+
+bool simulated_annealing::construct(const std::vector<logic_network::vertex>& order) noexcept
+{
+#if (PROGRESS_BARS)
+    // initialize a progress bar
+    mockturtle::progress_bar construction_bar{static_cast<uint32_t>(order.size()),
+                                              "[i] constructing initial placement: |{0}|"};
+    uint32_t bar_counter = 0u;
+#endif
+
+    for (const auto v : order)
+    {
+        const auto root = snapshot->in_degree(v, config.io_ports) == 0ul;
+        while (!(root ? place_root(v) : place_gate(v)))
+        {
+            if (growths == max_growths)
+                return false;
+
+            grow();
+        }
+
+#if (PROGRESS_BARS)
+        construction_bar(++bar_counter);
+#endif
+    }
+
+    return true;
+}
+
+bool simulated_annealing::place_root(const logic_network::vertex v) noexcept
+{
+    const auto& router = routers.front();
+
+    // scan the diagonals of the north-western corner
+    for (; root_diagonal < layout->x() + layout->y(); ++root_diagonal, root_y = 0ul)
+    {
+        for (; root_y <= root_diagonal; ++root_y)
+        {
+            const auto x = root_diagonal - root_y;
+            if (x >= layout->x() || root_y >= layout->y())
+                continue;
+
+            const tile t{x, root_y, GROUND};
+            if (!has_room(t, v, router, true))
+                continue;
+
+            // keep some spacing so that gates without predecessors do not take each other's outgoing tiles
+            auto isolated = true;
+            for (const auto& n : layout->surrounding_2d(t))
+                isolated &= layout->is_free_tile(n);
+
+            if (!isolated)
+                continue;
+
+            assign_vertex(v, t);
+            ++root_y;
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool simulated_annealing::place_gate(const logic_network::vertex v) noexcept
+{
+    auto& router = routers.front();
+
+    std::vector<std::pair<logic_network::edge, tile>> inputs{};
+    coord_t sum_x = 0ul, sum_y = 0ul;
+    for (const auto& e : snapshot->in_edges(v, config.io_ports))
+    {
+        const auto s = *positions[snapshot->source(e)];
+        inputs.emplace_back(e, s);
+        sum_x += s[X];
+        sum_y += s[Y];
+    }
+
+    const auto anchor_x = static_cast<int64_t>(sum_x / inputs.size()),
+               anchor_y = static_cast<int64_t>(sum_y / inputs.size());
+
+    // candidates are compared by routing cost first and by their distance to the north-western corner second
+    using candidate_key = std::tuple<std::uint32_t, coord_t, coord_t>;
+    std::optional<candidate_key> best_key{};
+    tile best_tile{};
+    std::vector<std::pair<logic_network::edge, maze_router::routing_path>> best_paths{};
+    std::optional<coord_t> first_ring{};
+
+    const auto evaluate_candidate = [&](const tile& t)
+    {
+        if (!has_room(t, v, router, true))
+            return;
+
+        // each path is at least as long as the manhattan distance it has to bridge
+        std::uint32_t bound = 0u;
+        for (const auto& [e, s] : inputs)
+            bound += static_cast<std::uint32_t>(layout->manhattan_distance(s, t));
+
+        if (best_key && bound > std::get<0>(*best_key))
+            return;
+
+        std::uint32_t cost = 0u;
+        std::vector<std::pair<logic_network::edge, maze_router::routing_path>> candidate_paths{};
+
+        router.block(t);
+        for (const auto& [e, s] : inputs)
+        {
+            auto p = router.find_path(s, t);
+            if (!p)
+                break;
+
+            router.block(*p);
+            cost += path_cost(*p);
+            candidate_paths.emplace_back(e, std::move(*p));
+        }
+        router.clear_overlay();
+
+        if (candidate_paths.size() != inputs.size())
+            return;
+
+        if (const candidate_key key{cost, std::max(t[X], t[Y]), t[X] + t[Y]}; !best_key || key < *best_key)
+        {
+            best_key   = key;
+            best_tile  = t;
+            best_paths = std::move(candidate_paths);
+        }
+    };
+
+    // search rings of increasing manhattan distance around the centroid of all predecessors
+    for (int64_t r = 0; r <= static_cast<int64_t>(max_radius); ++r)
+    {
+        if (first_ring && static_cast<coord_t>(r) > *first_ring + extra_rings)
+            break;
+
+        for (auto dx = -r; dx <= r; ++dx)
+        {
+            const int64_t dy = r - std::abs(dx);
+            const std::array<int64_t, 2> offsets{{dy, -dy}};
+
+            for (auto i = 0ul; i < (dy == 0 ? 1ul : 2ul); ++i)
+            {
+                const auto x = anchor_x + dx, y = anchor_y + offsets[i];
+                if (x < 0 || y < 0 || x >= static_cast<int64_t>(layout->x()) ||
+                    y >= static_cast<int64_t>(layout->y()))
+                    continue;
+
+                evaluate_candidate(tile{static_cast<coord_t>(x), static_cast<coord_t>(y), GROUND});
+            }
+        }
+
+        if (best_key && !first_ring)
+            first_ring = static_cast<coord_t>(r);
+    }
+
+    if (!best_key)
+        return false;
+
+    assign_vertex(v, best_tile);
+    for (auto& [e, p] : best_paths)
+    {
+        router.assign_path(p, e);
+        paths[e] = std::move(p);
+    }
+
+    return true;
+}
+
+void simulated_annealing::assign_vertex(const logic_network::vertex v, const tile& t) noexcept
+{
+    layout->assign_logic_vertex(t, v, config.io_ports ? snapshot->is_pi(v) : snapshot->pre_pi(v),
+                                      config.io_ports ? snapshot->is_po(v) : snapshot->post_po(v));
+    positions[v] = t;
+}
+
+bool simulated_annealing::has_room(const tile& t, const logic_network::vertex v, const maze_router& router,
+                                   const bool free_outputs) const noexcept
+{
+    // wires must not cross over gates
+    if (!router.is_free(t) || (layout->z() > 1 && !router.is_free(layout->above(t))))
+        return false;
+
+    const auto out = snapshot->out_degree(v, config.io_ports);
+    if (layout->in_degree(t) < snapshot->in_degree(v, config.io_ports) || layout->out_degree(t) < out)
+        return false;
+
+    if (!free_outputs)
+        return true;
+
+    std::size_t free = 0ul;
+    for (const auto& n : layout->outgoing_clocked_tiles(t))
+    {
+        if (router.is_free(n))
+            ++free;
+    }
+
+    return free >= out;
+}
+
+void simulated_annealing::anneal(nlohmann::json& log) noexcept
+{
+    if (config.rounds == 0ul)
+        return;
+
+    const std::size_t threads_available = config.num_threads == 0ul ?
+                                          std::max(std::thread::hardware_concurrency(), 1u) : config.num_threads;
+    while (routers.size() < threads_available)
+        routers.emplace_back(layout, routing);
+
+    std::uniform_real_distribution<double> uniform{0.0, 1.0};
+    auto temperature = config.initial_temperature;
+    std::size_t proposed = 0ul, feasible = 0ul, accepted = 0ul;
+
+    auto round = 0ul;
+    for (; round < config.rounds && !interrupted; ++round)
+    {
+        // moves become more local as the temperature drops
+        const auto ratio = config.initial_temperature > 0.0 ? temperature / config.initial_temperature : 1.0;
+        const auto radius = std::max(coord_t{1}, static_cast<coord_t>(std::ceil(static_cast<double>(config.window) *
+                                                                                   ratio)));
+
+        const auto moves = propose_moves(radius);
+        std::vector<std::optional<move_evaluation>> evaluations(moves.size());
+
+        // evaluations only read the layout and can therefore run in parallel
+        std::atomic<std::size_t> next_move{0ul};
+        const auto worker = [this, &moves, &evaluations, &next_move](maze_router& router)
+        {
+            for (auto i = next_move++; i < moves.size(); i = next_move++)
+                evaluations[i] = evaluate(moves[i], router);
+        };
+
+        // the calling thread works as well
+        std::vector<std::thread> threads{};
+        for (auto t = 1ul; t < routers.size(); ++t)
+            threads.emplace_back(worker, std::ref(routers[t]));
+
+        worker(routers.front());
+
+        for (auto& t : threads)
+            t.join();
+
+        // apply moves in order of proposal and skip those that read tiles which have been altered in the meantime
+        ground_set altered{};
+        for (auto i : iter::range(moves.size()))
+        {
+            ++proposed;
+
+            auto& me = evaluations[i];
+            if (!me)
+                continue;
+
+            ++feasible;
+
+            if (std::any_of(me->footprint.cbegin(), me->footprint.cend(),
+                            [&altered](const auto& g){ return altered.count(g) > 0ul; }))
+                continue;
+
+            // Metropolis criterion
+            if (me->delta > 0.0 && (temperature <= 0.0 || uniform(generator) >= std::exp(-me->delta / temperature)))
+                continue;
+
+            apply(moves[i], *me);
+            altered.insert(me->footprint.cbegin(), me->footprint.cend());
+            ++accepted;
+        }
+
+        temperature *= config.cooling;
+    }
+
+    log["annealing"] = {{"rounds", round}, {"proposed moves", proposed}, {"feasible moves", feasible},
+                        {"accepted moves", accepted}, {"threads", routers.size()}};
+}
+
+std::vector<simulated_annealing::gate_move> simulated_annealing::propose_moves(const coord_t radius) noexcept
+{
+    std::vector<logic_network::vertex> gates{};
+    for (const auto v : snapshot->vertices(config.io_ports))
+        gates.push_back(v);
+
+    std::shuffle(gates.begin(), gates.end(), generator);
+
+    const auto r = static_cast<int64_t>(radius);
+    std::uniform_int_distribution<int64_t> offset{-r, r};
+
+    std::vector<gate_move> moves{};
+    moves.reserve(gates.size());
+    for (const auto v : gates)
+    {
+        const auto& t = *positions[v];
+        const auto dx = offset(generator), dy = offset(generator);
+        const auto x = static_cast<int64_t>(t[X]) + dx, y = static_cast<int64_t>(t[Y]) + dy;
+
+        if ((dx == 0 && dy == 0) || x < 0 || y < 0 || x >= static_cast<int64_t>(layout->x()) ||
+            y >= static_cast<int64_t>(layout->y()))
+            continue;
+
+        moves.push_back({v, tile{static_cast<coord_t>(x), static_cast<coord_t>(y), GROUND}});
+    }
+
+    return moves;
+}
+
+std::optional<simulated_annealing::move_evaluation>
+simulated_annealing::evaluate(const gate_move& m, maze_router& router) const noexcept
+{
+    const auto& old = *positions[m.v];
+    move_evaluation me{0.0, {}, {}};
+
+    const auto add_footprint = [&me](const tile& t){ me.footprint.insert(tile{t[X], t[Y], GROUND}); };
+
+    std::vector<logic_network::edge> incident{};
+    for (const auto& e : snapshot->in_edges(m.v, config.io_ports))
+        incident.push_back(e);
+    for (const auto& e : snapshot->out_edges(m.v, config.io_ports))
+        incident.push_back(e);
+
+    // rip up all paths of the moved vertex in the overlay
+    router.clear_overlay();
+    std::uint32_t old_cost = 0u;
+    for (const auto& e : incident)
+    {
+        const auto& p = paths.at(e);
+        router.release(p);
+        old_cost += path_cost(p);
+
+        for (const auto& t : p.tiles)
+            add_footprint(t);
+    }
+    router.release(old);
+
+    // outgoing tiles of the target do not need to be free since all outgoing paths are routed right away
+    if (!has_room(m.target, m.v, router, false))
+        return std::nullopt;
+
+    router.block(m.target);
+    add_footprint(old);
+    add_footprint(m.target);
+
+    std::uint32_t new_cost = 0u;
+    for (const auto& e : incident)
+    {
+        const auto in = snapshot->target(e) == m.v;
+        auto p = in ? router.find_path(*positions[snapshot->source(e)], m.target) :
+                      router.find_path(m.target, *positions[snapshot->target(e)]);
+        if (!p)
+            return std::nullopt;
+
+        router.block(*p);
+        new_cost += path_cost(*p);
+
+        for (const auto& t : p->tiles)
+            add_footprint(t);
+
+        me.new_paths.emplace_back(e, std::move(*p));
+    }
+
+    const auto old_distance = static_cast<double>(old[X] + old[Y]),
+               new_distance = static_cast<double>(m.target[X] + m.target[Y]);
+
+    me.delta = static_cast<double>(new_cost) - static_cast<double>(old_cost) +
+               area_weight * (new_distance - old_distance);
+
+    return me;
+}
+
+void simulated_annealing::apply(const gate_move& m, move_evaluation& me) noexcept
+{
+    auto& router = routers.front();
+    router.clear_overlay();
+
+    const auto old = *positions[m.v];
+    const auto pi = layout->is_pi(old), po = layout->is_po(old);
+
+    for (const auto& [e, p] : me.new_paths)
+    {
+        // wires that crossed over the ripped up path run through the ground layer now
+        for (const auto& [f, g] : router.rip_up(paths.at(e)))
+        {
+            auto& lowered = paths.at(f);
+            std::replace(lowered.tiles.begin(), lowered.tiles.end(), layout->above(g), g);
+            --lowered.crossings;
+        }
+    }
+
+    layout->clear_tile(old);
+    layout->assign_logic_vertex(m.target, m.v, pi, po);
+    positions[m.v] = m.target;
+
+    for (auto& [e, p] : me.new_paths)
+    {
+        router.assign_path(p, e);
+        paths[e] = std::move(p);
+    }
+}
+
+std::uint32_t simulated_annealing::path_cost(const maze_router::routing_path& p) const noexcept
+{
+    return static_cast<std::uint32_t>(p.tiles.size() - 1ul) + routing.crossing_cost *
+                                                                static_cast<std::uint32_t>(p.crossings);
+}
@@ -0,0 +1,272 @@
+//
+// Created by marcel on 19.10.26.
+//
+
+#ifndef FICTION_SIMULATED_ANNEALING_H
+#define FICTION_SIMULATED_ANNEALING_H
+
+#include "physical_design.h"
+#include "annealing_pd_config.h"
+#include "maze_router.h"
+#include <atomic>
+#include <optional>
+#include <random>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+
+/**
+ * A scalable heuristic physical design approach that works for arbitrary clocking schemes. In contrast to orthogonal,
+ * which is bound to 2DDWave, and to exact, which does not scale beyond a few dozen gates, this approach combines a
+ * greedy construction with simulated annealing and routes all connections with a maze_router, which respects any
+ * clocking scheme by only following outgoing clocked tiles.
+ *
+ * During construction, gates are placed in topological order. Gates without predecessors are put close to the
+ * layout's north-western corner with some spacing, whereas every other gate is put on the tile close to the centroid
+ * of its predecessors from which all incoming connections can be routed most cheaply. If no such tile exists, the
+ * layout is enlarged.
+ *
+ * Afterwards, the placement is improved in rounds of simulated annealing. In each round, a random displacement is
+ * proposed for every gate whose distance shrinks with the temperature. Displacements are evaluated by ripping up and
+ * rerouting all connections of the respective gate in a router overlay without touching the layout, which allows to
+ * evaluate all of them in parallel. The cost of a placement is the summed cost of its paths plus a small penalty for
+ * the distance of gates to the north-western corner such that layouts are compacted over time. Evaluated moves are
+ * then accepted sequentially according to the Metropolis criterion while moves whose footprint on the ground layer
+ * overlaps with an already applied one are skipped. Finally, the layout is shrunk to fit.
+ *
+ * Open clocking schemes are assigned the RES (4 phases) or BANCS (3 phases) clocking pattern beforehand since the
+ * approach does not determine clock numbers itself.
+ */
+class simulated_annealing : public physical_design
+{
+public:
+    /**
+     * Standard constructor.
+     *
+     * @param ln Logic network.
+     * @param config Configuration object storing the clocking scheme, the annealing schedule, etc.
+     */
+    simulated_annealing(logic_network_ptr ln, annealing_pd_config&& config);
+    /**
+     * Starts the physical design process. Constructs an initial placement and routing, which is improved by simulated
+     * annealing afterwards.
+     *
+     * Returns a pd_result eventually.
+     *
+     * @return Result type containing statistical information about the process.
+     */
+    pd_result operator()() override;
+    /**
+     * Stops the annealing after the current round. The layout obtained so far remains valid.
+     */
+    void interrupt() noexcept override;
+
+private:
+    /**
+     * Alias for tiles.
+     */
+    using tile = fcn_gate_layout::tile;
+    /**
+     * Alias for a set of ground layer tiles.
+     */
+    using ground_set = std::unordered_set<tile, boost::hash<tile>>;
+    /**
+     * Configuration object storing the clocking scheme, the annealing schedule, etc.
+     */
+    const annealing_pd_config config;
+    /**
+     * Frozen snapshot of the logic network taken after fan-out substitution. Used for all traversals.
+     */
+    logic_network_snapshot_ptr snapshot;
+    /**
+     * Placed tile of each vertex.
+     */
+    std::vector<std::optional<tile>> positions{};
+    /**
+     * Routed path of each logic edge.
+     */
+    std::unordered_map<logic_network::edge, maze_router::routing_path, boost::hash<logic_network::edge>> paths{};
+    /**
+     * Configuration of all routers. Latches are not used since they would alter the layout's timing.
+     */
+    const maze_router::router_config routing;
+    /**
+     * One router per thread. The first one is used to modify the layout.
+     */
+    std::vector<maze_router> routers{};
+    /**
+     * Random number generator that proposes and accepts moves.
+     */
+    std::mt19937_64 generator;
+    /**
+     * Flag to indicate that interrupt has been called.
+     */
+    std::atomic<bool> interrupted{false};
+    /**
+     * Next position on the diagonals of the north-western corner to place a gate without predecessors at.
+     */
+    coord_t root_diagonal = 0ul, root_y = 0ul;
+    /**
+     * Number of times the layout had to be enlarged.
+     */
+    std::size_t growths = 0ul;
+    /**
+     * Maximum number of times the layout may be enlarged before the construction is given up.
+     */
+    static constexpr std::size_t max_growths = 8ul;
+    /**
+     * Maximum distance from the centroid of a gate's predecessors at which it is placed during construction.
+     */
+    static constexpr coord_t max_radius = 24ul;
+    /**
+     * Number of additional rings around the centroid that are searched for cheaper tiles after the first feasible one.
+     */
+    static constexpr coord_t extra_rings = 2ul;
+    /**
+     * Cost of moving a gate one tile away from the north-western corner.
+     */
+    static constexpr double area_weight = 0.5;
+    /**
+     * A proposed displacement of a gate.
+     */
+    struct gate_move
+    {
+        /**
+         * Vertex to move.
+         */
+        logic_network::vertex v;
+        /**
+         * Tile to move v to.
+         */
+        tile target;
+    };
+    /**
+     * Result of the evaluation of a gate_move.
+     */
+    struct move_evaluation
+    {
+        /**
+         * Change of the placement's cost if the move was applied.
+         */
+        double delta;
+        /**
+         * New paths of all logic edges incident to the moved vertex.
+         */
+        std::vector<std::pair<logic_network::edge, maze_router::routing_path>> new_paths;
+        /**
+         * Ground tiles that have been read by the evaluation or would be altered by the move.
+         */
+        ground_set footprint;
+    };
+    /**
+     * Creates the layout, assigns a clocking pattern if the clocking scheme is open, and sets up the routers. The
+     * layout's initial size is derived from the number of vertices and the depth of the logic network.
+     *
+     * @param order Vertices in topological order.
+     */
+    void initialize_layout(const std::vector<logic_network::vertex>& order) noexcept;
+    /**
+     * Enlarges the layout by half of its size in both dimensions.
+     */
+    void grow() noexcept;
+    /**
+     * Assigns the RES or BANCS clocking pattern to all tiles of an open clocking scheme.
+     */
+    void assign_open_clocking() noexcept;
+    /**
+     * Checks whether the clocking scheme offers tiles with enough incoming and outgoing clocked neighbors to host
+     * every vertex of the logic network.
+     *
+     * @return True, iff all vertices can be hosted.
+     */
+    bool supports_degrees() const noexcept;
+    /**
+     * Computes a topological ordering of the logic network via Kahn's algorithm.
+     *
+     * @return All vertices in topological order.
+     */
+    std::vector<logic_network::vertex> topological_order() const noexcept;
+    /**
+     * Places and routes all vertices in topological order. The layout is enlarged as needed.
+     *
+     * @param order Vertices in topological order.
+     * @return True, iff all vertices could be placed and routed.
+     */
+    bool construct(const std::vector<logic_network::vertex>& order) noexcept;
+    /**
+     * Places a vertex without predecessors on the next free tile in the north-western corner whose neighbors are
+     * free as well.
+     *
+     * @param v Vertex to place.
+     * @return True, iff a tile was found.
+     */
+    bool place_root(const logic_network::vertex v) noexcept;
+    /**
+     * Places a vertex on the tile close to the centroid of its predecessors from which all incoming edges can be routed
+     * most cheaply and routes them.
+     *
+     * @param v Vertex to place.
+     * @return True, iff a tile was found.
+     */
+    bool place_gate(const logic_network::vertex v) noexcept;
+    /**
+     * Assigns vertex v to tile t in the layout and stores its position.
+     *
+     * @param v Vertex to assign.
+     * @param t Tile to assign v to.
+     */
+    void assign_vertex(const logic_network::vertex v, const tile& t) noexcept;
+    /**
+     * Checks whether tile t is able to host vertex v with respect to the given router's overlay, i.e., whether t and
+     * the tile above it are free and t has enough incoming and outgoing clocked neighbors.
+     *
+     * @param t Tile to check.
+     * @param v Vertex to host.
+     * @param router Router whose overlay is considered.
+     * @param free_outputs Flag to additionally require enough free outgoing clocked neighbors.
+     * @return True, iff t can host v.
+     */
+    bool has_room(const tile& t, const logic_network::vertex v, const maze_router& router,
+                  const bool free_outputs) const noexcept;
+    /**
+     * Improves the placement by simulated annealing.
+     *
+     * @param log JSON object to store statistics in.
+     */
+    void anneal(nlohmann::json& log) noexcept;
+    /**
+     * Proposes a random displacement for every placed vertex.
+     *
+     * @param radius Maximum distance of a displacement in each direction.
+     * @return Proposed moves in random order.
+     */
+    std::vector<gate_move> propose_moves(const coord_t radius) noexcept;
+    /**
+     * Evaluates the given move by rerouting all edges incident to the moved vertex in the router's overlay. The layout
+     * is not modified.
+     *
+     * @param m Move to evaluate.
+     * @param router Router to use.
+     * @return Evaluation of m or std::nullopt if not all edges could be rerouted.
+     */
+    std::optional<move_evaluation> evaluate(const gate_move& m, maze_router& router) const noexcept;
+    /**
+     * Applies the given evaluated move to the layout, i.e., rips up the old paths, moves the vertex, and assigns the
+     * new paths.
+     *
+     * @param m Move to apply.
+     * @param me Evaluation of m.
+     */
+    void apply(const gate_move& m, move_evaluation& me) noexcept;
+    /**
+     * Returns the cost of a path, i.e., its length plus penalties for crossings.
+     *
+     * @param p Path whose cost is desired.
+     * @return Cost of p.
+     */
+    std::uint32_t path_cost(const maze_router::routing_path& p) const noexcept;
+};
+
+
+#endif //FICTION_SIMULATED_ANNEALING_H
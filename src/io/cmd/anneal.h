@@ -0,0 +1,185 @@
+//
+// Created by marcel on 19.10.26.
+//
+
+#ifndef FICTION_CMD_ANNEAL_H
+#define FICTION_CMD_ANNEAL_H
+
+
+#include "../../algo/simulated_annealing.h"
+#include "fcn_gate_layout.h"
+#include "fcn_clocking_scheme.h"
+#include "logic_network.h"
+#include "background_jobs.h"
+#include <fmt/format.h>
+#include <alice/alice.hpp>
+#include <nlohmann/json.hpp>
+
+
+namespace alice
+{
+    /**
+     * Executes a scalable heuristic physical design approach based on simulated annealing that supports arbitrary
+     * clocking schemes. See algo/simulated_annealing.h for more details.
+     */
+    class anneal_command : public command
+    {
+    public:
+        /**
+         * Standard constructor. Adds descriptive information, options, and flags.
+         *
+         * @param env alice::environment that specifies stores etc.
+         */
+        explicit anneal_command(const environment::ptr& env)
+                :
+                command(env, "Performs scalable placement and routing of the current logic network in store under "
+                             "any clocking scheme. An FCN layout that is not minimal will be found in reasonable "
+                             "runtime by simulated annealing.")
+        {
+            add_option("--clk_scheme,-s", clocking,
+                       "Clocking scheme to use {OPEN[3|4], 2DDWAVE[3|4], USE, RES, BANCS, TOPOLINANO[3|4]}", true);
+            add_option("--rounds,-r", config.rounds,
+                       "Number of annealing rounds (0 keeps the initial placement)", true);
+            add_option("--threads,-n", config.num_threads,
+                       "Number of threads to evaluate moves with (0 means all available)", true);
+            add_option("--temperature,-t", config.initial_temperature,
+                       "Initial temperature in tiles", true);
+            add_option("--cooling,-c", config.cooling,
+                       "Factor by which the temperature is multiplied after each round", true);
+            add_option("--window,-w", config.window,
+                       "Maximum distance in tiles a gate is moved in each direction in the first round", true);
+            add_option("--seed", config.seed,
+                       "Seed of the random number generator", true);
+
+            add_flag("--io_ports,-i", config.io_ports,
+                     "Use I/O port elements instead of gate pins");
+            add_flag("--planar,-p", planar,
+                     "Do not use wire crossings");
+            add_flag("--bg",
+                     "Run in the background; see jobs, wait, and kill");
+        }
+
+    protected:
+        /**
+         * Function to perform the physical design call. Generates a placed and routed FCN gate layout.
+         */
+        void execute() override
+        {
+            auto& s = store<logic_network_ptr>();
+
+            // error case: empty logic network store
+            if (s.empty())
+            {
+                env->out() << "[w] no logic network in store" << std::endl;
+                reset_flags();
+                return;
+            }
+            // error case: cooling factor would not cool
+            if (config.cooling <= 0.0 || config.cooling > 1.0)
+            {
+                env->out() << "[e] the cooling factor has to be in (0, 1]" << std::endl;
+                reset_flags();
+                return;
+            }
+
+            // choose clocking
+            if (auto clk = get_clocking_scheme(clocking))
+            {
+                config.scheme = std::make_shared<fcn_clocking_scheme>(*clk);
+            }
+            else
+            {
+                env->out() << "[e] \"" << clocking << "\" does not refer to a supported clocking scheme" << std::endl;
+                reset_flags();
+                return;
+            }
+            // if clocking is a ToPoliNano one, set a respective flag
+            if (config.scheme->name == "TOPOLINANO3" || config.scheme->name == "TOPOLINANO4")
+                config.vertical_offset = true;
+
+            config.crossings = !planar;
+
+            // networks are copied on write, i.e., the shared network serves as a snapshot for background jobs
+            auto pd = std::make_shared<simulated_annealing>(s.current(), std::move(config));
+
+            const auto name = s.current()->get_name();
+            const auto run = [this, pd, name](std::ostream& out) -> background_jobs::job_result
+            {
+                if (auto result = (*pd)(); result.success)
+                {
+                    const auto& json = result.json;
+                    out << fmt::format("[i] area: {} × {} = {}, wires: {}, crossings: {}, runtime: {:.2f} s",
+                                       json["x"].get<std::size_t>(), json["y"].get<std::size_t>(),
+                                       json["x"].get<std::size_t>() * json["y"].get<std::size_t>(),
+                                       json["wires"].get<std::size_t>(), json["crossings"].get<std::size_t>(),
+                                       json["runtime (s)"].get<double>()) << std::endl;
+
+                    return {[this, pd]{ store<fcn_gate_layout_ptr>().extend() = pd->get_layout(); }, result.json};
+                }
+
+                out << "[e] impossible to place and route " << name << " within the given parameters" << std::endl;
+                return {};
+            };
+
+            if (this->is_set("bg"))
+            {
+                const auto id = background_jobs::get().launch(fmt::format("anneal on {}", name), run,
+                                                              [pd]{ pd->interrupt(); });
+                env->out() << fmt::format("[i] started job {}", id) << std::endl;
+                pd_result = {{"job", id}};
+            }
+            else
+            {
+                auto result = run(env->out());
+                if (result.commit)
+                    result.commit();
+                pd_result = result.log;
+            }
+
+            reset_flags();
+        }
+
+        /**
+         * Logs the resulting information in a log file.
+         *
+         * @return JSON object containing information about the physical design process.
+         */
+        nlohmann::json log() const override
+        {
+            return pd_result;
+        }
+
+    private:
+        /**
+         * Configuration object extracted from arguments and flags.
+         */
+        annealing_pd_config config{};
+        /**
+         * Identifier of clocking scheme to use.
+         */
+        std::string clocking = "2DDWAVE4";
+        /**
+         * Flag to indicate that wires must not cross.
+         */
+        bool planar = false;
+        /**
+         * Resulting logging information.
+         */
+        nlohmann::json pd_result;
+
+        /**
+         * Reset all flags. Necessary for some reason... alice bug?
+         */
+        void reset_flags()
+        {
+            config = annealing_pd_config{};
+            clocking = "2DDWAVE4";
+            planar = false;
+        }
+    };
+
+    ALICE_ADD_COMMAND(anneal, "Physical Design")
+}
+
+
+#endif //FICTION_CMD_ANNEAL_H
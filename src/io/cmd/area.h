@@ -76,9 +76,7 @@ namespace alice
                 vspace = fcl->get_technology() == fcn::technology::QCA ? area_defaults::qca::vspace : area_defaults::inml::vspace;
             }
 
-            const auto bb = fcl->determine_bounding_box();
-
-            area = (bb.x_size * width + (bb.x_size - 1) * hspace) * (bb.y_size * height + (bb.y_size - 1) * vspace);
+            area = fcl->determine_statistics().area(width, height, hspace, vspace);
 
             env->out() << fmt::format("[i] {} nm²", area) << std::endl;
         }
@@ -53,7 +53,8 @@ namespace alice
                 return;
             }
 
-            auto ln = s.current();
+            // layouts and background jobs might share the network
+            auto ln = make_unique_network(s.current());
             network_hierarchy hier(ln, false);
 
             if (is_set("unify_outputs"))
@@ -0,0 +1,358 @@
+//
+// Created by marcel on 19.10.26.
+//
+
+#ifndef FICTION_CMD_BATCH_H
+#define FICTION_CMD_BATCH_H
+
+
+#include "tt_reader.h"
+#include "csv_writer.h"
+#if MUGEN
+#include "../../algo/one_pass_synthesis.h"
+#include "fcn_clocking_scheme.h"
+#endif
+#include <alice/alice.hpp>
+#include <fmt/format.h>
+#include <kitty/dynamic_truth_table.hpp>
+#include <kitty/operators.hpp>
+#include <kitty/print.hpp>
+#include <mockturtle/algorithms/akers_synthesis.hpp>
+#include <mockturtle/networks/mig.hpp>
+#include <mockturtle/utils/stopwatch.hpp>
+#include <mockturtle/views/depth_view.hpp>
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+
+namespace alice
+{
+    /**
+     * Synthesizes all truth tables of a file, e.g., an NPN class dump, one after another without storing them. Results
+     * are streamed to a CSV file.
+     */
+    class batch_command : public command
+    {
+    public:
+        /**
+         * Standard constructor. Adds descriptive information, options, and flags.
+         *
+         * @param env alice::environment that specifies stores etc.
+         */
+        explicit batch_command(const environment::ptr& env)
+                :
+                command(env,
+                        "Synthesizes each truth table of the given file, in which each line starts with a truth "
+                        "table in hexadecimal form, and appends the results to a CSV file instead of adding them to "
+                        "the stores. By default, Akers' synthesis is performed by a pool of worker threads and the "
+                        "resulting Majority networks are written as expressions that can be read by tt -e. "
+#if MUGEN
+                        "Alternatively, each function can be synthesized to a gate layout via onepass with all "
+                        "gate types enabled."
+#endif
+                        )
+        {
+            add_option("filename,--filename", filename,
+                       "Truth table file")->required();
+            add_option("--output,-o", output,
+                       "CSV file to append the results to", true);
+            add_option("--threads,-n", num_threads,
+                       "Number of worker threads for Akers' synthesis or worker processes per function for onepass "
+                       "(default: number of available threads)");
+#if MUGEN
+            add_flag("--onepass,-p",
+                     "Synthesize gate layouts via onepass instead of Majority networks via Akers' synthesis");
+            add_option("--clk_scheme,-s", clocking,
+                       "Clocking scheme to use for onepass {2DDWAVE[3|4], USE, RES, BANCS}", true);
+            add_option("--upper_bound,-u", upper_bound,
+                       "Number of FCN gate tiles to use at maximum for onepass");
+            add_option("--timeout,-t", timeout,
+                       "Timeout in seconds per function for onepass");
+#endif
+        }
+
+    protected:
+        /**
+         * Function to perform the batch call. Reads truth tables one by one and synthesizes them.
+         */
+        void execute() override
+        {
+            num_functions = 0ul;
+            num_failed = 0ul;
+            runtime = mockturtle::stopwatch<>::duration{0};
+
+            tt_reader reader{filename};
+            if (!reader.is_open())
+            {
+                env->out() << fmt::format("[e] could not read truth tables from {}", filename) << std::endl;
+                reset_flags();
+                return;
+            }
+
+            // only new files get a header
+            const bool header = !std::ifstream{output}.good();
+            csv_writer csv{output};
+
+            {
+                mockturtle::stopwatch stop{runtime};
+
+#if MUGEN
+                if (is_set("onepass"))
+                {
+                    if (header)
+                        csv.write_line("index", "function", "x", "y", "gates", "wires", "crossings", "runtime (s)");
+
+                    if (!synthesize_layouts(reader, csv))
+                    {
+                        reset_flags();
+                        return;
+                    }
+                }
+                else
+#endif
+                {
+                    if (header)
+                        csv.write_line("index", "function", "gates", "depth", "network");
+
+                    synthesize_networks(reader, csv);
+                }
+            }
+
+            env->out() << fmt::format("[i] synthesized {} functions from {} in {:.2f} s, {} failed; results were "
+                                      "appended to {}", num_functions, filename, mockturtle::to_seconds(runtime),
+                                      num_failed, output) << std::endl;
+
+            reset_flags();
+        }
+
+    private:
+        /**
+         * Truth table file to read.
+         */
+        std::string filename;
+        /**
+         * CSV file to write the results into.
+         */
+        std::string output{"batch.csv"};
+        /**
+         * Number of worker threads or processes. 0 means number of available threads.
+         */
+        std::size_t num_threads = 0ul;
+#if MUGEN
+        /**
+         * Identifier of clocking scheme to use for onepass.
+         */
+        std::string clocking = "2DDWave";
+        /**
+         * Maximum number of tiles for onepass.
+         */
+        std::size_t upper_bound = std::numeric_limits<unsigned>::max();
+        /**
+         * Timeout in seconds per function for onepass.
+         */
+        uint32_t timeout = 0u;
+#endif
+        /**
+         * Number of functions read and synthesized by the last call.
+         */
+        std::size_t num_functions = 0ul, num_failed = 0ul;
+        /**
+         * Runtime of the last call.
+         */
+        mockturtle::stopwatch<>::duration runtime{0};
+
+        /**
+         * Synthesizes Majority networks via Akers' synthesis for all truth tables of the given reader. Worker threads
+         * fetch the next function from the reader themselves such that only as many truth tables as there are workers
+         * are held in memory at once.
+         *
+         * @param reader Reader to fetch truth tables from.
+         * @param csv Writer to stream the results to.
+         */
+        void synthesize_networks(tt_reader& reader, csv_writer& csv)
+        {
+            std::mutex read_mutex{}, write_mutex{};
+            std::size_t next_index = 0ul;
+
+            const auto fetch = [&reader, &read_mutex, &next_index]
+                    () -> std::optional<std::pair<std::size_t, kitty::dynamic_truth_table>>
+            {
+                std::lock_guard<std::mutex> guard(read_mutex);
+
+                if (auto tt = reader.next(); tt)
+                    return std::make_pair(next_index++, std::move(*tt));
+
+                return std::nullopt;
+            };
+
+            const auto worker = [&fetch, &csv, &write_mutex]
+            {
+                for (auto job = fetch(); job; job = fetch())
+                {
+                    const auto& [index, tt] = *job;
+
+                    // all assignments are cared for
+                    const auto mig = mockturtle::akers_synthesis<mockturtle::mig_network>(tt, ~tt.construct());
+                    const mockturtle::depth_view<mockturtle::mig_network> depth_mig{mig};
+                    const auto expression = to_expression(mig);
+
+                    std::lock_guard<std::mutex> guard(write_mutex);
+                    csv.write_line(index, kitty::to_hex(tt), mig.num_gates(), depth_mig.depth(), expression);
+                }
+            };
+
+            // the calling thread works as well
+            const std::size_t threads_available = num_threads == 0ul ?
+                                                  std::max(std::thread::hardware_concurrency(), 1u) : num_threads;
+            std::vector<std::thread> threads{};
+            for (auto t = 1ul; t < threads_available; ++t)
+                threads.emplace_back(worker);
+
+            worker();
+
+            for (auto& t : threads)
+                t.join();
+
+            num_functions = next_index;
+        }
+#if MUGEN
+        /**
+         * Synthesizes gate layouts via onepass for all truth tables of the given reader. Since the embedded Python
+         * interpreter cannot run multiple instances of Mugen concurrently, functions are processed one after another
+         * but the dimensions of each one are explored in parallel by onepass' pool of forked worker processes.
+         *
+         * @param reader Reader to fetch truth tables from.
+         * @param csv Writer to stream the results to.
+         * @return false iff the configuration is invalid.
+         */
+        bool synthesize_layouts(tt_reader& reader, csv_writer& csv)
+        {
+            const auto clk = get_clocking_scheme(clocking);
+            if (!clk)
+            {
+                env->out() << "[e] \"" << clocking << "\" does not refer to a supported clocking scheme" << std::endl;
+                return false;
+            }
+            if (auto name = clk->name; name == "OPEN3" || name == "OPEN4" ||
+                                       name == "TOPOLINANO3" || name == "TOPOLINANO4")
+            {
+                env->out() << "[e] the \"" << name << "\" clocking scheme is not supported by onepass" << std::endl;
+                return false;
+            }
+
+            onepass_pd_config base{};
+            base.scheme = std::make_shared<fcn_clocking_scheme>(*clk);
+            base.upper_bound = upper_bound;
+            base.timeout = timeout;
+            base.num_processes = num_threads == 0ul ? std::max(std::thread::hardware_concurrency(), 1u) : num_threads;
+            base.enable_and = base.enable_or = base.enable_not = base.enable_wires = true;
+            // MAJ gates are only supported by RES
+            base.enable_maj = base.scheme->name == "RES";
+
+            for (auto tt = reader.next(); tt; tt = reader.next(), ++num_functions)
+            {
+                auto config = base;
+                config.name = kitty::to_hex(*tt);
+
+                one_pass_synthesis physical_design{{*tt}, std::move(config)};
+
+                if (const auto result = physical_design(); result.success)
+                {
+                    const auto fgl = physical_design.get_layout();
+                    csv.write_line(num_functions, kitty::to_hex(*tt), fgl->x(), fgl->y(), fgl->gate_count(true),
+                                   fgl->wire_count(), fgl->crossing_count(),
+                                   result.json["runtime (s)"].get<double>());
+                }
+                else
+                {
+                    ++num_failed;
+                    csv.write_line(num_functions, kitty::to_hex(*tt), "", "", "", "", "",
+                                   result.json["runtime (s)"].get<double>());
+                }
+            }
+
+            return true;
+        }
+#endif
+        /**
+         * Expresses the given single-output MIG in the expression format of tt -e, i.e., <EEE> for majority, !E for
+         * negation, variables a, b, ..., p, and constants 0 and 1.
+         *
+         * @param mig MIG to express.
+         * @return Expression of mig's first output.
+         */
+        static std::string to_expression(const mockturtle::mig_network& mig) noexcept
+        {
+            std::vector<std::string> expressions(mig.size());
+
+            const auto signal_expression = [&mig, &expressions](const auto& f)
+            {
+                const auto n = mig.get_node(f);
+                if (mig.is_constant(n))
+                    return std::string{mig.is_complemented(f) ? "1" : "0"};
+
+                return (mig.is_complemented(f) ? "!" : "") + expressions[mig.node_to_index(n)];
+            };
+
+            mig.foreach_pi([&](const auto& pi, auto i)
+            {
+                expressions[mig.node_to_index(pi)] = std::string(1, static_cast<char>('a' + i));
+            });
+            mig.foreach_gate([&](const auto& g)
+            {
+                std::string expression{"<"};
+                mig.foreach_fanin(g, [&](const auto& f){ expression += signal_expression(f); });
+                expressions[mig.node_to_index(g)] = expression + ">";
+            });
+
+            std::string result{};
+            mig.foreach_po([&](const auto& f)
+            {
+                result = signal_expression(f);
+                return false;
+            });
+
+            return result;
+        }
+        /**
+         * Reset all flags. Necessary for some reason... alice bug?
+         */
+        void reset_flags()
+        {
+            filename = "";
+            output = "batch.csv";
+            num_threads = 0ul;
+#if MUGEN
+            clocking = "2DDWave";
+            upper_bound = std::numeric_limits<unsigned>::max();
+            timeout = 0u;
+#endif
+        }
+        /**
+         * Logs the resulting information in a log file.
+         *
+         * @return JSON object containing information about the batch run.
+         */
+        nlohmann::json log() const override
+        {
+            return
+            {
+                {"functions", num_functions},
+                {"failed", num_failed},
+                {"runtime (s)", mockturtle::to_seconds(runtime)}
+            };
+        }
+    };
+
+    ALICE_ADD_COMMAND(batch, "Logic")
+}
+
+
+#endif //FICTION_CMD_BATCH_H
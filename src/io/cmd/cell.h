@@ -9,7 +9,9 @@
 #include "qca_one_library.h"
 #include "topolinano_library.h"
 #include "fcn_cell_layout.h"
+#include "background_jobs.h"
 #include <alice/alice.hpp>
+#include <fmt/format.h>
 #include <string>
 
 
@@ -35,6 +37,8 @@ namespace alice
         {
             add_option("--library,-l", library,
                        "Gate library to use for mapping", true)->set_type_name("{QCA-ONE=0, ToPoliNano=1}");
+            add_flag("--bg",
+                     "Run in the background; see jobs, wait, and kill");
         }
 
     protected:
@@ -108,19 +112,33 @@ namespace alice
                 return;
             }
 
-            try
+            // the library holds a shared pointer to the gate layout, which serves as a snapshot for background jobs
+            const auto name = fgl->get_name();
+            const auto run = [this, lib, name, lib_name](std::ostream& out) -> background_jobs::job_result
             {
-                auto fcl = std::make_shared<fcn_cell_layout>(std::move(lib));
+                try
+                {
+                    auto fcl = std::make_shared<fcn_cell_layout>(fcn_gate_library_ptr{lib});
+
+                    // store new layout
+                    return {[this, fcl]{ store<fcn_cell_layout_ptr>().extend() = fcl; }, {}};
+                }
+                catch (...)
+                {
+                    out << "[e] mapping " << name << " to cell-level using the " << lib_name
+                        << " library was not successful" << std::endl;
+                    return {};
+                }
+            };
 
-                // store new layout
-                store<fcn_cell_layout_ptr>().extend() = std::move(fcl);
+            if (is_set("bg"))
+            {
+                const auto id = background_jobs::get().launch(fmt::format("cell on {}", name), run);
+                env->out() << fmt::format("[i] started job {}", id) << std::endl;
             }
-            catch (...)
+            else if (auto result = run(env->out()); result.commit)
             {
-                env->out() << "[e] mapping " << s.current()->get_name() << " to cell-level using the "
-                           << lib_name << " library was not successful" << std::endl;
-                reset_flags();
-                return;
+                result.commit();
             }
 
             reset_flags();
@@ -7,6 +7,7 @@
 
 
 #include "design_checker.h"
+#include "incremental_design_checker.h"
 #include "fcn_gate_layout.h"
 #include <alice/alice.hpp>
 #include <nlohmann/json.hpp>
@@ -34,6 +35,8 @@ namespace alice
         {
             add_option("--wire_limit,-w", wire_limit,
                        "Maximum number of wires allowed per tile", true);
+            add_flag("--incremental,-i",
+                     "Additionally cross-check the incremental design rule check against the full one");
         }
 
     protected:
@@ -55,6 +58,9 @@ namespace alice
             design_checker c{s.current(), wire_limit};
             report = c.check(env->out());
 
+            if (is_set("incremental"))
+                report["incremental"] = verify_incremental(s.current());
+
             reset_flags();
         }
 
@@ -77,7 +83,27 @@ namespace alice
          * Maximum number of wires per tile.
          */
         std::size_t wire_limit = 1;
+        /**
+         * Cross-checks the incremental_design_checker against the full check on a snapshot of the given layout.
+         *
+         * @param fgl Gate layout to cross-check the incremental check on. It is not modified.
+         * @return True iff the incremental check agrees with the full one.
+         */
+        bool verify_incremental(const fcn_gate_layout_ptr& fgl)
+        {
+            // the checker subscribes to its layout; a snapshot keeps the stored one untouched
+            incremental_design_checker idc{fgl->snapshot_layout(), wire_limit};
 
+            if (!idc.is_consistent())
+            {
+                env->out() << "[e] incremental design rule check deviates from full check" << std::endl;
+                return false;
+            }
+
+            env->out() << "[i] incremental design rule check agrees with full check" << std::endl;
+
+            return true;
+        }
         /**
          * Reset all flags. Necessary for some reason... alice bug?
          */
@@ -0,0 +1,138 @@
+//
+// Created by marcel on 19.10.26.
+//
+
+#ifndef FICTION_CMD_COMPACT_H
+#define FICTION_CMD_COMPACT_H
+
+
+#include "fcn_gate_layout.h"
+#include "layout_compaction.h"
+#include "background_jobs.h"
+#include <alice/alice.hpp>
+#include <fmt/format.h>
+#include <nlohmann/json.hpp>
+
+
+namespace alice
+{
+    /**
+     * Reduces area and wire length of the current 2DDWave-clocked gate layout in store by deleting rows and columns and
+     * relocating gates. See algo/layout_compaction.h for more details.
+     */
+    class compact_command : public command
+    {
+    public:
+        /**
+         * Standard constructor. Adds descriptive information, options, and flags.
+         *
+         * @param env alice::environment that specifies stores etc.
+         */
+        explicit compact_command(const environment::ptr& env)
+                :
+                command(env, "Compacts the current 2DDWave-clocked gate layout in store, e.g., one generated by ortho, "
+                             "by deleting rows and columns of straight wires and relocating gates towards the "
+                             "north-west. The layout is modified in place.")
+        {
+            add_option("--window,-w", config.window,
+                       "Maximum distance in tiles a gate is moved in each direction per round", true);
+            add_option("--rounds,-r", config.max_rounds,
+                       "Maximum number of compaction rounds (0 means until convergence)", true);
+            add_option("--threads,-n", config.threads,
+                       "Number of threads to evaluate relocations with (0 means all available)", true);
+            add_flag("--delete_only,-d", delete_only,
+                     "Only delete rows and columns without relocating gates");
+        }
+
+    protected:
+        /**
+         * Function to perform the compaction call. Modifies the current gate layout.
+         */
+        void execute() override
+        {
+            auto& s = store<fcn_gate_layout_ptr>();
+
+            // error case: empty gate layout store
+            if (s.empty())
+            {
+                env->out() << "[w] no gate layout in store" << std::endl;
+                reset_flags();
+                return;
+            }
+
+            auto fgl = s.current();
+
+            // error case: layout is not 2DDWave-clocked
+            if ((!fgl->is_clocking("2DDWAVE3") && !fgl->is_clocking("2DDWAVE4")) || fgl->is_vertically_shifted())
+            {
+                env->out() << "[e] only 2DDWave-clocked layouts can be compacted" << std::endl;
+                reset_flags();
+                return;
+            }
+
+            // error case: running jobs may still read the layout that is about to be modified
+            if (background_jobs::get().refuse_while_running(env->out(), "gate layouts cannot be modified"))
+            {
+                reset_flags();
+                return;
+            }
+
+            config.relocate = !delete_only;
+
+            layout_compaction compaction{fgl, config};
+            const auto result = compaction();
+            lc_result = result.json();
+
+            env->out() << fmt::format("[i] area: {} × {} = {} -> {} × {} = {}, wires: {} -> {}, crossings: {} -> {}",
+                                      result.x_before, result.y_before, result.x_before * result.y_before,
+                                      result.x_after, result.y_after, result.x_after * result.y_after,
+                                      result.wires_before, result.wires_after, result.crossings_before,
+                                      result.crossings_after) << std::endl;
+            env->out() << fmt::format("[i] {} rows and {} columns deleted, {} gates relocated in {} rounds, runtime: "
+                                      "{:.2f} s", result.deleted_rows, result.deleted_columns, result.relocations,
+                                      result.rounds, mockturtle::to_seconds(result.runtime)) << std::endl;
+            if (result.rollbacks > 0ul)
+                env->out() << "[w] the last round introduced design rule violations and was rolled back" << std::endl;
+
+            reset_flags();
+        }
+
+        /**
+         * Logs the resulting information in a log file.
+         *
+         * @return JSON object containing information about the compaction.
+         */
+        nlohmann::json log() const override
+        {
+            return lc_result;
+        }
+
+    private:
+        /**
+         * Configuration of the compaction.
+         */
+        layout_compaction::compaction_config config{};
+        /**
+         * Flag to indicate that gates should not be relocated.
+         */
+        bool delete_only = false;
+        /**
+         * Resulting logging information.
+         */
+        nlohmann::json lc_result{};
+
+        /**
+         * Reset all flags. Necessary for some reason... alice bug?
+         */
+        void reset_flags()
+        {
+            config = {};
+            delete_only = false;
+        }
+    };
+
+    ALICE_ADD_COMMAND(compact, "Physical Design")
+}
+
+
+#endif //FICTION_CMD_COMPACT_H
@@ -7,7 +7,9 @@
 
 #include "fcn_gate_layout.h"
 #include "equivalence_checker.h"
+#include "background_jobs.h"
 #include <alice/alice.hpp>
+#include <fmt/format.h>
 #include <mockturtle/utils/stopwatch.hpp>
 #include <nlohmann/json.hpp>
 
@@ -34,6 +36,8 @@ public:
     {
         add_option("--gate_layout,-g", gli,
                    "Store index of gate layout to compare the current one against", false);
+        add_flag("--bg",
+                 "Run in the background; see jobs, wait, and kill");
     }
 
 protected:
@@ -94,31 +98,13 @@ protected:
                 return;
             }
 
-            result = equivalence_checker{fgl1, fgl2}();
+            check(equivalence_checker{fgl1, fgl2}, fgl1->get_name());
         }
         else
         {
-            result = equivalence_checker{fgl1}();
+            check(equivalence_checker{fgl1}, fgl1->get_name());
         }
 
-        env->out() << "[i] the layout is " <<
-                      (result.eq == equivalence_checker::equiv_result::eq_type::NONE ? "NOT" :
-                       result.eq == equivalence_checker::equiv_result::eq_type::WEAK ? "WEAKLY" : "STRONGLY") <<
-                      " equivalent to its specification";
-
-        if (result.eq == equivalence_checker::equiv_result::eq_type::NONE && !result.counter_example.empty())
-        {
-            env->out() << " with counter example ";
-            for (const auto c : result.counter_example)
-                env->out() << c;
-        }
-        else if (result.eq == equivalence_checker::equiv_result::eq_type::WEAK)
-        {
-            if (!is_set("gate_layout"))
-                env->out() << " with a delay of " << result.delay << " cycles";
-        }
-        env->out() << std::endl;
-
         reset_flags();
     }
 
@@ -129,14 +115,10 @@ protected:
      */
     nlohmann::json log() const override
     {
-        return nlohmann::json
-        {
-            {"equivalence type", result.eq == equivalence_checker::equiv_result::eq_type::NONE ? "NOT EQ" :
-                                 result.eq == equivalence_checker::equiv_result::eq_type::WEAK ? "WEAK" : "STRONG"},
-            {"counter example", result.counter_example},
-            {"delay", result.delay},
-            {"runtime (s)", mockturtle::to_seconds(result.runtime)}
-        };
+        if (!job_log.is_null())
+            return job_log;
+
+        return to_json(result);
     }
 
 private:
@@ -148,6 +130,87 @@ private:
      * Stores the result of the last equivalence check for easier access to result and logging data.
      */
     equivalence_checker::equiv_result result;
+    /**
+     * Identifier of the background job launched by the last call. Null if the last check ran in the foreground.
+     */
+    nlohmann::json job_log{};
+
+    /**
+     * Runs the given checker either in the foreground or as a background job. The checker holds shared pointers to
+     * the layouts which serve as a snapshot.
+     *
+     * @param checker Equivalence checker to run.
+     * @param name Name of the layout to check.
+     */
+    void check(equivalence_checker&& checker, const std::string& name)
+    {
+        job_log = nullptr;
+
+        if (is_set("bg"))
+        {
+            const auto against_layout = is_set("gate_layout");
+            const auto id = background_jobs::get().launch(fmt::format("equiv on {}", name),
+                    [checker = std::move(checker), against_layout](std::ostream& out) mutable -> background_jobs::job_result
+            {
+                const auto r = checker();
+                report(r, against_layout, out);
+
+                return {{}, to_json(r)};
+            });
+
+            env->out() << fmt::format("[i] started job {}", id) << std::endl;
+            job_log = {{"job", id}};
+        }
+        else
+        {
+            result = checker();
+            report(result, is_set("gate_layout"), env->out());
+        }
+    }
+    /**
+     * Prints the given result of an equivalence check.
+     *
+     * @param r Result to print.
+     * @param against_layout Flag to indicate that the check was performed against another gate layout.
+     * @param out Stream to print to.
+     */
+    static void report(const equivalence_checker::equiv_result& r, const bool against_layout, std::ostream& out)
+    {
+        out << "[i] the layout is " <<
+               (r.eq == equivalence_checker::equiv_result::eq_type::NONE ? "NOT" :
+                r.eq == equivalence_checker::equiv_result::eq_type::WEAK ? "WEAKLY" : "STRONGLY") <<
+               " equivalent to its specification";
+
+        if (r.eq == equivalence_checker::equiv_result::eq_type::NONE && !r.counter_example.empty())
+        {
+            out << " with counter example ";
+            for (const auto c : r.counter_example)
+                out << c;
+        }
+        else if (r.eq == equivalence_checker::equiv_result::eq_type::WEAK)
+        {
+            if (!against_layout)
+                out << " with a delay of " << r.delay << " cycles";
+        }
+        out << std::endl;
+    }
+    /**
+     * Converts the given result of an equivalence check to JSON for logging.
+     *
+     * @param r Result to convert.
+     * @return JSON object containing information about the equivalence checking process.
+     */
+    static nlohmann::json to_json(const equivalence_checker::equiv_result& r)
+    {
+        return nlohmann::json
+        {
+            {"equivalence type", r.eq == equivalence_checker::equiv_result::eq_type::NONE ? "NOT EQ" :
+                                 r.eq == equivalence_checker::equiv_result::eq_type::WEAK ? "WEAK" : "STRONG"},
+            {"counter example", r.counter_example},
+            {"delay", r.delay},
+            {"runtime (s)", mockturtle::to_seconds(r.runtime)}
+        };
+    }
 
     /**
      * Reset all flags. Necessary for some reason... alice bug?
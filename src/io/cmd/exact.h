@@ -7,9 +7,12 @@
 
 
 #include "../../algo/exact.h"
+#include "../../algo/decomposed_exact.h"
 #include "fcn_gate_layout.h"
 #include "fcn_clocking_scheme.h"
 #include "logic_network.h"
+#include "background_jobs.h"
+#include <fmt/format.h>
 #include <thread>
 #include <alice/alice.hpp>
 #include <nlohmann/json.hpp>
@@ -44,6 +47,17 @@ namespace alice
                        "Timeout in seconds");
             add_option("--async,-a", config.num_threads,
                        "Number of layout dimensions to examine in parallel");
+            add_option("--strategy,-S", strategy,
+                       "Solver strategy to use {SMT, TACTIC, SAT, AUTO}", true);
+            add_option("--solver_threads,-T", config.solver_threads,
+                       "Number of threads each Z3 solver may use internally");
+            add_option("--order,-o", order,
+                       "Order in which layout dimensions are explored {AREA, BEST}", true);
+            add_option("--aspect_ratio,-r", aspect_ratio,
+                       "Maximum ratio of a layout's longer side to its shorter one; AUTO derives it from the network's "
+                       "depth and width (not optimal)");
+            add_option("--area_slack", config.policy.area_slack,
+                       "Number of additional areas to explore at once in best-first order (not optimal)");
 
             add_flag("--async_max,",
                      "Examine as many layout dimensions in parallel as threads are available");
@@ -63,6 +77,24 @@ namespace alice
                      "Minimize the number of crossing tiles to be used (slightly runtime expensive)");
             add_flag("--clock_latches,-l", config.clock_latches,
                      "Allow clock latches to satisfy global synchronization (runtime expensive!)");
+            add_flag("--parallel_solving,-P", config.parallel_solving,
+                     "Enable Z3's parallel cube-and-conquer mode");
+            add_flag("--no_pruning,",
+                     "Do not exclude tile-element pairs that are unreachable under the clocking scheme");
+            add_flag("--decompose,-D", config.decompose,
+                     "Place and route weakly overlapping PO cones independently in parallel and stitch the results "
+                     "(not optimal)");
+            add_option("--partitions", config.max_partitions,
+                       "Maximum number of PO cone partitions to create when decomposing (default: number of threads)");
+            add_flag("--unsat_cores,-U", config.unsat_cores,
+                     "Extract UNSAT cores to learn which further dimensions are UNSAT as well and skip them");
+            add_flag("--profile,-p", config.profile,
+                     "Log timings and added assertions per constraint family, solver outcomes, and Z3 statistics for "
+                     "each examined dimension");
+            add_option("--trace", config.trace_file,
+                       "Write the profile to the given file in Chrome's trace event format (implies -p)");
+            add_flag("--bg",
+                     "Run in the background; see jobs, wait, and kill");
         }
 
     protected:
@@ -106,6 +138,9 @@ namespace alice
                 reset_flags();
                 return;
             }
+            // signals between partitions are routed along the clock zones, which irregular clockings do not define
+            if (config.decompose && !config.scheme->regular)
+                env->out() << "[w] irregular clocking schemes are not decomposed" << std::endl;
             // if clocking is a ToPoliNano one, set a respective flag
             if (config.scheme->name == "TOPOLINANO3" || config.scheme->name == "TOPOLINANO4")
             {
@@ -118,6 +153,60 @@ namespace alice
                 config.twoddwave = true;
             }
 
+            // choose solver strategy
+            if (auto st = get_solver_strategy(strategy))
+            {
+                config.strategy = *st;
+            }
+            else
+            {
+                env->out() << "[e] \"" << strategy << "\" does not refer to a supported solver strategy" << std::endl;
+                reset_flags();
+                return;
+            }
+
+            // choose exploration policy
+            if (auto o = get_exploration_order(order))
+            {
+                config.policy.order = *o;
+            }
+            else
+            {
+                env->out() << "[e] \"" << order << "\" does not refer to a supported exploration order" << std::endl;
+                reset_flags();
+                return;
+            }
+            if (this->is_set("aspect_ratio"))
+            {
+                if (boost::iequals(aspect_ratio, "AUTO"))
+                {
+                    config.policy.derive_aspect_ratio = true;
+                }
+                else
+                {
+                    try
+                    {
+                        config.policy.max_aspect_ratio = std::stod(aspect_ratio);
+                    }
+                    catch (const std::exception&)
+                    {
+                        config.policy.max_aspect_ratio = 0.0;
+                    }
+
+                    // error case: no dimension could ever be explored
+                    if (config.policy.max_aspect_ratio < 1.0)
+                    {
+                        env->out() << "[e] the aspect ratio has to be AUTO or a number of at least 1" << std::endl;
+                        reset_flags();
+                        return;
+                    }
+                }
+            }
+            if (config.policy.area_slack && config.policy.order != exploration_order::BEST_FIRST)
+                env->out() << "[w] --area_slack has no effect without best-first exploration" << std::endl;
+
+            config.domain_pruning = !this->is_set("no_pruning");
+
             // fetch number of threads available on the system
             if (this->is_set("async_max"))
             {
@@ -134,18 +223,37 @@ namespace alice
             // convert timeout entered in seconds to milliseconds
             config.timeout *= 1000;
 
-            // perform exact physical design
-            exact physical_design{s.current(), std::move(config)};
+            // perform exact physical design, possibly on a decomposition of the network; networks are copied on write,
+            // i.e., the shared network serves as a snapshot for background jobs
+            std::shared_ptr<physical_design> pd{};
+            if (config.decompose)
+                pd = std::make_shared<decomposed_exact>(s.current(), std::move(config));
+            else
+                pd = std::make_shared<exact>(s.current(), std::move(config));
 
-            if (auto result = physical_design(); result.success)
+            const auto name = s.current()->get_name();
+            const auto run = [this, pd, name](std::ostream& out) -> background_jobs::job_result
             {
-                store<fcn_gate_layout_ptr>().extend() = physical_design.get_layout();
-                pd_result = result.json;
+                if (auto result = (*pd)(); result.success)
+                    return {[this, pd]{ store<fcn_gate_layout_ptr>().extend() = pd->get_layout(); }, result.json};
+
+                out << "[e] impossible to place and route " << name << " within the given parameters" << std::endl;
+                return {};
+            };
+
+            if (this->is_set("bg"))
+            {
+                const auto id = background_jobs::get().launch(fmt::format("exact on {}", name), run,
+                                                              [pd]{ pd->interrupt(); });
+                env->out() << fmt::format("[i] started job {}", id) << std::endl;
+                pd_result = {{"job", id}};
             }
             else
             {
-                env->out() << "[e] impossible to place and route " << s.current()->get_name()
-                           << " within the given parameters" << std::endl;
+                auto result = run(env->out());
+                if (result.commit)
+                    result.commit();
+                pd_result = result.log;
             }
 
             reset_flags();
@@ -170,6 +278,18 @@ namespace alice
          * Identifier of clocking scheme to use.
          */
         std::string clocking = "OPEN4";
+        /**
+         * Identifier of solver strategy to use.
+         */
+        std::string strategy = "SMT";
+        /**
+         * Identifier of exploration order to use.
+         */
+        std::string order = "AREA";
+        /**
+         * Aspect ratio bound as a number or AUTO.
+         */
+        std::string aspect_ratio{};
         /**
          * Resulting logging information.
          */
@@ -182,6 +302,9 @@ namespace alice
         {
             config = exact_pd_config{};
             clocking = "OPEN4";
+            strategy = "SMT";
+            order = "AREA";
+            aspect_ratio.clear();
         }
     };
 
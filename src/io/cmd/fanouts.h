@@ -34,8 +34,8 @@ namespace alice
                        "Maximum number of outputs a fan-out "
                        "vertex can have", true)->set_type_name("{2, 3}");
             add_option("--strategy,-s", strategy,
-                       "Chain fan-outs in a balanced tree (breadth) "
-                       "or a DFS tree (depth) fashion", true)->set_type_name("{breadth=0, depth=1}");
+                       "Chain fan-outs in a balanced tree (breadth), a DFS tree (depth), "
+                       "or a tree that keeps critical paths short (delay) fashion", true)->set_type_name("{breadth=0, depth=1, delay=2}");
             add_option("--threshold,-t", threshold,
                        "Maximum number of outputs an AND/OR/MAJ gate can have before "
                        "substitution applies", true);
@@ -64,14 +64,16 @@ namespace alice
                 return;
             }
 
-            if (strategy != 0 && strategy != 1)
+            if (strategy != 0 && strategy != 1 && strategy != 2)
             {
                 env->out() << "[w] " << strategy << " does not refer to a valid strategy" << std::endl;
                 reset_flags();
                 return;
             }
 
-            s.current()->substitute_fan_outs(degree, strategy, threshold);
+            // layouts and background jobs might share the network
+            if (s.current()->requires_fan_out_substitution(threshold))
+                make_unique_network(s.current())->substitute_fan_outs(degree, strategy, threshold);
 
             reset_flags();
         }
@@ -82,7 +84,7 @@ namespace alice
          */
         std::size_t degree = 2u;
         /**
-         * Decomposition strategy (DEPTH vs. BREADTH).
+         * Decomposition strategy (DEPTH vs. BREADTH vs. DELAY).
          */
         logic_network::substitution_strategy strategy = logic_network::substitution_strategy::BREADTH;
         /**
@@ -0,0 +1,77 @@
+//
+// Created by marcel on 19.10.26.
+//
+
+#ifndef FICTION_CMD_JOBS_H
+#define FICTION_CMD_JOBS_H
+
+
+#include "background_jobs.h"
+#include <alice/alice.hpp>
+#include <fmt/format.h>
+
+
+namespace alice
+{
+    /**
+     * Lists all background jobs. Results of finished ones are committed to the stores.
+     */
+    class jobs_command : public command
+    {
+    public:
+        /**
+         * Standard constructor. Adds descriptive information, options, and flags.
+         *
+         * @param env alice::environment that specifies stores etc.
+         */
+        explicit jobs_command(const environment::ptr& env)
+                :
+                command(env, "Lists all background jobs launched via --bg. Results of finished jobs are put into the "
+                             "respective stores and their output is printed.")
+        {}
+
+    protected:
+        /**
+         * Function to perform the jobs call. Collects finished jobs and lists the running ones.
+         */
+        void execute() override
+        {
+            auto& bg = background_jobs::get();
+
+            collected = bg.collect(env->out());
+
+            const auto running = bg.list();
+            if (running.empty())
+            {
+                env->out() << "[i] no running jobs" << std::endl;
+                return;
+            }
+
+            for (const auto& j : running)
+                env->out() << fmt::format("[{}] running for {:.2f} s: {}", j.id, j.runtime, j.description) << std::endl;
+        }
+        /**
+         * Logs the resulting information in a log file.
+         *
+         * @return JSON object containing information about the collected jobs.
+         */
+        nlohmann::json log() const override
+        {
+            return
+            {
+                {"jobs", collected}
+            };
+        }
+
+    private:
+        /**
+         * Logging information of the jobs collected by the last call.
+         */
+        nlohmann::json collected = nlohmann::json::array();
+    };
+
+    ALICE_ADD_COMMAND(jobs, "General")
+}
+
+
+#endif //FICTION_CMD_JOBS_H
@@ -0,0 +1,69 @@
+//
+// Created by marcel on 19.10.26.
+//
+
+#ifndef FICTION_CMD_KILL_H
+#define FICTION_CMD_KILL_H
+
+
+#include "background_jobs.h"
+#include <alice/alice.hpp>
+#include <fmt/format.h>
+
+
+namespace alice
+{
+    /**
+     * Kills a background job by discarding its results.
+     */
+    class kill_command : public command
+    {
+    public:
+        /**
+         * Standard constructor. Adds descriptive information, options, and flags.
+         *
+         * @param env alice::environment that specifies stores etc.
+         */
+        explicit kill_command(const environment::ptr& env)
+                :
+                command(env, "Kills the given background job. Its results are discarded. Physical design jobs are "
+                             "interrupted; other computations cannot be preempted and keep running until they finish.")
+        {
+            add_option("job", id,
+                       "Identifier of the job to kill")->required();
+        }
+
+    protected:
+        /**
+         * Function to perform the kill call.
+         */
+        void execute() override
+        {
+            if (background_jobs::get().kill(id))
+                env->out() << fmt::format("[i] killed job {}", id) << std::endl;
+            else
+                env->out() << fmt::format("[w] no job with identifier {}", id) << std::endl;
+
+            reset_flags();
+        }
+
+    private:
+        /**
+         * Identifier of the job to kill.
+         */
+        background_jobs::job_id id = 0ul;
+
+        /**
+         * Reset all flags. Necessary for some reason... alice bug?
+         */
+        void reset_flags()
+        {
+            id = 0ul;
+        }
+    };
+
+    ALICE_ADD_COMMAND(kill, "General")
+}
+
+
+#endif //FICTION_CMD_KILL_H
@@ -0,0 +1,93 @@
+//
+// Created by marcel on 19.10.26.
+//
+
+#ifndef FICTION_CMD_LATCHES_H
+#define FICTION_CMD_LATCHES_H
+
+
+#include "fcn_gate_layout.h"
+#include "latch_insertion.h"
+#include "background_jobs.h"
+#include <alice/alice.hpp>
+#include <fmt/format.h>
+#include <nlohmann/json.hpp>
+
+
+namespace alice
+{
+    /**
+     * Synchronizes the current gate layout in store by inserting clock latches on wire tiles. See
+     * algo/latch_insertion.h for more details.
+     */
+    class latches_command : public command
+    {
+    public:
+        /**
+         * Standard constructor. Adds descriptive information, options, and flags.
+         *
+         * @param env alice::environment that specifies stores etc.
+         */
+        explicit latches_command(const environment::ptr& env)
+                :
+                command(env, "Inserts clock latches into wire tiles of the current gate layout in store such that "
+                             "all inputs of each tile arrive in the same clock cycle. This restores a throughput of "
+                             "1/1 for layouts generated by ortho. The layout is modified in place.")
+        {}
+
+    protected:
+        /**
+         * Function to perform the latch insertion call. Modifies the current gate layout.
+         */
+        void execute() override
+        {
+            auto& s = store<fcn_gate_layout_ptr>();
+
+            // error case: empty gate layout store
+            if (s.empty())
+            {
+                env->out() << "[w] no gate layout in store" << std::endl;
+                return;
+            }
+
+            // error case: running jobs may still read the layout that is about to be modified
+            if (background_jobs::get().refuse_while_running(env->out(), "gate layouts cannot be modified"))
+            {
+                return;
+            }
+
+            latch_insertion insertion{s.current()};
+            const auto result = insertion();
+            li_result = result.json();
+
+            env->out() << fmt::format("[i] throughput: 1/{} -> 1/{}, critical path: {} -> {}, {} latches holding {} "
+                                      "clock cycles in total", result.tp_before, result.tp_after, result.cp_before,
+                                      result.cp_after, result.latches, result.cycles) << std::endl;
+
+            if (result.unbalanced > 0ul)
+                env->out() << fmt::format("[w] inputs of {} tiles could not be balanced", result.unbalanced)
+                           << std::endl;
+        }
+
+        /**
+         * Logs the resulting information in a log file.
+         *
+         * @return JSON object containing information about the latch insertion.
+         */
+        nlohmann::json log() const override
+        {
+            return li_result;
+        }
+
+    private:
+        /**
+         * Resulting logging information.
+         */
+        nlohmann::json li_result{};
+    };
+
+    ALICE_ADD_COMMAND(latches, "Physical Design")
+}
+
+
+#endif //FICTION_CMD_LATCHES_H
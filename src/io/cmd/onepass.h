@@ -50,6 +50,14 @@ namespace alice
                        "Timeout in seconds");
             add_option("--async,-a", config.num_threads,
                        "Number of threads to use for parallel solving");
+            add_option("--processes,-p", config.num_processes,
+                       "Number of worker processes to explore multiple layout dimensions in parallel");
+            add_option("--order,-o", order,
+                       "Order in which layout dimensions are explored {AREA, BEST}", true);
+            add_option("--aspect_ratio,-r", config.policy.max_aspect_ratio,
+                       "Maximum ratio of a layout's longer side to its shorter one (not optimal)");
+            add_option("--area_slack", config.policy.area_slack,
+                       "Number of additional areas to explore at once in best-first order (not optimal)");
 
             add_flag("--async_max",
                      "Use the maximum number of threads available to the system");
@@ -134,6 +142,25 @@ namespace alice
             }
 
 
+            // choose exploration policy
+            if (auto o = get_exploration_order(order))
+            {
+                config.policy.order = *o;
+            }
+            else
+            {
+                env->out() << "[e] \"" << order << "\" does not refer to a supported exploration order" << std::endl;
+                reset_flags();
+                return;
+            }
+            // error case: no dimension could ever be explored
+            if (this->is_set("aspect_ratio") && config.policy.max_aspect_ratio < 1.0)
+            {
+                env->out() << "[e] the aspect ratio has to be at least 1" << std::endl;
+                reset_flags();
+                return;
+            }
+
             // if no gate types are specified, enable them all
             if (!config.enable_and && !config.enable_or && !config.enable_not && !config.enable_maj && !config.enable_wires)
             {
@@ -220,6 +247,10 @@ namespace alice
          * Identifier of clocking scheme to use.
          */
         std::string clocking = "2DDWave";
+        /**
+         * Identifier of exploration order to use.
+         */
+        std::string order = "AREA";
         /**
          * Specification to synthesize.
          */
@@ -236,6 +267,7 @@ namespace alice
         {
             config = onepass_pd_config{};
             clocking = "2DDWave";
+            order = "AREA";
         }
     };
 
@@ -0,0 +1,163 @@
+//
+// Created by marcel on 19.10.26.
+//
+
+#ifndef FICTION_OPTIMIZE_H
+#define FICTION_OPTIMIZE_H
+
+
+#include "logic_network.h"
+#include "logic_optimization.h"
+#include <alice/alice.hpp>
+#include <fmt/format.h>
+#include <memory>
+
+
+namespace alice
+{
+    /**
+     * Optimizes the current logic network in store with respect to FCN cost before physical design.
+     */
+    class optimize_command : public command
+    {
+    public:
+        /**
+         * Standard constructor. Adds descriptive information, options, and flags.
+         *
+         * @param env alice::environment that specifies stores etc.
+         */
+        explicit optimize_command(const environment::ptr& env)
+                :
+                command(env,
+                        "Optimizes the current logic network in store with respect to its FCN cost, i.e., the "
+                        "number of gate, inverter, and fan-out vertices, by balancing, resubstitution, cut rewriting, "
+                        "and refactoring. Results of passes are only accepted if they lower the cost. The optimized "
+                        "network is added to the store. If no pass is specified, all are applied.")
+        {
+            add_flag("--balance,-b", "Apply depth-oriented algebraic rewriting");
+            add_flag("--resubstitute,-s", "Apply resubstitution");
+            add_flag("--rewrite,-w", "Apply cut rewriting");
+            add_flag("--refactor,-f", "Apply cut-based refactoring");
+            add_flag("--maj,-m", "Allow MAJ gates in the result even if the network is an AOIG");
+            add_option("--rounds,-r", config.max_rounds,
+                       "Maximum number of rounds in which all passes are applied (default: until convergence)");
+            add_option("--fan_out_weight,-o", config.fan_out_weight,
+                       "Weight of fan-out vertices in the FCN cost", true);
+        }
+
+    protected:
+        /**
+         * Function to perform the optimize call. Optimizes the network and adds the result to the store.
+         */
+        void execute() override
+        {
+            auto& s = store<logic_network_ptr>();
+
+            // error case: empty logic network store
+            if (s.empty())
+            {
+                env->out() << "[w] no logic network in store" << std::endl;
+                reset_flags();
+                return;
+            }
+
+            auto ln = s.current();
+
+            // networks synthesized by onepass do not provide a logic description
+            if (const auto& mig = ln->get_mig(); mig.num_pis() == 0u && mig.num_pos() == 0u)
+            {
+                env->out() << "[w] " << ln->get_name() << " does not provide a logic description to optimize"
+                           << std::endl;
+                reset_flags();
+                return;
+            }
+
+            config.balance      = is_set("balance");
+            config.resubstitute = is_set("resubstitute");
+            config.rewrite      = is_set("rewrite");
+            config.refactor     = is_set("refactor");
+            // if no pass is specified, apply all
+            if (!config.balance && !config.resubstitute && !config.rewrite && !config.refactor)
+                config.balance = config.resubstitute = config.rewrite = config.refactor = true;
+
+            config.allow_maj = is_set("maj");
+
+            logic_optimizer optimizer{ln, config};
+            result = optimizer();
+            weight = config.fan_out_weight;
+
+            const auto vertices = ln->vertex_count(), optimized_vertices = result.network->vertex_count();
+
+            env->out() << fmt::format("[i] FCN cost: {} -> {} (gates: {} -> {}, inverters: {} -> {}, fan-outs: {} -> {})",
+                                      result.before.total(config.fan_out_weight),
+                                      result.after.total(config.fan_out_weight),
+                                      result.before.gates, result.after.gates,
+                                      result.before.inverters, result.after.inverters,
+                                      result.before.fan_outs, result.after.fan_outs) << std::endl;
+            env->out() << fmt::format("[i] vertices: {} -> {}, depth: {} -> {}, {} rounds in {:.2f} s",
+                                      vertices, optimized_vertices, result.before.depth, result.after.depth,
+                                      result.rounds, mockturtle::to_seconds(result.runtime)) << std::endl;
+
+            s.extend() = result.network;
+
+            reset_flags();
+        }
+
+    private:
+        /**
+         * Configuration of the passes.
+         */
+        logic_optimizer::optimizer_config config{};
+        /**
+         * Result of the last optimization.
+         */
+        logic_optimizer::optimization_result result{};
+        /**
+         * Fan-out weight used by the last optimization.
+         */
+        std::size_t weight = 2ul;
+
+        /**
+         * Reset all flags. Necessary for some reason... alice bug?
+         */
+        void reset_flags()
+        {
+            config = {};
+        }
+        /**
+         * Logs the resulting information in a log file.
+         *
+         * @return JSON object containing information about the optimization.
+         */
+        nlohmann::json log() const override
+        {
+            const auto cost_json = [this](const logic_optimizer::fcn_cost& c) -> nlohmann::json
+            {
+                return
+                {
+                    {"cost", c.total(weight)},
+                    {"gates", c.gates},
+                    {"MAJ", c.maj},
+                    {"inverters", c.inverters},
+                    {"fan-outs", c.fan_outs},
+                    {"depth", c.depth}
+                };
+            };
+
+            return
+            {
+                {"name", result.network ? result.network->get_name() : ""},
+                {"before", cost_json(result.before)},
+                {"after", cost_json(result.after)},
+                {"rounds", result.rounds},
+                {"accepted", result.accepted},
+                {"runtime (s)", mockturtle::to_seconds(result.runtime)}
+            };
+        }
+    };
+
+    ALICE_ADD_COMMAND(optimize, "Logic")
+}
+
+
+#endif //FICTION_OPTIMIZE_H
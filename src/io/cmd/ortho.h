@@ -7,9 +7,11 @@
 
 
 #include "../../algo/orthogonal.h"
+#include "../../algo/latch_insertion.h"
 #include "fcn_gate_layout.h"
 #include "logic_network.h"
 #include <alice/alice.hpp>
+#include <fmt/format.h>
 #include <nlohmann/json.hpp>
 
 
@@ -38,6 +40,8 @@ namespace alice
                      "Use I/O port elements instead of gate pins");
             add_flag("--border_io,-b", border_ios,
                      "Enforce primary I/O to be placed at the layout's borders");
+            add_flag("--latches,-l", latches,
+                     "Insert clock latches afterwards to restore a throughput of 1/1");
         }
 
     protected:
@@ -73,8 +77,20 @@ namespace alice
 
             if (auto result = physical_design(); result.success)
             {
-                store<fcn_gate_layout_ptr>().extend() = physical_design.get_layout();
+                auto layout = physical_design.get_layout();
                 pd_result = result.json;
+
+                if (latches)
+                {
+                    latch_insertion insertion{layout};
+                    const auto li_result = insertion();
+                    pd_result["latch insertion"] = li_result.json();
+
+                    env->out() << fmt::format("[i] throughput: 1/{} -> 1/{}, {} latches inserted", li_result.tp_before,
+                                              li_result.tp_after, li_result.latches) << std::endl;
+                }
+
+                store<fcn_gate_layout_ptr>().extend() = layout;
             }
             else
                 env->out() << "[e] impossible to place and route " << s.current()->get_name() << std::endl;
@@ -105,6 +121,10 @@ namespace alice
          * Flag to indicate that designated I/O ports should be routed to the layout's borders.
          */
         bool border_ios = false;
+        /**
+         * Flag to indicate that clock latches should be inserted to synchronize the layout.
+         */
+        bool latches = false;
         /**
          * Resulting logging information.
          */
@@ -118,6 +138,7 @@ namespace alice
             phases = 4u;
             io_ports = false;
             border_ios = false;
+            latches = false;
         }
     };
 
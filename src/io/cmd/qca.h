@@ -8,6 +8,8 @@
 
 #include "qca_writer.h"
 #include "fcn_cell_layout.h"
+#include "fcn_gate_layout.h"
+#include "qca_one_library.h"
 #include <alice/alice.hpp>
 #include <boost/filesystem.hpp>
 #include <string>
@@ -16,7 +18,9 @@
 namespace alice
 {
     /**
-     * Generates a QCADesigner file for the current cell layout in store and writes it to the given path.
+     * Generates a QCADesigner file for the current cell layout in store and writes it to the given path. Alternatively,
+     * the current gate layout in store can be streamed to the file using the QCA-ONE library without constructing a
+     * cell layout.
      *
      * QCADesigner is available at: https://waluslab.ece.ubc.ca/qcadesigner/
      */
@@ -35,6 +39,10 @@ namespace alice
         {
             add_option("filename", filename,
                        "QCA file name");
+            add_flag("--gate_layout,-g",
+                     "Stream the current gate layout in store to the file using the QCA-ONE library instead of "
+                     "writing the current cell layout. No cell layout is constructed which saves memory for large "
+                     "layouts");
         }
 
     protected:
@@ -43,6 +51,12 @@ namespace alice
          */
         void execute() override
         {
+            if (is_set("gate_layout"))
+            {
+                write_gate_layout();
+                return;
+            }
+
             auto& s = store<fcn_cell_layout_ptr>();
 
             // error case: empty cell layout store
@@ -59,18 +73,8 @@ namespace alice
                 return;
             }
 
-            // error case: do not override directories
-            if (boost::filesystem::is_directory(filename))
-            {
-                env->out() << "[e] cannot override a directory" << std::endl;
+            if (!prepare_filename(fcl->get_name()))
                 return;
-            }
-            // if filename was empty or not given, use stored layout name
-            if (filename.empty())
-                filename = fcl->get_name();
-            // add .qca file extension if necessary
-            if (boost::filesystem::extension(filename) != ".qca")
-                filename += ".qca";
 
             try
             {
@@ -87,6 +91,76 @@ namespace alice
          * File name to write the QCA file into.
          */
         std::string filename;
+
+        /**
+         * Streams the current gate layout in store to a QCADesigner file using the QCA-ONE library.
+         */
+        void write_gate_layout()
+        {
+            auto& s = store<fcn_gate_layout_ptr>();
+
+            // error case: empty gate layout store
+            if (s.empty())
+            {
+                env->out() << "[w] no gate layout in store" << std::endl;
+                return;
+            }
+
+            auto fgl = s.current();
+            // QCA-ONE only allows non-shifted layouts
+            if (fgl->is_vertically_shifted())
+            {
+                env->out() << "[e] non-shifted layouts are required for the QCA-ONE library" << std::endl;
+                return;
+            }
+
+            if (!prepare_filename(fgl->get_name()))
+                return;
+
+            fcn_gate_library_ptr lib = nullptr;
+            try
+            {
+                lib = std::make_shared<qca_one_library>(fgl);
+            }
+            catch (...)
+            {
+                env->out() << "[e] could not assign directions in " << fgl->get_name() << " to cell ports"
+                           << std::endl;
+                return;
+            }
+
+            try
+            {
+                qca::write(std::move(lib), filename);
+            }
+            catch (...)
+            {
+                env->out() << "[e] an error occurred while the file was being written; it could be corrupted" << std::endl;
+            }
+        }
+        /**
+         * Checks the stored file name and completes it if necessary.
+         *
+         * @param layout_name Name of the layout to use if no file name was given.
+         * @return false iff the file name refers to a directory.
+         */
+        bool prepare_filename(const std::string& layout_name)
+        {
+            // error case: do not override directories
+            if (boost::filesystem::is_directory(filename))
+            {
+                env->out() << "[e] cannot override a directory" << std::endl;
+                return false;
+            }
+            // if filename was empty or not given, use stored layout name
+            if (filename.empty())
+                filename = layout_name;
+            // add .qca file extension if necessary
+            if (boost::filesystem::extension(filename) != ".qca")
+                filename += ".qca";
+
+            return true;
+        }
     };
 
     ALICE_ADD_COMMAND(qca, "I/O")
@@ -0,0 +1,426 @@
+//
+// Created by marcel on 19.10.26.
+//
+
+#ifndef FICTION_CMD_SERVER_H
+#define FICTION_CMD_SERVER_H
+
+
+#include "background_jobs.h"
+#if MUGEN
+#include "one_pass_synthesis.h"
+#endif
+#include <alice/alice.hpp>
+#include <fmt/format.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+
+namespace alice
+{
+    /**
+     * Turns fiction into a long-running server that listens on a UNIX domain socket. This avoids paying process startup,
+     * library loading, and benchmark parsing for each of many short requests.
+     *
+     * Each connection is a session that is served by a forked process. It inherits all stores of the server as they
+     * were when the server was started, i.e., benchmarks can be read once before calling server and are resident for
+     * all sessions afterwards. Changes made by a session are isolated from all other sessions but persist between the
+     * session's own requests. The Python interpreter needed by onepass is started once before the first session is
+     * served such that sessions inherit it instead of starting it on each onepass call.
+     *
+     * A socket left behind at the given path by a previous run is replaced. Any other file at that path is left
+     * untouched and the server is not started.
+     *
+     * Since forking a process while other threads are running is unsafe, the server cannot be started while background
+     * jobs are running.
+     *
+     * The protocol is line-based: each line sent by a client is a request consisting of one or more commands separated
+     * by semicolons. The server answers with the commands' output followed by a line that only consists of the
+     * end-of-transmission character (ASCII 0x04). Sending "quit" or closing the connection ends the session.
+     */
+    class server_command : public command
+    {
+    public:
+        /**
+         * Standard constructor. Adds descriptive information, options, and flags.
+         *
+         * @param env alice::environment that specifies stores etc.
+         */
+        explicit server_command(const environment::ptr& env)
+                :
+                command(env,
+                        "Listens on a UNIX domain socket and serves each connection as an isolated session that "
+                        "executes one request of semicolon-separated commands per line. Sessions start with a copy "
+                        "of all stores. Stop the server via SIGINT or SIGTERM.")
+        {
+            add_option("--socket,-s", socket_path,
+                       "Path of the socket to listen on (default: fiction.sock)");
+            add_option("--sessions,-n", max_sessions,
+                       "Maximum number of concurrently served sessions (default: number of available threads)");
+        }
+
+    protected:
+        /**
+         * Function to perform the server call. Accepts connections and forks a session process for each one until the
+         * server is stopped.
+         */
+        void execute() override
+        {
+            num_sessions = 0ul;
+
+            // error case: forked sessions would inherit locks held by the threads of running jobs
+            if (background_jobs::get().refuse_while_running(env->out(), "server cannot be started"))
+            {
+                reset_flags();
+                return;
+            }
+
+            if (max_sessions == 0ul)
+                max_sessions = std::max(std::thread::hardware_concurrency(), 1u);
+
+            sockaddr_un address{};
+            address.sun_family = AF_UNIX;
+
+            if (socket_path.size() >= sizeof(address.sun_path))
+            {
+                env->out() << fmt::format("[e] socket path is limited to {} characters",
+                                          sizeof(address.sun_path) - 1) << std::endl;
+                reset_flags();
+                return;
+            }
+            std::strncpy(address.sun_path, socket_path.c_str(), sizeof(address.sun_path) - 1);
+
+            // remove stale sockets of previous runs but never any other file that happens to be located at the path
+            if (struct stat status{}; ::lstat(socket_path.c_str(), &status) == 0)
+            {
+                if (!S_ISSOCK(status.st_mode))
+                {
+                    env->out() << fmt::format("[e] {} exists and is not a socket", socket_path) << std::endl;
+                    reset_flags();
+                    return;
+                }
+                ::unlink(socket_path.c_str());
+            }
+
+            const auto listener = ::socket(AF_UNIX, SOCK_STREAM, 0);
+            if (listener < 0)
+            {
+                env->out() << fmt::format("[e] could not create socket: {}", std::strerror(errno)) << std::endl;
+                reset_flags();
+                return;
+            }
+
+            if (::bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 ||
+                ::listen(listener, SOMAXCONN) < 0)
+            {
+                env->out() << fmt::format("[e] could not listen on {}: {}", socket_path, std::strerror(errno))
+                           << std::endl;
+                ::close(listener);
+                reset_flags();
+                return;
+            }
+
+#if MUGEN
+            // sessions inherit the running interpreter
+            one_pass_synthesis::initialize_interpreter();
+#endif
+
+            env->out() << fmt::format("[i] listening on {} with up to {} concurrent sessions", socket_path,
+                                      max_sessions) << std::endl;
+
+            stop_requested() = 0;
+            struct sigaction stop_action{}, old_int{}, old_term{};
+            stop_action.sa_handler = [](int){ stop_requested() = 1; };
+            sigemptyset(&stop_action.sa_mask);
+            ::sigaction(SIGINT, &stop_action, &old_int);
+            ::sigaction(SIGTERM, &stop_action, &old_term);
+
+            std::unordered_set<pid_t> sessions{};
+
+            while (!stop_requested())
+            {
+                // reap finished sessions
+                for (pid_t pid; (pid = ::waitpid(-1, nullptr, WNOHANG)) > 0; )
+                    sessions.erase(pid);
+
+                // leave further connections in the backlog while all session slots are occupied
+                if (sessions.size() >= max_sessions)
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                    continue;
+                }
+
+                pollfd pfd{listener, POLLIN, 0};
+                if (::poll(&pfd, 1, 100) <= 0 || !(pfd.revents & POLLIN))
+                    continue;
+
+                const auto connection = ::accept(listener, nullptr, nullptr);
+                if (connection < 0)
+                    continue;
+
+                // flush before forking to not duplicate buffered output
+                env->out().flush();
+
+#if MUGEN
+                // Python has to reset its locks and thread states in the child process
+                PyOS_BeforeFork();
+#endif
+                const auto pid = ::fork();
+#if MUGEN
+                if (pid == 0)
+                    PyOS_AfterFork_Child();
+                else
+                    PyOS_AfterFork_Parent();
+#endif
+
+                if (pid == 0)
+                {
+                    ::close(listener);
+                    ::sigaction(SIGINT, &old_int, nullptr);
+                    ::sigaction(SIGTERM, &old_term, nullptr);
+
+                    serve(connection);
+
+                    // skip static destructors of the server's state
+                    ::_exit(EXIT_SUCCESS);
+                }
+                else if (pid > 0)
+                {
+                    sessions.insert(pid);
+                    ++num_sessions;
+                }
+                else
+                {
+                    env->out() << fmt::format("[w] could not fork session: {}", std::strerror(errno)) << std::endl;
+                }
+
+                ::close(connection);
+            }
+
+            // terminate running sessions
+            for (const auto pid : sessions)
+                ::kill(pid, SIGTERM);
+            for (const auto pid : sessions)
+                ::waitpid(pid, nullptr, 0);
+
+            ::sigaction(SIGINT, &old_int, nullptr);
+            ::sigaction(SIGTERM, &old_term, nullptr);
+
+            ::close(listener);
+            ::unlink(socket_path.c_str());
+
+            env->out() << fmt::format("[i] server stopped after serving {} sessions", num_sessions) << std::endl;
+
+            reset_flags();
+        }
+
+    private:
+        /**
+         * Path of the socket to listen on.
+         */
+        std::string socket_path{"fiction.sock"};
+        /**
+         * Maximum number of concurrently served sessions. 0 means number of available threads.
+         */
+        std::size_t max_sessions = 0ul;
+        /**
+         * Number of sessions served by the last server call.
+         */
+        std::size_t num_sessions = 0ul;
+        /**
+         * Flag that is set by the signal handler to stop the server.
+         *
+         * @return Reference to the flag.
+         */
+        static volatile sig_atomic_t& stop_requested() noexcept
+        {
+            static volatile sig_atomic_t flag = 0;
+            return flag;
+        }
+        /**
+         * Serves a session on the given connection. Runs in a forked process whose standard output and error are
+         * redirected to the connection.
+         *
+         * @param connection File descriptor of the accepted connection.
+         */
+        void serve(const int connection)
+        {
+            // a client that disconnects while output is written should not kill the session with SIGPIPE
+            ::signal(SIGPIPE, SIG_IGN);
+
+            ::dup2(connection, STDOUT_FILENO);
+            ::dup2(connection, STDERR_FILENO);
+
+            std::string buffer{};
+            char chunk[4096];
+
+            for (ssize_t n; (n = ::read(connection, chunk, sizeof(chunk))) > 0; )
+            {
+                buffer.append(chunk, static_cast<std::size_t>(n));
+
+                for (auto pos = buffer.find('\n'); pos != std::string::npos; pos = buffer.find('\n'))
+                {
+                    auto line = buffer.substr(0, pos);
+                    buffer.erase(0, pos + 1);
+
+                    if (!line.empty() && line.back() == '\r')
+                        line.pop_back();
+
+                    if (line == "quit" || line == "exit")
+                        return;
+
+                    execute_request(line);
+
+                    // end of response
+                    env->out() << '\x04' << std::endl;
+                    if (!env->out())
+                        return;
+                }
+            }
+        }
+        /**
+         * Executes all semicolon-separated commands of the given request line one after another.
+         *
+         * @param request Request line to execute.
+         */
+        void execute_request(const std::string& request)
+        {
+            for (const auto& cmd_line : split(request, ';'))
+            {
+                const auto args = tokenize(cmd_line);
+                if (args.empty())
+                    continue;
+
+                // sessions are not allowed to spawn servers of their own
+                if (args.front() == "server")
+                {
+                    env->out() << "[e] server cannot be called within a session" << std::endl;
+                    return;
+                }
+
+                const auto& commands = env->commands();
+                if (auto it = commands.find(args.front()); it != commands.end())
+                {
+                    try
+                    {
+                        it->second->run(args);
+                    }
+                    catch (const std::exception& e)
+                    {
+                        env->out() << fmt::format("[e] {}", e.what()) << std::endl;
+                    }
+                }
+                else
+                {
+                    env->out() << fmt::format("[e] unknown command: {}", args.front()) << std::endl;
+                    return;
+                }
+            }
+        }
+        /**
+         * Splits the given string at each occurrence of the given delimiter that is not enclosed in double quotes.
+         *
+         * @param str String to split.
+         * @param delimiter Character to split at.
+         * @return Parts of str.
+         */
+        static std::vector<std::string> split(const std::string& str, const char delimiter)
+        {
+            std::vector<std::string> parts{""};
+            auto quoted = false;
+
+            for (const auto c : str)
+            {
+                if (c == '"')
+                    quoted = !quoted;
+
+                if (c == delimiter && !quoted)
+                    parts.emplace_back();
+                else
+                    parts.back().push_back(c);
+            }
+
+            return parts;
+        }
+        /**
+         * Splits the given command line into its arguments at whitespace that is not enclosed in double quotes. The
+         * quotes are removed.
+         *
+         * @param cmd_line Command line to tokenize.
+         * @return Arguments of cmd_line with the command name first.
+         */
+        static std::vector<std::string> tokenize(const std::string& cmd_line)
+        {
+            std::vector<std::string> args{};
+            std::string arg{};
+            auto quoted = false, pending = false;
+
+            for (const auto c : cmd_line)
+            {
+                if (c == '"')
+                {
+                    quoted = !quoted;
+                    pending = true;
+                }
+                else if (std::isspace(static_cast<unsigned char>(c)) && !quoted)
+                {
+                    if (pending)
+                        args.push_back(std::move(arg));
+
+                    arg.clear();
+                    pending = false;
+                }
+                else
+                {
+                    arg.push_back(c);
+                    pending = true;
+                }
+            }
+
+            if (pending)
+                args.push_back(std::move(arg));
+
+            return args;
+        }
+        /**
+         * Reset all flags. Necessary for some reason... alice bug?
+         */
+        void reset_flags()
+        {
+            socket_path = "fiction.sock";
+            max_sessions = 0ul;
+        }
+        /**
+         * Logs the resulting information in a log file.
+         *
+         * @return JSON object containing information about the server run.
+         */
+        nlohmann::json log() const override
+        {
+            return
+            {
+                {"sessions", num_sessions}
+            };
+        }
+    };
+
+    ALICE_ADD_COMMAND(server, "General")
+}
+
+
+#endif //FICTION_CMD_SERVER_H
@@ -0,0 +1,318 @@
+//
+// Created by marcel on 19.10.26.
+//
+
+#ifndef FICTION_STATS_H
+#define FICTION_STATS_H
+
+#include "fcn_gate_layout.h"
+#include "fcn_cell_layout.h"
+#include "area_defaults.h"
+#include "csv_writer.h"
+#include <alice/alice.hpp>
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <optional>
+#include <thread>
+#include <vector>
+
+
+namespace alice
+{
+    /**
+     * Gathers layout statistics like element counts, energy dissipation, bounding box, and area usage for the current
+     * gate or cell layout or for the whole respective store. Store-wide evaluations are distributed over all available
+     * threads and can be appended to a CSV file for design space explorations.
+     */
+    class stats_command : public command
+    {
+    public:
+        /**
+         * Standard constructor. Adds descriptive information, options, and flags.
+         *
+         * @param env alice::environment that specifies stores etc.
+         */
+        explicit stats_command(const environment::ptr& env)
+                :
+                command(env,
+                        "Prints gate, wire, and crossing counts, inverter bendings, QCA-ONE energy dissipation, "
+                        "and bounding box of the current gate layout in store or cell counts, bounding box, and "
+                        "area usage (in nm²) of the current cell layout in store. Cell dimensions default to "
+                        "QCADesigner (QCA) or NMLSim (iNML) values if not provided.")
+        {
+            add_flag("--gate_layout,-g",
+                     "Gather statistics of gate layouts (default)");
+            add_flag("--cell_layout,-c",
+                     "Gather statistics of cell layouts");
+            add_flag("--all,-a",
+                     "Process all layouts in the respective store in parallel instead of just the current one");
+            add_option("--csv", filename,
+                       "Append the statistics to the given CSV file");
+            add_option("--width,-x", width,
+                       "Cell width in nm");
+            add_option("--height,-y", height,
+                       "Cell height in nm");
+            add_option("--hspace", hspace,
+                       "Horizontal cell spacing in nm");
+            add_option("--vspace", vspace,
+                       "Vertical cell spacing in nm");
+        }
+
+    protected:
+        /**
+         * Function to perform the stats call. Fetches the desired layouts and evaluates them.
+         */
+        void execute() override
+        {
+            result = nlohmann::json::array();
+
+            if (is_set("cell_layout"))
+                cell_layout_statistics();
+            else
+                gate_layout_statistics();
+
+            reset_flags();
+        }
+
+    private:
+        /**
+         * Name of the CSV file to write into.
+         */
+        std::string filename;
+        /**
+         * Width and height of each cell.
+         */
+        uint64_t width = 0ul, height = 0ul;
+        /**
+         * Horizontal and vertical spacing between cells.
+         */
+        uint64_t hspace = 0ul, vspace = 0ul;
+        /**
+         * Gathered statistics.
+         */
+        nlohmann::json result = nlohmann::json::array();
+        /**
+         * Fetches either the current layout or all layouts from the given store.
+         *
+         * @tparam Store Store type.
+         * @param s Store to fetch layouts from.
+         * @return Vector of layouts to evaluate.
+         */
+        template <typename Store>
+        auto fetch_layouts(Store& s) const noexcept
+        {
+            std::vector<std::decay_t<decltype(s.current())>> layouts{};
+
+            if (is_set("all"))
+            {
+                for (auto i = 0ul; i < s.size(); ++i)
+                    layouts.push_back(s[i]);
+            }
+            else
+                layouts.push_back(s.current());
+
+            return layouts;
+        }
+        /**
+         * Evaluates the given function on all given layouts using as many threads as are available to the system.
+         * The result order corresponds to the order of layouts.
+         *
+         * @tparam Layout Layout pointer type.
+         * @tparam Fn Function type that maps Layouts to statistics.
+         * @param layouts Layouts to evaluate.
+         * @param fn Function to apply to each layout.
+         * @return Vector of evaluation results.
+         */
+        template <typename Layout, typename Fn>
+        static auto evaluate(const std::vector<Layout>& layouts, Fn&& fn)
+        {
+            std::vector<std::optional<std::invoke_result_t<Fn, const Layout&>>> results(layouts.size());
+
+            std::atomic<std::size_t> next{0ul};
+            const auto worker = [&layouts, &results, &next, &fn]
+            {
+                for (auto i = next++; i < layouts.size(); i = next++)
+                    results[i] = fn(layouts[i]);
+            };
+
+            // the calling thread works as well
+            const std::size_t num_threads = std::max(std::thread::hardware_concurrency(), 1u);
+            std::vector<std::thread> threads{};
+            for (auto t = 1ul; t < std::min(num_threads, layouts.size()); ++t)
+                threads.emplace_back(worker);
+
+            worker();
+
+            for (auto& t : threads)
+                t.join();
+
+            return results;
+        }
+        /**
+         * Gathers and outputs statistics of gate layouts.
+         */
+        void gate_layout_statistics()
+        {
+            auto& s = store<fcn_gate_layout_ptr>();
+
+            // error case: empty gate layout store
+            if (s.empty())
+            {
+                env->out() << "[w] no gate layout in store" << std::endl;
+                return;
+            }
+
+            const auto layouts = fetch_layouts(s);
+            const auto stats = evaluate(layouts, [](const fcn_gate_layout_ptr& fgl)
+                                                 { return fgl->determine_statistics(); });
+
+            std::optional<csv_writer> csv{};
+            if (is_set("csv"))
+            {
+                // only new files get a header
+                const bool header = !std::ifstream{filename}.good();
+                csv.emplace(filename);
+                if (header)
+                    csv->write_line("name", "x", "y", "bb x", "bb y", "gates", "wires", "crossings",
+                                    "straight inverters", "bent inverters", "AND", "OR", "MAJ", "fan-outs",
+                                    "slow energy (meV)", "fast energy (meV)");
+            }
+
+            for (auto i = 0ul; i < layouts.size(); ++i)
+            {
+                const auto& fgl = layouts[i];
+                const auto& st  = *stats[i];
+
+                env->out() << fmt::format("[i] {} - {} × {}, BB: {} × {}, #G: {}, #W: {}, #C: {}, "
+                                          "#INV: {} straight / {} bent, E: {} meV slow / {} meV fast",
+                                          fgl->get_name(), fgl->x(), fgl->y(), st.bb.x_size, st.bb.y_size,
+                                          st.gates, st.wires, st.crossings, st.straight_inverters, st.bent_inverters,
+                                          st.energy.first, st.energy.second) << std::endl;
+
+                if (csv)
+                    csv->write_line(fgl->get_name(), fgl->x(), fgl->y(), st.bb.x_size, st.bb.y_size, st.gates,
+                                    st.wires, st.crossings, st.straight_inverters, st.bent_inverters,
+                                    st.conjunctions, st.disjunctions, st.majorities, st.fan_outs,
+                                    st.energy.first, st.energy.second);
+
+                result.push_back(
+                {
+                    {"name", fgl->get_name()},
+                    {"bounding box",
+                     {
+                        {"x-size", st.bb.x_size},
+                        {"y-size", st.bb.y_size}
+                     }
+                    },
+                    {"gate tiles", st.gates},
+                    {"wire tiles", st.wires},
+                    {"crossings", st.crossings},
+                    {"inverters",
+                     {
+                        {"straight", st.straight_inverters},
+                        {"bent", st.bent_inverters}
+                     }
+                    },
+                    {"energy (meV, QCA)",
+                     {
+                        {"slow (25 GHz)", st.energy.first},
+                        {"fast (100 GHz)", st.energy.second}
+                     }
+                    }
+                });
+            }
+        }
+        /**
+         * Gathers and outputs statistics of cell layouts.
+         */
+        void cell_layout_statistics()
+        {
+            auto& s = store<fcn_cell_layout_ptr>();
+
+            // error case: empty cell layout store
+            if (s.empty())
+            {
+                env->out() << "[w] no cell layout in store" << std::endl;
+                return;
+            }
+
+            const auto layouts = fetch_layouts(s);
+            const auto stats = evaluate(layouts, [this](const fcn_cell_layout_ptr& fcl)
+            {
+                const auto qca = fcl->get_technology() == fcn::technology::QCA;
+                const auto st  = fcl->determine_statistics();
+
+                return std::make_pair(st, st.area(
+                        is_set("width")  ? width  : qca ? area_defaults::qca::width  : area_defaults::inml::width,
+                        is_set("height") ? height : qca ? area_defaults::qca::height : area_defaults::inml::height,
+                        is_set("hspace") ? hspace : qca ? area_defaults::qca::hspace : area_defaults::inml::hspace,
+                        is_set("vspace") ? vspace : qca ? area_defaults::qca::vspace : area_defaults::inml::vspace));
+            });
+
+            std::optional<csv_writer> csv{};
+            if (is_set("csv"))
+            {
+                // only new files get a header
+                const bool header = !std::ifstream{filename}.good();
+                csv.emplace(filename);
+                if (header)
+                    csv->write_line("name", "technology", "x", "y", "bb x", "bb y", "cells", "magnets",
+                                    "area (nm²)");
+            }
+
+            for (auto i = 0ul; i < layouts.size(); ++i)
+            {
+                const auto& fcl = layouts[i];
+                const auto& [st, area] = *stats[i];
+
+                env->out() << fmt::format("[i] {} ({}) - {} × {}, BB: {} × {}, #Cells: {}, area: {} nm²",
+                                          fcl->get_name(), fcn::to_string(fcl->get_technology()), fcl->x(), fcl->y(),
+                                          st.bb.x_size, st.bb.y_size, st.cells, area) << std::endl;
+
+                if (csv)
+                    csv->write_line(fcl->get_name(), fcn::to_string(fcl->get_technology()), fcl->x(), fcl->y(),
+                                    st.bb.x_size, st.bb.y_size, st.cells, st.magnets, area);
+
+                result.push_back(
+                {
+                    {"name", fcl->get_name()},
+                    {"technology", fcn::to_string(fcl->get_technology())},
+                    {"bounding box",
+                     {
+                        {"x-size", st.bb.x_size},
+                        {"y-size", st.bb.y_size}
+                     }
+                    },
+                    {"cells", st.cells},
+                    {"magnets", st.magnets},
+                    {"area (nm²)", area}
+                });
+            }
+        }
+        /**
+         * Reset all flags. Necessary for some reason... alice bug?
+         */
+        void reset_flags()
+        {
+            filename = "";
+            width = 0ul; height = 0ul; hspace = 0ul; vspace = 0ul;
+        }
+        /**
+         * Logs the resulting information in a log file.
+         *
+         * @return JSON object containing statistics of all evaluated layouts.
+         */
+        nlohmann::json log() const override
+        {
+            return
+            {
+                {"layouts", result}
+            };
+        }
+    };
+
+    ALICE_ADD_COMMAND(stats, "Technology")
+}
+
+#endif //FICTION_STATS_H
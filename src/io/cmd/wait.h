@@ -0,0 +1,96 @@
+//
+// Created by marcel on 19.10.26.
+//
+
+#ifndef FICTION_CMD_WAIT_H
+#define FICTION_CMD_WAIT_H
+
+
+#include "background_jobs.h"
+#include <alice/alice.hpp>
+#include <fmt/format.h>
+
+
+namespace alice
+{
+    /**
+     * Blocks until one or all background jobs have finished and commits their results to the stores.
+     */
+    class wait_command : public command
+    {
+    public:
+        /**
+         * Standard constructor. Adds descriptive information, options, and flags.
+         *
+         * @param env alice::environment that specifies stores etc.
+         */
+        explicit wait_command(const environment::ptr& env)
+                :
+                command(env, "Waits for the given background job or, if none is given, for all of them to finish. "
+                             "Their results are put into the respective stores and their output is printed.")
+        {
+            add_option("job", id,
+                       "Identifier of the job to wait for");
+        }
+
+    protected:
+        /**
+         * Function to perform the wait call. Blocks until the respective jobs have finished and collects them.
+         */
+        void execute() override
+        {
+            auto& bg = background_jobs::get();
+
+            if (is_set("job"))
+            {
+                collected = nlohmann::json::array();
+
+                if (auto l = bg.wait(id, env->out()); !l.is_null())
+                    collected.push_back(std::move(l));
+                else
+                    env->out() << fmt::format("[w] no job with identifier {}", id) << std::endl;
+            }
+            else
+            {
+                collected = bg.wait_all(env->out());
+            }
+
+            reset_flags();
+        }
+        /**
+         * Logs the resulting information in a log file.
+         *
+         * @return JSON object containing information about the collected jobs.
+         */
+        nlohmann::json log() const override
+        {
+            return
+            {
+                {"jobs", collected}
+            };
+        }
+
+    private:
+        /**
+         * Identifier of the job to wait for.
+         */
+        background_jobs::job_id id = 0ul;
+        /**
+         * Logging information of the jobs collected by the last call.
+         */
+        nlohmann::json collected = nlohmann::json::array();
+
+        /**
+         * Reset all flags. Necessary for some reason... alice bug?
+         */
+        void reset_flags()
+        {
+            id = 0ul;
+        }
+    };
+
+    ALICE_ADD_COMMAND(wait, "General")
+}
+
+
+#endif //FICTION_CMD_WAIT_H
@@ -8,24 +8,34 @@
 
 #include "cmd/version.h"
 #include "cmd/clear.h"
+#include "cmd/jobs.h"
+#include "cmd/wait.h"
+#include "cmd/kill.h"
 #include "cmd/read.h"
 #include "cmd/gates.h"
 #include "cmd/fanouts.h"
 #include "cmd/balance.h"
+#include "cmd/optimize.h"
 #include "cmd/tt.h"
 #include "cmd/random.h"
 #include "cmd/simulate.h"
 #include "cmd/akers.h"
+#include "cmd/batch.h"
 #include "cmd/exact.h"
 #include "cmd/onepass.h"
 #include "cmd/ortho.h"
+#include "cmd/anneal.h"
+#include "cmd/latches.h"
+#include "cmd/compact.h"
 #include "cmd/check.h"
 #include "cmd/equiv.h"
 #include "cmd/energy.h"
 #include "cmd/cell.h"
 #include "cmd/area.h"
+#include "cmd/stats.h"
 #include "cmd/qca.h"
 #include "cmd/qcc.h"
+#include "cmd/server.h"
 
 
 #endif //FICTION_COMMANDS_H
@@ -6,16 +6,16 @@
 
 namespace qca
 {
-    void write(fcn_cell_layout_ptr fcl, const std::string& filename)
+    namespace
     {
-        std::ofstream file(filename, std::ios::out);
-
-        if (!file.is_open())
-            throw std::ofstream::failure("could not open file");
-
-        std::vector<fcn_cell_layout::cell> via_layer_cells{};
-
-        auto write_cell = [&](const fcn_cell_layout::cell cell) -> void
+        /**
+         * Writes a single cell of the given layout including its quantum dots and its label to the given file.
+         *
+         * @param file File to write into.
+         * @param fcl Cell layout containing the cell.
+         * @param cell Cell to write.
+         */
+        void write_cell(std::ofstream& file, const fcn_cell_layout_ptr& fcl, const fcn_cell_layout::cell& cell)
         {
             auto cell_type = fcl->get_cell_type(cell);
 
@@ -68,10 +68,7 @@ namespace qca
             // handle cell mode
             file << CELL_OPTIONS_MODE;
             if (fcl->get_cell_mode(cell) == fcn::cell_mode::VERTICAL)
-            {
                 file << CELL_MODE_VERTICAL;
-                via_layer_cells.push_back(cell);  // save via cell for inter-layer
-            }
             else if (cell[Z] != GROUND)
                 file << CELL_MODE_CROSSOVER;
             else if (fcl->get_cell_mode(cell) == fcn::cell_mode::ROTATED)
@@ -185,7 +182,41 @@ namespace qca
 
             // close cell
             file << CLOSE_QCAD_CELL;
-        };
+        }
+        /**
+         * Opens a design layer with the given description.
+         *
+         * @param file File to write into.
+         * @param description Description of the layer.
+         */
+        void open_layer(std::ofstream& file, const std::string& description)
+        {
+            file << OPEN_QCAD_LAYER;
+
+            file << TYPE << 1 << '\n';
+            file << STATUS << 0 << '\n';
+            file << PSZ_DESCRIPTION << description << '\n';
+        }
+        /**
+         * Returns the description of the given layer.
+         *
+         * @param layer Layer to describe.
+         * @return Description of layer.
+         */
+        std::string layer_description(const coord_t layer)
+        {
+            return layer == 0 ? "Ground Layer" : "Crossing Layer " + std::to_string(layer);
+        }
+    }
+
+    void write(fcn_cell_layout_ptr fcl, const std::string& filename)
+    {
+        std::ofstream file(filename, std::ios::out);
+
+        if (!file.is_open())
+            throw std::ofstream::failure("could not open file");
+
+        std::vector<fcn_cell_layout::cell> via_layer_cells{};
 
         auto via_counter = 1u;
         auto write_via_cells = [&](std::vector<fcn_cell_layout::cell>& vias) -> void
@@ -194,14 +225,10 @@ namespace qca
                 return;
 
             // open via layer
-            file << OPEN_QCAD_LAYER;
-
-            file << TYPE << 1 << '\n';
-            file << STATUS << 0 << '\n';
-            file << PSZ_DESCRIPTION << "Via Layer " << std::to_string(via_counter++) << '\n';
+            open_layer(file, "Via Layer " + std::to_string(via_counter++));
 
             for (auto& v : vias)
-                write_cell(v);
+                write_cell(file, fcl, v);
 
             // close design layer
             file << CLOSE_QCAD_LAYER;
@@ -218,11 +245,7 @@ namespace qca
             write_via_cells(via_layer_cells);
 
             // open design layer
-            file << OPEN_QCAD_LAYER;
-
-            file << TYPE << 1 << '\n';
-            file << STATUS << 0 << '\n';
-            file << PSZ_DESCRIPTION << ((layer == 0) ? "Ground Layer" : ("Crossing Layer " + std::to_string(layer))) << '\n';
+            open_layer(file, layer_description(layer));
 
             // for all cells in that layer
             for (auto&& cell : fcl->layer_n(layer))
@@ -230,9 +253,81 @@ namespace qca
                 if (fcl->get_cell_type(cell) == fcn::EMPTY_CELL)
                     continue;
 
-                write_cell(cell);
+                write_cell(file, fcl, cell);
+
+                // save via cell for inter-layer
+                if (fcl->get_cell_mode(cell) == fcn::cell_mode::VERTICAL)
+                    via_layer_cells.push_back(cell);
+            }
+
+            // close design layer
+            file << CLOSE_QCAD_LAYER;
+        }
+
+        // close design block
+        file << CLOSE_DESIGN << std::endl;
+    }
+
+    void write(fcn_gate_library_ptr lib, const std::string& filename)
+    {
+        std::ofstream file(filename, std::ios::out);
+
+        if (!file.is_open())
+            throw std::ofstream::failure("could not open file");
+
+        const fcn_cell_stream stream{std::move(lib)};
+
+        // writes all non-empty cells of the given layer that satisfy the given predicate; one pass over the gate layout
+        const auto write_layer = [&file, &stream](const coord_t layer, const auto& predicate, const auto& open)
+        {
+            stream([&](const fcn_cell_layout_ptr& window, const coord_t first_row, const coord_t last_row)
+            {
+                for (auto y : iter::range(first_row, last_row + 1))
+                {
+                    for (auto x : iter::range(window->x()))
+                    {
+                        if (const auto cell = fcn_cell_layout::cell{x, y, layer};
+                                !window->is_free_cell(cell) && predicate(window, cell))
+                        {
+                            open();
+                            write_cell(file, window, cell);
+                        }
+                    }
+                }
+            });
+        };
+
+        // write version header
+        file << VERSION_2_HEADER;
+
+        auto via_counter = 1u;
+        // for each layer
+        for (auto layer : iter::range(stream.dimensions()[Z]))
+        {
+            // vias of the layer below are only known while streaming; therefore, the via layer is opened lazily
+            if (layer > 0)
+            {
+                auto via_layer_open = false;
+                write_layer(layer - 1, [](const auto& window, const auto& cell)
+                            { return window->get_cell_mode(cell) == fcn::cell_mode::VERTICAL; },
+                            [&]
+                            {
+                                if (!via_layer_open)
+                                {
+                                    open_layer(file, "Via Layer " + std::to_string(via_counter++));
+                                    via_layer_open = true;
+                                }
+                            });
+
+                if (via_layer_open)
+                    file << CLOSE_QCAD_LAYER;
             }
 
+            // open design layer
+            open_layer(file, layer_description(layer));
+
+            write_layer(layer, [](const auto&, const auto&){ return true; }, []{});
+
             // close design layer
             file << CLOSE_QCAD_LAYER;
         }
@@ -6,7 +6,9 @@
 #define FICTION_QCA_WRITER_H
 
 #include "fcn_cell_layout.h"
+#include "fcn_cell_stream.h"
 #include <itertools.hpp>
+#include <fstream>
 #include <iostream>
 #include <string>
 #include "fmt/format.h"
@@ -106,6 +108,16 @@ namespace qca
      * @param filename Desired file name of file to write fcl into. Should end with ".qca" (without quotes).
      */
     void write(fcn_cell_layout_ptr fcl, const std::string& filename);
+    /**
+     * Writes the gate layout associated with the given gate library to a file readable by the QCADesigner without
+     * constructing an fcn_cell_layout first. Cells are streamed tile row by tile row via an fcn_cell_stream and written
+     * out immediately. Since QCADesigner files list cells layer by layer, one pass over the gate layout is performed per
+     * layer and per via layer.
+     *
+     * @param lib QCA gate library associated with the gate layout to be written.
+     * @param filename Desired file name of file to write the layout into. Should end with ".qca" (without quotes).
+     */
+    void write(fcn_gate_library_ptr lib, const std::string& filename);
 }
 
 
@@ -8,6 +8,7 @@
 #include "logic_network.h"
 #include "fcn_gate_layout.h"
 #include "fcn_cell_layout.h"
+#include "qca_one_library.h"
 #include "svg_writer.h"
 #include "fmt/format.h"
 #include "fmt/ostream.h"
@@ -95,7 +96,7 @@ namespace alice
         extension = "dot";
 
         cmd.add_flag("--simple,-s", "Less detailed visualization "
-                                    "(structural information only)")->group("logic_network (-n) / cell_layout (-c)");
+                                    "(structural information only)")->group("logic_network (-n) / gate_layout (-g) / cell_layout (-c)");
 
         return true;
     }
@@ -180,6 +181,48 @@ namespace alice
         };
     }
 
+    template<>
+    bool can_show<fcn_gate_layout_ptr>(std::string& extension, [[maybe_unused]] command& cmd)
+    {
+        extension = "svg";
+
+        return true;
+    }
+
+    template<>
+    void show<fcn_gate_layout_ptr>(std::ostream& os, const fcn_gate_layout_ptr& element, const command& cmd)  // const & for pointer because alice says so...
+    {
+        // gate layouts are streamed to cell level via the QCA-ONE library without constructing a cell layout
+        if (element->is_vertically_shifted())
+        {
+            cmd.env->out() << "[w] currently, only non-shifted gate layouts can be shown, but " << element->get_name()
+                           << " is vertically shifted" << std::endl;
+            return;
+        }
+
+        fcn_gate_library_ptr lib = nullptr;
+        try
+        {
+            lib = std::make_shared<qca_one_library>(element);
+        }
+        catch (...)
+        {
+            cmd.env->out() << "[e] could not assign directions in " << element->get_name() << " to cell ports"
+                           << std::endl;
+            return;
+        }
+
+        try
+        {
+            svg::write_svg(os, std::move(lib), cmd.is_set("simple"));
+            os << std::endl;
+        }
+        catch (const std::invalid_argument& e)
+        {
+            cmd.env->out() << "[e] " << e.what() << std::endl;
+        }
+    }
+
 
     /**
      * FCN cell layouts.
@@ -25,6 +25,48 @@ namespace svg
         // Collects ALL tile-descriptions
         std::stringstream tile_descriptions{};
 
+        write_tile_descriptions(tile_descriptions, fcl, 0, fcl->y() - 1, simple);
+
+        coord_t length_x = fcl->x() / fcl->get_library()->gate_x_size();
+        coord_t length_y = fcl->y() / fcl->get_library()->gate_y_size();
+
+        double viewbox_x = 2 * viewbox_distance + length_x * tile_distance;
+        double viewbox_y = 2 * viewbox_distance + length_y * tile_distance;
+
+        return fmt::format(header, fiction::VERSION, fiction::REPO, boost::lexical_cast<std::string>(viewbox_x),
+                                   boost::lexical_cast<std::string>(viewbox_y), tile_descriptions.str());
+    }
+
+    void write_svg(std::ostream& os, fcn_gate_library_ptr lib, bool simple)
+    {
+        const fcn_cell_stream stream{lib};
+        const auto lengths = stream.dimensions();
+
+        coord_t length_x = lengths[X] / lib->gate_x_size();
+        coord_t length_y = lengths[Y] / lib->gate_y_size();
+
+        double viewbox_x = 2 * viewbox_distance + length_x * tile_distance;
+        double viewbox_y = 2 * viewbox_distance + length_y * tile_distance;
+
+        // the header encloses all tile-descriptions; it is split such that they can be written in between
+        const auto frame = fmt::format(header, fiction::VERSION, fiction::REPO,
+                                       boost::lexical_cast<std::string>(viewbox_x),
+                                       boost::lexical_cast<std::string>(viewbox_y), "");
+        const auto split = frame.rfind("</g>");
+
+        os << frame.substr(0, split);
+
+        stream([&os, simple](const fcn_cell_layout_ptr& window, const coord_t first_row, const coord_t last_row)
+        {
+            write_tile_descriptions(os, window, first_row, last_row, simple);
+        });
+
+        os << frame.substr(split);
+    }
+
+    void write_tile_descriptions(std::ostream& tile_descriptions, fcn_cell_layout_ptr fcl,
+                                 const coord_t first_row, const coord_t last_row, bool simple)
+    {
         // Used for generating tile-descriptions with information about the tile's coordinates and clock zone
         // It is needed because cells may not be in "tile-order" when read from a cell layout
         coord_to_tile_mapping coord_to_tile{};
@@ -37,10 +79,23 @@ namespace svg
             tile_colors{{clock_zone_1_tile, clock_zone_2_tile, clock_zone_3_tile, clock_zone_4_tile}},
             text_colors{{clock_zone_12_text, clock_zone_12_text, clock_zone_34_text, clock_zone_34_text}};
 
-        // Adds all non-empty cells from the layout to their correct tiles; it generates the "body"
+        // Gathers all non-empty cells of the given rows layer by layer
+        std::vector<fcn_cell_layout::cell> cells{};
+        for (auto z : iter::range(fcl->z()))
+        {
+            for (auto y : iter::range(first_row, last_row + 1))
+            {
+                for (auto x : iter::range(fcl->x()))
+                {
+                    if (const auto c = fcn_cell_layout::cell{x, y, z}; !fcl->is_free_cell(c))
+                        cells.push_back(c);
+                }
+            }
+        }
+
+        // Adds all gathered cells to their correct tiles; it generates the "body"
         // of all the tile-descriptions to be used later
-        for (const auto& c : fcl->cells() | iter::filterfalse([fcl](const fcn_cell_layout::cell& _c)
-                                                              { return fcl->is_free_cell(_c); }))
+        for (const auto& c : cells)
         {
             auto clock_zone = *fcl->cell_clocking(c);
             auto tile_coords = std::make_pair(static_cast<coord_t>(ceil(c[X] / fcl->get_library()->gate_x_size())),
@@ -141,15 +196,6 @@ namespace svg
 
             tile_descriptions << t_descr;
         }
-
-        coord_t length_x = fcl->x() / fcl->get_library()->gate_x_size();
-        coord_t length_y = fcl->y() / fcl->get_library()->gate_y_size();
-
-        double viewbox_x = 2 * viewbox_distance + length_x * tile_distance;
-        double viewbox_y = 2 * viewbox_distance + length_y * tile_distance;
-
-        return fmt::format(header, fiction::VERSION, fiction::REPO, boost::lexical_cast<std::string>(viewbox_x),
-                                   boost::lexical_cast<std::string>(viewbox_y), tile_descriptions.str());
     }
 
     std::string generate_cell_based_svg(fcn_cell_layout_ptr fcl, bool simple)
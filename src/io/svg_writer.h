@@ -6,6 +6,7 @@
 #define FICTION_SVG_WRITER_H
 
 #include "fcn_cell_layout.h"
+#include "fcn_cell_stream.h"
 #include "version_info.h"
 #include <iostream>
 #include <cmath>
@@ -324,6 +325,30 @@ namespace svg
      * @return The SVG string containing a visual representation of the given layout.
      */
     std::string generate_tile_based_svg(fcn_cell_layout_ptr fcl, bool simple);
+    /**
+     * Writes an SVG representation of the gate layout associated with the given gate library to the given stream
+     * without constructing an fcn_cell_layout first. Cells are streamed tile row by tile row via an fcn_cell_stream
+     * and their tile-descriptions are written out immediately.
+     *
+     * @param os The stream to write the SVG representation into.
+     * @param lib The QCA gate library associated with the gate layout to generate an SVG representation for.
+     * @param simple Flag to indicate that the SVG representation should be generated with less details. Recommended
+     *               for large layouts.
+     */
+    void write_svg(std::ostream& os, fcn_gate_library_ptr lib, bool simple);
+    /**
+     * Writes the tile-descriptions of all tiles whose cells are located in the given rows of the given tile-based
+     * clocked cell layout to the given stream.
+     *
+     * @param tile_descriptions The stream to write the tile-descriptions into.
+     * @param fcl The cell layout to generate tile-descriptions for.
+     * @param first_row First row to consider.
+     * @param last_row Last row to consider (inclusive).
+     * @param simple Flag to indicate that the SVG representation should be generated with less details. Recommended
+     *               for large layouts.
+     */
+    void write_tile_descriptions(std::ostream& tile_descriptions, fcn_cell_layout_ptr fcl,
+                                 const coord_t first_row, const coord_t last_row, bool simple);
     /**
      * Returns an SVG string representing the given cell-based clocked cell layout
      *
@@ -3,35 +3,107 @@
 //
 
 #include "tt_reader.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+
+namespace
+{
+    /**
+     * Converts a hexadecimal digit to its value.
+     *
+     * @param c Hexadecimal digit.
+     * @return Value of c or -1 if c is no hexadecimal digit.
+     */
+    int hex_value(const char c) noexcept
+    {
+        if (c >= '0' && c <= '9')
+            return c - '0';
+        if (c >= 'a' && c <= 'f')
+            return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F')
+            return c - 'A' + 10;
+
+        return -1;
+    }
+}
 
 
 tt_reader::tt_reader(const std::string& filename)
 {
-    std::ifstream file{filename, std::ios::in};
-    if (file.is_open())
+    const auto fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+        return;
+
+    if (struct stat st{}; ::fstat(fd, &st) == 0 && st.st_size > 0)
     {
-        // read the file in a vector of strings
-        elements = std::vector<std::string>{std::istream_iterator<std::string>{file},
-                                            std::istream_iterator<std::string>{}};
-        // TODO fill the vector with an std::copy_if instead where you increase a counter and only copy if counter is even
+        if (auto map = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            map != MAP_FAILED)
+        {
+            data = static_cast<const char*>(map);
+            size = static_cast<std::size_t>(st.st_size);
+            pos  = data;
+
+            // the file is parsed front to back exactly once
+            ::madvise(map, size, MADV_SEQUENTIAL);
+        }
     }
+
+    // the mapping stays valid after closing the file
+    ::close(fd);
+}
+
+tt_reader::~tt_reader()
+{
+    if (data != nullptr)
+        ::munmap(const_cast<char*>(data), size);
+}
+
+bool tt_reader::is_open() const noexcept
+{
+    return data != nullptr;
 }
 
 std::optional<kitty::dynamic_truth_table> tt_reader::next()
 {
-    if (pos >= elements.size() - 1)
-        return std::nullopt;
+    const auto end = data + size;
+
+    while (pos != nullptr && pos < end)
+    {
+        const auto line_end = std::find(pos, end, '\n');
 
-    // remove the 0x prefix
-    auto table = elements[pos].substr(2u);
-    // determine number of truth table variables
-    uint32_t num_vars = std::log2(table.size() << 2u);
-    // create truth table
-    kitty::dynamic_truth_table tt{num_vars};
-    kitty::create_from_hex_string(tt, table);
+        // the truth table is the first token of the line
+        auto token = std::find_if(pos, line_end, [](const char c){ return c != ' ' && c != '\t' && c != '\r'; });
+        const auto token_end = std::find_if(token, line_end, [](const char c){ return c == ' ' || c == '\t' || c == '\r'; });
 
-    // TODO change pos to an iterator
-    pos += 2;
+        pos = line_end == end ? end : line_end + 1;
+
+        // remove the 0x prefix
+        if (token_end - token > 2 && token[0] == '0' && (token[1] == 'x' || token[1] == 'X'))
+            token += 2;
+
+        const auto num_digits = static_cast<std::size_t>(token_end - token);
+        // skip empty lines, comments, and malformed truth tables
+        if (num_digits == 0ul || (num_digits & (num_digits - 1ul)) != 0ul ||
+            !std::all_of(token, token_end, [](const char c){ return hex_value(c) >= 0; }))
+            continue;
+
+        // determine number of truth table variables
+        const auto num_vars = static_cast<uint32_t>(std::log2(num_digits << 2u));
+        // create truth table and fill its words directly; the first digit is the most significant one
+        kitty::dynamic_truth_table tt{num_vars};
+        auto words = tt.begin();
+        for (auto i = 0ul; i < num_digits; ++i)
+            *(words + static_cast<std::ptrdiff_t>(i >> 4u)) |=
+                    static_cast<uint64_t>(hex_value(*(token_end - 1 - i))) << ((i & 15ul) << 2u);
+
+        return tt;
+    }
 
-    return tt;
+    return std::nullopt;
 }
@@ -6,15 +6,10 @@
 #define FICTION_TT_READER_H
 
 
-#include <kitty/constructors.hpp>
 #include <kitty/dynamic_truth_table.hpp>
-#include <fstream>
-#include <istream>
-#include <iostream>
-#include <iterator>
+#include <cstddef>
 #include <optional>
 #include <string>
-#include <vector>
 
 
 /**
@@ -22,16 +17,36 @@
  * truth table in hexadecimal form plus its corresponding Boolean expression. The two are separated by a space.
  *
  * This format is used by, e.g., Alan Mishchenko for his DSD functions: https://people.eecs.berkeley.edu/~alanmi/temp5/
+ *
+ * Files like NPN class dumps can contain millions of functions. Therefore, the file is memory-mapped instead of being
+ * read into memory and each truth table is parsed from the mapping directly into the words of a
+ * kitty::dynamic_truth_table without any intermediate strings. Lines that do not start with a hexadecimal truth table
+ * whose length is a power of 2, e.g., comments, are skipped. Reading is not thread-safe.
  */
 class tt_reader
 {
 public:
     /**
-     * Standard constructor. Reads the given file in a vector of lines.
+     * Standard constructor. Maps the given file into memory.
      *
      * @param filename File to parse.
      */
     explicit tt_reader(const std::string& filename);
+    /**
+     * Destructor. Unmaps the file.
+     */
+    ~tt_reader();
+    /**
+     * Readers own their mapping and can therefore not be copied.
+     */
+    tt_reader(const tt_reader&) = delete;
+    tt_reader& operator=(const tt_reader&) = delete;
+    /**
+     * Checks whether the file could be opened and mapped. Empty files count as not mapped.
+     *
+     * @return true iff truth tables can be read.
+     */
+    bool is_open() const noexcept;
     /**
      * Returns the next truth table parsed from the file or std::nullopt if no further truth tables are available.
      *
@@ -41,14 +56,17 @@ public:
 
 private:
     /**
-     * Contains the hexadecimal truth tables and their Boolean expressions in string representation. The two are
-     * alternating.
+     * Start of the mapped file.
+     */
+    const char* data = nullptr;
+    /**
+     * Size of the mapped file in bytes.
      */
-    std::vector<std::string> elements;
+    std::size_t size = 0ul;
     /**
-     * Current position in the vector.
+     * Current position in the mapped file.
      */
-    std::size_t pos = 0ul;
+    const char* pos = nullptr;
 };
 
 
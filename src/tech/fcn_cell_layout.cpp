@@ -44,14 +44,14 @@ void fcn_cell_layout::assign_cell_type(const cell& c, const fcn::cell_type t) no
     if (t == fcn::EMPTY_CELL)
     {
         type_map.erase(c);
-        pi_set.erase(c);
-        po_set.erase(c);
+        pi_set.write().erase(c);
+        po_set.write().erase(c);
         return;
     }
     else if (t == fcn::INPUT_CELL)
-        pi_set.insert(c);
+        pi_set.write().insert(c);
     else if (t == fcn::OUTPUT_CELL)
-        po_set.insert(c);
+        po_set.write().insert(c);
 
     type_map[c] = t;
 }
@@ -129,11 +129,11 @@ std::optional<fcn_clock::zone> fcn_cell_layout::cell_clocking(const cell& c) con
     if (clocking.regular)
     {
         coord_t x = c[X] / library->gate_x_size(), y = c[Y] / library->gate_y_size();
-        return clocking.scheme[y % clocking.cutout_y][x % clocking.cutout_x];
+        return clocking.zone_at(x, y);
     }
     else  // irregular clocking accesses clocking map
     {
-        if (auto it = c_map.find(get_ground(c)); it != c_map.end())
+        if (auto it = c_map->find(get_ground(c)); it != c_map->end())
         {
             return it->second;
         }
@@ -205,85 +205,32 @@ std::size_t fcn_cell_layout::magcad_magnet_count() const noexcept
 
 fcn_layout::bounding_box fcn_cell_layout::determine_bounding_box() const noexcept
 {
-    // calculate min_x
-    coord_t min_x = 0u;
-    for (coord_t x = 0u; x < this->x(); ++x)
-    {
-        bool elem_found = false;
-        for (coord_t y = 0u; y < this->y(); ++y)
-        {
-            if (!this->is_free_cell(cell{x, y, GROUND}) || !this->is_free_cell(cell{x, y, 1}))
-            {
-                elem_found = true;
-                break;
-            }
-        }
-
-        min_x = x;
-        if (elem_found)
-            break;
-    }
+    return determine_statistics().bb;
+}
 
-    // calculate min_y
-    coord_t min_y = 0u;
-    for (coord_t y = 0u; y < this->y(); ++y)
-    {
-        bool elem_found = false;
-        for (coord_t x = 0u; x < this->x(); ++x)
-        {
-            if (!this->is_free_cell(cell{x, y, GROUND}) || !this->is_free_cell(cell{x, y, 1}))
-            {
-                elem_found = true;
-                break;
-            }
-        }
+fcn_cell_layout::statistics fcn_cell_layout::determine_statistics() const noexcept
+{
+    // an empty layout results in the same box that directional sweeps over all cells would have produced
+    coord_t min_x = x() - 1, min_y = y() - 1, max_x = 0u, max_y = 0u;
 
-        min_y = y;
-        if (elem_found)
-            break;
-    }
+    std::size_t num_inv_cells = 0ul;
 
-    // calculate max_x
-    coord_t max_x = this->x() - 1;
-    for (auto x = static_cast<long>(this->x()) - 1; x >= 0; --x)
+    for (const auto& [c, t] : type_map)
     {
-        bool elem_found = false;
-        for (coord_t y = 0u; y < this->y(); ++y)
-        {
-            if (!this->is_free_cell(cell{static_cast<coord_t>(x), y, GROUND}) ||
-                !this->is_free_cell(cell{static_cast<coord_t>(x), y, 1}))
-            {
-                elem_found = true;
-                break;
-            }
-        }
-
-        max_x = static_cast<coord_t>(x);
-        if (elem_found)
-            break;
-    }
+        if (t == fcn::inml::INVERTER_MAGNET)
+            ++num_inv_cells;
 
-    // calculate max_y
-    coord_t max_y = this->y() - 1;
-    for (auto y = static_cast<long>(this->y()) - 1; y >= 0; --y)
-    {
-        bool elem_found = false;
-        for (coord_t x = 0u; x < this->x(); ++x)
-        {
-            if (!this->is_free_cell(cell{x, static_cast<coord_t>(y), GROUND}) ||
-                !this->is_free_cell(cell{x, static_cast<coord_t>(y), 1}))
-            {
-                elem_found = true;
-                break;
-            }
-        }
+        // only ground and crossing layer are taken into account
+        if (c[Z] > 1)
+            continue;
 
-        max_y = static_cast<coord_t>(y);
-        if (elem_found)
-            break;
+        min_x = std::min(min_x, c[X]); max_x = std::max(max_x, c[X]);
+        min_y = std::min(min_y, c[Y]); max_y = std::max(max_y, c[Y]);
     }
 
-    return bounding_box{min_x, min_y, max_x, max_y};
+    const auto num_magnets = technology == fcn::technology::INML ? cell_count() + num_inv_cells / 4 : 0ul;
+
+    return statistics{bounding_box{min_x, min_y, max_x, max_y}, cell_count(), num_magnets};
 }
 
 void fcn_cell_layout::write_layout(std::ostream& os, const bool io_color, const bool clk_color) const noexcept
@@ -359,18 +306,21 @@ void fcn_cell_layout::map_irregular_clocking() noexcept
 void fcn_cell_layout::assign_vias() noexcept
 {
     for (auto&& c : crossing_layers() | iter::filterfalse([this](const cell& _c){return is_free_cell(_c);}))
+        assign_via(c);
+}
+
+void fcn_cell_layout::assign_via(const cell& c) noexcept
+{
+    // if number of surrounding cells is 1 or less, it is a via cell
+    if (auto surrounding = surrounding_2d(c) | iter::filterfalse([this](const cell& _c)
+            { return is_free_cell(_c); }); std::distance(surrounding.begin(), surrounding.end()) <= 1u)
     {
-        // if number of surrounding cells is 1 or less, it is a via cell
-        if (auto surrounding = surrounding_2d(c) | iter::filterfalse([this](const cell& _c)
-                { return is_free_cell(_c); }); std::distance(surrounding.begin(), surrounding.end()) <= 1u)
-        {
-            // change mode to via
-            assign_cell_mode(c, fcn::cell_mode::VERTICAL);
-            // create a via ground cell
-            auto ground_via = cell{c[X], c[Y], GROUND};
-            assign_cell_type(ground_via, fcn::NORMAL_CELL);
-            assign_cell_mode(ground_via, fcn::cell_mode::VERTICAL);
-        }
+        // change mode to via
+        assign_cell_mode(c, fcn::cell_mode::VERTICAL);
+        // create a via ground cell
+        auto ground_via = cell{c[X], c[Y], GROUND};
+        assign_cell_type(ground_via, fcn::NORMAL_CELL);
+        assign_cell_mode(ground_via, fcn::cell_mode::VERTICAL);
     }
 }
 
@@ -12,6 +12,8 @@
 #include "port_router.h"
 
 
+class fcn_cell_stream;
+
 /**
  * Represents layouts of field coupled nanocomputing (FCN) devices on a cell level abstraction. Inherits from fcn_layout
  * so it is a 3-dimensional grid-like structure as well. Faces are called cells in a cell layout. Cells can have special
@@ -217,6 +219,41 @@ public:
      * @return Bounding box.
      */
     bounding_box determine_bounding_box() const noexcept override;
+    /**
+     * Container for statistical information about the layout that can be gathered in a single scan over all assigned
+     * cells.
+     */
+    struct statistics
+    {
+        /**
+         * Bounding box as computed by determine_bounding_box().
+         */
+        bounding_box bb;
+        /**
+         * Number of assigned cells and number of magnets as computed by magcad_magnet_count().
+         */
+        std::size_t cells, magnets;
+        /**
+         * Computes the area occupied by the bounding box given cell dimensions and spacings.
+         *
+         * @param width Cell width.
+         * @param height Cell height.
+         * @param hspace Horizontal spacing between two cells.
+         * @param vspace Vertical spacing between two cells.
+         * @return Area of the bounding box in units of the given parameters squared.
+         */
+        uint64_t area(const uint64_t width, const uint64_t height, const uint64_t hspace, const uint64_t vspace) const noexcept
+        {
+            return (bb.x_size * width + (bb.x_size - 1) * hspace) * (bb.y_size * height + (bb.y_size - 1) * vspace);
+        }
+    };
+    /**
+     * Gathers cell and magnet counts as well as the bounding box in a single pass over the assigned cells instead of
+     * sweeping over the whole layout in each direction.
+     *
+     * @return Statistical information about the layout.
+     */
+    statistics determine_statistics() const noexcept;
     /**
      * Prints the assigned cell types to the given std::ostream channel. A textual representation is used for
      * visualization. Currently only one crossing layer can be represented correctly. This is more of a debug function
@@ -229,6 +266,10 @@ public:
     void write_layout(std::ostream& os = std::cout, const bool io_color = true, const bool clk_color = false) const noexcept;
 
 private:
+    /**
+     * Streams map gate layouts to cell level tile row by tile row and need to maintain the internal maps.
+     */
+    friend class fcn_cell_stream;
     /**
      * Gate library associated with the layout. Determines tile sizes and enables for adding gates instead of cells.
      */
@@ -277,12 +318,20 @@ private:
      * automatically generated by output functions if needed (like for QCA).
      */
     void assign_vias() noexcept;
+    /**
+     * Marks the given crossing layer cell as a via if it has at most one non-free neighbor in its layer and creates the
+     * corresponding via cell in the ground layer.
+     *
+     * @param c Non-free crossing layer cell.
+     */
+    void assign_via(const cell& c) noexcept;
     /**
      * Removes bumps and straightens input and output wires.
      * This optimization function is designed to be used with iNML layouts clocked with one of the ToPoliNano clocking
      * schemes. Due to the shifted tile layouts, which emulate row-wise clocking in a tile-based fashion, wire bumps can
      * occur when mapping to a cell level layout. This function removes them and thereby creates a more pleasing looking
-     * layout that even saves a few magnets.
+     * layout that even saves a few magnets. Rows are swept once from top to bottom; only rows into which humps have been
+     * merged upwards are revisited.
      *
      * Implemented in optimization.cpp.
      */
@@ -291,6 +340,11 @@ private:
      * Tries to find cuts in a layout to optimize depth.
      * A cut is defined as a set of horizontal cell sequences (wires) in different y-positions that can be removed to
      * seperate the layout into two non-connected blocks that can be merged together seamlessly.
+     *
+     * All cuts are identified in a single scan over the layout's columns. Afterwards, one column remapping is computed
+     * and all cell planes are rewritten once.
+     *
+     * Implemented in optimization.cpp.
      */
     void cut_optimization() noexcept;
     /**
@@ -0,0 +1,153 @@
+//
+// Created by marcel on 19.10.26.
+//
+
+#include "fcn_cell_stream.h"
+#include <itertools.hpp>
+#include <algorithm>
+#include <memory>
+
+
+fcn_cell_stream::fcn_cell_stream(fcn_gate_library_ptr lib) noexcept
+        :
+        library{std::move(lib)}
+{}
+
+fcn_dimension_xyz fcn_cell_stream::dimensions() const noexcept
+{
+    const auto layout = library->get_layout();
+
+    return fcn_dimension_xyz{layout->x() * library->gate_x_size(),
+                             layout->y() * library->gate_y_size() +
+                             (layout->is_vertically_shifted() ?
+                             library->gate_y_size() / 2 : 0),  // add half a tile in y direction if layout is vertically shifted
+                             layout->z()};
+}
+
+void fcn_cell_stream::operator()(const band_callback& fn) const
+{
+    const auto layout = library->get_layout();
+
+    // the window has the full dimensions but only stores the cells of up to three bands
+    auto window = std::make_shared<fcn_cell_layout>(dimensions(), layout->clocking,
+                                                    library->get_technology(), layout->get_name());
+    window->library = library;
+
+    const auto num_bands = static_cast<coord_t>((window->y() + library->gate_y_size() - 1) / library->gate_y_size());
+    if (num_bands == 0u)
+        return;
+
+    map_tile_row(*window, 0);
+    map_band_clocking(*window, 0);
+
+    for (auto band : iter::range(num_bands))
+    {
+        // the successor is needed for vias and holds the lower halves of shifted gates from the current tile row
+        if (band + 1 < layout->y())
+            map_tile_row(*window, band + 1);
+        if (band + 1 < num_bands)
+            map_band_clocking(*window, band + 1);
+
+        map_band_vias(*window, band);
+
+        const auto [first_row, last_row] = band_rows(*window, band);
+        fn(window, first_row, last_row);
+
+        // the current band is still needed as a neighbor for its successor
+        if (band > 0)
+            drop_band(*window, band - 1);
+    }
+}
+
+void fcn_cell_stream::map_tile_row(fcn_cell_layout& window, const coord_t row) const
+{
+    const auto layout = library->get_layout();
+
+    // layers are mapped in ascending order for each tile, just like fcn_cell_layout does
+    for (auto x : iter::range(layout->x()))
+    {
+        for (auto z : iter::range(layout->z()))
+        {
+            const auto t = fcn_gate_layout::tile{x, row, z};
+            if (layout->is_free_tile(t))
+                continue;
+
+            window.assign_gate({t[X] * library->gate_x_size(),
+                                t[Y] * library->gate_y_size() + (layout->is_vertically_shifted() && (layout->is_odd_column(t)) ?
+                                library->gate_y_size() / 2 : 0), window.technology == fcn::technology::INML ? GROUND : t[Z]},
+                               library->set_up_gate(t), layout->get_latch(t), layout->get_inp_names(t), layout->get_out_names(t));
+        }
+    }
+}
+
+void fcn_cell_stream::map_band_clocking(fcn_cell_layout& window, const coord_t band) const noexcept
+{
+    if (window.clocking.regular)
+        return;
+
+    const auto layout = library->get_layout();
+    const auto [first_row, last_row] = band_rows(window, band);
+
+    for (auto y : iter::range(first_row, last_row + 1))
+    {
+        for (auto x : iter::range(window.x()))
+        {
+            if (auto t = fcn_gate_layout::tile{x / library->gate_x_size(), y / library->gate_y_size(), GROUND};
+                    auto clk = layout->tile_clocking(t))
+                window.assign_clocking(fcn_cell_layout::cell{x, y, GROUND}, clk.value_or(0));
+        }
+    }
+}
+
+void fcn_cell_stream::map_band_vias(fcn_cell_layout& window, const coord_t band) const noexcept
+{
+    // only QCA layouts need vias
+    if (window.technology != fcn::technology::QCA)
+        return;
+
+    const auto [first_row, last_row] = band_rows(window, band);
+
+    for (auto z : iter::range(coord_t{1}, window.z()))
+    {
+        for (auto y : iter::range(first_row, last_row + 1))
+        {
+            for (auto x : iter::range(window.x()))
+            {
+                if (const auto c = fcn_cell_layout::cell{x, y, z}; !window.is_free_cell(c))
+                    window.assign_via(c);
+            }
+        }
+    }
+}
+
+void fcn_cell_stream::drop_band(fcn_cell_layout& window, const coord_t band) const noexcept
+{
+    const auto [first_row, last_row] = band_rows(window, band);
+
+    for (auto y : iter::range(first_row, last_row + 1))
+    {
+        for (auto x : iter::range(window.x()))
+        {
+            for (auto z : iter::range(window.z()))
+            {
+                const auto c = fcn_cell_layout::cell{x, y, z};
+
+                window.assign_cell_type(c, fcn::EMPTY_CELL);
+                window.assign_cell_mode(c, fcn::cell_mode::NORMAL);
+                window.assign_cell_name(c, "");
+            }
+
+            const auto c = fcn_cell_layout::cell{x, y, GROUND};
+            window.assign_latch(c, 0);
+            window.c_map.write().erase(window.get_ground(c));
+        }
+    }
+}
+
+std::pair<coord_t, coord_t> fcn_cell_stream::band_rows(const fcn_cell_layout& window, const coord_t band) const noexcept
+{
+    const coord_t first_row = band * library->gate_y_size();
+    const coord_t last_row  = std::min(first_row + library->gate_y_size(), window.y()) - 1;
+
+    return {first_row, last_row};
+}
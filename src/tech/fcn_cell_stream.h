@@ -0,0 +1,102 @@
+//
+// Created by marcel on 19.10.26.
+//
+
+#ifndef FICTION_FCN_CELL_STREAM_H
+#define FICTION_FCN_CELL_STREAM_H
+
+
+#include "fcn_cell_layout.h"
+#include "fcn_gate_library.h"
+#include <functional>
+#include <utility>
+
+
+/**
+ * Maps the fcn_gate_layout associated with a gate library to cell level tile row by tile row instead of materializing
+ * a complete fcn_cell_layout. Cells are held in a window layout that has the dimensions of the full cell layout but
+ * only ever stores the cells of three consecutive tile rows, i.e., the band currently handed out, its predecessor,
+ * and its successor. The neighbors are needed to determine vias and the cells of vertically shifted gates that reach
+ * into the next band.
+ *
+ * Output functions that need to visit the layout's cells in row-major order, e.g., layer by layer, can pull bands of
+ * cell rows from the stream and write them out immediately. Multiple passes are possible and call set_up_gate anew.
+ *
+ * Cell-level optimizations that need the whole layout, i.e., the clean-up and cut compaction of iNML layouts clocked
+ * with one of the ToPoliNano clocking schemes, are not performed.
+ */
+class fcn_cell_stream
+{
+public:
+    /**
+     * Callback type for bands of cell rows. The window layout contains all cells of the rows first_row to last_row
+     * (both inclusive) exactly as an fcn_cell_layout constructed from the same library would contain them.
+     */
+    using band_callback = std::function<void(const fcn_cell_layout_ptr& window,
+                                             const coord_t first_row, const coord_t last_row)>;
+    /**
+     * Standard constructor.
+     *
+     * @param lib FCN gate library to use for mapping operations.
+     */
+    explicit fcn_cell_stream(fcn_gate_library_ptr lib) noexcept;
+    /**
+     * Performs one pass over the gate layout and calls fn for each band of cell rows from top to bottom. A band
+     * corresponds to one tile row.
+     *
+     * @param fn Callback to be invoked for each band.
+     */
+    void operator()(const band_callback& fn) const;
+    /**
+     * Returns the dimensions of the cell layout that is being streamed.
+     *
+     * @return x-, y-, and z-size of the cell layout.
+     */
+    fcn_dimension_xyz dimensions() const noexcept;
+
+private:
+    /**
+     * Gate library to map tiles with.
+     */
+    const fcn_gate_library_ptr library;
+    /**
+     * Maps all non-free tiles of the given row into the window.
+     *
+     * @param window Window layout.
+     * @param row Tile row to map.
+     */
+    void map_tile_row(fcn_cell_layout& window, const coord_t row) const;
+    /**
+     * Assigns clock numbers to the ground cells of the given band if the clocking is irregular.
+     *
+     * @param window Window layout.
+     * @param band Band whose cells should be clocked.
+     */
+    void map_band_clocking(fcn_cell_layout& window, const coord_t band) const noexcept;
+    /**
+     * Determines vias in the crossing layers of the given band. Requires the neighboring bands to be mapped.
+     *
+     * @param window Window layout.
+     * @param band Band whose vias should be determined.
+     */
+    void map_band_vias(fcn_cell_layout& window, const coord_t band) const noexcept;
+    /**
+     * Removes all cells and their attributes of the given band from the window.
+     *
+     * @param window Window layout.
+     * @param band Band to remove.
+     */
+    void drop_band(fcn_cell_layout& window, const coord_t band) const noexcept;
+    /**
+     * Returns the first and last cell row of the given band. The last band of vertically shifted layouts only spans
+     * half a tile.
+     *
+     * @param window Window layout.
+     * @param band Band whose rows are desired.
+     * @return Pair of first and last row (both inclusive).
+     */
+    std::pair<coord_t, coord_t> band_rows(const fcn_cell_layout& window, const coord_t band) const noexcept;
+};
+
+
+#endif //FICTION_FCN_CELL_STREAM_H
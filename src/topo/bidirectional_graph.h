@@ -181,6 +181,25 @@ public:
     {
         graph = graph_container();
     }
+    /**
+     * Replaces the stored graph by a new one that is constructed in one go from the given vertex properties and edge
+     * list. Vertex i gets properties props[i] assigned. Edges are inserted in the given order which therefore also
+     * determines the order of all in- and out-edge lists. This is much faster than removing and adding several
+     * elements individually but invalidates all previously obtained edges.
+     *
+     * @param props Properties for each vertex.
+     * @param edges Pairs of source and target vertices.
+     */
+    void rebuild_graph(const std::vector<VERTEX_PROPERTIES>& props, const std::vector<std::pair<vertex_t, vertex_t>>& edges)
+    {
+        graph_container new_graph(edges.cbegin(), edges.cend(), props.size());
+
+        typename boost::property_map<graph_container, vertex_properties_t>::type param = get(vertex_properties, new_graph);
+        for (vertex_t v = 0u; v < props.size(); ++v)
+            param[v] = props[v];
+
+        graph = std::move(new_graph);
+    }
 
     // ************************************************************
     // ************************ Properties ************************
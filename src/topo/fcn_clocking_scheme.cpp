@@ -5,6 +5,34 @@
 #include "fcn_clocking_scheme.h"
 
 
+namespace
+{
+    /**
+     * Stores the given cutout in row-major order.
+     *
+     * @param c Cutout to flatten.
+     * @return Zones of c in row-major order.
+     */
+    std::vector<fcn_clock::zone> flatten(const fcn_clock::cutout& c) noexcept
+    {
+        std::vector<fcn_clock::zone> flat{};
+        for (const auto& row : c)
+            flat.insert(flat.cend(), row.cbegin(), row.cend());
+
+        return flat;
+    }
+    /**
+     * Checks whether n is a power of two.
+     *
+     * @param n Number to check.
+     * @return True, iff n is a power of two.
+     */
+    constexpr bool is_power_of_two(const uint64_t n) noexcept
+    {
+        return n != 0u && (n & (n - 1u)) == 0u;
+    }
+}
+
 fcn_clocking_scheme::fcn_clocking_scheme(const std::string& name, const fcn_clock::cutout& c, const fcn_clock::number n, const bool r) noexcept
         :
         name(name),
@@ -12,7 +40,11 @@ fcn_clocking_scheme::fcn_clocking_scheme(const std::string& name, const fcn_cloc
         num_clocks(n),
         regular(r),
         cutout_y(scheme.size()),
-        cutout_x(cutout_y ? scheme[0].size() : 0)
+        cutout_x(cutout_y ? scheme[0].size() : 0),
+        flat_scheme(flatten(scheme)),
+        x_mask(cutout_x ? cutout_x - 1u : 0u),
+        y_mask(cutout_y ? cutout_y - 1u : 0u),
+        power_of_two(is_power_of_two(cutout_x) && is_power_of_two(cutout_y))
 {}
 
 fcn_clocking_scheme::fcn_clocking_scheme(std::string&& name, fcn_clock::cutout&& c, fcn_clock::number&& n, bool&& r) noexcept
@@ -22,7 +54,11 @@ fcn_clocking_scheme::fcn_clocking_scheme(std::string&& name, fcn_clock::cutout&&
         num_clocks(std::move(n)),
         regular(std::move(r)),
         cutout_y(scheme.size()),
-        cutout_x(cutout_y ? scheme[0].size() : 0)
+        cutout_x(cutout_y ? scheme[0].size() : 0),
+        flat_scheme(flatten(scheme)),
+        x_mask(cutout_x ? cutout_x - 1u : 0u),
+        y_mask(cutout_y ? cutout_y - 1u : 0u),
+        power_of_two(is_power_of_two(cutout_x) && is_power_of_two(cutout_y))
 {}
 
 std::optional<fcn_clocking_scheme> get_clocking_scheme(const std::string& name) noexcept
@@ -5,6 +5,8 @@
 #ifndef FICTION_FCN_CLOCKING_SCHEME_H
 #define FICTION_FCN_CLOCKING_SCHEME_H
 
+#include <array>
+#include <cstdint>
 #include <utility>
 #include <vector>
 #include <string>
@@ -26,88 +28,186 @@ namespace fcn_clock
      * Alias for a cutout of clock zone tiles.
      */
     using cutout = std::vector<std::vector<zone>>;
+    /**
+     * Wraps coordinate c into the range [0, N). Power-of-two values of N are resolved to a bit mask at compile time.
+     *
+     * @tparam N Period to wrap c into.
+     * @param c Coordinate to wrap.
+     * @return c mod N.
+     */
+    template <std::size_t N>
+    constexpr uint64_t wrap(const uint64_t c) noexcept
+    {
+        static_assert(N > 0ul, "period must not be 0");
+
+        if constexpr ((N & (N - 1ul)) == 0ul)
+            return c & (N - 1ul);
+        else
+            return c % N;
+    }
+    /**
+     * A cutout of a regular clocking scheme whose dimensions and clock zones are known at compile time. Clock queries
+     * on it inline to a table lookup. Pre-defined schemes are given as constexpr instances of this type, which also
+     * serve as the source of the runtime cutouts below. See dispatch for a way to obtain them from an
+     * fcn_clocking_scheme.
+     *
+     * @tparam Clocks Number of different clocks.
+     * @tparam Y Number of zones in y-direction.
+     * @tparam X Number of zones in x-direction.
+     */
+    template <number Clocks, std::size_t Y, std::size_t X>
+    struct static_cutout
+    {
+        /**
+         * Clock zones in row-major order.
+         */
+        std::array<std::array<zone, X>, Y> zones;
+        /**
+         * Returns the clock zone of the tile at position (x, y).
+         *
+         * @param x X-coordinate.
+         * @param y Y-coordinate.
+         * @return Clock zone at (x, y).
+         */
+        constexpr zone at(const uint64_t x, const uint64_t y) const noexcept
+        {
+            return zones[wrap<Y>(y)][wrap<X>(x)];
+        }
+        /**
+         * Returns the clock zone that is d phases after z.
+         *
+         * @param z Clock zone.
+         * @param d Number of phases.
+         * @return (z + d) mod Clocks.
+         */
+        static constexpr zone advance(const zone z, const uint64_t d) noexcept
+        {
+            return static_cast<zone>(wrap<Clocks>(z + d));
+        }
+        /**
+         * Converts this cutout to its runtime representation.
+         *
+         * @return Runtime cutout holding the same zones.
+         */
+        cutout to_cutout() const
+        {
+            cutout c{};
+            for (const auto& row : zones)
+                c.emplace_back(row.cbegin(), row.cend());
+
+            return c;
+        }
+    };
     /**
      * Representing the BANCS clocking as defined in "BANCS: Bidirectional Alternating Nanomagnetic Clocking Scheme" by
      * Ruan Evangelista Formigoni, Omar P. Vilela Neto, and Jose Augusto M. Nacif in SBCCI 2018.
      */
-    const cutout bancs_3 =
-    {{
+    inline constexpr static_cutout<3, 6, 3> bancs_3_zones
+    {{{
          {{0, 1, 2}},
          {{2, 1, 0}},
          {{2, 0, 1}},
          {{1, 0, 2}},
          {{1, 2, 0}},
          {{0, 2, 1}}
-    }};
+    }}};
+    /**
+     * Runtime representation of bancs_3_zones.
+     */
+    const cutout bancs_3 = bancs_3_zones.to_cutout();
     /**
      * Representing the USE clocking as defined in "USE: A Universal, Scalable, and Efficient Clocking Scheme for QCA"
      * by Caio Araujo T. Campos, Abner L. Marciano, Omar P. Vilela Neto, and Frank Sill Torres in TCAD 2015.
      */
-    const cutout use_4 =
-    {{
+    inline constexpr static_cutout<4, 4, 4> use_4_zones
+    {{{
          {{0, 1, 2, 3}},
          {{3, 2, 1, 0}},
          {{2, 3, 0, 1}},
          {{1, 0, 3, 2}}
-    }};
+    }}};
+    /**
+     * Runtime representation of use_4_zones.
+     */
+    const cutout use_4 = use_4_zones.to_cutout();
     /**
      * Representing the RES clocking as defined in "An efficient clocking scheme for quantum-dot cellular automata" by
      * Mrinal Goswami, Anindan Mondal, Mahabub Hasan Mahalat, Bibhash Sen, and Biplab K. Sikdar in International Journal
      * of Electronics Letters 2019.
      */
-    const cutout res_4 =
-    {{
+    inline constexpr static_cutout<4, 4, 4> res_4_zones
+    {{{
          {{3, 0, 1, 2}},
          {{0, 1, 0, 3}},
          {{1, 2, 3, 0}},
          {{0, 3, 2, 1}}
-    }};
+    }}};
+    /**
+     * Runtime representation of res_4_zones.
+     */
+    const cutout res_4 = res_4_zones.to_cutout();
     /**
      * Representing a 3-phase adoption of the 2DDWave clocking as defined in "Clocking and Cell Placement for QCA" by
      * V. Vankamamidi, M. Ottavi, and F. Lombardi in IEEE Conference on Nanotechnology 2006.
      */
-    const cutout twoddwave_3 =
-    {{
+    inline constexpr static_cutout<3, 3, 3> twoddwave_3_zones
+    {{{
          {{0, 1, 2}},
          {{1, 2, 0}},
          {{2, 0, 1}}
-    }};
+    }}};
+    /**
+     * Runtime representation of twoddwave_3_zones.
+     */
+    const cutout twoddwave_3 = twoddwave_3_zones.to_cutout();
     /**
      * Representing the original 2DDWave clocking as defined in "Clocking and Cell Placement for QCA" by V. Vankamamidi,
      * M. Ottavi, and F. Lombardi in IEEE Conference on Nanotechnology 2006.
      */
-    const cutout twoddwave_4 =
-    {{
+    inline constexpr static_cutout<4, 4, 4> twoddwave_4_zones
+    {{{
          {{0, 1, 2, 3}},
          {{1, 2, 3, 0}},
          {{2, 3, 0, 1}},
          {{3, 0, 1, 2}}
-    }};
+    }}};
+    /**
+     * Runtime representation of twoddwave_4_zones.
+     */
+    const cutout twoddwave_4 = twoddwave_4_zones.to_cutout();
     /**
      * Representing a 3-phase adaption of the clocking originally introduced in "A device architecture for computing
      * with quantum dots" by C. S. Lent and P. D. Tougaw in the Proceedings of the IEEE 1997. As it is used in
      * "ToPoliNano" (https://topolinano.polito.it/), it is referred to by that name in fiction to differentiate it
      * better from 2DDWave.
      */
-    const cutout topolinano_3 =
-    {{
+    inline constexpr static_cutout<3, 3, 3> topolinano_3_zones
+    {{{
          {{0, 1, 2}},
          {{0, 1, 2}},
          {{0, 1, 2}}
-    }};
+    }}};
+    /**
+     * Runtime representation of topolinano_3_zones.
+     */
+    const cutout topolinano_3 = topolinano_3_zones.to_cutout();
     /**
      * Representing a linear 4-phase 1D clocking as originally introduced in "A device architecture for computing with
      * quantum dots" by C. S. Lent and P. D. Tougaw in the Proceedings of the IEEE 1997. As it is used in "ToPoliNano"
      * (https://topolinano.polito.it/), it is referred to by that name in fiction to differentiate it better from
      * 2DDWave.
      */
-    const cutout topolinano_4 =
-    {{
+    inline constexpr static_cutout<4, 4, 4> topolinano_4_zones
+    {{{
          {{0, 1, 2, 3}},
          {{0, 1, 2, 3}},
          {{0, 1, 2, 3}},
          {{0, 1, 2, 3}}
-    }};
+    }}};
+    /**
+     * Runtime representation of topolinano_4_zones.
+     */
+    const cutout topolinano_4 = topolinano_4_zones.to_cutout();
 }
 
 /**
@@ -163,6 +263,36 @@ public:
      * @param r Flag to indicate clocking as regular.
      */
     fcn_clocking_scheme(std::string&& name, fcn_clock::cutout&& c, fcn_clock::number&& n, bool&& r) noexcept;
+    /**
+     * Returns the clock zone of the tile at position (x, y) of a regular scheme. The cutout is stored as a flat table
+     * and power-of-two cutout sizes are wrapped via bit masks instead of modulo operations. For pre-defined schemes
+     * known at compile time, see fcn_clock::dispatch.
+     *
+     * @param x X-coordinate.
+     * @param y Y-coordinate.
+     * @return Clock zone at (x, y).
+     */
+    fcn_clock::zone zone_at(const uint64_t x, const uint64_t y) const noexcept
+    {
+        if (power_of_two)
+            return flat_scheme[(y & y_mask) * cutout_x + (x & x_mask)];
+
+        return flat_scheme[(y % cutout_y) * cutout_x + x % cutout_x];
+    }
+
+private:
+    /**
+     * Cutout in row-major order.
+     */
+    std::vector<fcn_clock::zone> flat_scheme;
+    /**
+     * Masks to wrap coordinates into the cutout if its sizes are powers of two.
+     */
+    uint64_t x_mask, y_mask;
+    /**
+     * Flag to indicate that both cutout sizes are powers of two.
+     */
+    bool power_of_two;
 };
 
 /**
@@ -201,6 +331,91 @@ static fcn_clocking_scheme topolinano_3_clocking{"TOPOLINANO3", fcn_clock::topol
  * Pre-defined 4 x 4 ToPoliNano clocking instance.
  */
 static fcn_clocking_scheme topolinano_4_clocking{"TOPOLINANO4", fcn_clock::topolinano_4, 4u, true};
+namespace fcn_clock
+{
+    /**
+     * Offers the interface of static_cutout for regular clocking schemes that are only known at runtime. Used as the
+     * fallback of dispatch.
+     */
+    class dynamic_cutout
+    {
+    public:
+        /**
+         * Standard constructor.
+         *
+         * @param s Regular clocking scheme to wrap. Must outlive this object.
+         */
+        explicit dynamic_cutout(const fcn_clocking_scheme& s) noexcept
+                :
+                scheme{&s}
+        {}
+        /**
+         * Returns the clock zone of the tile at position (x, y).
+         *
+         * @param x X-coordinate.
+         * @param y Y-coordinate.
+         * @return Clock zone at (x, y).
+         */
+        zone at(const uint64_t x, const uint64_t y) const noexcept
+        {
+            return scheme->zone_at(x, y);
+        }
+        /**
+         * Returns the clock zone that is d phases after z.
+         *
+         * @param z Clock zone.
+         * @param d Number of phases.
+         * @return (z + d) mod the scheme's number of clocks.
+         */
+        zone advance(const zone z, const uint64_t d) const noexcept
+        {
+            return static_cast<zone>((z + d) % scheme->num_clocks);
+        }
+
+    private:
+        /**
+         * Wrapped clocking scheme.
+         */
+        const fcn_clocking_scheme* scheme;
+    };
+    /**
+     * Resolves the given clocking scheme to a compile-time representation and calls f with it. If s is one of the
+     * pre-defined regular schemes, f is called with the respective static_cutout such that all clock queries within f
+     * inline to table lookups. Otherwise, f is called with a dynamic_cutout. Thereby, f is instantiated once per
+     * pre-defined scheme. The lookup itself compares names and should therefore be done outside of hot loops.
+     *
+     * Irregular schemes are passed as dynamic_cutout as well, which must not be queried.
+     *
+     * @tparam F Callable that accepts static_cutout and dynamic_cutout objects, e.g., a generic lambda.
+     * @param s Clocking scheme to resolve.
+     * @param f Callable to invoke.
+     * @return Result of f.
+     */
+    template <typename F>
+    decltype(auto) dispatch(const fcn_clocking_scheme& s, F&& f)
+    {
+        if (s.regular)
+        {
+            if (s.name == "2DDWAVE4")
+                return f(twoddwave_4_zones);
+            if (s.name == "2DDWAVE3")
+                return f(twoddwave_3_zones);
+            if (s.name == "USE")
+                return f(use_4_zones);
+            if (s.name == "RES")
+                return f(res_4_zones);
+            if (s.name == "BANCS")
+                return f(bancs_3_zones);
+            if (s.name == "TOPOLINANO4")
+                return f(topolinano_4_zones);
+            if (s.name == "TOPOLINANO3")
+                return f(topolinano_3_zones);
+        }
+
+        return f(dynamic_cutout{s});
+    }
+}
+
 /**
  * Looks up a clocking scheme by its name. String comparison happens case-insensitive.
  *
@@ -5,6 +5,25 @@
 #include "fcn_gate_layout.h"
 
 
+namespace
+{
+    /**
+     * Erases key k from the wrapped map or set m. Write access is only requested if k is present so that shared
+     * storage is not copied needlessly.
+     *
+     * @tparam Container Map or set type.
+     * @tparam Key Key type.
+     * @param m Wrapped map or set.
+     * @param k Key to erase.
+     */
+    template <typename Container, typename Key>
+    void erase_if_present(copy_on_write<Container>& m, const Key& k) noexcept
+    {
+        if (m->count(k) > 0u)
+            m.write().erase(k);
+    }
+}
+
 fcn_gate_layout::fcn_gate_layout(const fcn_dimension_xyz& lengths, fcn_clocking_scheme clocking, logic_network_ptr ln, offset o) noexcept
         :
         fcn_layout(lengths, std::move(clocking), o),
@@ -38,35 +57,28 @@ fcn_gate_layout::fcn_gate_layout(logic_network_ptr ln, offset o) noexcept
 std::optional<fcn_gate_layout::tile> fcn_gate_layout::random_gate() const noexcept
 {
     std::mt19937 rgen(std::random_device{}());
-    std::uniform_int_distribution<coord_t> dist(0, v_map.left.size() - 1); // distribution in range [0, |G|]
+    std::uniform_int_distribution<coord_t> dist(0, v_map->left.size() - 1); // distribution in range [0, |G|]
 
-    const auto rnd_it = std::next(std::begin(v_map.left), dist(rgen));
+    const auto rnd_it = std::next(std::begin(v_map->left), dist(rgen));
 
-    return rnd_it == v_map.left.end() ? std::nullopt : std::make_optional(rnd_it->first);
+    return rnd_it == v_map->left.end() ? std::nullopt : std::make_optional(rnd_it->first);
 }
 
 bool fcn_gate_layout::is_incoming_clocked(const tile& t1, const tile& t2) const noexcept
 {
-    if (!tile_clocking(t1) || !tile_clocking(t2))
-        return false;
-
-    if (t1 == t2)
-        return false;
-
-    return static_cast<fcn_clock::zone>((*tile_clocking(t2) + get_latch(t2) + 1) %
-                                        clocking.num_clocks) == *tile_clocking(t1);
+    return is_outgoing_clocked(t2, t1);
 }
 
 bool fcn_gate_layout::is_outgoing_clocked(const tile& t1, const tile& t2) const noexcept
 {
-    if (!tile_clocking(t1) || !tile_clocking(t2))
+    if (t1 == t2)
         return false;
 
-    if (t1 == t2)
+    const auto c1 = tile_clocking(t1), c2 = tile_clocking(t2);
+    if (!c1 || !c2)
         return false;
 
-    return static_cast<fcn_clock::zone>((*tile_clocking(t1) + get_latch(t1) + 1) %
-                                        clocking.num_clocks) == *tile_clocking(t2);
+    return static_cast<fcn_clock::zone>((*c1 + get_latch(t1) + 1) % clocking.num_clocks) == *c2;
 }
 
 layout::directions fcn_gate_layout::closest_border(const tile& t) const noexcept
@@ -105,12 +117,11 @@ std::optional<fcn_clock::zone> fcn_gate_layout::tile_clocking(const tile& t) con
 {
     if (clocking.regular)
     {
-        auto x = t[X], y = t[Y];
-        return clocking.scheme[y % clocking.cutout_y][x % clocking.cutout_x];
+        return clocking.zone_at(t[X], t[Y]);
     }
     else  // irregular clocking accesses clocking map
     {
-        if (auto it = c_map.find(get_ground(t)); it != c_map.end())
+        if (auto it = c_map->find(get_ground(t)); it != c_map->end())
         {
             return it->second;
         }
@@ -128,15 +139,19 @@ std::optional<fcn_clock::zone> fcn_gate_layout::tile_clocking(const tile_index t
 
 void fcn_gate_layout::assign_logic_vertex(const tile& t, const logic_network::vertex v, const bool pi, const bool po) noexcept
 {
+    prepare_modification(t);
+
     dissociate_logic_edges(t);
     dissociate_logic_vertex(t);
-    v_map.insert(vertex_map::value_type(t, v));
+    v_map.write().insert(vertex_map::value_type(t, v));
 
     // keep track of I/O sets
     if (pi)
-        pi_set.emplace(t);
+        pi_set.write().emplace(t);
     if (po)
-        po_set.emplace(t);
+        po_set.write().emplace(t);
+
+    notify_modification(t);
 }
 
 void fcn_gate_layout::dissociate_logic_vertex(const tile& t) noexcept
@@ -144,20 +159,29 @@ void fcn_gate_layout::dissociate_logic_vertex(const tile& t) noexcept
     if (is_wire_tile(t))
         return;
 
-    v_map.left.erase(t);
+    // nothing to dissociate; return early to not copy shared maps
+    if (!is_gate_tile(t) && !is_pi(t) && !is_po(t) && !inp_dir_map->count(t) && !out_dir_map->count(t))
+        return;
+
+    prepare_modification(t);
+
+    if (is_gate_tile(t))
+        v_map.write().left.erase(t);
 
     // keep track of I/O sets
-    pi_set.erase(t);
-    po_set.erase(t);
+    erase_if_present(pi_set, t);
+    erase_if_present(po_set, t);
 
     // remove directions associated with t
-    inp_dir_map.erase(t);
-    out_dir_map.erase(t);
+    erase_if_present(inp_dir_map, t);
+    erase_if_present(out_dir_map, t);
+
+    notify_modification(t);
 }
 
 std::optional<logic_network::vertex> fcn_gate_layout::get_logic_vertex(const tile& t) const noexcept
 {
-    if (auto it = v_map.left.find(t); it != v_map.left.end())
+    if (auto it = v_map->left.find(t); it != v_map->left.end())
     {
         return it->second;
     }
@@ -169,12 +193,12 @@ std::optional<logic_network::vertex> fcn_gate_layout::get_logic_vertex(const til
 
 bool fcn_gate_layout::is_gate_tile(const tile& t) const noexcept
 {
-    return v_map.left.find(t) != v_map.left.end();
+    return v_map->left.find(t) != v_map->left.end();
 }
 
 bool fcn_gate_layout::has_logic_vertex(const tile& t, const logic_network::vertex v) const noexcept
 {
-    if (auto it = v_map.left.find(t); it != v_map.left.end())
+    if (auto it = v_map->left.find(t); it != v_map->left.end())
     {
         return it->second == v;
     }
@@ -186,7 +210,7 @@ bool fcn_gate_layout::has_logic_vertex(const tile& t, const logic_network::verte
 
 std::optional<fcn_gate_layout::tile> fcn_gate_layout::get_logic_tile(const logic_network::vertex v) const noexcept
 {
-    if (auto it = v_map.right.find(v); it != v_map.right.end())
+    if (auto it = v_map->right.find(v); it != v_map->right.end())
     {
         return it->second;
     }
@@ -198,52 +222,71 @@ std::optional<fcn_gate_layout::tile> fcn_gate_layout::get_logic_tile(const logic
 
 void fcn_gate_layout::assign_logic_edge(const tile& t, const logic_network::edge& e) noexcept
 {
+    prepare_modification(t);
+
     dissociate_logic_vertex(t);
-    e_map[t].emplace(e);
+    e_map.write()[t].emplace(e);
+
+    notify_modification(t);
 }
 
 void fcn_gate_layout::dissociate_logic_edge(const tile& t, const logic_network::edge& e) noexcept
 {
-    if (auto it = e_map.find(t); it != e_map.end())
+    // if tile t does not have e assigned, do nothing
+    if (!has_logic_edge(t, e))
+        return;
+
+    prepare_modification(t);
+
+    auto& edges = e_map.write();
+    if (auto it = edges.find(t); it != edges.end())
     {
         it->second.erase(e);
         // if this was the last edge assigned, save memory
         if (it->second.empty())
-            e_map.erase(t);
+            edges.erase(it);
+    }
 
-        edge_inp_dir_map.erase({t, e});
-        edge_out_dir_map.erase({t, e});
+    erase_if_present(edge_inp_dir_map, std::make_pair(t, e));
+    erase_if_present(edge_out_dir_map, std::make_pair(t, e));
 
-        // recalculate tile directions based on the leftover wires
-        const auto& edges = get_logic_edges(t);
-        inp_dir_map[t] = std::accumulate(edges.cbegin(), edges.cend(), layout::DIR_NONE,
-                                         [this, &t](auto val, const auto& _e)
-                                         { return val | get_wire_inp_dirs(t, _e); });
-        out_dir_map[t] = std::accumulate(edges.cbegin(), edges.cend(), layout::DIR_NONE,
-                                         [this, &t](auto val, const auto& _e)
-                                         { return val | get_wire_out_dirs(t, _e); });
-    }
+    // recalculate tile directions based on the leftover wires
+    const auto& leftover = get_logic_edges(t);
+    inp_dir_map.write()[t] = std::accumulate(leftover.cbegin(), leftover.cend(), layout::DIR_NONE,
+                                             [this, &t](auto val, const auto& _e)
+                                             { return val | get_wire_inp_dirs(t, _e); });
+    out_dir_map.write()[t] = std::accumulate(leftover.cbegin(), leftover.cend(), layout::DIR_NONE,
+                                             [this, &t](auto val, const auto& _e)
+                                             { return val | get_wire_out_dirs(t, _e); });
 
-    // if tile t does not have any edges assigned, do nothing
+    notify_modification(t);
 }
 
 void fcn_gate_layout::dissociate_logic_edges(const tile& t) noexcept
 {
-    inp_dir_map.erase(t);
-    out_dir_map.erase(t);
+    // nothing to dissociate; return early to not copy shared maps
+    if (!is_wire_tile(t) && !e_map->count(t) && !inp_dir_map->count(t) && !out_dir_map->count(t))
+        return;
+
+    prepare_modification(t);
+
+    erase_if_present(inp_dir_map, t);
+    erase_if_present(out_dir_map, t);
 
     for (auto& e : get_logic_edges(t))
     {
-        edge_inp_dir_map.erase({t, e});
-        edge_out_dir_map.erase({t, e});
+        erase_if_present(edge_inp_dir_map, std::make_pair(t, e));
+        erase_if_present(edge_out_dir_map, std::make_pair(t, e));
     }
 
-    e_map.erase(t);
+    erase_if_present(e_map, t);
+
+    notify_modification(t);
 }
 
 fcn_gate_layout::edge_set fcn_gate_layout::get_logic_edges(const tile& t) const noexcept
 {
-    if (auto it = e_map.find(t); it != e_map.end())
+    if (auto it = e_map->find(t); it != e_map->end())
     {
         return it->second;
     }
@@ -255,7 +298,7 @@ fcn_gate_layout::edge_set fcn_gate_layout::get_logic_edges(const tile& t) const
 
 bool fcn_gate_layout::is_wire_tile(const tile& t) const noexcept
 {
-    if (auto it = e_map.find(t); it != e_map.end())
+    if (auto it = e_map->find(t); it != e_map->end())
     {
         return !it->second.empty();
     }
@@ -267,7 +310,7 @@ bool fcn_gate_layout::is_wire_tile(const tile& t) const noexcept
 
 bool fcn_gate_layout::has_logic_edge(const tile& t, const logic_network::edge& e) const noexcept
 {
-    if (auto it = e_map.find(t); it != e_map.end())
+    if (auto it = e_map->find(t); it != e_map->end())
     {
         return it->second.count(e) > 0u;
     }
@@ -279,15 +322,6 @@ bool fcn_gate_layout::has_logic_edge(const tile& t, const logic_network::edge& e
 
 void fcn_gate_layout::clear_tile(const tile& t) noexcept
 {
-    inp_dir_map.erase(t);
-    out_dir_map.erase(t);
-
-    for (auto& e : get_logic_edges(t))
-    {
-        edge_inp_dir_map.erase({t, e});
-        edge_out_dir_map.erase({t, e});
-    }
-
     dissociate_logic_vertex(t);
     dissociate_logic_edges(t);
     assign_latch(t, 0);
@@ -304,10 +338,14 @@ void fcn_gate_layout::assign_tile_inp_dir(const tile& t, layout::directions d) n
     if (is_free_tile(t))
         return;
 
+    prepare_modification(t);
+
     if (d == layout::DIR_NONE)
-        inp_dir_map.erase(t);
+        erase_if_present(inp_dir_map, t);
     else
-        inp_dir_map[t] |= d;
+        inp_dir_map.write()[t] |= d;
+
+    notify_modification(t);
 }
 
 void fcn_gate_layout::assign_wire_inp_dir(const tile& t, const logic_network::edge& e, layout::directions d) noexcept
@@ -316,21 +354,25 @@ void fcn_gate_layout::assign_wire_inp_dir(const tile& t, const logic_network::ed
     if (!has_logic_edge(t, e))
         return;
 
+    prepare_modification(t);
+
     if (d == layout::DIR_NONE)
     {
-        inp_dir_map.erase(t);
-        edge_inp_dir_map.erase({t, e});
+        erase_if_present(inp_dir_map, t);
+        erase_if_present(edge_inp_dir_map, std::make_pair(t, e));
     }
     else
     {
-        inp_dir_map[t] |= d;
-        edge_inp_dir_map[{t, e}] |= d;
+        inp_dir_map.write()[t] |= d;
+        edge_inp_dir_map.write()[{t, e}] |= d;
     }
+
+    notify_modification(t);
 }
 
 bool fcn_gate_layout::is_tile_inp_dir(const tile& t, const layout::directions& d) const noexcept
 {
-    if (auto it = inp_dir_map.find(t); it != inp_dir_map.end())
+    if (auto it = inp_dir_map->find(t); it != inp_dir_map->end())
     {
         return (it->second & d) == d;
     }
@@ -342,7 +384,7 @@ bool fcn_gate_layout::is_tile_inp_dir(const tile& t, const layout::directions& d
 
 bool fcn_gate_layout::is_wire_inp_dir(const tile& t, const logic_network::edge& e, const layout::directions& d) const noexcept
 {
-    if (auto it = edge_inp_dir_map.find({t, e}); it != edge_inp_dir_map.end())
+    if (auto it = edge_inp_dir_map->find({t, e}); it != edge_inp_dir_map->end())
     {
         return (it->second & d) == d;
     }
@@ -354,7 +396,7 @@ bool fcn_gate_layout::is_wire_inp_dir(const tile& t, const logic_network::edge&
 
 layout::directions fcn_gate_layout::get_tile_inp_dirs(const tile& t) const noexcept
 {
-    if (auto it = inp_dir_map.find(t); it != inp_dir_map.end())
+    if (auto it = inp_dir_map->find(t); it != inp_dir_map->end())
     {
         return it->second;
     }
@@ -366,7 +408,7 @@ layout::directions fcn_gate_layout::get_tile_inp_dirs(const tile& t) const noexc
 
 layout::directions fcn_gate_layout::get_wire_inp_dirs(const tile& t, const logic_network::edge& e) const noexcept
 {
-    if (auto it = edge_inp_dir_map.find({t, e}); it != edge_inp_dir_map.end())
+    if (auto it = edge_inp_dir_map->find({t, e}); it != edge_inp_dir_map->end())
     {
         return it->second;
     }
@@ -382,10 +424,14 @@ void fcn_gate_layout::assign_tile_out_dir(const tile& t, layout::directions d) n
     if (is_free_tile(t))
         return;
 
+    prepare_modification(t);
+
     if (d == layout::DIR_NONE)
-        out_dir_map.erase(t);
+        erase_if_present(out_dir_map, t);
     else
-        out_dir_map[t] |= d;
+        out_dir_map.write()[t] |= d;
+
+    notify_modification(t);
 }
 
 void fcn_gate_layout::assign_wire_out_dir(const tile& t, const logic_network::edge& e, layout::directions d) noexcept
@@ -394,21 +440,25 @@ void fcn_gate_layout::assign_wire_out_dir(const tile& t, const logic_network::ed
     if (!has_logic_edge(t, e))
         return;
 
+    prepare_modification(t);
+
     if (d == layout::DIR_NONE)
     {
-        out_dir_map.erase(t);
-        edge_out_dir_map.erase({t, e});
+        erase_if_present(out_dir_map, t);
+        erase_if_present(edge_out_dir_map, std::make_pair(t, e));
     }
     else
     {
-        out_dir_map[t] |= d;
-        edge_out_dir_map[{t, e}] |= d;
+        out_dir_map.write()[t] |= d;
+        edge_out_dir_map.write()[{t, e}] |= d;
     }
+
+    notify_modification(t);
 }
 
 bool fcn_gate_layout::is_tile_out_dir(const tile& t, const layout::directions& d) const noexcept
 {
-    if (auto it = out_dir_map.find(t); it != out_dir_map.end())
+    if (auto it = out_dir_map->find(t); it != out_dir_map->end())
     {
         return (it->second & d) == d;
     }
@@ -420,7 +470,7 @@ bool fcn_gate_layout::is_tile_out_dir(const tile& t, const layout::directions& d
 
 bool fcn_gate_layout::is_wire_out_dir(const tile& t, const logic_network::edge& e, const layout::directions& d) const noexcept
 {
-    if (auto it = edge_out_dir_map.find({t, e}); it != edge_out_dir_map.end())
+    if (auto it = edge_out_dir_map->find({t, e}); it != edge_out_dir_map->end())
     {
         return (it->second & d) == d;
     }
@@ -432,7 +482,7 @@ bool fcn_gate_layout::is_wire_out_dir(const tile& t, const logic_network::edge&
 
 layout::directions fcn_gate_layout::get_tile_out_dirs(const tile& t) const noexcept
 {
-    if (auto it = out_dir_map.find(t); it != out_dir_map.end())
+    if (auto it = out_dir_map->find(t); it != out_dir_map->end())
     {
         return it->second;
     }
@@ -444,7 +494,7 @@ layout::directions fcn_gate_layout::get_tile_out_dirs(const tile& t) const noexc
 
 layout::directions fcn_gate_layout::get_wire_out_dirs(const tile& t, const logic_network::edge& e) const noexcept
 {
-    if (auto it = edge_out_dir_map.find({t, e}); it != edge_out_dir_map.end())
+    if (auto it = edge_out_dir_map->find({t, e}); it != edge_out_dir_map->end())
     {
         return it->second;
     }
@@ -692,7 +742,7 @@ std::vector<fcn_gate_layout::tile> fcn_gate_layout::incoming_data_flow(const til
 
 operation fcn_gate_layout::get_op(const tile& t) const noexcept
 {
-    if (auto it = v_map.left.find(t); it != v_map.left.end())
+    if (auto it = v_map->left.find(t); it != v_map->left.end())
     {
         return network->get_op(it->second);
     }
@@ -708,7 +758,7 @@ fcn_gate_layout::path_info fcn_gate_layout::signal_delay(const tile& t, const ga
         return {};
 
     if (auto idf = incoming_data_flow(t, gw); idf.empty())
-        return {1, *tile_clocking(t), 0};
+        return {1, *tile_clocking(t) + get_latch(t), 0};
     else if (auto it = dc.find(t); it != dc.end())  // cache hit
         return it->second;
     else  // cache miss
@@ -725,7 +775,7 @@ fcn_gate_layout::path_info fcn_gate_layout::signal_delay(const tile& t, const ga
 
         if (infos.size() == 1)  // size cannot be 0
             dominant_path = infos.front();
-        else  // fetch highest delay and difference
+        else if (latch_count() == 0ul)  // fetch highest delay and difference
         {
             // sort by path length
             std::sort(infos.begin(), infos.end(), [](const auto& i1, const auto& i2) { return i1.length < i2.length; });
@@ -734,10 +784,21 @@ fcn_gate_layout::path_info fcn_gate_layout::signal_delay(const tile& t, const ga
             dominant_path.delay = infos.back().delay;
             dominant_path.diff = infos.back().delay - infos.front().delay;
         }
+        else  // fetch highest delay and difference considering latches
+        {
+            // latches make path lengths and delays diverge; hence, both are determined separately
+            const auto [min_delay, max_delay] = std::minmax_element(infos.cbegin(), infos.cend(),
+                    [](const auto& i1, const auto& i2) { return i1.delay < i2.delay; });
+
+            dominant_path.length = std::max_element(infos.cbegin(), infos.cend(),
+                    [](const auto& i1, const auto& i2) { return i1.length < i2.length; })->length;
+            dominant_path.delay = max_delay->delay;
+            dominant_path.diff = max_delay->delay - min_delay->delay;
+        }
 
-        // incorporate self
+        // incorporate self including its latch
         ++dominant_path.length;
-        ++dominant_path.delay;
+        dominant_path.delay += 1 + get_latch(t);
 
         // cache value for gates only
         if (is_gate_tile(t))
@@ -775,13 +836,14 @@ logic_network::mig_nt fcn_gate_layout::extract() const noexcept
     using extraction_cache = std::unordered_map<tile, std::vector<logic_network::mig_nt::signal>, boost::hash<tile>>;
     extraction_cache cache{};
 
+    const auto frozen = get_network_snapshot();
+
     // check if all but one incoming signals have been cached (the one missing signal is the current one)
-    const auto is_discovered = [&cache, this](const auto& _t) -> bool
+    const auto is_discovered = [&cache, &frozen, this](const auto& _t) -> bool
     {
         if (auto it = cache.find(_t); it != cache.end())
         {
-            auto pre = network->in_edges(*get_logic_vertex(_t), true);
-            return (it->second.size() + 1ul) == static_cast<std::size_t>(std::distance(pre.begin(), pre.end()));
+            return (it->second.size() + 1ul) == frozen->in_degree(*get_logic_vertex(_t), true);
         }
         else
         {
@@ -935,9 +997,10 @@ std::vector<std::string> fcn_gate_layout::get_inp_names(const tile& t) const noe
     {
         if (auto v = get_logic_vertex(t))
         {
-            for (auto&& iav : network->inv_adjacent_vertices(*v, true))
+            const auto frozen = get_network_snapshot();
+            for (auto&& iav : frozen->inv_adjacent_vertices(*v, true))
             {
-                if (network->get_op(iav) == operation::PI)
+                if (frozen->get_op(iav) == operation::PI)
                     inp_names.push_back(network->get_port_name(iav));
             }
         }
@@ -959,9 +1022,10 @@ std::vector<std::string> fcn_gate_layout::get_out_names(const tile& t) const noe
     {
         if (auto v = get_logic_vertex(t))
         {
-            for (auto&& av : network->adjacent_vertices(*v, true))
+            const auto frozen = get_network_snapshot();
+            for (auto&& av : frozen->adjacent_vertices(*v, true))
             {
-                if (network->get_op(av) == operation::PO)
+                if (frozen->get_op(av) == operation::PO)
                     out_names.push_back(network->get_port_name(av));
             }
         }
@@ -972,8 +1036,8 @@ std::vector<std::string> fcn_gate_layout::get_out_names(const tile& t) const noe
 
 bool fcn_gate_layout::has_io_pins() const noexcept
 {
-    return std::all_of(pi_set.cbegin(), pi_set.cend(), [this](const auto& pi){return get_op(pi) == operation::PI;}) &&
-            std::all_of(po_set.cbegin(), po_set.cend(), [this](const auto& po){return get_op(po) == operation::PO;});
+    return std::all_of(pi_set->cbegin(), pi_set->cend(), [this](const auto& pi){return get_op(pi) == operation::PI;}) &&
+            std::all_of(po_set->cbegin(), po_set->cend(), [this](const auto& po){return get_op(po) == operation::PO;});
 }
 
 std::string fcn_gate_layout::get_name() const noexcept
@@ -986,84 +1050,72 @@ logic_network_ptr fcn_gate_layout::get_network() const noexcept
     return network;
 }
 
-fcn_layout::bounding_box fcn_gate_layout::determine_bounding_box() const noexcept
+logic_network_snapshot_ptr fcn_gate_layout::get_network_snapshot() const noexcept
 {
-    // calculate min_x
-    coord_t min_x = 0u;
-    for (coord_t x = 0u; x < this->x(); ++x)
-    {
-        bool elem_found = false;
-        for (coord_t y = 0u; y < this->y(); ++y)
-        {
-            if (!this->is_free_tile(tile{x, y, GROUND}) || !this->is_free_tile(tile{x, y, CROSSING}))
-            {
-                elem_found = true;
-                break;
-            }
-        }
+    return snapshot.get(network);
+}
 
-        min_x = x;
-        if (elem_found)
-            break;
-    }
+logic_network_snapshot_ptr fcn_gate_layout::freeze(const logic_network_ptr& ln) noexcept
+{
+    return ln ? std::make_shared<const logic_network_snapshot>(ln) : nullptr;
+}
 
-    // calculate min_y
-    coord_t min_y = 0u;
-    for (coord_t y = 0u; y < this->y(); ++y)
-    {
-        bool elem_found = false;
-        for (coord_t x = 0u; x < this->x(); ++x)
-        {
-            if (!this->is_free_tile(tile{x, y, GROUND}) || !this->is_free_tile(tile{x, y, CROSSING}))
-            {
-                elem_found = true;
-                break;
-            }
-        }
+fcn_gate_layout::lazy_snapshot::lazy_snapshot(const lazy_snapshot& other) noexcept
+{
+    *this = other;
+}
+
+fcn_gate_layout::lazy_snapshot& fcn_gate_layout::lazy_snapshot::operator=(const lazy_snapshot& other) noexcept
+{
+    if (this == &other)
+        return *this;
+
+    created = std::make_unique<std::once_flag>();
+    ready = false;
+    snapshot = nullptr;
 
-        min_y = y;
-        if (elem_found)
-            break;
+    // an already created snapshot is shared; otherwise, the copy creates its own one on first access
+    if (other.ready.load(std::memory_order_acquire))
+    {
+        std::call_once(*created, [this, &other]{ snapshot = other.snapshot; });
+        ready.store(true, std::memory_order_release);
     }
 
-    // calculate max_x
-    coord_t max_x = this->x() - 1;
-    for (auto x = static_cast<long>(this->x()) - 1; x >= 0; --x)
+    return *this;
+}
+
+logic_network_snapshot_ptr fcn_gate_layout::lazy_snapshot::get(const logic_network_ptr& ln) const noexcept
+{
+    std::call_once(*created, [this, &ln]
     {
-        bool elem_found = false;
-        for (coord_t y = 0u; y < this->y(); ++y)
-        {
-            if (!this->is_free_tile(tile{static_cast<coord_t>(x), y, GROUND}) ||
-                    !this->is_free_tile(tile{static_cast<coord_t>(x), y, CROSSING}))
-            {
-                elem_found = true;
-                break;
-            }
-        }
+        snapshot = freeze(ln);
+        ready.store(true, std::memory_order_release);
+    });
 
-        max_x = static_cast<coord_t>(x);
-        if (elem_found)
-            break;
-    }
+    return snapshot;
+}
+
+fcn_layout::bounding_box fcn_gate_layout::determine_bounding_box() const noexcept
+{
+    // an empty layout results in the same box that directional sweeps over all tiles would have produced
+    coord_t min_x = x() - 1, min_y = y() - 1, max_x = 0u, max_y = 0u;
 
-    // calculate max_y
-    coord_t max_y = this->y() - 1;
-    for (auto y = static_cast<long>(this->y()) - 1; y >= 0; --y)
+    const auto fit = [&min_x, &min_y, &max_x, &max_y](const tile& t)
     {
-        bool elem_found = false;
-        for (coord_t x = 0u; x < this->x(); ++x)
-        {
-            if (!this->is_free_tile(tile{x, static_cast<coord_t>(y), GROUND}) ||
-                    !this->is_free_tile(tile{x, static_cast<coord_t>(y), CROSSING}))
-            {
-                elem_found = true;
-                break;
-            }
-        }
+        min_x = std::min(min_x, t[X]); max_x = std::max(max_x, t[X]);
+        min_y = std::min(min_y, t[Y]); max_y = std::max(max_y, t[Y]);
+    };
 
-        max_y = static_cast<coord_t>(y);
-        if (elem_found)
-            break;
+    // each non-free tile is stored in exactly one of the maps
+    for (auto&& [t, v] : v_map->left)
+    {
+        (void)v;  // fix compiler warning
+        fit(t);
+    }
+    for (auto&& [t, es] : *e_map)
+    {
+        (void)es;  // fix compiler warning
+        fit(t);
     }
 
     return bounding_box{min_x, min_y, max_x, max_y};
@@ -1071,27 +1123,31 @@ fcn_layout::bounding_box fcn_gate_layout::determine_bounding_box() const noexcep
 
 energy::info fcn_gate_layout::calculate_energy() const noexcept
 {
-    double slow_energy = 0.0, fast_energy = 0.0;
-
-    auto num_wires = wire_count();
-    auto num_crossings = crossing_count();
+    return determine_statistics().energy;
+}
 
-    // adding wire energy (subtract 2 wires for each crossing)
-    slow_energy += static_cast<double>(num_wires - num_crossings * 2) * energy::WIRE_SLOW;
-    fast_energy += static_cast<double>(num_wires - num_crossings * 2) * energy::WIRE_FAST;
+fcn_gate_layout::statistics fcn_gate_layout::determine_statistics() const noexcept
+{
+    coord_t min_x = x() - 1, min_y = y() - 1, max_x = 0u, max_y = 0u;
 
-    // adding crossing energy
-    slow_energy += num_crossings * energy::CROSSING_SLOW;
-    fast_energy += num_crossings * energy::CROSSING_FAST;
+    const auto fit = [&min_x, &min_y, &max_x, &max_y](const tile& t)
+    {
+        min_x = std::min(min_x, t[X]); max_x = std::max(max_x, t[X]);
+        min_y = std::min(min_y, t[Y]); max_y = std::max(max_y, t[Y]);
+    };
 
-    // counting gates
-    auto num_inv_s = 0u, num_inv_b = 0u, num_and = 0u, num_or = 0u, num_maj = 0u, num_fan_out = 0u;
+    std::size_t num_gates = 0ul, num_crossings = 0ul, num_inv_s = 0ul, num_inv_b = 0ul, num_and = 0ul, num_or = 0ul,
+                num_maj = 0ul, num_fan_out = 0ul;
 
-    for (auto&& [t, v] : v_map.left)
+    for (auto&& [t, v] : v_map->left)
     {
-        (void)v;  // fix compiler warning
-        switch (get_op(t))
+        fit(t);
+
+        // the operation is fetched directly from the network to save a hash lookup
+        switch (network->get_op(v))
         {
+            case operation::W:
+                continue;
             case operation::NOT:
             {
                 // inputs are opposite to outputs --> straight inverter
@@ -1117,29 +1173,39 @@ energy::info fcn_gate_layout::calculate_energy() const noexcept
             default:
                 break;
         }
+
+        ++num_gates;
     }
 
-    // adding inverter energy
-    slow_energy += num_inv_s * energy::INVERTER_STRAIGHT_SLOW + num_inv_b * energy::INVERTER_BENT_SLOW;
-    fast_energy += num_inv_s * energy::INVERTER_STRAIGHT_FAST + num_inv_b * energy::INVERTER_BENT_FAST;
+    for (auto&& [t, es] : *e_map)
+    {
+        (void)es;  // fix compiler warning
+        fit(t);
+
+        if (t[Z] != GROUND)
+            ++num_crossings;
+    }
 
-    // adding conjunction energy
-    slow_energy += num_and * energy::AND_SLOW;
-    fast_energy += num_and * energy::AND_FAST;
+    const auto num_wires = e_map->size();
 
-    // adding disjunction energy
-    slow_energy += num_or * energy::OR_SLOW;
-    fast_energy += num_or * energy::OR_FAST;
+    // subtract 2 wires for each crossing
+    const auto num_plain_wires = static_cast<double>(num_wires) - static_cast<double>(num_crossings * 2);
 
-    // adding majority energy
-    slow_energy += num_maj * energy::MAJORITY_SLOW;
-    fast_energy += num_maj * energy::MAJORITY_FAST;
+    const energy::info dissipation
+    {
+        num_plain_wires * energy::WIRE_SLOW + num_crossings * energy::CROSSING_SLOW +
+        (num_inv_s * energy::INVERTER_STRAIGHT_SLOW + num_inv_b * energy::INVERTER_BENT_SLOW) +
+        num_and * energy::AND_SLOW + num_or * energy::OR_SLOW + num_maj * energy::MAJORITY_SLOW +
+        num_fan_out * energy::FANOUT_SLOW,
 
-    // adding fan-out energy
-    slow_energy += num_fan_out * energy::FANOUT_SLOW;
-    fast_energy += num_fan_out * energy::FANOUT_FAST;
+        num_plain_wires * energy::WIRE_FAST + num_crossings * energy::CROSSING_FAST +
+        (num_inv_s * energy::INVERTER_STRAIGHT_FAST + num_inv_b * energy::INVERTER_BENT_FAST) +
+        num_and * energy::AND_FAST + num_or * energy::OR_FAST + num_maj * energy::MAJORITY_FAST +
+        num_fan_out * energy::FANOUT_FAST
+    };
 
-    return {slow_energy, fast_energy};
+    return statistics{bounding_box{min_x, min_y, max_x, max_y}, num_gates, num_wires, num_crossings,
+                      num_inv_s, num_inv_b, num_and, num_or, num_maj, num_fan_out, dissipation};
 }
 
 void fcn_gate_layout::write_layout(std::ostream& os, const bool io_color, const bool clk_color) const noexcept
@@ -1251,11 +1317,228 @@ void fcn_gate_layout::write_layout(std::ostream& os, const bool io_color, const
 
 void fcn_gate_layout::clear_layout() noexcept
 {
+    // record before anything is cleared; fcn_layout::clear_layout notifies after everything is cleared
+    prepare_modification(std::nullopt);
+
+    v_map = {};
+    e_map = {};
+    inp_dir_map = {};
+    out_dir_map = {};
+    edge_inp_dir_map = {};
+    edge_out_dir_map = {};
+
     fcn_layout::clear_layout();
-    v_map.clear();
-    e_map.clear();
-    inp_dir_map.clear();
-    out_dir_map.clear();
-    edge_inp_dir_map.clear();
-    edge_out_dir_map.clear();
+}
+
+fcn_gate_layout::subscription fcn_gate_layout::subscribe(modification_callback cb) noexcept
+{
+    const auto s = subscribers.next++;
+    subscribers.callbacks.emplace_back(s, std::move(cb));
+
+    return s;
+}
+
+void fcn_gate_layout::unsubscribe(const subscription s) noexcept
+{
+    auto& cbs = subscribers.callbacks;
+    cbs.erase(std::remove_if(cbs.begin(), cbs.end(), [s](const auto& cb){ return cb.first == s; }), cbs.end());
+}
+
+void fcn_gate_layout::notify_modification(const std::optional<tile>& t) noexcept
+{
+    for (const auto& [s, cb] : subscribers.callbacks)
+        cb(t);
+}
+
+void fcn_gate_layout::begin_transaction() noexcept
+{
+    transactions.levels.push_back({transactions.log.size(), {}, false});
+}
+
+void fcn_gate_layout::commit_transaction() noexcept
+{
+    auto& levels = transactions.levels;
+    if (levels.empty())
+        return;
+
+    // outermost transaction: no modification can be rolled back anymore
+    if (levels.size() == 1ul)
+    {
+        transactions.log.clear();
+        levels.clear();
+        return;
+    }
+
+    // records of the inner transaction become records of the outer one
+    auto inner = std::move(levels.back());
+    levels.pop_back();
+
+    auto& outer = levels.back();
+    outer.recorded.insert(inner.recorded.cbegin(), inner.recorded.cend());
+    outer.layout_recorded = outer.layout_recorded || inner.layout_recorded;
+}
+
+void fcn_gate_layout::rollback_transaction() noexcept
+{
+    auto& levels = transactions.levels;
+    if (levels.empty())
+        return;
+
+    auto& log = transactions.log;
+    const auto start = levels.back().log_start;
+
+    // restore in reverse order such that the earliest record of each tile is restored last
+    for (auto i = log.size(); i > start; --i)
+    {
+        std::visit([this](const auto& r)
+                   {
+                       if constexpr (std::is_same_v<std::decay_t<decltype(r)>, tile_record>)
+                           restore_tile(r);
+                       else
+                           restore_layout(r);
+                   }, log[i - 1]);
+    }
+
+    log.erase(log.begin() + static_cast<std::ptrdiff_t>(start), log.end());
+    levels.pop_back();
+}
+
+bool fcn_gate_layout::in_transaction() const noexcept
+{
+    return !transactions.levels.empty();
+}
+
+std::shared_ptr<fcn_gate_layout> fcn_gate_layout::snapshot_layout() const noexcept
+{
+    return std::make_shared<fcn_gate_layout>(*this);
+}
+
+void fcn_gate_layout::prepare_modification(const std::optional<tile>& t) noexcept
+{
+    if (transactions.levels.empty())
+        return;
+
+    auto& level = transactions.levels.back();
+    // restoring the whole layout reverts all later modifications anyway
+    if (level.layout_recorded)
+        return;
+
+    if (t)
+    {
+        // only the state before the first modification is of interest
+        if (level.recorded.insert(*t).second)
+            transactions.log.emplace_back(record_tile(*t));
+    }
+    else
+    {
+        level.layout_recorded = true;
+        transactions.log.emplace_back(layout_record{fcn_dimension_xyz{x(), y(), z()}, v_map, e_map, inp_dir_map,
+                                                    out_dir_map, edge_inp_dir_map, edge_out_dir_map, c_map, pi_set,
+                                                    po_set, l_map});
+    }
+}
+
+fcn_gate_layout::tile_record fcn_gate_layout::record_tile(const tile& t) const noexcept
+{
+    const auto find = [](const auto& map, const auto& key) -> std::optional<layout::directions>
+    {
+        if (auto it = map.find(key); it != map.cend())
+            return it->second;
+
+        return std::nullopt;
+    };
+
+    tile_record r{t, get_logic_vertex(t), get_logic_edges(t), is_pi(t), is_po(t), find(*inp_dir_map, t),
+                  find(*out_dir_map, t), {}, get_latch(t), std::nullopt};
+
+    for (const auto& e : r.edges)
+        r.wire_dirs.emplace_back(e, find(*edge_inp_dir_map, std::make_pair(t, e)),
+                                 find(*edge_out_dir_map, std::make_pair(t, e)));
+
+    if (auto it = c_map->find(get_ground(t)); it != c_map->cend())
+        r.zone = it->second;
+
+    return r;
+}
+
+void fcn_gate_layout::restore_tile(const tile_record& r) noexcept
+{
+    const auto& t = r.t;
+
+    // drop the current state of t
+    if (is_gate_tile(t))
+        v_map.write().left.erase(t);
+
+    for (const auto& e : get_logic_edges(t))
+    {
+        erase_if_present(edge_inp_dir_map, std::make_pair(t, e));
+        erase_if_present(edge_out_dir_map, std::make_pair(t, e));
+    }
+
+    erase_if_present(e_map, t);
+    erase_if_present(inp_dir_map, t);
+    erase_if_present(out_dir_map, t);
+    erase_if_present(pi_set, t);
+    erase_if_present(po_set, t);
+
+    // restore the recorded state
+    if (r.vertex)
+    {
+        // the vertex might have been moved to a tile that is restored later on
+        if (v_map->right.count(*r.vertex) > 0u)
+            v_map.write().right.erase(*r.vertex);
+
+        v_map.write().insert(vertex_map::value_type(t, *r.vertex));
+    }
+    if (!r.edges.empty())
+        e_map.write()[t] = r.edges;
+
+    if (r.pi)
+        pi_set.write().insert(t);
+    if (r.po)
+        po_set.write().insert(t);
+
+    if (r.inp_dirs)
+        inp_dir_map.write()[t] = *r.inp_dirs;
+    if (r.out_dirs)
+        out_dir_map.write()[t] = *r.out_dirs;
+
+    for (const auto& [e, inp, out] : r.wire_dirs)
+    {
+        if (inp)
+            edge_inp_dir_map.write()[{t, e}] = *inp;
+        if (out)
+            edge_out_dir_map.write()[{t, e}] = *out;
+    }
+
+    const auto g = get_ground(t);
+    if (r.latch == 0u)
+        erase_if_present(l_map, g);
+    else
+        l_map.write()[g] = r.latch;
+
+    if (r.zone)
+        c_map.write()[g] = *r.zone;
+    else
+        erase_if_present(c_map, g);
+
+    notify_modification(t);
+}
+
+void fcn_gate_layout::restore_layout(const layout_record& r) noexcept
+{
+    resize_grid(r.lengths);
+
+    v_map = r.v_map;
+    e_map = r.e_map;
+    inp_dir_map = r.inp_dir_map;
+    out_dir_map = r.out_dir_map;
+    edge_inp_dir_map = r.edge_inp_dir_map;
+    edge_out_dir_map = r.edge_out_dir_map;
+    c_map = r.c_map;
+    pi_set = r.pi_set;
+    po_set = r.po_set;
+    l_map = r.l_map;
+
+    notify_modification(std::nullopt);
 }
@@ -7,8 +7,15 @@
 
 #include "fcn_layout.h"
 #include "logic_network.h"
+#include "logic_network_snapshot.h"
 #include "directions.h"
 #include "energy_model.h"
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <unordered_set>
 #include <optional>
 #include <variant>
 #include <boost/bimap.hpp>
@@ -66,6 +73,10 @@ public:
      * Granting fcn_cell_layout access to private data members.
      */
     friend class fcn_cell_layout;
+    /**
+     * Granting fcn_cell_stream access to private data members.
+     */
+    friend class fcn_cell_stream;
     /**
      * Granting design_checker access to private data members.
      */
@@ -74,6 +85,10 @@ public:
      * Granting equivalence_checker access to private data members.
      */
     friend class equivalence_checker;
+    /**
+     * Granting layout_compaction access to private data members.
+     */
+    friend class layout_compaction;
     /**
      * Standard constructor. Creates an FCN gate layout by the means of an array determining its size
      * as well as a clocking scheme defining its data flow possibilities.
@@ -202,6 +217,73 @@ public:
         return surrounding_2d(t) |
                iter::filter([this, t = t](const tile& _t) { return is_outgoing_clocked(t, _t); });
     }
+    /**
+     * Same as is_outgoing_clocked but with clock zones looked up in the given cutout, which is usually obtained via
+     * fcn_clock::dispatch. With a static_cutout, the query inlines to two table lookups. Only valid for regularly
+     * clocked layouts.
+     *
+     * @tparam Cutout fcn_clock::static_cutout or fcn_clock::dynamic_cutout of this layout's clocking scheme.
+     * @param t1 Source tile.
+     * @param t2 Target tile.
+     * @param c Cutout of this layout's clocking scheme.
+     * @return True iff data flow from t1 to t2 is possible.
+     */
+    template <typename Cutout>
+    bool is_outgoing_clocked(const tile& t1, const tile& t2, const Cutout& c) const noexcept
+    {
+        return t1 != t2 && c.advance(c.at(t1[X], t1[Y]), get_latch(t1) + 1ul) == c.at(t2[X], t2[Y]);
+    }
+    /**
+     * Same as is_incoming_clocked but with clock zones looked up in the given cutout. See is_outgoing_clocked.
+     *
+     * @tparam Cutout fcn_clock::static_cutout or fcn_clock::dynamic_cutout of this layout's clocking scheme.
+     * @param t1 Target tile.
+     * @param t2 Source tile.
+     * @param c Cutout of this layout's clocking scheme.
+     * @return True iff data flow from t2 to t1 is possible.
+     */
+    template <typename Cutout>
+    bool is_incoming_clocked(const tile& t1, const tile& t2, const Cutout& c) const noexcept
+    {
+        return is_outgoing_clocked(t2, t1, c);
+    }
+    /**
+     * Same as incoming_clocked_tiles but with clock zones looked up in the given cutout. See is_outgoing_clocked.
+     *
+     * @tparam Cutout fcn_clock::static_cutout or fcn_clock::dynamic_cutout of this layout's clocking scheme.
+     * @param t Tile whose counterparts with incoming clocking are desired.
+     * @param c Cutout of this layout's clocking scheme.
+     * @return A range of all tiles that are clocked incoming to t.
+     */
+    template <typename Cutout>
+    auto incoming_clocked_tiles(const tile& t, const Cutout& c) const noexcept
+    {
+        return surrounding_2d(t) |
+               iter::filter([this, t = t, c](const tile& _t){ return is_incoming_clocked(t, _t, c); });
+    }
+    /**
+     * Same as outgoing_clocked_tiles but with clock zones looked up in the given cutout. See is_outgoing_clocked.
+     *
+     * @tparam Cutout fcn_clock::static_cutout or fcn_clock::dynamic_cutout of this layout's clocking scheme.
+     * @param t Tile whose counterparts with outgoing clocking are desired.
+     * @param c Cutout of this layout's clocking scheme.
+     * @return A range of all tiles that are clocked outgoing to t.
+     */
+    template <typename Cutout>
+    auto outgoing_clocked_tiles(const tile& t, const Cutout& c) const noexcept
+    {
+        return surrounding_2d(t) |
+               iter::filter([this, t = t, c](const tile& _t){ return is_outgoing_clocked(t, _t, c); });
+    }
+    /**
+     * Returns the clocking scheme of this layout, e.g., to resolve it via fcn_clock::dispatch.
+     *
+     * @return Clocking scheme.
+     */
+    const fcn_clocking_scheme& get_clocking() const noexcept
+    {
+        return clocking;
+    }
     /**
      * Returns the number of tiles that are able to pass information to the given tile t within the same layer, i.e. the
      * indegree of t if viewed from a graph representation perspective.
@@ -620,10 +702,10 @@ public:
     auto gate_count(const bool ignore_wire_vertices = false) const noexcept
     {
         if (ignore_wire_vertices)
-            return static_cast<std::size_t>(std::count_if(v_map.left.begin(), v_map.left.end(),
+            return static_cast<std::size_t>(std::count_if(v_map->left.begin(), v_map->left.end(),
                     [this](const auto& v){ return get_op(v.first) != operation::W; }));
         else
-            return v_map.size();
+            return v_map->size();
     }
     /**
      * Returns the number of tiles that are assigned with logic edges. Note that wire tiles in higher layers are counted
@@ -634,10 +716,10 @@ public:
     auto wire_count(const bool count_wire_vertices = false) const noexcept
     {
         if (count_wire_vertices)
-            return static_cast<std::size_t>(std::count_if(v_map.left.begin(), v_map.left.end(),
+            return static_cast<std::size_t>(std::count_if(v_map->left.begin(), v_map->left.end(),
                     [this](const auto& v){ return get_op(v.first) == operation::W; }));
         else
-            return e_map.size();
+            return e_map->size();
     }
     /**
      * Returns the number of logic edges assigned to tiles above ground layer.
@@ -647,10 +729,10 @@ public:
     auto crossing_count(const bool count_wire_vertices = false) const noexcept
     {
         if (count_wire_vertices)
-            return std::count_if(v_map.left.begin(), v_map.left.end(),
+            return std::count_if(v_map->left.begin(), v_map->left.end(),
                     [this](const auto& v) { return v.first[Z] != GROUND && get_op(v.first) == operation::W; });
         else
-            return std::count_if(e_map.cbegin(), e_map.cend(), [](auto& te){return te.first[Z] != GROUND;});
+            return std::count_if(e_map->cbegin(), e_map->cend(), [](auto& te){return te.first[Z] != GROUND;});
     }
     /**
      * Container to store statistical information about paths.
@@ -669,7 +751,12 @@ public:
     /**
      * Returns the number of tiles of the longest path in the layout from a primary input to t. Information is stored in
      * a wrapper struct that comes with path length in tiles (length), path length in tiles starting with clock zone of
-     * PI (delay), and the delay differences leading to t (diff). If t is an empty tile, all those values are 0.
+     * PI plus all latch delays on the path (delay), and the delay differences leading to t (diff). If t is an empty
+     * tile, all those values are 0.
+     *
+     * Without latches, delay and diff refer to the longest incoming path and its difference to the shortest one. Since
+     * latches make a shorter path arrive later, the highest delay and the spread between the highest and lowest one
+     * are determined independently of path lengths in layouts that contain latches.
      *
      * A delay cache is used to store partial results. It caches gate values only, because wires are only computed once
      * anyways. This way, the cache is just a slight memory overhead but significantly reduces runtime.
@@ -743,6 +830,16 @@ public:
      * @return A pointer to the associated network.
      */
     logic_network_ptr get_network() const noexcept;
+    /**
+     * Returns a frozen snapshot of the associated network for fast traversal. It is created on first access, which
+     * allows approaches like one_pass_synthesis to fill the network of a layout after constructing it. Afterwards,
+     * the network must not be altered anymore. Since networks are copied on write (see make_unique_network), this is
+     * the case for all networks shared with stores. Creation is thread-safe and the snapshot is never written
+     * afterwards; it can thus be read concurrently. Copies of the layout share an already created snapshot.
+     *
+     * @return A pointer to a snapshot of the associated network.
+     */
+    logic_network_snapshot_ptr get_network_snapshot() const noexcept;
     /**
      * Determines the layout's bounding box i.e. the area in which logic elements are placed. Helps to determine the
      * "real" size of a layout.
@@ -757,6 +854,37 @@ public:
      * @return An std::pair containing slow and fast energy dissipation in meV.
      */
     energy::info calculate_energy() const noexcept;
+    /**
+     * Container for statistical information about the layout that can be gathered in a single scan over all assigned
+     * tiles. Counts follow the conventions of gate_count(true), wire_count(), and crossing_count().
+     */
+    struct statistics
+    {
+        /**
+         * Bounding box as computed by determine_bounding_box().
+         */
+        bounding_box bb;
+        /**
+         * Number of gate tiles (excluding wire vertices), wire tiles, and wire tiles above ground layer.
+         */
+        std::size_t gates, wires, crossings;
+        /**
+         * Number of gates per class relevant for the energy model. Inverters are classified by their bending.
+         */
+        std::size_t straight_inverters, bent_inverters, conjunctions, disjunctions, majorities, fan_outs;
+        /**
+         * Energy dissipation as returned by calculate_energy().
+         */
+        energy::info energy;
+    };
+    /**
+     * Gathers gate, wire, and crossing counts, inverter classification, energy dissipation, and the bounding box in a
+     * single pass over the assigned tiles. Prefer this function over calling the respective functions one by one if
+     * more than one of these values is needed.
+     *
+     * @return Statistical information about the layout.
+     */
+    statistics determine_statistics() const noexcept;
     /**
      * Prints the assigned logic operations and edges to the given std::ostream channel. A textual representation of
      * assigned objects is used as provided by the type operations. Currently only one crossing layer can be represented
@@ -771,12 +899,153 @@ public:
      * Clears all maps and sets stored in the layout.
      */
     void clear_layout() noexcept;
+    /**
+     * Callback that is invoked with a tile whose assigned vertex, edges, directions, latch, or clock zone have been
+     * modified. It is invoked with std::nullopt if the layout as a whole has been modified, i.e., resized or cleared.
+     * Callbacks are invoked after the modification took place and may be invoked several times per tile for a single
+     * call, e.g., assign_logic_vertex dissociates previously assigned elements first.
+     */
+    using modification_callback = std::function<void(const std::optional<tile>&)>;
+    /**
+     * Alias for an identifier of a registered modification_callback.
+     */
+    using subscription = std::size_t;
+    /**
+     * Registers a callback that is invoked on every modification of this layout. Used for instance by
+     * incremental_design_checker to re-check modified tiles only. Copies of a layout do not inherit its subscribers.
+     *
+     * @param cb Callback to register.
+     * @return Identifier of the registration that can be passed to unsubscribe.
+     */
+    subscription subscribe(modification_callback cb) noexcept;
+    /**
+     * Removes a callback that has been registered via subscribe.
+     *
+     * @param s Identifier returned by subscribe.
+     */
+    void unsubscribe(const subscription s) noexcept;
+    /**
+     * Starts a transaction. All subsequent modifications of tiles are recorded in an undo log until the transaction is
+     * either committed or rolled back. Before a tile is modified for the first time within a transaction, its
+     * assigned vertex or edges, I/O flags, directions, latch, and clock zone are recorded. Before the layout as a
+     * whole is modified, i.e., resized or cleared, its entire storage is recorded, which is O(1) due to copy-on-write.
+     * Thereby, moves of local search approaches can be tried and reverted in time proportional to the number of
+     * modified tiles.
+     *
+     * Transactions can be nested. Committing or rolling back an inner transaction only affects modifications since
+     * its begin.
+     */
+    void begin_transaction() noexcept;
+    /**
+     * Commits the innermost transaction, i.e., keeps all its modifications. If it was the outermost one, the undo log
+     * is dropped. Does nothing if no transaction is running.
+     */
+    void commit_transaction() noexcept;
+    /**
+     * Rolls back the innermost transaction, i.e., restores all tiles modified since its begin to their previous state.
+     * Subscribers are notified of each restored tile. Does nothing if no transaction is running.
+     */
+    void rollback_transaction() noexcept;
+    /**
+     * Returns whether a transaction is running.
+     *
+     * @return True iff begin_transaction has been called more often than commit_transaction and rollback_transaction.
+     */
+    bool in_transaction() const noexcept;
+    /**
+     * Creates an independent copy of this layout in O(1). All tile storage is copied on write, i.e., the snapshot
+     * shares it with this layout until one of them modifies a map, which is then copied once for the modifying
+     * layout. The logic network is shared as well. Snapshots do not inherit subscribers or running transactions.
+     *
+     * Distinct snapshots can be read and modified from different threads concurrently, e.g., to evaluate different
+     * moves in parallel, since shared storage is never modified (see copy_on_write). A single layout, however, must not
+     * be used from different threads concurrently.
+     *
+     * @return Snapshot of this layout.
+     */
+    std::shared_ptr<fcn_gate_layout> snapshot_layout() const noexcept;
+
+protected:
+    /**
+     * Invokes all registered modification callbacks with the given tile.
+     *
+     * @param t Modified tile or std::nullopt if the whole layout has been modified.
+     */
+    void notify_modification(const std::optional<tile>& t) noexcept override;
+    /**
+     * Records the state of the given tile or of the whole layout in the undo log if a transaction is running.
+     *
+     * @param t Tile about to be modified or std::nullopt if the whole layout is about to be modified.
+     */
+    void prepare_modification(const std::optional<tile>& t) noexcept override;
 
 private:
+    /**
+     * Registered modification callbacks. Copying a subscriber_list yields an empty one so that callbacks, which are
+     * usually bound to objects observing a particular layout, are not invoked for its copies.
+     */
+    struct subscriber_list
+    {
+        subscriber_list() = default;
+        subscriber_list(const subscriber_list&) noexcept {}
+        subscriber_list& operator=(const subscriber_list&) noexcept { return *this; }
+        /**
+         * Registered callbacks and their identifiers.
+         */
+        std::vector<std::pair<subscription, modification_callback>> callbacks{};
+        /**
+         * Identifier of the next registration.
+         */
+        subscription next = 0ul;
+    };
+    /**
+     * Callbacks to invoke on modifications.
+     */
+    subscriber_list subscribers{};
     /**
      * Logic network associated with the vertices assigned to layout's tiles.
      */
     logic_network_ptr network = nullptr;
+    /**
+     * Snapshot of a network that is created on first access. Copying a lazy_snapshot shares the snapshot if it has
+     * been created already and defers its creation otherwise.
+     */
+    struct lazy_snapshot
+    {
+        lazy_snapshot() = default;
+        lazy_snapshot(const lazy_snapshot& other) noexcept;
+        lazy_snapshot& operator=(const lazy_snapshot& other) noexcept;
+        /**
+         * Returns the snapshot of the given network and creates it if this has not happened yet.
+         *
+         * @param ln Logic network to freeze on first access.
+         * @return A pointer to a snapshot of ln or nullptr if ln is nullptr.
+         */
+        logic_network_snapshot_ptr get(const logic_network_ptr& ln) const noexcept;
+        /**
+         * Ensures that the snapshot is created exactly once even if it is accessed by multiple threads at once.
+         */
+        mutable std::unique_ptr<std::once_flag> created = std::make_unique<std::once_flag>();
+        /**
+         * Flag to indicate that snapshot has been created. Used by copies that must not wait for the creation.
+         */
+        mutable std::atomic<bool> ready{false};
+        /**
+         * The snapshot.
+         */
+        mutable logic_network_snapshot_ptr snapshot = nullptr;
+    };
+    /**
+     * Snapshot of network. See get_network_snapshot.
+     */
+    lazy_snapshot snapshot{};
+    /**
+     * Creates a snapshot of the given network.
+     *
+     * @param ln Logic network to freeze.
+     * @return A pointer to a snapshot of ln or nullptr if ln is nullptr.
+     */
+    static logic_network_snapshot_ptr freeze(const logic_network_ptr& ln) noexcept;
     /**
      * Alias for a hashed bidirectional map that assigns logic vertices to the tiles and vice versa.
      */
@@ -785,7 +1054,7 @@ private:
     /**
      * Stores mapping tile -> logic_network::vertex. Helper functions for access save memory.
      */
-    vertex_map v_map{};
+    copy_on_write<vertex_map> v_map{};
     /**
      * Alias for a hash map that assigns sets of logic edges to the tiles.
      */
@@ -794,7 +1063,7 @@ private:
      * Stores mapping tile -> set of logic_network::edge. Note that several edges per tile are possible.
      * Helper functions for access save memory.
      */
-    edge_map e_map{};
+    copy_on_write<edge_map> e_map{};
     /**
      * Alias for a hash map that assigns directions to the tiles.
      */
@@ -803,7 +1072,7 @@ private:
      * Stores mapping tile -> directions for inputs and outputs respectively.
      * Helper functions for access save memory.
      */
-    direction_map inp_dir_map{}, out_dir_map{};
+    copy_on_write<direction_map> inp_dir_map{}, out_dir_map{};
     /**
      * Alias for a hash map that assigns directions to pairs of tiles and logic_network::edges to allow for a complete
      * many-to-many relation.
@@ -817,7 +1086,127 @@ private:
      * available directions for the respective tiles.
      * Helper functions for access save memory.
      */
-    edge_direction_map edge_inp_dir_map{}, edge_out_dir_map{};
+    copy_on_write<edge_direction_map> edge_inp_dir_map{}, edge_out_dir_map{};
+    /**
+     * State of a single tile before its first modification within a transaction.
+     */
+    struct tile_record
+    {
+        /**
+         * Recorded tile.
+         */
+        tile t;
+        /**
+         * Assigned vertex.
+         */
+        std::optional<logic_network::vertex> vertex;
+        /**
+         * Assigned edges.
+         */
+        edge_set edges;
+        /**
+         * Flags to indicate that t was a PI/PO.
+         */
+        bool pi, po;
+        /**
+         * Input and output directions of t if any were stored.
+         */
+        std::optional<layout::directions> inp_dirs, out_dirs;
+        /**
+         * Input and output directions of each assigned edge if any were stored.
+         */
+        std::vector<std::tuple<logic_network::edge, std::optional<layout::directions>,
+                               std::optional<layout::directions>>> wire_dirs;
+        /**
+         * Latch delay of t's ground tile.
+         */
+        latch_delay latch;
+        /**
+         * Clock zone of t's ground tile if it was assigned one. Irregular clocking schemes only.
+         */
+        std::optional<fcn_clock::zone> zone;
+    };
+    /**
+     * State of the whole layout before it was resized or cleared within a transaction. Storing the maps is O(1) due
+     * to copy-on-write.
+     */
+    struct layout_record
+    {
+        /**
+         * Dimensions of the layout.
+         */
+        fcn_dimension_xyz lengths;
+        /**
+         * Tile storage of the layout.
+         */
+        copy_on_write<vertex_map> v_map;
+        copy_on_write<edge_map> e_map;
+        copy_on_write<direction_map> inp_dir_map, out_dir_map;
+        copy_on_write<edge_direction_map> edge_inp_dir_map, edge_out_dir_map;
+        copy_on_write<clocking_map> c_map;
+        copy_on_write<primary_set> pi_set, po_set;
+        copy_on_write<latch_map> l_map;
+    };
+    /**
+     * A nesting level of transactions.
+     */
+    struct transaction_level
+    {
+        /**
+         * Size of the undo log when the transaction began.
+         */
+        std::size_t log_start;
+        /**
+         * Tiles that have been recorded since the transaction began. They need not be recorded again.
+         */
+        std::unordered_set<tile, boost::hash<tile>> recorded;
+        /**
+         * Flag to indicate that the whole layout has been recorded since the transaction began. Then, no further
+         * records are necessary since restoring it reverts all later modifications.
+         */
+        bool layout_recorded;
+    };
+    /**
+     * Running transactions and their undo log. Copying a transaction_log yields an empty one so that snapshots do not
+     * inherit running transactions.
+     */
+    struct transaction_log
+    {
+        transaction_log() = default;
+        transaction_log(const transaction_log&) noexcept {}
+        transaction_log& operator=(const transaction_log&) noexcept { return *this; }
+        /**
+         * Undo log of all running transactions in order of recording.
+         */
+        std::vector<std::variant<tile_record, layout_record>> log{};
+        /**
+         * Running transactions from outermost to innermost.
+         */
+        std::vector<transaction_level> levels{};
+    };
+    /**
+     * Running transactions.
+     */
+    transaction_log transactions{};
+    /**
+     * Captures the current state of tile t.
+     *
+     * @param t Tile to record.
+     * @return Record of t.
+     */
+    tile_record record_tile(const tile& t) const noexcept;
+    /**
+     * Restores the state of a tile without recording it and notifies subscribers.
+     *
+     * @param r Record to restore.
+     */
+    void restore_tile(const tile_record& r) noexcept;
+    /**
+     * Restores the state of the whole layout without recording it and notifies subscribers.
+     *
+     * @param r Record to restore.
+     */
+    void restore_layout(const layout_record& r) noexcept;
 };
 
 using fcn_gate_layout_ptr = std::shared_ptr<fcn_gate_layout>;
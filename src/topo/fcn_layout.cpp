@@ -51,7 +51,9 @@ void fcn_layout::resize(const fcn_dimension_xyz& lengths) noexcept
     if (lengths[X] < 2 || lengths[Y] < 2 || lengths[Z] < 2)
         std::cerr << "[w] due to a bug in the BGL, every dimension should have a minimum size of 2 to prevent SEGFAULTs." << std::endl;
 
+    prepare_modification(std::nullopt);
     resize_grid(lengths);
+    notify_modification(std::nullopt);
 }
 
 void fcn_layout::resize(const fcn_dimension_xy& lengths) noexcept
@@ -231,7 +233,11 @@ bool fcn_layout::is_clocking(std::string&& name) const noexcept
 void fcn_layout::assign_clocking(const face& f, const fcn_clock::number c) noexcept
 {
     if (!clocking.regular && c <= clocking.num_clocks)
-        c_map[get_ground(f)] = c;
+    {
+        prepare_modification(f);
+        c_map.write()[get_ground(f)] = c;
+        notify_modification(f);
+    }
 }
 
 void fcn_layout::assign_clocking(const face_index f, const fcn_clock::number c) noexcept
@@ -241,25 +247,33 @@ void fcn_layout::assign_clocking(const face_index f, const fcn_clock::number c)
 
 bool fcn_layout::is_pi(const face& f) const noexcept
 {
-    return pi_set.count(f) > 0u;
+    return pi_set->count(f) > 0u;
 }
 
 bool fcn_layout::is_po(const face& f) const noexcept
 {
-    return po_set.count(f) > 0u;
+    return po_set->count(f) > 0u;
 }
 
 void fcn_layout::assign_latch(const face& f, const latch_delay l) noexcept
 {
+    // nothing changes
+    if (l == get_latch(f))
+        return;
+
+    prepare_modification(f);
+
     if (l == 0u)
-        l_map.erase(get_ground(f));
+        l_map.write().erase(get_ground(f));
     else
-        l_map[get_ground(f)] = l;
+        l_map.write()[get_ground(f)] = l;
+
+    notify_modification(f);
 }
 
 fcn_layout::latch_delay fcn_layout::get_latch(const face& f) const noexcept
 {
-    if (auto it = l_map.find(get_ground(f)); it != l_map.end())
+    if (auto it = l_map->find(get_ground(f)); it != l_map->end())
     {
         return it->second;
     }
@@ -272,7 +286,7 @@ fcn_layout::latch_delay fcn_layout::get_latch(const face& f) const noexcept
 std::vector<std::string> fcn_layout::latch_str_reprs() const noexcept
 {
     std::vector<std::string> reprs{};
-    for (const auto& [t, l] : l_map)
+    for (const auto& [t, l] : *l_map)
     {
         std::stringstream ss{};
         ss << "l@" << t << "=" << l;
@@ -343,8 +357,18 @@ void fcn_layout::shrink_to_fit() noexcept
 
 void fcn_layout::clear_layout() noexcept
 {
-    c_map.clear();
-    pi_set.clear();
-    po_set.clear();
-    l_map.clear();
+    prepare_modification(std::nullopt);
+
+    c_map = {};
+    pi_set = {};
+    po_set = {};
+    l_map = {};
+
+    notify_modification(std::nullopt);
 }
+
+void fcn_layout::notify_modification(const std::optional<face>&) noexcept
+{}
+
+void fcn_layout::prepare_modification(const std::optional<face>&) noexcept
+{}
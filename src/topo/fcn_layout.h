@@ -7,6 +7,7 @@
 
 #include "grid_graph.h"
 #include "fcn_clocking_scheme.h"
+#include "copy_on_write.h"
 #include <algorithm>
 #include <random>
 #include <set>
@@ -504,7 +505,7 @@ public:
      */
     auto get_pis() const noexcept
     {
-        return range_t<primary_set::const_iterator>{{pi_set.cbegin(), pi_set.cend()}};
+        return range_t<primary_set::const_iterator>{{pi_set->cbegin(), pi_set->cend()}};
     }
     /**
      * Returns whether or not given face f is a PO port.
@@ -520,7 +521,7 @@ public:
      */
     auto get_pos() const noexcept
     {
-        return range_t<primary_set::const_iterator>{{po_set.cbegin(), po_set.cend()}};
+        return range_t<primary_set::const_iterator>{{po_set->cbegin(), po_set->cend()}};
     }
     /**
      * Assigns a latch delay to a given face in the layout. The delay is given in clock phases (i.e. fractions of clock
@@ -553,7 +554,7 @@ public:
      */
     auto latch_count() const noexcept
     {
-        return l_map.size();
+        return l_map->size();
     }
     /**
      * Returns a vector of string representations of the assigned latches. The representation looks similar to
@@ -664,6 +665,22 @@ public:
     void clear_layout() noexcept;
 
 protected:
+    /**
+     * Hook that is called whenever the elements, latch, or clock zone of face f have been modified or, if f is
+     * std::nullopt, whenever the layout as a whole has been modified, e.g., resized or cleared. Does nothing by default.
+     * Derived classes can override it to track modifications. See fcn_gate_layout::subscribe.
+     *
+     * @param f Modified face or std::nullopt if the whole layout has been modified.
+     */
+    virtual void notify_modification(const std::optional<face>& f) noexcept;
+    /**
+     * Hook that is called right before the elements, latch, or clock zone of face f are modified or, if f is
+     * std::nullopt, right before the layout as a whole is modified. Does nothing by default. Derived classes can
+     * override it to record the state that is about to change. See fcn_gate_layout::begin_transaction.
+     *
+     * @param f Face about to be modified or std::nullopt if the whole layout is about to be modified.
+     */
+    virtual void prepare_modification(const std::optional<face>& f) noexcept;
     /**
      * Clocking scheme representing possible data flow.
      */
@@ -679,7 +696,7 @@ protected:
     /**
      * Stores a mapping face -> clock number for irregular clocking schemes. Helper functions for access save memory.
      */
-    clocking_map c_map{};
+    copy_on_write<clocking_map> c_map{};
     /**
      * Alias for a set that holds faces to represent PI/PO ports.
      */
@@ -687,7 +704,7 @@ protected:
     /**
      * Stores faces that are marked as PIs/POs.
      */
-    primary_set pi_set{}, po_set{};
+    copy_on_write<primary_set> pi_set{}, po_set{};
     /**
      * Alias for a hash map that assigns a certain delay to a face.
      */
@@ -704,7 +721,7 @@ protected:
      * data for 1 full cycle plus l phases longer. If one want to realize a hold of 2 extra phases, it can be achieved
      * by adding a latch with l == 6 (4 + 2) to hold data for one cycle and 2 phases.
      */
-    latch_map l_map{};
+    copy_on_write<latch_map> l_map{};
 };
 
 
@@ -77,6 +77,19 @@ public:
             :
             grid(std::make_unique<grid_container>(lengths))
     {}
+    /**
+     * Copy constructor. The grid container only stores the grid's dimensions. Therefore, copying is cheap.
+     *
+     * @param other Grid graph to copy.
+     */
+    grid_graph(const grid_graph& other) noexcept
+            :
+            grid(std::make_unique<grid_container>(*other.grid))
+    {}
+    /**
+     * Default move constructor.
+     */
+    grid_graph(grid_graph&&) noexcept = default;
     /**
      * Resizes an already constructed grid_graph object so that only the stored grid_container is affected but
      * the overall object stays the same. The new grid_container will be initialized with the given lengths.
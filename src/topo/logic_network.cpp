@@ -62,7 +62,7 @@ logic_network::degree_t logic_network::in_degree(const vertex v, const bool ios)
 
 logic_network::vertex logic_network::create_logic_vertex(const operation o) noexcept
 {
-    increment_op_counter(o);
+    register_vertex(o);
     return add_vertex(o);
 }
 
@@ -70,9 +70,18 @@ void logic_network::remove_logic_vertex(const vertex v) noexcept
 {
     decrement_op_counter(get_op(v));
 
-    pi_set.erase(v);
-    po_set.erase(v);
-    io_port_map.left.erase(v);
+    vertex_flags.erase(vertex_flags.begin() + static_cast<long>(v));
+    vertex_port_names.erase(vertex_port_names.begin() + static_cast<long>(v));
+
+    // all vertex IDs greater than v are decremented by the BGL
+    const auto update_list = [v](primary_list& l)
+    {
+        l.erase(std::remove(l.begin(), l.end(), v), l.end());
+        std::for_each(l.begin(), l.end(), [v](vertex& _v){ if (_v > v) --_v; });
+    };
+
+    update_list(pi_list);
+    update_list(po_list);
 
     remove_vertex(v);
 }
@@ -80,8 +89,9 @@ void logic_network::remove_logic_vertex(const vertex v) noexcept
 logic_network::vertex logic_network::create_pi(const std::string& name) noexcept
 {
     auto v = create_logic_vertex(operation::PI);
-    pi_set.emplace(v);
-    io_port_map.insert(port_map::value_type(v, name));
+    vertex_flags[v] |= PI_FLAG;
+    pi_list.push_back(v);
+    assign_port_name(v, name);
 
     return v;
 }
@@ -89,8 +99,9 @@ logic_network::vertex logic_network::create_pi(const std::string& name) noexcept
 logic_network::vertex logic_network::create_po(const std::string& name) noexcept
 {
     auto v = create_logic_vertex(operation::PO);
-    po_set.emplace(v);
-    io_port_map.insert(port_map::value_type(v, name));
+    vertex_flags[v] |= PO_FLAG;
+    po_list.push_back(v);
+    assign_port_name(v, name);
 
     return v;
 }
@@ -153,6 +164,12 @@ logic_network::vertex logic_network::create_balance_vertex(const edge& e) noexce
 
 void logic_network::assign_op(const vertex v, const operation o) noexcept
 {
+    decrement_op_counter(get_op(v));
+    increment_op_counter(o);
+
+    // keep I/O flags but update the ones derived from the operation
+    vertex_flags[v] = static_cast<uint8_t>((vertex_flags[v] & (PI_FLAG | PO_FLAG)) | operation_flags(o));
+
     properties(v) = o;
 }
 
@@ -163,7 +180,7 @@ operation logic_network::get_op(const vertex v) const noexcept
 
 bool logic_network::is_pi(const vertex v) const noexcept
 {
-    return pi_set.count(v) > 0u;
+    return (vertex_flags[v] & PI_FLAG) != 0u;
 }
 
 bool logic_network::pre_pi(const vertex v) const noexcept
@@ -174,7 +191,7 @@ bool logic_network::pre_pi(const vertex v) const noexcept
 
 bool logic_network::is_po(const vertex v) const noexcept
 {
-    return po_set.count(v) > 0u;
+    return (vertex_flags[v] & PO_FLAG) != 0u;
 }
 
 bool logic_network::post_po(const vertex v) const noexcept
@@ -188,6 +205,16 @@ bool logic_network::is_io(const vertex v) const noexcept
     return get_op(v) == operation::PI || get_op(v) == operation::PO;
 }
 
+bool logic_network::is_fan_out(const vertex v) const noexcept
+{
+    return (vertex_flags[v] & FAN_OUT_FLAG) != 0u;
+}
+
+bool logic_network::is_balance(const vertex v) const noexcept
+{
+    return (vertex_flags[v] & BALANCE_FLAG) != 0u;
+}
+
 uint64_t logic_network::operation_count(const operation o) const noexcept
 {
     return operation_counter[o];
@@ -323,9 +350,9 @@ bool logic_network::is_MAOIG() const noexcept
 
 std::string logic_network::get_port_name(const vertex v) const noexcept
 {
-    if (auto it = io_port_map.left.find(v); it != io_port_map.left.end())
+    if (v < vertex_port_names.size())
     {
-        return it->second;
+        return port_names[vertex_port_names[v]];
     }
     else
     {
@@ -362,11 +389,59 @@ std::vector<kitty::dynamic_truth_table> logic_network::simulate() const
             mockturtle::default_simulator<kitty::dynamic_truth_table>(mig.num_pis()));
 }
 
+const logic_network::mig_nt& logic_network::get_mig() const noexcept
+{
+    return mig;
+}
+
+bool logic_network::requires_fan_out_substitution(const std::size_t threshold) const noexcept
+{
+    for (auto&& v : get_vertices())
+    {
+        // same thresholds as in substitute_fan_outs
+        const auto specific_threshold = (get_op(v) == operation::NOT || get_op(v) == operation::PI) ?
+                                        1ul : std::max(threshold, std::size_t{1});
+
+        if (!is_fan_out(v) && get_out_degree(v) > specific_threshold)
+            return true;
+    }
+
+    return false;
+}
+
 void logic_network::substitute_fan_outs(const std::size_t degree, const substitution_strategy stgy, const std::size_t threshold) noexcept
 {
-    auto connect = [&, this](std::vector<vertex> targets) -> std::vector<vertex>
+    // nothing to substitute; do not rebuild the graph
+    if (!requires_fan_out_substitution(threshold))
+        return;
+
+    // element of a planned fan-out tree; either an existing vertex or the id-th fan-out of the tree
+    struct tree_node
+    {
+        bool fan_out;
+        std::size_t id;
+    };
+    // planned fan-out tree of a single vertex
+    struct fan_out_tree
+    {
+        // outgoing edges that are substituted by the tree
+        std::vector<edge> substituted{};
+        // children of each fan-out in order of their creation
+        std::vector<std::vector<tree_node>> fan_outs{};
+        // node that is connected directly to the vertex
+        tree_node root{};
+    };
+
+    const auto num_vertices = get_vertex_count();
+    std::vector<fan_out_tree> trees(num_vertices);
+
+    // longest path lengths towards the POs; only needed for delay-aware substitution
+    std::vector<uint64_t> inv_level(stgy == substitution_strategy::DELAY ? num_vertices : 0ul, 0ul);
+
+    // builds one layer of a balanced (BREADTH) or a DFS (DEPTH) tree
+    auto connect = [&degree, &stgy](std::vector<tree_node> targets, fan_out_tree& tree) -> std::vector<tree_node>
     {
-        std::vector<vertex> new_targets;
+        std::vector<tree_node> new_targets;
 
         while (!targets.empty())
         {
@@ -378,51 +453,252 @@ void logic_network::substitute_fan_outs(const std::size_t degree, const substitu
 
             auto fan_out_degree = std::min(targets.size(), degree);
 
-            auto fo = create_logic_vertex(fan_out_degree == 2 ? operation::F1O2 : operation::F1O3);
-            std::for_each(targets.end() - fan_out_degree, targets.end(), [_fo = fo, this](auto v){ add_edge(_fo, v); });
+            tree.fan_outs.emplace_back(targets.end() - static_cast<long>(fan_out_degree), targets.end());
+            const tree_node fo{true, tree.fan_outs.size() - 1};
 
-            if (stgy == substitution_strategy::BREADTH)
+            if (stgy == substitution_strategy::DEPTH)
             {
+                std::copy(targets.begin(), targets.end() - static_cast<long>(fan_out_degree), std::back_inserter(new_targets));
                 new_targets.push_back(fo);
-                targets.erase(targets.end() - fan_out_degree, targets.end());
-                continue;
+                return new_targets;
             }
-            else if (stgy == substitution_strategy::DEPTH)
+            else
             {
-                std::copy(targets.begin(), targets.end() - fan_out_degree, std::back_inserter(new_targets));
                 new_targets.push_back(fo);
-                return new_targets;
+                targets.erase(targets.end() - static_cast<long>(fan_out_degree), targets.end());
             }
         }
 
         return new_targets;
     };
 
-    for (auto&& v : vertices(true) | iter::filterfalse([this](const auto _v)
-                                            { return get_op(_v) == operation::F1O2 || get_op(_v) == operation::F1O3; }))
+    // weight of a tree node in terms of path length towards the POs
+    auto weight = [&inv_level](const std::vector<uint64_t>& fo_weights, const tree_node& n)
+    {
+        return n.fan_out ? fo_weights[n.id] : inv_level[n.id];
+    };
+
+    // builds a tree that always merges the least critical nodes first, i.e. a Huffman tree with respect to the maximum
+    // path length, and returns the root's weight
+    auto huffman = [&degree, &weight](const std::vector<tree_node>& targets, fan_out_tree& tree) -> uint64_t
+    {
+        std::vector<uint64_t> fo_weights{};
+
+        // weight and insertion order for deterministic tie breaking
+        using queue_entry = std::tuple<uint64_t, std::size_t, tree_node>;
+        auto heavier = [](const queue_entry& e1, const queue_entry& e2)
+        {
+            return std::tie(std::get<0>(e1), std::get<1>(e1)) > std::tie(std::get<0>(e2), std::get<1>(e2));
+        };
+        std::priority_queue<queue_entry, std::vector<queue_entry>, decltype(heavier)> queue{heavier};
+
+        std::size_t seq = 0ul;
+        for (const auto& t : targets)
+            queue.emplace(weight(fo_weights, t), seq++, t);
+
+        while (queue.size() > 1)
+        {
+            const auto fan_out_degree = std::min(queue.size(), degree);
+
+            std::vector<tree_node> children{};
+            uint64_t max_weight = 0ul;
+            for ([[maybe_unused]] auto i = 0ul; i < fan_out_degree; ++i)
+            {
+                max_weight = std::max(max_weight, std::get<0>(queue.top()));
+                children.push_back(std::get<2>(queue.top()));
+                queue.pop();
+            }
+
+            tree.fan_outs.push_back(std::move(children));
+            fo_weights.push_back(max_weight + 1);
+            queue.emplace(max_weight + 1, seq++, tree_node{true, tree.fan_outs.size() - 1});
+        }
+
+        tree.root = std::get<2>(queue.top());
+
+        return std::get<0>(queue.top());
+    };
+
+    // determines the fan-out tree of vertex v without altering the graph
+    auto plan = [&, this](const vertex v)
+    {
+        auto oe = get_out_edges(v);
+        std::vector<edge> edges(oe.begin(), oe.end());
+
+        const auto specific_threshold = (get_op(v) == operation::NOT || get_op(v) == operation::PI) ?
+                                        1ul : std::max(threshold, std::size_t{1});
+
+        auto& tree = trees[v];
+        if (!is_fan_out(v) && edges.size() > specific_threshold)
+        {
+            if (stgy == substitution_strategy::DELAY)
+            {
+                // keep the (specific_threshold - 1) most critical edges which won't be substituted
+                std::stable_sort(edges.begin(), edges.end(), [this, &inv_level](const edge& e1, const edge& e2)
+                                 { return inv_level[target(e1)] > inv_level[target(e2)]; });
+                edges.erase(edges.begin(), edges.begin() + static_cast<long>(specific_threshold - 1));
+            }
+            else
+            {
+                // remove the last (specific_threshold - 1) elements which won't be substituted
+                edges.erase(edges.end() - static_cast<long>(specific_threshold - 1), edges.end());
+            }
+
+            std::vector<tree_node> targets{};
+            std::transform(edges.cbegin(), edges.cend(), std::back_inserter(targets),
+                           [this](const edge& e){ return tree_node{false, target(e)}; });
+
+            tree.substituted = std::move(edges);
+
+            if (stgy == substitution_strategy::DELAY)
+            {
+                const auto root_weight = huffman(targets, tree);
+
+                // the vertex' path length is determined by its tree and the edges that were not substituted
+                inv_level[v] = root_weight + 1;
+                for (auto&& e : get_out_edges(v))
+                {
+                    if (std::find(tree.substituted.cbegin(), tree.substituted.cend(), e) == tree.substituted.cend())
+                        inv_level[v] = std::max(inv_level[v], inv_level[target(e)] + 1);
+                }
+            }
+            else
+            {
+                while (targets.size() > 1)
+                {
+                    targets = connect(targets, tree);
+                }
+
+                tree.root = targets.front();
+            }
+        }
+        else if (stgy == substitution_strategy::DELAY)
+        {
+            for (auto&& t : get_adjacent_vertices(v))
+                inv_level[v] = std::max(inv_level[v], inv_level[t] + 1);
+        }
+    };
+
+    if (stgy == substitution_strategy::DELAY)
     {
-        std::size_t specific_threshold = (get_op(v) == operation::NOT || get_op(v) == operation::PI) ? 1 : threshold;
+        // reversed topological order guarantees that all successors are known before a vertex is planned
+        for (auto&& v : topological_sort())
+            plan(v);
+    }
+    else
+    {
+        for (auto&& v : get_vertices())
+            plan(v);
+    }
 
-        if (get_out_degree(v) > specific_threshold)
+    // create fan-out vertices and their connections; IDs are assigned in vertex order
+    std::vector<operation> props{};
+    props.reserve(num_vertices);
+    for (auto&& v : get_vertices())
+        props.push_back(get_op(v));
+
+    std::unordered_set<edge, boost::hash<edge>> substituted{};
+    std::vector<std::pair<vertex, vertex>> new_edges{};
+
+    for (auto&& v : get_vertices())
+    {
+        const auto& tree = trees[v];
+        if (tree.substituted.empty())
+            continue;
+
+        substituted.insert(tree.substituted.cbegin(), tree.substituted.cend());
+
+        const auto first_fo = props.size();
+        for (const auto& children : tree.fan_outs)
+        {
+            const auto fo_op = children.size() == 2 ? operation::F1O2 : operation::F1O3;
+            register_vertex(fo_op);
+            props.push_back(fo_op);
+        }
+
+        const auto resolve = [&first_fo](const tree_node& n){ return n.fan_out ? first_fo + n.id : n.id; };
+
+        for (auto i = 0ul; i < tree.fan_outs.size(); ++i)
         {
-            auto oe = out_edges(v, true);
-            std::vector<edge> edges(oe.begin(), oe.end());
-            // remove the last (specific_threshold - 1) elements which won't be substituted
-            edges.erase(edges.end() - (specific_threshold - 1), edges.end());
+            for (const auto& c : tree.fan_outs[i])
+                new_edges.emplace_back(first_fo + i, resolve(c));
+        }
+
+        new_edges.emplace_back(v, resolve(tree.root));
+    }
 
-            std::vector<vertex> targets{};
-            // figure out targets and remove edges which will be substituted
-            std::for_each(edges.begin(), edges.end(),
-                    [this, &targets](auto _oe){ targets.push_back(target(_oe)); remove_edge(_oe); });
+    // nothing to substitute
+    if (substituted.empty())
+        return;
 
-            while (targets.size() > 1)
+    // index all kept edges
+    std::vector<edge> kept{};
+    std::unordered_map<edge, std::size_t, boost::hash<edge>> kept_index{};
+    for (auto&& e : get_edges())
+    {
+        if (substituted.count(e) == 0ul)
+        {
+            kept_index.emplace(e, kept.size());
+            kept.push_back(e);
+        }
+    }
+
+    // out- and in-edge lists are ordered by creation of their edges; an edge has to be re-inserted after its
+    // predecessors in both the out-edge list of its source and the in-edge list of its target to maintain both orders
+    std::vector<std::vector<std::size_t>> successors(kept.size());
+    std::vector<std::size_t> num_predecessors(kept.size(), 0ul);
+    const auto chain = [&](const auto& edge_range)
+    {
+        std::optional<std::size_t> previous{};
+        for (auto&& e : edge_range)
+        {
+            if (auto it = kept_index.find(e); it != kept_index.cend())
             {
-                targets = connect(targets);
+                if (previous)
+                {
+                    successors[*previous].push_back(it->second);
+                    ++num_predecessors[it->second];
+                }
+                previous = it->second;
             }
+        }
+    };
+
+    for (auto&& v : get_vertices())
+    {
+        chain(get_out_edges(v));
+        chain(get_in_edges(v));
+    }
 
-            add_edge(v, targets.front());
+    // rebuild the graph in one go; kept edges in an order consistent with both lists followed by the new ones such that
+    // substituted connections are appended to the in-edge lists of their targets as an edge-by-edge substitution does
+    std::vector<std::pair<vertex, vertex>> edge_list{};
+    edge_list.reserve(kept.size() + new_edges.size());
+
+    std::vector<std::size_t> ready{};
+    for (auto i = 0ul; i < kept.size(); ++i)
+    {
+        if (num_predecessors[i] == 0ul)
+            ready.push_back(i);
+    }
+
+    while (!ready.empty())
+    {
+        const auto i = ready.back();
+        ready.pop_back();
+
+        edge_list.emplace_back(source(kept[i]), target(kept[i]));
+
+        for (const auto s : successors[i])
+        {
+            if (--num_predecessors[s] == 0ul)
+                ready.push_back(s);
         }
     }
+
+    edge_list.insert(edge_list.end(), new_edges.cbegin(), new_edges.cend());
+
+    rebuild_graph(props, edge_list);
 }
 
 void logic_network::write_dot(std::ostream& os) const noexcept
@@ -494,6 +770,43 @@ void logic_network::clear_network() noexcept
 
     for (auto i = 0u; i < OP_COUNT; ++i)
         operation_counter[i] = 0;
+
+    pi_list.clear();
+    po_list.clear();
+    vertex_flags.clear();
+    vertex_port_names.clear();
+    port_names.assign(1u, "");
+    port_name_index = {{"", 0u}};
+}
+
+void logic_network::register_vertex(const operation o) noexcept
+{
+    increment_op_counter(o);
+    vertex_flags.push_back(operation_flags(o));
+    vertex_port_names.push_back(0u);
+}
+
+uint8_t logic_network::operation_flags(const operation o) noexcept
+{
+    switch (o)
+    {
+        case operation::F1O2:
+        case operation::F1O3:
+            return FAN_OUT_FLAG;
+        case operation::W:
+            return BALANCE_FLAG;
+        default:
+            return 0u;
+    }
+}
+
+void logic_network::assign_port_name(const vertex v, const std::string& name) noexcept
+{
+    auto [it, inserted] = port_name_index.emplace(name, static_cast<uint32_t>(port_names.size()));
+    if (inserted)
+        port_names.push_back(name);
+
+    vertex_port_names[v] = it->second;
 }
 
 void logic_network::increment_op_counter(const operation o) noexcept
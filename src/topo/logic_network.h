@@ -9,9 +9,12 @@
 #include "operations.h"
 #include "fmt/format.h"
 #include "fmt/ostream.h"
-#include <boost/bimap.hpp>
-#include <boost/bimap/unordered_set_of.hpp>
 #include <boost/filesystem.hpp>
+#include <atomic>
+#include <unordered_map>
+#include <unordered_set>
+#include <queue>
+#include <tuple>
 #include <itertools.hpp>
 #include <mockturtle/networks/mig.hpp>
 #include <mockturtle/views/names_view.hpp>
@@ -151,7 +154,7 @@ public:
     /**
      * Removes the given vertex from the network.
      *
-     * NOTE that this might invalidate mappings as all node IDs will be recomputed.
+     * NOTE that this might invalidate mappings as all node IDs will be recomputed. Runs in O(|V|).
      *
      * @param v Vertex to remove.
      */
@@ -368,14 +371,14 @@ public:
      */
     operation get_op(const vertex v) const noexcept;
     /**
-     * Returns whether or not given vertex v is a PI port as by set entry.
+     * Returns whether or not given vertex v is a PI port as by flag entry. Runs in O(1).
      *
      * @param v vertex whose assigned PI port should be checked.
      * @return true iff v is a PI port.
      */
     bool is_pi(const vertex v) const noexcept;
     /**
-     * Returns whether or not given vertex v has predecessors which are PIs as by set entry.
+     * Returns whether or not given vertex v has predecessors which are PIs as by flag entry.
      *
      * @param v vertex whose predecessors should be checked for PI status.
      * @return True if v has PI predecessors.
@@ -388,26 +391,26 @@ public:
      */
     auto num_pis() const noexcept
     {
-        return pi_set.size();
+        return pi_list.size();
     }
     /**
-     * Returns a range of all vertices flagged as primary input in the network.
+     * Returns a range of all vertices flagged as primary input in the network in order of their creation.
      *
      * @return range_t of all primary input vertices.
      */
     auto get_pis() const noexcept
     {
-        return range_t<primary_set::const_iterator>{std::make_pair(pi_set.begin(), pi_set.end())};
+        return range_t<primary_list::const_iterator>{std::make_pair(pi_list.cbegin(), pi_list.cend())};
     }
     /**
-     * Returns whether or not given vertex v is a PO port as by set entry.
+     * Returns whether or not given vertex v is a PO port as by flag entry. Runs in O(1).
      *
      * @param v vertex whose assigned PO port should be checked.
      * @return true iff v is a PO port.
      */
     bool is_po(const vertex v) const noexcept;
     /**
-     * Returns whether or not given vertex v has successors which are POs as by set entry.
+     * Returns whether or not given vertex v has successors which are POs as by flag entry.
      *
      * @param v vertex whose successors should be checked for PO status.
      * @return True if v has PO successors.
@@ -420,16 +423,16 @@ public:
      */
     auto num_pos() const noexcept
     {
-        return po_set.size();
+        return po_list.size();
     }
     /**
-     * Returns a range of all vertices flagged as primary output in the network.
+     * Returns a range of all vertices flagged as primary output in the network in order of their creation.
      *
      * @return range_t of all primary output vertices.
      */
     auto get_pos() const noexcept
     {
-        return range_t<primary_set::const_iterator>{std::make_pair(po_set.begin(), po_set.end())};
+        return range_t<primary_list::const_iterator>{std::make_pair(po_list.cbegin(), po_list.cend())};
     }
     /**
      * Returns true iff given vertex v is an explicit PI or PO node.
@@ -438,6 +441,20 @@ public:
      * @return True iff v is I/O.
      */
     bool is_io(const vertex v) const noexcept;
+    /**
+     * Returns true iff given vertex v is a fan-out, i.e. it has operation F1O2 or F1O3 assigned. Runs in O(1).
+     *
+     * @param v Vertex to test for fan-out-ness.
+     * @return True iff v is a fan-out.
+     */
+    bool is_fan_out(const vertex v) const noexcept;
+    /**
+     * Returns true iff given vertex v is a balance vertex, i.e. it has operation W assigned. Runs in O(1).
+     *
+     * @param v Vertex to test for balance-ness.
+     * @return True iff v is a balance vertex.
+     */
+    bool is_balance(const vertex v) const noexcept;
     /**
      * Returns the number of operations of given type in the network.
      *
@@ -482,7 +499,7 @@ public:
     bool is_MAOIG() const noexcept;
     /**
      * Returns the stored I/O port name of given vertex v. If no port name was stored before, an empty string is
-     * returned.
+     * returned. Runs in O(1).
      *
      * @param v Vertex whose port name is desired.
      * @return Port name of v if there is one, "" otherwise.
@@ -511,23 +528,43 @@ public:
      * @return Vector of truth tables.
      */
     std::vector<kitty::dynamic_truth_table> simulate() const;
+    /**
+     * Returns the MIG network the logic_network was created from. Note that copies of mockturtle networks share their
+     * storage. Algorithms that modify it need to work on a deep copy, e.g., one obtained via cleanup_dangling.
+     *
+     * @return Boolean function representation as an MIG network.
+     */
+    const mig_nt& get_mig() const noexcept;
     /**
      * Strategies for breaking down gates in a depth first or breadth first way. Depth creates deeper networks, while
-     * breadth creates wider ranks.
+     * breadth creates wider ranks. Delay builds fan-out trees in which the successors with the longest paths towards
+     * the primary outputs are kept as shallow as possible.
      */
-    enum substitution_strategy { BREADTH, DEPTH };
+    enum substitution_strategy { BREADTH, DEPTH, DELAY };
     /**
      * Substitutes multi-outputs of gate vertices and replaces them with fan-out ones. That is, connections become
      * "gates". Some algorithms require fan-out vertices explicitly and will break down networks if needed. Others might
      * be able to handle both.
      *
+     * The fan-out trees of all vertices are determined first and the graph is rebuilt afterwards in one go. Therefore,
+     * all previously obtained edges become invalid.
+     *
      * @param degree Maximum number of outputs a fan-out vertex is allowed to have. Currently, there are different
      *               operation types for them, F1O2 and F1O3, which means, only 2 and 3 are supported.
-     * @param stgy Strategy to align fan-outs. They can form a balanced tree (BREADTH) or a DFS tree (DEPTH).
+     * @param stgy Strategy to align fan-outs. They can form a balanced tree (BREADTH), a DFS tree (DEPTH), or a tree
+     *             that minimizes the path lengths to the primary outputs (DELAY).
      * @param threshold Maximum number of outputs an AND/OR/MAJ gate can have before substitution applies.
      */
     void substitute_fan_outs(const std::size_t degree = 2u, const substitution_strategy stgy = substitution_strategy::BREADTH,
                              const std::size_t threshold = 1u) noexcept;
+    /**
+     * Checks whether substitute_fan_outs would alter the network, i.e., whether there is a vertex that is not a fan-out
+     * and has more outputs than allowed by the given threshold. Runs in O(|V|).
+     *
+     * @param threshold Maximum number of outputs an AND/OR/MAJ gate can have before substitution applies.
+     * @return true iff substitute_fan_outs with the given threshold would create any fan-out vertex.
+     */
+    bool requires_fan_out_substitution(const std::size_t threshold = 1u) const noexcept;
     /**
      * Writes a Graphviz (https://www.graphviz.org/) dot representation of the logic_network to the given ostream.
      * Incorporates the logic function names.
@@ -556,26 +593,64 @@ private:
      */
     mig_nt mig;
     /**
-     * Alias for a set that holds vertices to represent PI/PO ports.
+     * Alias for a dense list that holds vertices to represent PI/PO ports.
+     */
+    using primary_list = std::vector<vertex>;
+    /**
+     * Stores vertices that are marked as PIs/POs in order of their creation.
+     */
+    primary_list pi_list{}, po_list{};
+    /**
+     * Attributes that can be attached to vertices.
+     */
+    enum vertex_flag : uint8_t
+    {
+        PI_FLAG      = 1u << 0u,
+        PO_FLAG      = 1u << 1u,
+        FAN_OUT_FLAG = 1u << 2u,
+        BALANCE_FLAG = 1u << 3u
+    };
+    /**
+     * Stores one byte of vertex_flags per vertex. Indexed by vertex.
      */
-    using primary_set = std::set<vertex>;
+    std::vector<uint8_t> vertex_flags{};
     /**
-     * Stores vertices that are marked as PIs/POs. Helper functions for access save memory.
+     * Interned I/O port names. Each distinct name is stored exactly once. Index 0 is reserved for the empty name.
      */
-    primary_set pi_set{}, po_set{};
+    std::vector<std::string> port_names{""};
     /**
-     * Alias for a bidirectional hash map of vertices to names specifying port nodes in the network.
+     * Maps port names to their index in port_names for interning.
      */
-    using port_map = boost::bimap<boost::bimaps::unordered_set_of<vertex, boost::hash<vertex>>,
-                                  boost::bimaps::unordered_set_of<std::string, boost::hash<std::string>>>;
+    std::unordered_map<std::string, uint32_t> port_name_index{{"", 0u}};
     /**
-     * Stores I/O port names.
+     * Stores the index of each vertex' port name in port_names. Indexed by vertex.
      */
-    port_map io_port_map{};
+    std::vector<uint32_t> vertex_port_names{};
     /**
      * Counts the operations the network is composed of.
      */
     std::vector<uint64_t> operation_counter;
+    /**
+     * Updates operation counter, flags, and port names for a vertex of operation o that is about to be added to the
+     * graph.
+     *
+     * @param o Operation of the vertex to be added.
+     */
+    void register_vertex(const operation o) noexcept;
+    /**
+     * Computes the flags derived from the given operation, i.e. FAN_OUT_FLAG for F1O2 and F1O3 and BALANCE_FLAG for W.
+     *
+     * @param o Operation whose flags are desired.
+     * @return Flags associated with o.
+     */
+    static uint8_t operation_flags(const operation o) noexcept;
+    /**
+     * Assigns the given port name to the given vertex v. Equal names are only stored once.
+     *
+     * @param v Vertex to name.
+     * @param name Port name to assign.
+     */
+    void assign_port_name(const vertex v, const std::string& name) noexcept;
     /**
      * Increases the operation counter of the given operation by 1.
      *
@@ -596,5 +671,28 @@ private:
 
 using logic_network_ptr = std::shared_ptr<logic_network>;
 
+/**
+ * Logic networks are shared between stores, layouts, and physical design approaches and copied on write only. Any
+ * function that is about to modify a network in place has to call this function first. If the given pointer is not
+ * the only owner of its network, it is redirected to a deep copy that can be modified without affecting other owners.
+ * Like copy_on_write::write, it can be called on distinct pointers sharing a network from different threads
+ * concurrently, e.g., by background jobs that were handed the network, but not on the same pointer.
+ *
+ * @param ln Pointer to a network that is about to be modified.
+ * @return Reference to ln which is the only owner of its network afterwards.
+ */
+inline logic_network_ptr& make_unique_network(logic_network_ptr& ln)
+{
+    if (ln.use_count() > 1)
+        ln = std::make_shared<logic_network>(*ln);
+    else
+    {
+        // see copy_on_write::write; reads of former owners have to happen before the following modifications
+        std::atomic_thread_fence(std::memory_order_acquire);
+    }
+
+    return ln;
+}
+
 
 #endif //FICTION_LOGIC_NETWORK_H
@@ -0,0 +1,103 @@
+//
+// Created by marcel on 19.10.26.
+//
+
+#include "logic_network_snapshot.h"
+
+
+logic_network_snapshot::logic_network_snapshot(logic_network_ptr ln) noexcept
+        :
+        network{std::move(ln)}
+{
+    const auto n = network->vertex_count(true);
+
+    op_list.resize(n);
+    pi_bitmap.resize(n, false);
+    po_bitmap.resize(n, false);
+    io_bitmap.resize(n, false);
+
+    for (auto&& v : network->vertices(true))
+    {
+        op_list[v]   = static_cast<uint8_t>(network->get_op(v));
+        pi_bitmap[v] = network->is_pi(v);
+        po_bitmap[v] = network->is_po(v);
+        io_bitmap[v] = network->is_io(v);
+    }
+
+    for (auto&& pi : network->get_pis())
+        pi_list.push_back(pi);
+
+    for (auto&& po : network->get_pos())
+        po_list.push_back(po);
+
+    for (auto o = 0u; o < OP_COUNT; ++o)
+        operation_counter[o] = network->operation_count(static_cast<operation>(o));
+
+    for (const bool ios : {false, true})
+    {
+        num_vertices[ios] = network->vertex_count(ios);
+        num_edges[ios]    = network->edge_count(ios);
+
+        auto vs = network->vertices(ios);
+        vertex_list[ios].assign(vs.begin(), vs.end());
+
+        auto es = network->edges(ios);
+        edge_list[ios].assign(es.begin(), es.end());
+
+        auto& out = out_csr[ios];
+        auto& in  = in_csr[ios];
+
+        out.offsets.reserve(n + 1);
+        in.offsets.reserve(n + 1);
+        out.offsets.push_back(0ul);
+        in.offsets.push_back(0ul);
+
+        // neighborhoods are stored for all vertices to be able to query I/Os even if they are excluded as neighbors
+        for (auto v = 0ul; v < n; ++v)
+        {
+            for (auto&& oe : network->out_edges(v, ios))
+            {
+                out.adjacent.push_back(network->target(oe));
+                out.incident.push_back(oe);
+            }
+            out.offsets.push_back(out.adjacent.size());
+
+            for (auto&& ie : network->in_edges(v, ios))
+            {
+                in.adjacent.push_back(network->source(ie));
+                in.incident.push_back(ie);
+            }
+            in.offsets.push_back(in.adjacent.size());
+        }
+    }
+}
+
+bool logic_network_snapshot::pre_pi(const vertex v) const noexcept
+{
+    auto pre = inv_adjacent_vertices(v, true);
+    return std::any_of(pre.begin(), pre.end(), [this](const vertex _v){return is_pi(_v);});
+}
+
+bool logic_network_snapshot::post_po(const vertex v) const noexcept
+{
+    auto post = adjacent_vertices(v, true);
+    return std::any_of(post.begin(), post.end(), [this](const vertex _v){return is_po(_v);});
+}
+
+std::vector<logic_network_snapshot::edge_path> logic_network_snapshot::get_all_paths(const vertex v, const bool ios) const noexcept
+{
+    if (in_degree(v, true) == 0u)
+        return std::vector<edge_path>{edge_path{}};
+
+    std::vector<edge_path> paths{};
+    for (auto&& e : in_edges(v, ios))
+    {
+        auto ps = get_all_paths(source(e), ios);
+        for (auto& p : ps)
+            p.push_back(e);
+
+        paths.insert(paths.end(), ps.cbegin(), ps.cend());
+    }
+
+    return paths;
+}
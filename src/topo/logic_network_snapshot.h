@@ -0,0 +1,420 @@
+//
+// Created by marcel on 19.10.26.
+//
+
+#ifndef FICTION_LOGIC_NETWORK_SNAPSHOT_H
+#define FICTION_LOGIC_NETWORK_SNAPSHOT_H
+
+#include "logic_network.h"
+#include "range.h"
+#include <array>
+#include <vector>
+#include <memory>
+#include <algorithm>
+
+/**
+ * A frozen, read-only view of a logic_network in compressed sparse row (CSR) format. Physical design algorithms do not
+ * alter their logic networks after the preprocessing phase (e.g. substitute_fan_outs) but traverse them many times.
+ * Walking the BGL adjacency list via filtered ranges that check for I/O-ness on every single element is not exactly
+ * cache-friendly. This class stores in- and out-adjacencies in contiguous arrays, operations in a byte array, and
+ * PI/PO/I/O flags in bitmaps instead. Ranges with and without I/Os are precomputed so that no filtering is required
+ * during iteration.
+ *
+ * The interface resembles the one of logic_network so that algorithms can be switched over by simply exchanging the
+ * pointer type. Vertices and edges are the very same objects as in the underlying logic_network. Thereby, they can
+ * be assigned to fcn_gate_layouts as usual. Iteration order is the same as well.
+ *
+ * NOTE that the snapshot is NOT updated when the underlying network is altered. Edge objects will become invalid then.
+ * Therefore, a snapshot should only be created after all structural manipulations are done.
+ */
+class logic_network_snapshot
+{
+public:
+    /**
+     * Vertices are the same as in logic_network.
+     */
+    using vertex = logic_network::vertex;
+    /**
+     * Edges are the same as in logic_network.
+     */
+    using edge = logic_network::edge;
+    /**
+     * A sequence of edges can be used as a path.
+     */
+    using edge_path = logic_network::edge_path;
+    /**
+     * Range type of vertices stored in contiguous memory.
+     */
+    using vertex_range = range_t<std::vector<vertex>::const_iterator>;
+    /**
+     * Range type of edges stored in contiguous memory.
+     */
+    using edge_range = range_t<std::vector<edge>::const_iterator>;
+    /**
+     * Standard constructor. Freezes the current state of the given logic network.
+     *
+     * @param ln Logic network to take a snapshot of.
+     */
+    explicit logic_network_snapshot(logic_network_ptr ln) noexcept;
+    /**
+     * Returns a range of vertices in the network. The range can be parameterized to specify whether I/Os should be
+     * included.
+     *
+     * @param ios Flag to indicate that I/Os should be included in the range.
+     * @return Range of vertices that might include I/Os depending on parameters.
+     */
+    vertex_range vertices(const bool ios = false) const noexcept
+    {
+        return vertex_range{std::make_pair(vertex_list[ios].cbegin(), vertex_list[ios].cend())};
+    }
+    /**
+     * Returns a range of vertices adjacent to the given vertex v. The range can be parameterized to specify whether
+     * I/Os should be included.
+     *
+     * @param v Vertex whose adjacent vertices are desired.
+     * @param ios Flag to indicate that I/Os should be included in the range.
+     * @return Range of vertices adjacent to v that might include I/Os depending on parameters.
+     */
+    vertex_range adjacent_vertices(const vertex v, const bool ios = false) const noexcept
+    {
+        return out_csr[ios].adjacent_range(v);
+    }
+    /**
+     * Returns a range of vertices inversely adjacent to the given vertex v. The range can be parameterized to specify
+     * whether I/Os should be included.
+     *
+     * @param v Vertex whose inversely adjacent vertices are desired.
+     * @param ios Flag to indicate that I/Os should be included in the range.
+     * @return Range of vertices inversely adjacent to v that might include I/Os depending on parameters.
+     */
+    vertex_range inv_adjacent_vertices(const vertex v, const bool ios = false) const noexcept
+    {
+        return in_csr[ios].adjacent_range(v);
+    }
+    /**
+     * Returns a range of edges in the network. The range can be parameterized to specify whether edges leading towards
+     * or from I/Os should be included.
+     *
+     * @param ios Flag to indicate that edges leading towards or from I/Os should be included in the range.
+     * @return Range of edges that might include such leading towards or from I/Os depending on parameters.
+     */
+    edge_range edges(const bool ios = false) const noexcept
+    {
+        return edge_range{std::make_pair(edge_list[ios].cbegin(), edge_list[ios].cend())};
+    }
+    /**
+     * Returns a range of edges outgoing from the given vertex v. The range can be parameterized to specify whether
+     * edges leading towards I/Os should be included.
+     *
+     * @param v Vertex whose outgoing edges are desired.
+     * @param ios Flag to indicate that edges leading towards I/Os should be included in the range.
+     * @return Range of edges outgoing from v that might include edges towards I/Os depending on parameters.
+     */
+    edge_range out_edges(const vertex v, const bool ios = false) const noexcept
+    {
+        return out_csr[ios].incident_range(v);
+    }
+    /**
+     * Returns a range of edges incoming to the given vertex v. The range can be parameterized to specify whether
+     * edges coming from I/Os should be included.
+     *
+     * @param v Vertex whose incoming edges are desired.
+     * @param ios Flag to indicate that edges coming from I/Os should be included in the range.
+     * @return Range of edges incoming to v that might include edges from I/Os depending on parameters.
+     */
+    edge_range in_edges(const vertex v, const bool ios = false) const noexcept
+    {
+        return in_csr[ios].incident_range(v);
+    }
+    /**
+     * Returns the number of vertices in the network. Behaves exactly like logic_network::vertex_count.
+     *
+     * @param ios Flag to indicate that I/Os should be counted as vertices.
+     * @return Number of vertices with respect to the flags.
+     */
+    std::size_t vertex_count(const bool ios = false) const noexcept
+    {
+        return num_vertices[ios];
+    }
+    /**
+     * Returns the number of edges in the network. Behaves exactly like logic_network::edge_count.
+     *
+     * @param ios Flag to indicate that I/Os should be counted as edges.
+     * @return Number of edges with respect to the flags.
+     */
+    std::size_t edge_count(const bool ios = false) const noexcept
+    {
+        return num_edges[ios];
+    }
+    /**
+     * Returns the number of outgoing edges of the given vertex v in O(1).
+     *
+     * @param v Vertex whose out degree is desired.
+     * @param ios Flag to indicate that edges to I/Os should be counted.
+     * @return Number of v's outgoing edges with respect to the flags.
+     */
+    std::size_t out_degree(const vertex v, const bool ios = false) const noexcept
+    {
+        return out_csr[ios].degree(v);
+    }
+    /**
+     * Returns the number of incoming edges of the given vertex v in O(1).
+     *
+     * @param v Vertex whose in degree is desired.
+     * @param ios Flag to indicate that edges from I/Os should be counted.
+     * @return Number of v's incoming edges with respect to the flags.
+     */
+    std::size_t in_degree(const vertex v, const bool ios = false) const noexcept
+    {
+        return in_csr[ios].degree(v);
+    }
+    /**
+     * Returns the operation assigned to vertex v.
+     *
+     * @param v Vertex whose assigned operation is desired.
+     * @return Operation associated with v.
+     */
+    operation get_op(const vertex v) const noexcept
+    {
+        return static_cast<operation>(op_list[v]);
+    }
+    /**
+     * Returns whether or not given vertex v is a PI port.
+     *
+     * @param v Vertex whose assigned PI port should be checked.
+     * @return true iff v is a PI port.
+     */
+    bool is_pi(const vertex v) const noexcept
+    {
+        return pi_bitmap[v];
+    }
+    /**
+     * Returns whether or not given vertex v is a PO port.
+     *
+     * @param v Vertex whose assigned PO port should be checked.
+     * @return true iff v is a PO port.
+     */
+    bool is_po(const vertex v) const noexcept
+    {
+        return po_bitmap[v];
+    }
+    /**
+     * Returns true iff given vertex v is an explicit PI or PO node.
+     *
+     * @param v Vertex to test for I/O-ness.
+     * @return True iff v is I/O.
+     */
+    bool is_io(const vertex v) const noexcept
+    {
+        return io_bitmap[v];
+    }
+    /**
+     * Returns whether or not given vertex v has predecessors which are PIs.
+     *
+     * @param v Vertex whose predecessors should be checked for PI status.
+     * @return True if v has PI predecessors.
+     */
+    bool pre_pi(const vertex v) const noexcept;
+    /**
+     * Returns whether or not given vertex v has successors which are POs.
+     *
+     * @param v Vertex whose successors should be checked for PO status.
+     * @return True if v has PO successors.
+     */
+    bool post_po(const vertex v) const noexcept;
+    /**
+     * Returns the number of primary input flagged vertices in the network.
+     *
+     * @return Number of PIs.
+     */
+    std::size_t num_pis() const noexcept
+    {
+        return pi_list.size();
+    }
+    /**
+     * Returns the number of primary output flagged vertices in the network.
+     *
+     * @return Number of POs.
+     */
+    std::size_t num_pos() const noexcept
+    {
+        return po_list.size();
+    }
+    /**
+     * Returns a range of all vertices flagged as primary input in the network in order of their creation.
+     *
+     * @return Range of all primary input vertices.
+     */
+    vertex_range get_pis() const noexcept
+    {
+        return vertex_range{std::make_pair(pi_list.cbegin(), pi_list.cend())};
+    }
+    /**
+     * Returns a range of all vertices flagged as primary output in the network in order of their creation.
+     *
+     * @return Range of all primary output vertices.
+     */
+    vertex_range get_pos() const noexcept
+    {
+        return vertex_range{std::make_pair(po_list.cbegin(), po_list.cend())};
+    }
+    /**
+     * Returns the number of operations of given type in the network.
+     *
+     * @param o Type of operation whose count is desired.
+     * @return Number of operations of type o in the network.
+     */
+    uint64_t operation_count(const operation o) const noexcept
+    {
+        return operation_counter[o];
+    }
+    /**
+     * Returns the source vertex of the given edge.
+     *
+     * @param e Edge whose source vertex is desired.
+     * @return Source vertex of e.
+     */
+    vertex source(const edge& e) const noexcept
+    {
+        return network->source(e);
+    }
+    /**
+     * Returns the target vertex of the given edge.
+     *
+     * @param e Edge whose target vertex is desired.
+     * @return Target vertex of e.
+     */
+    vertex target(const edge& e) const noexcept
+    {
+        return network->target(e);
+    }
+    /**
+     * Returns a vector of all possible paths to reach the given vertex within the network. Behaves exactly like
+     * logic_network::get_all_paths.
+     *
+     * @param v Vertex to which all paths should lead.
+     * @param ios Flag to indicate that I/Os should be considered as path elements.
+     * @return A vector of all possible edge paths leading from terminals to v.
+     */
+    std::vector<edge_path> get_all_paths(const vertex v, const bool ios = false) const noexcept;
+    /**
+     * Returns the stored I/O port name of given vertex v.
+     *
+     * @param v Vertex whose port name is desired.
+     * @return Port name of v if there is one, "" otherwise.
+     */
+    std::string get_port_name(const vertex v) const noexcept
+    {
+        return network->get_port_name(v);
+    }
+    /**
+     * Returns the stored file path name.
+     *
+     * @return The stored file path name.
+     */
+    std::string get_name() const noexcept
+    {
+        return network->get_name();
+    }
+    /**
+     * Returns the logic network this snapshot was taken of.
+     *
+     * @return Underlying logic network.
+     */
+    logic_network_ptr get_network() const noexcept
+    {
+        return network;
+    }
+
+private:
+    /**
+     * Underlying logic network the snapshot was taken of.
+     */
+    const logic_network_ptr network;
+    /**
+     * Adjacency information in compressed sparse row format. The neighbors of vertex v are stored in the index range
+     * [offsets[v], offsets[v + 1]) of adjacent and incident, respectively.
+     */
+    struct csr
+    {
+        /**
+         * Start index of each vertex' neighborhood. Contains |V| + 1 elements.
+         */
+        std::vector<std::size_t> offsets{};
+        /**
+         * Adjacent vertices of all vertices in a row.
+         */
+        std::vector<vertex> adjacent{};
+        /**
+         * Incident edges of all vertices in a row. Parallel to adjacent.
+         */
+        std::vector<edge> incident{};
+        /**
+         * Returns the range of vertices adjacent to v.
+         *
+         * @param v Vertex whose neighbors are desired.
+         * @return Range of adjacent vertices.
+         */
+        vertex_range adjacent_range(const vertex v) const noexcept
+        {
+            return vertex_range{std::make_pair(adjacent.cbegin() + offsets[v], adjacent.cbegin() + offsets[v + 1])};
+        }
+        /**
+         * Returns the range of edges incident to v.
+         *
+         * @param v Vertex whose incident edges are desired.
+         * @return Range of incident edges.
+         */
+        edge_range incident_range(const vertex v) const noexcept
+        {
+            return edge_range{std::make_pair(incident.cbegin() + offsets[v], incident.cbegin() + offsets[v + 1])};
+        }
+        /**
+         * Returns the number of neighbors of v.
+         *
+         * @param v Vertex whose degree is desired.
+         * @return Degree of v.
+         */
+        std::size_t degree(const vertex v) const noexcept
+        {
+            return offsets[v + 1] - offsets[v];
+        }
+    };
+    /**
+     * Outgoing and incoming adjacencies. Index 0 excludes I/Os, index 1 includes them.
+     */
+    std::array<csr, 2> out_csr{}, in_csr{};
+    /**
+     * All vertices without (index 0) and with (index 1) I/Os.
+     */
+    std::array<std::vector<vertex>, 2> vertex_list{};
+    /**
+     * All edges without (index 0) and with (index 1) those leading from or to I/Os.
+     */
+    std::array<std::vector<edge>, 2> edge_list{};
+    /**
+     * Vertex and edge counts as reported by the underlying network without (index 0) and with (index 1) I/Os.
+     */
+    std::array<std::size_t, 2> num_vertices{}, num_edges{};
+    /**
+     * Operation of each vertex stored as a byte.
+     */
+    std::vector<uint8_t> op_list{};
+    /**
+     * Bitmaps marking PIs, POs, and I/Os in general.
+     */
+    std::vector<bool> pi_bitmap{}, po_bitmap{}, io_bitmap{};
+    /**
+     * Dense lists of PI and PO vertices.
+     */
+    std::vector<vertex> pi_list{}, po_list{};
+    /**
+     * Number of operations of each type.
+     */
+    std::array<uint64_t, OP_COUNT> operation_counter{};
+};
+
+using logic_network_snapshot_ptr = std::shared_ptr<const logic_network_snapshot>;
+
+
+#endif //FICTION_LOGIC_NETWORK_SNAPSHOT_H
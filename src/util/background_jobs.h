@@ -0,0 +1,419 @@
+//
+// Created by marcel on 19.10.26.
+//
+
+#ifndef FICTION_BACKGROUND_JOBS_H
+#define FICTION_BACKGROUND_JOBS_H
+
+#include "nlohmann/json.hpp"
+#include <fmt/format.h>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+/**
+ * Runs long-lasting commands like exact, equiv, or cell on worker threads such that the shell can be used for other
+ * work in the meantime.
+ *
+ * Jobs never touch the stores themselves. Instead, a command takes a snapshot of all store elements it needs when
+ * launching a job, i.e., it either copies them or holds shared pointers to elements that are not modified in place
+ * anymore. The job's work then returns a function that commits its results to the stores. Since alice's stores are not
+ * thread-safe, these commit functions are only executed on the thread running the shell when finished jobs are
+ * collected, e.g., by the jobs or wait commands. Output of jobs is buffered and printed on collection as well.
+ *
+ * Jobs can provide an interrupt hook that asks their computation to stop early. It is used when jobs are killed and
+ * when the process ends. Worker threads are never detached but joined once their work has returned.
+ */
+class background_jobs
+{
+public:
+    /**
+     * Identifier of a job.
+     */
+    using job_id = std::size_t;
+    /**
+     * Results of a job: a function that commits them to the stores (can be empty) and logging information.
+     */
+    struct job_result
+    {
+        std::function<void()> commit{};
+        nlohmann::json log{};
+    };
+    /**
+     * Work to be performed by a job. It receives a stream for its output and must not access any stores.
+     */
+    using job_work = std::function<job_result(std::ostream&)>;
+    /**
+     * Asks the work of a job to stop as soon as possible. It is called from the thread running the shell or from the
+     * destructor and must therefore be thread-safe, e.g., by calling physical_design::interrupt.
+     */
+    using job_interrupt = std::function<void()>;
+    /**
+     * Status of a job.
+     */
+    enum class job_status { RUNNING, FINISHED };
+    /**
+     * Returns the job manager of this process.
+     *
+     * @return Reference to the one and only instance.
+     */
+    static background_jobs& get() noexcept
+    {
+        static background_jobs instance{};
+        return instance;
+    }
+    /**
+     * Launches the given work on a new worker thread.
+     *
+     * @param description Textual description of the job, e.g., the command that launched it.
+     * @param work Work to perform.
+     * @param interrupt Hook to stop work early. Can be empty if the work cannot be preempted.
+     * @return Identifier of the launched job.
+     */
+    job_id launch(const std::string& description, job_work&& work, job_interrupt&& interrupt = {})
+    {
+        std::lock_guard<std::mutex> guard(mutex);
+
+        const auto id = ++last_id;
+        auto j = std::make_shared<job>();
+        j->description = description;
+        j->interrupt = std::move(interrupt);
+        j->start = std::chrono::steady_clock::now();
+
+        // the thread shares ownership of the job such that killed jobs can finish safely after being forgotten
+        j->worker = std::thread([this, j, work = std::move(work)]
+        {
+            job_result result{};
+            try
+            {
+                result = work(j->output);
+            }
+            catch (const std::exception& e)
+            {
+                j->output << fmt::format("[e] job failed: {}", e.what()) << std::endl;
+            }
+
+            {
+                std::lock_guard<std::mutex> job_guard(mutex);
+                j->result = std::move(result);
+                j->end = std::chrono::steady_clock::now();
+                j->status = job_status::FINISHED;
+            }
+            finished.notify_all();
+        });
+
+        jobs.emplace(id, std::move(j));
+
+        return id;
+    }
+    /**
+     * Commits the results of all finished jobs, prints their output, and forgets them. Must only be called by the
+     * thread running the shell.
+     *
+     * @param out Stream to print the jobs' output to.
+     * @return Logging information of all collected jobs.
+     */
+    nlohmann::json collect(std::ostream& out)
+    {
+        auto log = nlohmann::json::array();
+
+        for (const auto& [id, j] : take_finished())
+            log.push_back(commit(id, *j, out));
+
+        return log;
+    }
+    /**
+     * Blocks until the given job has finished and collects it. Must only be called by the thread running the shell.
+     *
+     * @param id Job to wait for.
+     * @param out Stream to print the job's output to.
+     * @return Logging information of the job or null if no job with the given identifier is known.
+     */
+    nlohmann::json wait(const job_id id, std::ostream& out)
+    {
+        std::shared_ptr<job> j{};
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+
+            auto it = jobs.find(id);
+            if (it == jobs.end())
+                return nullptr;
+
+            j = it->second;
+            finished.wait(lock, [&j]{ return j->status == job_status::FINISHED; });
+            jobs.erase(it);
+        }
+        j->worker.join();
+
+        return commit(id, *j, out);
+    }
+    /**
+     * Blocks until all jobs have finished and collects them. Must only be called by the thread running the shell.
+     *
+     * @param out Stream to print the jobs' output to.
+     * @return Logging information of all collected jobs.
+     */
+    nlohmann::json wait_all(std::ostream& out)
+    {
+        auto log = nlohmann::json::array();
+
+        for (const auto& id : ids())
+        {
+            if (auto l = wait(id, out); !l.is_null())
+                log.push_back(std::move(l));
+        }
+
+        return log;
+    }
+    /**
+     * Kills the given job by calling its interrupt hook and discarding its results. Jobs without such a hook keep
+     * running until their work is done. Either way, the worker thread is joined as soon as it has finished, at the
+     * latest when the process ends.
+     *
+     * @param id Job to kill.
+     * @return true iff a job with the given identifier was known.
+     */
+    bool kill(const job_id id) noexcept
+    {
+        std::shared_ptr<job> j{};
+        {
+            std::lock_guard<std::mutex> guard(mutex);
+
+            auto it = jobs.find(id);
+            if (it == jobs.end())
+                return false;
+
+            j = it->second;
+            jobs.erase(it);
+            killed.push_back(j);
+        }
+
+        // called outside the lock since the work might report back to the job manager while stopping
+        if (j->interrupt)
+            j->interrupt();
+
+        reap();
+
+        return true;
+    }
+    /**
+     * Summary of a job for listing purposes.
+     */
+    struct job_info
+    {
+        job_id id;
+        std::string description;
+        job_status status;
+        double runtime;
+    };
+    /**
+     * Lists all jobs that have not been collected yet.
+     *
+     * @return Summaries of all known jobs in order of their launch.
+     */
+    std::vector<job_info> list() const noexcept
+    {
+        std::lock_guard<std::mutex> guard(mutex);
+
+        std::vector<job_info> infos{};
+        for (const auto& [id, j] : jobs)
+        {
+            const auto end = j->status == job_status::FINISHED ? j->end : std::chrono::steady_clock::now();
+            infos.push_back({id, j->description, j->status,
+                             std::chrono::duration<double>(end - j->start).count()});
+        }
+
+        return infos;
+    }
+    /**
+     * Checks whether any job is still running. Forking while worker threads exist is unsafe because the child process
+     * inherits locks they hold, e.g., the ones of the memory allocator, without the threads that would release them.
+     *
+     * @return true iff at least one job is running, including killed ones that have not stopped yet.
+     */
+    bool running() const noexcept
+    {
+        std::lock_guard<std::mutex> guard(mutex);
+
+        return std::any_of(jobs.cbegin(), jobs.cend(), [](const auto& j)
+                           { return j.second->status == job_status::RUNNING; }) ||
+               std::any_of(killed.cbegin(), killed.cend(), [](const auto& j)
+                           { return j->status == job_status::RUNNING; });
+    }
+    /**
+     * Guards commands that must not run concurrently with any job, e.g., ones that modify stored data that running jobs
+     * might still read. Prints an error to the given stream if any job is still running, including killed ones.
+     *
+     * @param out Stream to print the error to.
+     * @param action Description of what cannot be done, e.g., "gate layouts cannot be modified".
+     * @return true iff at least one job is running, i.e., iff the calling command has to be aborted.
+     */
+    bool refuse_while_running(std::ostream& out, const std::string& action) const
+    {
+        if (!running())
+            return false;
+
+        out << fmt::format("[e] {} while background jobs are running; use wait first", action) << std::endl;
+        return true;
+    }
+
+private:
+    /**
+     * A job consisting of its worker thread, its buffered output, and its results.
+     */
+    struct job
+    {
+        std::string description{};
+        job_interrupt interrupt{};
+        std::thread worker{};
+        std::ostringstream output{};
+        job_result result{};
+        job_status status = job_status::RUNNING;
+        std::chrono::steady_clock::time_point start{}, end{};
+    };
+    /**
+     * All jobs that have not been collected yet indexed by their identifiers.
+     */
+    std::map<job_id, std::shared_ptr<job>> jobs{};
+    /**
+     * Killed jobs whose worker threads have not been joined yet.
+     */
+    std::vector<std::shared_ptr<job>> killed{};
+    /**
+     * Identifier of the most recently launched job.
+     */
+    job_id last_id = 0ul;
+    /**
+     * Restricts access to jobs, killed, and their status.
+     */
+    mutable std::mutex mutex{};
+    /**
+     * Notified whenever a job finishes.
+     */
+    std::condition_variable finished{};
+
+    background_jobs() = default;
+    /**
+     * Jobs that are still running when the process ends are interrupted and joined since their threads refer to this
+     * instance. Jobs without an interrupt hook delay the exit until their work is done.
+     */
+    ~background_jobs()
+    {
+        std::vector<std::shared_ptr<job>> remaining{};
+        {
+            std::lock_guard<std::mutex> guard(mutex);
+
+            for (const auto& [id, j] : jobs)
+                remaining.push_back(j);
+            remaining.insert(remaining.end(), killed.cbegin(), killed.cend());
+        }
+
+        // interrupting finished work is harmless
+        for (const auto& j : remaining)
+        {
+            if (j->interrupt)
+                j->interrupt();
+        }
+
+        for (const auto& j : remaining)
+        {
+            if (j->worker.joinable())
+                j->worker.join();
+        }
+    }
+    /**
+     * Joins the worker threads of all killed jobs that have finished and forgets them.
+     */
+    void reap() noexcept
+    {
+        std::vector<std::shared_ptr<job>> done{};
+        {
+            std::lock_guard<std::mutex> guard(mutex);
+
+            const auto it = std::stable_partition(killed.begin(), killed.end(), [](const auto& j)
+                                                  { return j->status == job_status::RUNNING; });
+            done.assign(it, killed.end());
+            killed.erase(it, killed.end());
+        }
+
+        for (auto& j : done)
+            j->worker.join();
+    }
+    /**
+     * Removes all finished jobs from the list of known ones and joins their threads.
+     *
+     * @return Finished jobs with their identifiers.
+     */
+    std::vector<std::pair<job_id, std::shared_ptr<job>>> take_finished() noexcept
+    {
+        std::vector<std::pair<job_id, std::shared_ptr<job>>> done{};
+        {
+            std::lock_guard<std::mutex> guard(mutex);
+
+            for (auto it = jobs.begin(); it != jobs.end(); )
+            {
+                if (it->second->status == job_status::FINISHED)
+                {
+                    done.emplace_back(*it);
+                    it = jobs.erase(it);
+                }
+                else
+                    ++it;
+            }
+        }
+
+        for (auto& [id, j] : done)
+            j->worker.join();
+
+        reap();
+
+        return done;
+    }
+    /**
+     * Identifiers of all known jobs.
+     *
+     * @return Identifiers in order of launch.
+     */
+    std::vector<job_id> ids() const noexcept
+    {
+        std::lock_guard<std::mutex> guard(mutex);
+
+        std::vector<job_id> result{};
+        for (const auto& [id, j] : jobs)
+            result.push_back(id);
+
+        return result;
+    }
+    /**
+     * Prints the output of the given finished job and commits its results.
+     *
+     * @param id Identifier of the job.
+     * @param j Finished job.
+     * @param out Stream to print the job's output to.
+     * @return Logging information of j.
+     */
+    static nlohmann::json commit(const job_id id, job& j, std::ostream& out)
+    {
+        out << fmt::format("[i] job {} ({}) finished after {:.2f} s", id, j.description,
+                           std::chrono::duration<double>(j.end - j.start).count()) << std::endl;
+        out << j.output.str() << std::flush;
+
+        if (j.result.commit)
+            j.result.commit();
+
+        return {{"job", id}, {"command", j.description}, {"result", j.result.log}};
+    }
+};
+
+
+#endif //FICTION_BACKGROUND_JOBS_H
@@ -0,0 +1,91 @@
+//
+// Created by marcel on 19.10.26.
+//
+
+#ifndef FICTION_COPY_ON_WRITE_H
+#define FICTION_COPY_ON_WRITE_H
+
+#include <atomic>
+#include <memory>
+
+/**
+ * Wraps an object such that copies of the wrapper share it until one of them is about to modify it. Copying a wrapper
+ * is therefore O(1) regardless of the size of the wrapped object. Read access is granted via operator* and operator->,
+ * whereas write access has to be requested explicitly via write, which copies the wrapped object first if it is
+ * shared with other wrappers.
+ *
+ * Distinct wrappers can be used from different threads concurrently even if they share an object, i.e., copies can be
+ * handed to other threads and be read and modified there. Shared objects are never modified. If write observes that
+ * its wrapper is the only owner, no other wrapper can share the object anymore and an acquire fence ensures that all
+ * accesses of wrappers that released it before have completed. A single wrapper, however, must not be used from
+ * different threads concurrently.
+ *
+ * @tparam T Type of the wrapped object. Must be default and copy constructible.
+ */
+template <typename T>
+class copy_on_write
+{
+public:
+    /**
+     * Standard constructor. Wraps a default constructed object.
+     */
+    copy_on_write()
+            :
+            data{std::make_shared<T>()}
+    {}
+    /**
+     * Read access to the wrapped object.
+     *
+     * @return Const reference to the wrapped object.
+     */
+    const T& operator*() const noexcept
+    {
+        return *data;
+    }
+    /**
+     * Read access to the wrapped object.
+     *
+     * @return Const pointer to the wrapped object.
+     */
+    const T* operator->() const noexcept
+    {
+        return data.get();
+    }
+    /**
+     * Write access to the wrapped object. If it is shared with other wrappers, it is copied first such that they are
+     * not affected by the modification.
+     *
+     * @return Reference to the wrapped object that is owned by this wrapper only.
+     */
+    T& write()
+    {
+        if (data.use_count() > 1)
+            data = std::make_shared<T>(*data);
+        else
+        {
+            // other wrappers released the object via decrements of the reference counter that use_count does not
+            // synchronize with; their reads have to happen before the following modifications
+            std::atomic_thread_fence(std::memory_order_acquire);
+        }
+
+        return *data;
+    }
+    /**
+     * Checks whether the wrapped object is shared with other wrappers, i.e., whether the next call to write copies it.
+     *
+     * @return True iff the wrapped object is shared.
+     */
+    bool is_shared() const noexcept
+    {
+        return data.use_count() > 1;
+    }
+
+private:
+    /**
+     * Wrapped object.
+     */
+    std::shared_ptr<T> data;
+};
+
+
+#endif //FICTION_COPY_ON_WRITE_H
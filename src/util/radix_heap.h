@@ -0,0 +1,152 @@
+//
+// Created by marcel on 19.10.26.
+//
+
+#ifndef FICTION_RADIX_HEAP_H
+#define FICTION_RADIX_HEAP_H
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * A monotone priority queue for unsigned integral keys as introduced in "Faster Algorithms for the Shortest Path
+ * Problem" by Ravindra K. Ahuja, Kurt Mehlhorn, James B. Orlin, and Robert E. Tarjan in Journal of the ACM 1990.
+ *
+ * Elements are sorted into buckets by the highest bit in which their key differs from the last extracted minimum.
+ * Pushing is constant time and each element is moved to a lower bucket at most once per bit, which results in an
+ * amortized runtime of O(log C) per extraction where C is the largest key difference. Requires that no key smaller than
+ * the last extracted minimum is pushed, which holds for Dijkstra's algorithm and for A* with consistent heuristics.
+ *
+ * Buckets keep their capacity when the heap is cleared such that a heap can be reused for many searches without
+ * further allocations.
+ *
+ * @tparam Key Unsigned integral key type.
+ * @tparam Value Type of the stored values.
+ */
+template <typename Key, typename Value>
+class radix_heap
+{
+    static_assert(std::is_unsigned_v<Key>, "radix_heap requires an unsigned integral key type");
+
+public:
+    /**
+     * Inserts the given value with the given key. Keys smaller than the last extracted minimum are raised to it.
+     *
+     * @param k Key of v.
+     * @param v Value to insert.
+     */
+    void push(const Key k, Value v) noexcept
+    {
+        const auto key = std::max(k, last);
+        buckets[bucket(key)].emplace_back(key, std::move(v));
+        ++count;
+    }
+    /**
+     * Removes and returns an element with minimum key. Must not be called on an empty heap.
+     *
+     * @return Pair of minimum key and its value.
+     */
+    std::pair<Key, Value> pop() noexcept
+    {
+        if (buckets[0].empty())
+        {
+            // find the first non-empty bucket
+            auto i = 1ul;
+            while (buckets[i].empty())
+                ++i;
+
+            // its minimum becomes the new reference and all its elements move to lower buckets
+            last = std::min_element(buckets[i].cbegin(), buckets[i].cend(), [](const auto& e1, const auto& e2)
+                                    { return e1.first < e2.first; })->first;
+
+            for (auto& e : buckets[i])
+                buckets[bucket(e.first)].push_back(std::move(e));
+
+            buckets[i].clear();
+        }
+
+        auto e = std::move(buckets[0].back());
+        buckets[0].pop_back();
+        --count;
+
+        return e;
+    }
+    /**
+     * Returns true iff the heap does not contain any elements.
+     *
+     * @return True iff size() == 0.
+     */
+    bool empty() const noexcept
+    {
+        return count == 0ul;
+    }
+    /**
+     * Returns the number of stored elements.
+     *
+     * @return Number of elements.
+     */
+    std::size_t size() const noexcept
+    {
+        return count;
+    }
+    /**
+     * Removes all elements and resets the reference key to 0. Allocated bucket capacity is kept.
+     */
+    void clear() noexcept
+    {
+        for (auto& b : buckets)
+            b.clear();
+
+        last  = 0;
+        count = 0ul;
+    }
+
+private:
+    /**
+     * Number of bits of Key.
+     */
+    static constexpr std::size_t bits = std::numeric_limits<Key>::digits;
+    /**
+     * One bucket for keys equal to the last minimum and one for each bit position.
+     */
+    std::array<std::vector<std::pair<Key, Value>>, bits + 1> buckets{};
+    /**
+     * Last extracted minimum.
+     */
+    Key last = 0;
+    /**
+     * Number of stored elements.
+     */
+    std::size_t count = 0ul;
+    /**
+     * Returns the bucket index of the given key, i.e. the position of the highest bit in which it differs from last
+     * plus 1 or 0 if it equals last.
+     *
+     * @param k Key whose bucket is desired.
+     * @return Bucket index of k.
+     */
+    std::size_t bucket(const Key k) const noexcept
+    {
+        auto diff = static_cast<std::uint64_t>(k ^ last);
+        if (diff == 0u)
+            return 0ul;
+
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<std::size_t>(64 - __builtin_clzll(diff));
+#else
+        std::size_t width = 0ul;
+        for (; diff != 0u; diff >>= 1u)
+            ++width;
+
+        return width;
+#endif
+    }
+};
+
+
+#endif //FICTION_RADIX_HEAP_H
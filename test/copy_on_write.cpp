@@ -0,0 +1,182 @@
+//
+// Created by marcel on 19.10.26.
+//
+
+#include "copy_on_write.h"
+#include "network_reader.h"
+#include "orthogonal.h"
+#include <fmt/format.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+
+namespace
+{
+    /**
+     * Number of threads that use copies concurrently.
+     */
+    const std::size_t num_threads = std::max(std::thread::hardware_concurrency(), 4u);
+    /**
+     * Number of times the threads are launched on freshly shared copies.
+     */
+    constexpr std::size_t num_rounds = 200ul;
+    /**
+     * Number of elements in each wrapped vector.
+     */
+    constexpr std::size_t num_elements = 10000ul;
+
+    /**
+     * Hands wrappers that share a vector to several threads. Each of them reads its vector, fills it with its own
+     * identifier, and reads it again. The last thread to write is the only owner and modifies the vector in place while
+     * the others might just have copied it. All threads have to observe their own values only.
+     *
+     * @return True iff no thread observed values of another one.
+     */
+    bool verify_wrappers()
+    {
+        std::atomic<std::size_t> deviations{0ul};
+
+        for (std::size_t r = 0ul; r < num_rounds; ++r)
+        {
+            std::vector<copy_on_write<std::vector<std::size_t>>> copies(num_threads);
+            copies.front().write().assign(num_elements, 0ul);
+            std::fill(std::next(copies.begin()), copies.end(), copies.front());
+
+            std::vector<std::thread> threads{};
+            for (std::size_t i = 0ul; i < num_threads; ++i)
+            {
+                threads.emplace_back([&copies, &deviations, i]
+                {
+                    auto& own = copies[i];
+
+                    if (std::any_of(own->cbegin(), own->cend(), [](const auto e){ return e != 0ul; }))
+                        ++deviations;
+
+                    auto& v = own.write();
+                    std::fill(v.begin(), v.end(), i + 1);
+
+                    if (std::any_of(own->cbegin(), own->cend(), [i](const auto e){ return e != i + 1; }))
+                        ++deviations;
+                });
+            }
+
+            for (auto& t : threads)
+                t.join();
+        }
+
+        if (deviations > 0ul)
+        {
+            std::cout << fmt::format("[e] copies observed values of other copies {} times", deviations.load())
+                      << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+    /**
+     * Hands snapshots of the given layout to several threads. Each of them clears all tiles of its snapshot and of a
+     * further snapshot it takes itself. Neither the other snapshots nor the layout itself may be affected.
+     *
+     * @param fgl Gate layout to take snapshots of.
+     * @return True iff all snapshots were modified independently.
+     */
+    bool verify_snapshots(const fcn_gate_layout_ptr& fgl)
+    {
+        const auto count_assigned = [](const fcn_gate_layout_ptr& layout)
+        {
+            std::size_t assigned = 0ul;
+            for (auto&& t : layout->tiles())
+            {
+                if (!layout->is_free_tile(t))
+                    ++assigned;
+            }
+
+            return assigned;
+        };
+
+        const auto assigned = count_assigned(fgl);
+        std::atomic<std::size_t> deviations{0ul};
+
+        std::vector<fcn_gate_layout_ptr> snapshots{};
+        for (std::size_t i = 0ul; i < num_threads; ++i)
+            snapshots.push_back(fgl->snapshot_layout());
+
+        std::vector<std::thread> threads{};
+        for (std::size_t i = 0ul; i < num_threads; ++i)
+        {
+            threads.emplace_back([&snapshots, &deviations, &count_assigned, assigned, i]
+            {
+                const auto own = snapshots[i];
+                for (const auto& layout : {own, own->snapshot_layout()})
+                {
+                    if (count_assigned(layout) != assigned)
+                        ++deviations;
+
+                    for (auto&& t : layout->tiles())
+                        layout->clear_tile(t);
+
+                    if (count_assigned(layout) != 0ul)
+                        ++deviations;
+                }
+            });
+        }
+
+        for (auto& t : threads)
+            t.join();
+
+        if (count_assigned(fgl) != assigned)
+            ++deviations;
+
+        if (deviations > 0ul)
+        {
+            std::cout << fmt::format("[e] {}: snapshots were not modified independently in {} cases", fgl->get_name(),
+                                     deviations.load()) << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+}
+
+/**
+ * Verifies that copy_on_write wrappers and snapshots of gate layouts sharing storage can be read and modified from
+ * different threads concurrently. The layouts are generated by orthogonal physical design from all logic networks
+ * given as arguments.
+ */
+int main(int argc, char* argv[])
+{
+    auto failures = verify_wrappers() ? 0ul : 1ul;
+
+    for (auto i = 1; i < argc; ++i)
+    {
+        network_reader reader{argv[i], std::cout};
+        for (const auto& ln : reader.get_networks())
+        {
+            orthogonal physical_design{ln, 4u, true};
+            if (!physical_design().success)
+            {
+                std::cout << fmt::format("[e] impossible to place and route {}", ln->get_name()) << std::endl;
+                ++failures;
+                continue;
+            }
+
+            if (!verify_snapshots(physical_design.get_layout()))
+                ++failures;
+        }
+    }
+
+    if (failures > 0ul)
+    {
+        std::cout << fmt::format("[e] {} verifications failed", failures) << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "[i] copies and snapshots were modified independently from concurrent threads" << std::endl;
+
+    return EXIT_SUCCESS;
+}
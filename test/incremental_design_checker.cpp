@@ -0,0 +1,170 @@
+//
+// Created by marcel on 19.10.26.
+//
+
+#include "incremental_design_checker.h"
+#include "network_reader.h"
+#include "orthogonal.h"
+#include <fmt/format.h>
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+
+namespace
+{
+    /**
+     * Number of batches in which the tiles of a layout are cleared. Each batch is followed by a full check.
+     */
+    constexpr std::size_t num_edit_batches = 16ul;
+
+    /**
+     * Clears all assigned tiles of the given layout batch by batch within a transaction that is rolled back afterwards.
+     * Then, a latch is assigned and removed, nested transactions are committed and rolled back, and the layout is
+     * enlarged and shrunk again. After each step, the tracked violations have to match a full check.
+     *
+     * @param fgl Gate layout to verify the incremental check on. It is restored eventually.
+     * @param wire_limit Maximum number of wires per tile.
+     * @return True iff the incremental check agreed with the full one after every step.
+     */
+    bool verify(const fcn_gate_layout_ptr& fgl, const std::size_t wire_limit)
+    {
+        incremental_design_checker idc{fgl, wire_limit};
+
+        const auto agrees = [&idc, &fgl](const char* step)
+        {
+            if (idc.is_consistent())
+                return true;
+
+            std::cout << fmt::format("[e] {}: incremental design rule check deviates from full check after {}",
+                                     fgl->get_name(), step) << std::endl;
+            return false;
+        };
+
+        if (!agrees("construction"))
+            return false;
+
+        const auto drvs = idc.get_drvs(), warnings = idc.get_warnings();
+        const auto restored = [&idc, &fgl, &agrees, drvs, warnings](const char* step)
+        {
+            if (!agrees(step))
+                return false;
+
+            if (idc.get_drvs() == drvs && idc.get_warnings() == warnings)
+                return true;
+
+            std::cout << fmt::format("[e] {}: numbers of violations were not restored after {}", fgl->get_name(),
+                                     step) << std::endl;
+            return false;
+        };
+
+        std::vector<fcn_gate_layout::tile> assigned{};
+        for (auto&& t : fgl->tiles())
+        {
+            if (!fgl->is_free_tile(t))
+                assigned.push_back(t);
+        }
+
+        // edits that pass through states violating rules
+        fgl->begin_transaction();
+        const auto batch_size = std::max(assigned.size() / num_edit_batches, std::size_t{1});
+        for (std::size_t i = 0ul; i < assigned.size(); ++i)
+        {
+            fgl->clear_tile(assigned[i]);
+            if ((i + 1) % batch_size == 0ul && !agrees("clearing tiles"))
+                return false;
+        }
+        fgl->rollback_transaction();
+        if (!restored("rolling back a transaction"))
+            return false;
+
+        // latch assignment
+        if (const auto wire = std::find_if(assigned.cbegin(), assigned.cend(), [&fgl](const auto& t)
+                                           { return fgl->is_wire_tile(t); }); wire != assigned.cend())
+        {
+            fgl->begin_transaction();
+            fgl->assign_latch(*wire, static_cast<fcn_layout::latch_delay>(fgl->get_latch(*wire) + 1));
+            if (!agrees("assigning a latch"))
+                return false;
+            fgl->rollback_transaction();
+            if (!restored("rolling back a latch"))
+                return false;
+        }
+
+        // nested transactions of which the inner one is committed
+        if (!assigned.empty())
+        {
+            fgl->begin_transaction();
+            fgl->begin_transaction();
+            fgl->clear_tile(assigned.front());
+            fgl->commit_transaction();
+            if (!agrees("committing a nested transaction"))
+                return false;
+            fgl->rollback_transaction();
+            if (!restored("rolling back an outer transaction"))
+                return false;
+        }
+
+        // resizing
+        const auto x = fgl->x(), y = fgl->y(), z = fgl->z();
+        fgl->resize(fcn_dimension_xyz{x + 1, y + 1, z});
+        if (!agrees("enlarging the layout"))
+            return false;
+        fgl->resize(fcn_dimension_xyz{x, y, z});
+
+        return restored("shrinking the layout");
+    }
+}
+
+/**
+ * Verifies the incremental_design_checker against full design rule checks while gate layouts are edited, rolled back,
+ * and resized. The layouts are generated by orthogonal physical design from all logic networks given as arguments.
+ */
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        std::cout << fmt::format("[e] usage: {} <logic network file or folder>...", argv[0]) << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    auto failures = 0ul, layouts = 0ul;
+    for (auto i = 1; i < argc; ++i)
+    {
+        network_reader reader{argv[i], std::cout};
+        for (const auto& ln : reader.get_networks())
+        {
+            // layouts with and without designated I/O pins and with 3 and 4 clock phases
+            for (const auto& [phases, io] : {std::pair{3u, false}, std::pair{4u, true}})
+            {
+                orthogonal physical_design{ln, phases, io};
+                if (!physical_design().success)
+                {
+                    std::cout << fmt::format("[e] impossible to place and route {}", ln->get_name()) << std::endl;
+                    ++failures;
+                    continue;
+                }
+
+                ++layouts;
+                for (const auto wire_limit : {1ul, 2ul})
+                {
+                    if (!verify(physical_design.get_layout(), wire_limit))
+                        ++failures;
+                }
+            }
+        }
+    }
+
+    if (failures > 0ul)
+    {
+        std::cout << fmt::format("[e] {} verifications failed", failures) << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << fmt::format("[i] incremental design rule check agrees with full check on {} layouts", layouts)
+              << std::endl;
+
+    return EXIT_SUCCESS;
+}